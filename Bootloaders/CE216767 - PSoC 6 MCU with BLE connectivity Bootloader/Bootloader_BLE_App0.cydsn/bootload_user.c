@@ -22,7 +22,7 @@
 *******************************************************************************/
 
 #include <string.h>
-#include "transport_ble.h"
+#include "transport_mux.h"
 #include "syslib/cy_syslib.h"
 #include "flash/cy_flash.h"
 #include "bootloader/cy_bootload.h"
@@ -164,7 +164,7 @@ cy_en_bootload_status_t Cy_Bootload_ReadData (uint32_t address, uint32_t length,
 *******************************************************************************/
 cy_en_bootload_status_t Cy_Bootload_TransportRead (uint8_t *buffer, uint32_t size, uint32_t *count, uint32_t timeout)
 {
-    return (CyBLE_CyBtldrCommRead(buffer, size, count, timeout));
+    return (TransportMux_CyBtldrCommRead(buffer, size, count, timeout));
 }
 
 /*******************************************************************************
@@ -177,7 +177,7 @@ cy_en_bootload_status_t Cy_Bootload_TransportRead (uint8_t *buffer, uint32_t siz
 *******************************************************************************/
 cy_en_bootload_status_t Cy_Bootload_TransportWrite(uint8_t *buffer, uint32_t size, uint32_t *count, uint32_t timeout)
 {
-    return (CyBLE_CyBtldrCommWrite(buffer, size, count, timeout));
+    return (TransportMux_CyBtldrCommWrite(buffer, size, count, timeout));
 }
 
 /*******************************************************************************
@@ -190,7 +190,7 @@ cy_en_bootload_status_t Cy_Bootload_TransportWrite(uint8_t *buffer, uint32_t siz
 *******************************************************************************/
 void Cy_Bootload_TransportReset(void)
 {
-    CyBLE_CyBtldrCommReset();
+    TransportMux_CyBtldrCommReset();
 }
 
 /*******************************************************************************
@@ -203,7 +203,7 @@ void Cy_Bootload_TransportReset(void)
 *******************************************************************************/
 void Cy_Bootload_TransportStart(void)
 {
-    CyBLE_CyBtldrCommStart();
+    TransportMux_CyBtldrCommStart();
 }
 
 /*******************************************************************************
@@ -216,7 +216,7 @@ void Cy_Bootload_TransportStart(void)
 *******************************************************************************/
 void Cy_Bootload_TransportStop(void)
 {
-    CyBLE_CyBtldrCommStop();
+    TransportMux_CyBtldrCommStop();
 }
 
 
@@ -0,0 +1,210 @@
+/***************************************************************************//**
+* \file transport_mux.c
+* \version 1.0
+*
+*  This file provides the source code of the bootloader transport multiplexer.
+*  All transports are started together and polled in turn until one of them
+*  receives a bootloader command. The session is then locked onto that
+*  transport until Cy_Bootload_TransportReset() is called, so an image is never
+*  mixed from two links. Every transport reads directly into the packet buffer
+*  passed in by the Bootloader SDK, so the buffers are shared.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "transport_mux.h"
+#include "transport_ble.h"
+
+#if (TRANSPORT_MUX_UART_ENABLED != 0u)
+#include "UART.h"
+#endif /* (TRANSPORT_MUX_UART_ENABLED != 0u) */
+
+#if CY_BLE_HOST_CORE
+
+/* Time (in milliseconds) one polling pass takes: a slice for each transport */
+#if (TRANSPORT_MUX_UART_ENABLED != 0u)
+#define TRANSPORT_MUX_PASS_MS       (2u * TRANSPORT_MUX_POLL_SLICE_MS)
+#else
+#define TRANSPORT_MUX_PASS_MS       (TRANSPORT_MUX_POLL_SLICE_MS)
+#endif /* (TRANSPORT_MUX_UART_ENABLED != 0u) */
+
+/* Transport the current session is locked onto */
+static transport_mux_t activeTransport = TRANSPORT_MUX_NONE;
+
+
+/*******************************************************************************
+* Function Name: TransportMux_CyBtldrCommStart
+****************************************************************************//**
+*
+* Starts all transports. No transport is selected until a command is received.
+*
+*******************************************************************************/
+void TransportMux_CyBtldrCommStart(void)
+{
+    CyBLE_CyBtldrCommStart();
+#if (TRANSPORT_MUX_UART_ENABLED != 0u)
+    UART_UartCyBtldrCommStart();
+#endif /* (TRANSPORT_MUX_UART_ENABLED != 0u) */
+    activeTransport = TRANSPORT_MUX_NONE;
+}
+
+
+/*******************************************************************************
+* Function Name: TransportMux_CyBtldrCommStop
+****************************************************************************//**
+*
+* Stops all transports.
+*
+*******************************************************************************/
+void TransportMux_CyBtldrCommStop(void)
+{
+#if (TRANSPORT_MUX_UART_ENABLED != 0u)
+    UART_UartCyBtldrCommStop();
+#endif /* (TRANSPORT_MUX_UART_ENABLED != 0u) */
+    CyBLE_CyBtldrCommStop();
+    activeTransport = TRANSPORT_MUX_NONE;
+}
+
+
+/*******************************************************************************
+* Function Name: TransportMux_CyBtldrCommReset
+****************************************************************************//**
+*
+* Resets all transports and releases the session lock, so the next session
+* can be started from any transport.
+*
+*******************************************************************************/
+void TransportMux_CyBtldrCommReset(void)
+{
+    CyBLE_CyBtldrCommReset();
+#if (TRANSPORT_MUX_UART_ENABLED != 0u)
+    UART_UartCyBtldrCommReset();
+#endif /* (TRANSPORT_MUX_UART_ENABLED != 0u) */
+    activeTransport = TRANSPORT_MUX_NONE;
+}
+
+
+/*******************************************************************************
+* Function Name: TransportMux_CyBtldrCommRead
+****************************************************************************//**
+*
+* Receives a command from the locked transport. If no session is active, polls
+* every transport for TRANSPORT_MUX_POLL_SLICE_MS in turn until one of them
+* returns a command or the timeout expires, and locks onto that transport.
+* Each pass takes a slice per transport off the timeout.
+*
+* \param pData   The pointer to the buffer to store data from the host.
+* \param size    The number of bytes to read into the data buffer.
+* \param count   The pointer to where the number of bytes read is written.
+* \param timeout The amount of time (in milliseconds) to wait for a command.
+*
+* \return
+* - CY_BOOTLOAD_SUCCESS       - A command was successfully read.
+* - CY_BOOTLOAD_ERROR_TIMEOUT - No transport received a command in time.
+* - Other status codes are passed through from the transport.
+*
+*******************************************************************************/
+cy_en_bootload_status_t TransportMux_CyBtldrCommRead(uint8_t pData[], uint32_t size, uint32_t *count, uint32_t timeout)
+{
+    cy_en_bootload_status_t status = CY_BOOTLOAD_ERROR_TIMEOUT;
+
+    switch (activeTransport)
+    {
+    case TRANSPORT_MUX_BLE:
+        status = CyBLE_CyBtldrCommRead(pData, size, count, timeout);
+        break;
+
+#if (TRANSPORT_MUX_UART_ENABLED != 0u)
+    case TRANSPORT_MUX_UART:
+        status = UART_UartCyBtldrCommRead(pData, size, count, timeout);
+        break;
+#endif /* (TRANSPORT_MUX_UART_ENABLED != 0u) */
+
+    default:
+        do
+        {
+            status = CyBLE_CyBtldrCommRead(pData, size, count, TRANSPORT_MUX_POLL_SLICE_MS);
+            if (status != CY_BOOTLOAD_ERROR_TIMEOUT)
+            {
+                activeTransport = TRANSPORT_MUX_BLE;
+                break;
+            }
+        #if (TRANSPORT_MUX_UART_ENABLED != 0u)
+            status = UART_UartCyBtldrCommRead(pData, size, count, TRANSPORT_MUX_POLL_SLICE_MS);
+            if (status != CY_BOOTLOAD_ERROR_TIMEOUT)
+            {
+                activeTransport = TRANSPORT_MUX_UART;
+                break;
+            }
+        #endif /* (TRANSPORT_MUX_UART_ENABLED != 0u) */
+            timeout = (timeout > TRANSPORT_MUX_PASS_MS) ? (timeout - TRANSPORT_MUX_PASS_MS) : 0u;
+        } while (timeout != 0u);
+        break;
+    }
+    return (status);
+}
+
+
+/*******************************************************************************
+* Function Name: TransportMux_CyBtldrCommWrite
+****************************************************************************//**
+*
+* Sends a response through the transport the session is locked onto.
+*
+* \param pData   The pointer to the buffer containing data to be written.
+* \param size    The number of bytes from the data buffer to write.
+* \param count   The pointer to where the number of bytes written is stored.
+* \param timeout The amount of time (in milliseconds) to complete the write.
+*
+* \return
+* - CY_BOOTLOAD_SUCCESS       - The response was sent.
+* - CY_BOOTLOAD_ERROR_UNKNOWN - No session is active.
+* - Other status codes are passed through from the transport.
+*
+*******************************************************************************/
+cy_en_bootload_status_t TransportMux_CyBtldrCommWrite(const uint8_t pData[], uint32_t size, uint32_t *count, uint32_t timeout)
+{
+    cy_en_bootload_status_t status = CY_BOOTLOAD_ERROR_UNKNOWN;
+
+    switch (activeTransport)
+    {
+    case TRANSPORT_MUX_BLE:
+        status = CyBLE_CyBtldrCommWrite(pData, size, count, timeout);
+        break;
+
+#if (TRANSPORT_MUX_UART_ENABLED != 0u)
+    case TRANSPORT_MUX_UART:
+        status = UART_UartCyBtldrCommWrite(pData, size, count, timeout);
+        break;
+#endif /* (TRANSPORT_MUX_UART_ENABLED != 0u) */
+
+    default:
+        *count = 0u;
+        break;
+    }
+    return (status);
+}
+
+
+/*******************************************************************************
+* Function Name: TransportMux_GetActive
+****************************************************************************//**
+*
+* Returns the transport the current session is locked onto.
+*
+* \return TRANSPORT_MUX_NONE if no session is active.
+*
+*******************************************************************************/
+transport_mux_t TransportMux_GetActive(void)
+{
+    return (activeTransport);
+}
+
+#endif /* CY_BLE_HOST_CORE */
+
+/* [] END OF FILE */
@@ -0,0 +1,60 @@
+/***************************************************************************//**
+* \file transport_mux.h
+* \version 1.0
+*
+*  Contains the function prototypes and constants for the bootloader
+*  transport multiplexer. The multiplexer polls the BLE and UART transports
+*  and locks onto the one which receives the first bootloader command.
+*
+********************************************************************************
+* \copyright
+* Copyright 2017, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(TRANSPORT_MUX_H)
+#define TRANSPORT_MUX_H
+
+#include <stdint.h>
+#include "bootloader/cy_bootload.h"
+
+/***************************************
+* Conditional Compilation Parameters
+***************************************/
+/*
+* Set to non-zero to also accept bootloader commands on the SCB UART
+* component named "UART" (not the debug UART_DEB). Requires the component
+* to be placed in the TopDesign.
+*/
+#define TRANSPORT_MUX_UART_ENABLED          (0u)
+
+/***************************************
+*           API Constants
+***************************************/
+/* Transports served by the multiplexer */
+typedef enum
+{
+    TRANSPORT_MUX_NONE = 0u,    /* No session, all transports are polled */
+    TRANSPORT_MUX_BLE,          /* Session locked onto BLE               */
+    TRANSPORT_MUX_UART          /* Session locked onto UART              */
+} transport_mux_t;
+
+/* Time slice (in milliseconds) given to each transport while polling */
+#define TRANSPORT_MUX_POLL_SLICE_MS         (1u)
+
+/***************************************
+*        Function Prototypes
+***************************************/
+void TransportMux_CyBtldrCommStart(void);
+void TransportMux_CyBtldrCommStop (void);
+void TransportMux_CyBtldrCommReset(void);
+cy_en_bootload_status_t TransportMux_CyBtldrCommRead (uint8_t pData[], uint32_t size, uint32_t *count, uint32_t timeout);
+cy_en_bootload_status_t TransportMux_CyBtldrCommWrite(const uint8_t pData[], uint32_t size, uint32_t *count, uint32_t timeout);
+transport_mux_t TransportMux_GetActive(void);
+
+#endif /* !defined(TRANSPORT_MUX_H) */
+
+
+/* [] END OF FILE */
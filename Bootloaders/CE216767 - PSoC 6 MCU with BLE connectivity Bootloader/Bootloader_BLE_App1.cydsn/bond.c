@@ -22,6 +22,9 @@
 
 /* Static global variables */
 static bool removeBondListFlag = false;
+static bool bondStorePending = false;
+static uint32_t bondStoreHoldOff = 0u;
+static bool bondStoreRowBusy = false;
 
 
 /*******************************************************************************
@@ -275,4 +278,120 @@ bool App_IsRemoveBondListFlag(void)
 }
 
 
+/*******************************************************************************
+* Function Name: App_BondStoreRequest()
+********************************************************************************
+* Summary:
+*  Schedules the bonding data to be stored to flash. Every request restarts
+*  the hold-off time, so a burst of bond updates (keys, CCCD, etc.) results
+*  in a single commit.
+*
+*******************************************************************************/
+void App_BondStoreRequest(void)
+{
+    bondStorePending = true;
+    bondStoreHoldOff = BOND_STORE_HOLD_OFF;
+}
+
+
+/*******************************************************************************
+* Function Name: App_BondStoreTick()
+********************************************************************************
+* Summary:
+*  Counts down the bond store hold-off time. Must be called once per second.
+*
+*******************************************************************************/
+void App_BondStoreTick(void)
+{
+    if(bondStoreHoldOff != 0u)
+    {
+        bondStoreHoldOff--;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: App_BondStoreTask()
+********************************************************************************
+* Summary:
+*  Commits the pending bonding data in the background, one flash row at a time.
+*  Once the hold-off time has elapsed (or immediately when there is no active
+*  connection) Cy_BLE_StoreBondingData() lays out the next changed row of the
+*  bond storage and starts its write (CY_BLE_INFO_FLASH_WRITE_IN_PROGRESS).
+*  The write is not waited for: every later call polls Cy_Flash_IsWriteComplete()
+*  once and only hands the next row to the stack when the previous one is done.
+*  The time the main loop is blocked between two BLE events is therefore
+*  bounded by starting a single row write.
+*
+*******************************************************************************/
+void App_BondStoreTask(void)
+{
+#if(CY_BLE_BONDING_REQUIREMENT == CY_BLE_BONDING_YES)
+    cy_en_ble_api_result_t apiResult;
+    
+    /* Catch updates made without CY_BLE_EVT_PENDING_FLASH_WRITE */
+    if((cy_ble_pendingFlashWrite != 0u) && (bondStorePending == false))
+    {
+        App_BondStoreRequest();
+    }
+    
+    /* No connection events to protect, commit without waiting */
+    if(Cy_BLE_GetNumOfActiveConn() == 0u)
+    {
+        bondStoreHoldOff = 0u;
+    }
+    
+    /* Poll the row started on an earlier pass, never wait for it */
+    if((bondStoreRowBusy == true) && (Cy_Flash_IsWriteComplete() == CY_FLASH_DRV_SUCCESS))
+    {
+        bondStoreRowBusy = false;
+    }
+    
+    /* Store bonding data to flash only when all debug information has been sent */
+    if((bondStorePending == true) && (bondStoreHoldOff == 0u) && (bondStoreRowBusy == false) && 
+       (UART_DEB_IS_TX_COMPLETE() != 0u))
+    {
+        apiResult = Cy_BLE_StoreBondingData();
+        if(apiResult == CY_BLE_INFO_FLASH_WRITE_IN_PROGRESS)
+        {
+            bondStoreRowBusy = true;
+        }
+        
+        if(cy_ble_pendingFlashWrite == 0u)
+        {
+            bondStorePending = false;
+            DBG_PRINTF("Store bonding data, status: %x \r\n", apiResult);
+        }
+    }
+#endif /* (CY_BLE_BONDING_REQUIREMENT == CY_BLE_BONDING_YES) */
+}
+
+
+/*******************************************************************************
+* Function Name: App_BondStoreFlush()
+********************************************************************************
+* Summary:
+*  Stores all pending bonding data to flash, blocking until the last row write
+*  is complete. Used before the BLE component is stopped or the device is reset.
+*
+*******************************************************************************/
+void App_BondStoreFlush(void)
+{
+#if(CY_BLE_BONDING_REQUIREMENT == CY_BLE_BONDING_YES)
+    while((cy_ble_pendingFlashWrite != 0u) || (bondStoreRowBusy == true))
+    {
+        if(bondStoreRowBusy == true)
+        {
+            bondStoreRowBusy = (Cy_Flash_IsWriteComplete() != CY_FLASH_DRV_SUCCESS);
+        }
+        else
+        {
+            bondStoreRowBusy = (Cy_BLE_StoreBondingData() == CY_BLE_INFO_FLASH_WRITE_IN_PROGRESS);
+        }
+    }
+    bondStorePending = false;
+#endif /* (CY_BLE_BONDING_REQUIREMENT == CY_BLE_BONDING_YES) */
+}
+
+
 /* [] END OF FILE */
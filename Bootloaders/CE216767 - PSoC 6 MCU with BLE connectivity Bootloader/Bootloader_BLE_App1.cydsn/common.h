@@ -36,6 +36,9 @@
 /* BAS service defines */
 #define BATTERY_TIMEOUT                 (30u)               /* Battery simulation timeout */
 
+/* Bond store defines */
+#define BOND_STORE_HOLD_OFF             (2u)                /* Counts in seconds, coalesces bond updates */
+
 /***************************************
 *        External Function Prototypes
 ***************************************/
@@ -57,6 +60,10 @@ void App_SetRemoveBondListFlag(void);
 bool App_IsRemoveBondListFlag(void);
 bool App_IsDeviceInBondList(uint32_t bdHandle);
 uint32_t App_GetCountOfBondedDevices(void);
+void App_BondStoreRequest(void);
+void App_BondStoreTick(void);
+void App_BondStoreTask(void);
+void App_BondStoreFlush(void);
 
 
 /***************************************
@@ -27,6 +27,7 @@
 #include "flash/cy_flash.h"
 #include "bootloader/cy_bootload.h"
 #include "smif_mem.h"
+#include "smif_cache.h"
 
 
 /*
@@ -342,14 +343,15 @@ cy_en_bootload_status_t Cy_Bootload_ReadData (uint32_t address, uint32_t length,
         /* Check if address is in the external memory */
         else if ((minXIPAddress <= address) && (address < maxXIPAddress))
     	{
+            /* Rows are read again to verify them, served from the read cache */
     		if ((ctl & CY_BOOTLOAD_IOCTL_COMPARE) == 0u)
     		{
-    		    ReadMemory(params->dataBuffer, length, address - minXIPAddress);
+    		    ReadMemoryCached(params->dataBuffer, length, address - minXIPAddress);
     		}
     		else
     		{
     		    uint8_t buffer[CY_BOOTLOAD_SIZEOF_DATA_BUFFER];
-    		    ReadMemory(&buffer[0], length, address - minXIPAddress);
+    		    ReadMemoryCached(&buffer[0], length, address - minXIPAddress);
     		    status = ( memcmp(params->dataBuffer, &buffer[0], length) == 0 )
     			     ? CY_BOOTLOAD_SUCCESS : CY_BOOTLOAD_ERROR_VERIFY;
     		}
@@ -0,0 +1,659 @@
+/******************************************************************************
+* File Name: smif_async.c
+*
+* Version: 1.0
+*
+* Description: Functions in this file implement the asynchronous SMIF request
+*              engine. The data phase of every request is moved between the
+*              buffer and the SMIF FIFOs by a DataWire channel, as in the
+*              F-RAM example CE222967, while the end of the transfer and the
+*              write-in-progress polling of program and erase operations are
+*              checked from ProcessSMIFRequests() without blocking.
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_async.h"
+#include "smif_mem.h"
+#include "smif_cache.h"
+#include "project.h"
+
+/* Elements of one X loop of a DataWire descriptor */
+#define DMA_X_COUNT_MAX             (256u)
+
+/* States of the request engine */
+typedef enum
+{
+    SMIF_ASYNC_IDLE = 0u,                   /* No request is running             */
+    SMIF_ASYNC_XFER,                        /* Data phase runs by DMA            */
+    SMIF_ASYNC_WAIT_WIP                     /* Memory is programming or erasing  */
+} smif_async_state_t;
+
+/* Request queue, the head entry is the running request */
+static smif_async_req_t* requestQueue[SMIF_ASYNC_QUEUE_DEPTH];
+static uint32_t queueHead = 0u;
+static uint32_t queueCount = 0u;
+
+static smif_async_state_t engineState = SMIF_ASYNC_IDLE;
+
+/* Progress of the running request */
+static uint32_t xferOffset;
+static uint32_t xferChunk;
+
+/* 2D descriptor for whole 256-byte rows and 1D descriptor for the rest */
+static cy_stc_dma_descriptor_t dmaDescriptors[2u];
+
+static cy_stc_dma_descriptor_config_t dmaDescriptorConfig =
+{
+    .retrigger       = CY_DMA_RETRIG_IM,
+    .interruptType   = CY_DMA_DESCR_CHAIN,
+    .triggerOutType  = CY_DMA_DESCR_CHAIN,
+    .channelState    = CY_DMA_CHANNEL_DISABLED,
+    .triggerInType   = CY_DMA_DESCR_CHAIN,
+    .dataSize        = CY_DMA_BYTE,
+    .srcTransferSize = CY_DMA_TRANSFER_SIZE_WORD,
+    .dstTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+    .descriptorType  = CY_DMA_1D_TRANSFER,
+    .srcAddress      = NULL,
+    .dstAddress      = NULL,
+    .srcXincrement   = 0,
+    .dstXincrement   = 1,
+    .xCount          = 1u,
+    .srcYincrement   = 0,
+    .dstYincrement   = 0,
+    .yCount          = 1u,
+    .nextDescriptor  = NULL
+};
+
+static bool dmaInitialized = false;
+
+/* Local functions */
+static void InitDma(void);
+static void SetupDma(uint8_t buffer[], uint32_t size, bool rx);
+static bool IsDmaDone(cy_en_smif_status_t *status);
+static cy_en_smif_status_t StartRequest(smif_async_req_t *req);
+static cy_en_smif_status_t StartReadChunk(smif_async_req_t *req);
+static cy_en_smif_status_t StartProgramChunk(smif_async_req_t *req);
+static void CompleteRequest(cy_en_smif_status_t status);
+static void DropCachedRange(const smif_async_req_t *req);
+
+/*******************************************************************************
+* Function Name: InitDma
+********************************************************************************
+*
+* This function sets up the DataWire channel on the first request. The SMIF
+* must insert wait states on a read from an empty RX FIFO or a write to a full
+* TX FIFO (blockEvent = CY_SMIF_WAIT_STATES), so the DMA follows the memory 
+* clock.
+*
+* \param
+*  None
+*
+* \return
+*  None
+*******************************************************************************/
+static void InitDma(void)
+{
+    cy_stc_dma_channel_config_t channelConfig;
+    SMIF_Type *base;
+    cy_stc_smif_context_t *context;
+
+    GetSMIFPointers(&base, &context);
+
+    /* A bus error instead of wait states fails the DMA on every FIFO access it is early for */
+    CY_ASSERT(_FLD2VAL(SMIF_CTL_BLOCK, base->CTL) == (uint32_t)CY_SMIF_WAIT_STATES);
+
+    channelConfig.descriptor  = &dmaDescriptors[0u];
+    channelConfig.preemptable = true;
+    channelConfig.priority    = SMIF_ASYNC_DMA_PRIORITY;
+    channelConfig.enable      = false;
+    (void)Cy_DMA_Descriptor_Init(&dmaDescriptors[0u], &dmaDescriptorConfig);
+    (void)Cy_DMA_Channel_Init(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL, &channelConfig);
+    Cy_DMA_Enable(SMIF_ASYNC_DMA_HW);
+    dmaInitialized = true;
+}
+
+/*******************************************************************************
+* Function Name: SetupDma
+********************************************************************************
+*
+* This function prepares the DMA channel to move the data phase of a command 
+* between the SMIF data FIFO and the buffer. The channel is enabled but starts
+* only on the software trigger.
+*
+* \param buffer
+* Data to program or read buffer.
+*
+* \param size
+* Size of the data phase, at most SMIF_ASYNC_MAX_CHUNK.
+*
+* \param rx
+* true to read from the RX FIFO, false to write to the TX FIFO.
+*
+* \return
+*  None
+*******************************************************************************/
+static void SetupDma(uint8_t buffer[], uint32_t size, bool rx)
+{
+    SMIF_Type *base;
+    cy_stc_smif_context_t *context;
+    void *fifo;
+    uint32_t rows = size / DMA_X_COUNT_MAX;
+    uint32_t rest = size % DMA_X_COUNT_MAX;
+    uint32_t idx = 0u;
+
+    GetSMIFPointers(&base, &context);
+    fifo = rx ? (void *)&base->RX_DATA_FIFO_RD1 : (void *)&base->TX_DATA_FIFO_WR1;
+
+    /* The FIFO side is a register and does not increment */
+    dmaDescriptorConfig.srcTransferSize = rx ? CY_DMA_TRANSFER_SIZE_WORD : CY_DMA_TRANSFER_SIZE_DATA;
+    dmaDescriptorConfig.dstTransferSize = rx ? CY_DMA_TRANSFER_SIZE_DATA : CY_DMA_TRANSFER_SIZE_WORD;
+    dmaDescriptorConfig.srcXincrement = rx ? 0 : 1;
+    dmaDescriptorConfig.dstXincrement = rx ? 1 : 0;
+    dmaDescriptorConfig.srcYincrement = rx ? 0 : (int32_t)DMA_X_COUNT_MAX;
+    dmaDescriptorConfig.dstYincrement = rx ? (int32_t)DMA_X_COUNT_MAX : 0;
+
+    if(rows != 0u)
+    {
+        dmaDescriptorConfig.descriptorType = CY_DMA_2D_TRANSFER;
+        dmaDescriptorConfig.srcAddress = rx ? fifo : (void *)buffer;
+        dmaDescriptorConfig.dstAddress = rx ? (void *)buffer : fifo;
+        dmaDescriptorConfig.xCount = DMA_X_COUNT_MAX;
+        dmaDescriptorConfig.yCount = rows;
+        dmaDescriptorConfig.channelState = (rest != 0u) ? CY_DMA_CHANNEL_ENABLED : CY_DMA_CHANNEL_DISABLED;
+        dmaDescriptorConfig.nextDescriptor = (rest != 0u) ? &dmaDescriptors[1u] : NULL;
+        (void)Cy_DMA_Descriptor_Init(&dmaDescriptors[0u], &dmaDescriptorConfig);
+        idx = 1u;
+    }
+
+    if(rest != 0u)
+    {
+        dmaDescriptorConfig.descriptorType = CY_DMA_1D_TRANSFER;
+        dmaDescriptorConfig.srcAddress = rx ? fifo : (void *)&buffer[rows * DMA_X_COUNT_MAX];
+        dmaDescriptorConfig.dstAddress = rx ? (void *)&buffer[rows * DMA_X_COUNT_MAX] : fifo;
+        dmaDescriptorConfig.xCount = rest;
+        dmaDescriptorConfig.yCount = 1u;
+        dmaDescriptorConfig.channelState = CY_DMA_CHANNEL_DISABLED;
+        dmaDescriptorConfig.nextDescriptor = NULL;
+        (void)Cy_DMA_Descriptor_Init(&dmaDescriptors[idx], &dmaDescriptorConfig);
+    }
+
+    Cy_DMA_Channel_ClearInterrupt(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL);
+    Cy_DMA_Channel_SetDescriptor(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL, &dmaDescriptors[0u]);
+    Cy_DMA_Channel_Enable(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL);
+}
+
+/*******************************************************************************
+* Function Name: IsDmaDone
+********************************************************************************
+*
+* This function checks if the DMA has moved the data phase and the SMIF has
+* completed the command. A DMA error aborts the SMIF transfer: the SMIF waits
+* for data the DMA will not move, so it is restarted, which empties the FIFOs.
+*
+* \param status
+* Set to the result of the data phase when it is over.
+*
+* \return
+* true if the data phase is over.
+*******************************************************************************/
+static bool IsDmaDone(cy_en_smif_status_t *status)
+{
+    SMIF_Type *base;
+    cy_stc_smif_context_t *context;
+    bool done = false;
+
+    GetSMIFPointers(&base, &context);
+
+    if(Cy_DMA_Channel_GetInterruptStatus(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL) != 0u)
+    {
+        if(Cy_DMA_Channel_GetStatus(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL) != CY_DMA_INTR_CAUSE_COMPLETION)
+        {
+            Cy_DMA_Channel_ClearInterrupt(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL);
+            Cy_DMA_Channel_Disable(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL);
+            Cy_SMIF_Disable(base);
+            Cy_SMIF_Enable(base, context);
+            *status = CY_SMIF_BAD_PARAM;
+            done = true;
+        }
+        else if(!Cy_SMIF_BusyCheck(base))
+        {
+            /* The last bytes of a program are clocked out of the TX FIFO */
+            Cy_DMA_Channel_ClearInterrupt(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL);
+            *status = CY_SMIF_SUCCESS;
+            done = true;
+        }
+        else
+        {
+            /* Wait for the SMIF */
+        }
+    }
+    return done;
+}
+
+/*******************************************************************************
+* Function Name: SubmitSMIFRequest
+********************************************************************************
+*
+* This function puts a request into the queue. The request is started from the
+* next call of ProcessSMIFRequests() once all earlier requests are completed.
+*
+* \param req
+* Request to queue. Must not be changed until req->done is set.
+*
+* \return
+* true if the request was queued. false if the queue is full, a read or program
+* request is empty or the request does not fit into the memory.
+*******************************************************************************/
+bool SubmitSMIFRequest(smif_async_req_t *req)
+{
+    bool queued = false;
+    uint32_t interruptState;
+    uint32_t memSize = smifMemConfigs[0]->deviceCfg->memSize;
+
+    if((req == NULL) || (req->address >= memSize))
+    {
+        return false;
+    }
+    if((req->op != SMIF_ASYNC_ERASE) && ((req->size == 0u) || (req->size > (memSize - req->address))))
+    {
+        return false;
+    }
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    if(queueCount < SMIF_ASYNC_QUEUE_DEPTH)
+    {
+        req->done = false;
+        req->status = CY_SMIF_SUCCESS;
+        requestQueue[(queueHead + queueCount) % SMIF_ASYNC_QUEUE_DEPTH] = req;
+        queueCount++;
+        queued = true;
+    }
+    Cy_SysLib_ExitCriticalSection(interruptState);
+    return queued;
+}
+
+/*******************************************************************************
+* Function Name: ProcessSMIFRequests
+********************************************************************************
+*
+* This function advances the request engine. It never waits for the memory:
+* it starts the next request when the engine is idle, checks for the end of the
+* data phase and polls the WIP bit once per call while the memory is busy.
+* Completion callbacks are called from this function.
+*
+* \param
+*  None
+*
+* \return
+*  None
+*******************************************************************************/
+void ProcessSMIFRequests(void)
+{
+    SMIF_Type *base;
+    cy_stc_smif_context_t *context;
+    smif_async_req_t *req;
+    cy_en_smif_status_t smif_status = CY_SMIF_SUCCESS;
+
+    if(queueCount == 0u)
+    {
+        return;
+    }
+
+    GetSMIFPointers(&base, &context);
+    req = requestQueue[queueHead];
+
+    switch(engineState)
+    {
+    case SMIF_ASYNC_IDLE:
+        /* The previous command must be released by the memory first */
+        if(!Cy_SMIF_Memslot_IsBusy(base, (cy_stc_smif_mem_config_t*)smifMemConfigs[0], context))
+        {
+            smif_status = StartRequest(req);
+            if(smif_status != CY_SMIF_SUCCESS)
+            {
+                CompleteRequest(smif_status);
+            }
+        }
+        break;
+
+    case SMIF_ASYNC_XFER:
+        if(IsDmaDone(&smif_status))
+        {
+            if(smif_status != CY_SMIF_SUCCESS)
+            {
+                CompleteRequest(smif_status);
+            }
+            else if(req->op == SMIF_ASYNC_READ)
+            {
+                xferOffset += xferChunk;
+                if(xferOffset < req->size)
+                {
+                    smif_status = StartReadChunk(req);
+                    if(smif_status != CY_SMIF_SUCCESS)
+                    {
+                        CompleteRequest(smif_status);
+                    }
+                }
+                else
+                {
+                    CompleteRequest(CY_SMIF_SUCCESS);
+                }
+            }
+            else
+            {
+                engineState = SMIF_ASYNC_WAIT_WIP;
+            }
+        }
+        break;
+
+    case SMIF_ASYNC_WAIT_WIP:
+        if(req->op == SMIF_ASYNC_ERASE)
+        {
+            if(!IsSMIFEraseBusy())
+            {
+                CompleteRequest(CY_SMIF_SUCCESS);
+            }
+        }
+        else if(!Cy_SMIF_Memslot_IsBusy(base, (cy_stc_smif_mem_config_t*)smifMemConfigs[0], context))
+        {
+            xferOffset += xferChunk;
+            if(xferOffset < req->size)
+            {
+                smif_status = StartProgramChunk(req);
+                if(smif_status != CY_SMIF_SUCCESS)
+                {
+                    CompleteRequest(smif_status);
+                }
+            }
+            else
+            {
+                CompleteRequest(CY_SMIF_SUCCESS);
+            }
+        }
+        else
+        {
+            /* The memory is still programming */
+        }
+        break;
+
+    default:
+        CompleteRequest(CY_SMIF_BAD_PARAM);
+        break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: IsSMIFQueueIdle
+********************************************************************************
+*
+* This function checks if all requests are completed.
+*
+* \param
+*  None
+*
+* \return
+* true if no request is queued or running.
+*******************************************************************************/
+bool IsSMIFQueueIdle(void)
+{
+    return (queueCount == 0u);
+}
+
+/*******************************************************************************
+* Function Name: GetSMIFQueueCount
+********************************************************************************
+*
+* This function returns the number of outstanding requests.
+*
+* \param
+*  None
+*
+* \return
+* Number of queued requests, including the running one.
+*******************************************************************************/
+uint32_t GetSMIFQueueCount(void)
+{
+    return queueCount;
+}
+
+/*******************************************************************************
+* Function Name: StartRequest
+********************************************************************************
+*
+* This function issues the first command of a request. Erase requests are
+* started by StartEraseSMIFSector(), so IsSMIFEraseBusy() and the blocking
+* functions of smif_mem.c know about the erase in progress.
+*
+* \param req
+* Request at the head of the queue.
+*
+* \return
+* Status of the SMIF driver.
+*******************************************************************************/
+static cy_en_smif_status_t StartRequest(smif_async_req_t *req)
+{
+    cy_en_smif_status_t smif_status;
+
+    if(!dmaInitialized)
+    {
+        InitDma();
+    }
+
+    xferOffset = 0u;
+    xferChunk = 0u;
+
+    switch(req->op)
+    {
+    case SMIF_ASYNC_READ:
+        smif_status = StartReadChunk(req);
+        break;
+
+    case SMIF_ASYNC_PROGRAM:
+        smif_status = StartProgramChunk(req);
+        break;
+
+    case SMIF_ASYNC_ERASE:
+        StartEraseSMIFSector(req->address);
+        engineState = SMIF_ASYNC_WAIT_WIP;
+        smif_status = CY_SMIF_SUCCESS;
+        break;
+
+    default:
+        smif_status = CY_SMIF_BAD_PARAM;
+        break;
+    }
+    return smif_status;
+}
+
+/*******************************************************************************
+* Function Name: StartReadChunk
+********************************************************************************
+*
+* This function reads the next part of a read request, at most 
+* SMIF_ASYNC_MAX_CHUNK bytes. The read command is given no buffer, so the 
+* driver leaves the RX FIFO to the DMA, which is triggered once the command 
+* is queued.
+*
+* \param req
+* Request at the head of the queue.
+*
+* \return
+* Status of the SMIF driver.
+*******************************************************************************/
+static cy_en_smif_status_t StartReadChunk(smif_async_req_t *req)
+{
+    SMIF_Type *base;
+    cy_stc_smif_context_t *context;
+    cy_en_smif_status_t smif_status;
+    uint32_t address = req->address + xferOffset;
+
+    GetSMIFPointers(&base, &context);
+
+    xferChunk = req->size - xferOffset;
+    if(xferChunk > SMIF_ASYNC_MAX_CHUNK)
+    {
+        xferChunk = SMIF_ASYNC_MAX_CHUNK;
+    }
+
+    /* Reverse address byte order */
+    address = __REV(address);
+    engineState = SMIF_ASYNC_XFER;
+
+    SetupDma(&req->buffer[xferOffset], xferChunk, true);
+    smif_status = Cy_SMIF_Memslot_CmdRead(base, smifMemConfigs[0], (uint8_t*)&address, NULL, xferChunk, NULL, context);
+    if(smif_status == CY_SMIF_SUCCESS)
+    {
+        (void)Cy_TrigMux_SwTrigger((uint32_t)TRIG0_OUT_CPUSS_DW0_TR_IN0 + SMIF_ASYNC_DMA_CHANNEL, CY_TRIGGER_TWO_CYCLES);
+    }
+    else
+    {
+        Cy_DMA_Channel_Disable(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL);
+    }
+    return smif_status;
+}
+
+/*******************************************************************************
+* Function Name: StartProgramChunk
+********************************************************************************
+*
+* This function programs the next part of a program request. A part never
+* crosses a page border of the memory, so it is programmed by one command.
+* The data is moved into the TX FIFO by the DMA, as for reads.
+*
+* \param req
+* Request at the head of the queue.
+*
+* \return
+* Status of the SMIF driver.
+*******************************************************************************/
+static cy_en_smif_status_t StartProgramChunk(smif_async_req_t *req)
+{
+    SMIF_Type *base;
+    cy_stc_smif_context_t *context;
+    cy_en_smif_status_t smif_status;
+    uint32_t pageSize = smifMemConfigs[0]->deviceCfg->programSize;
+    uint32_t address = req->address + xferOffset;
+
+    GetSMIFPointers(&base, &context);
+
+    /* Bytes left until the end of the page */
+    xferChunk = pageSize - (address % pageSize);
+    if(xferChunk > (req->size - xferOffset))
+    {
+        xferChunk = req->size - xferOffset;
+    }
+
+    /* Reverse address byte order */
+    address = __REV(address);
+    engineState = SMIF_ASYNC_XFER;
+
+    smif_status = Cy_SMIF_Memslot_CmdWriteEnable(base, smifMemConfigs[0], context);
+    if(smif_status == CY_SMIF_SUCCESS)
+    {
+        SetupDma(&req->buffer[xferOffset], xferChunk, false);
+        smif_status = Cy_SMIF_Memslot_CmdProgram(base, smifMemConfigs[0], (uint8_t*)&address, NULL, xferChunk, NULL, context);
+        if(smif_status == CY_SMIF_SUCCESS)
+        {
+            (void)Cy_TrigMux_SwTrigger((uint32_t)TRIG0_OUT_CPUSS_DW0_TR_IN0 + SMIF_ASYNC_DMA_CHANNEL, CY_TRIGGER_TWO_CYCLES);
+        }
+        else
+        {
+            Cy_DMA_Channel_Disable(SMIF_ASYNC_DMA_HW, SMIF_ASYNC_DMA_CHANNEL);
+        }
+    }
+    return smif_status;
+}
+
+/*******************************************************************************
+* Function Name: CompleteRequest
+********************************************************************************
+*
+* This function removes the running request from the queue and reports its
+* result.
+*
+* \param status
+* Result of the request.
+*
+* \return
+*  None
+*******************************************************************************/
+static void CompleteRequest(cy_en_smif_status_t status)
+{
+    smif_async_req_t *req = requestQueue[queueHead];
+    uint32_t interruptState;
+
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    queueHead = (queueHead + 1u) % SMIF_ASYNC_QUEUE_DEPTH;
+    queueCount--;
+    Cy_SysLib_ExitCriticalSection(interruptState);
+
+    engineState = SMIF_ASYNC_IDLE;
+
+    /* The memory has changed now, also when the request failed part way */
+    DropCachedRange(req);
+
+    req->status = status;
+    req->done = true;
+    if(req->callback != NULL)
+    {
+        req->callback(req);
+    }
+}
+
+/*******************************************************************************
+* Function Name: DropCachedRange
+********************************************************************************
+*
+* This function drops the copies of the range changed by a program request 
+* from the read cache and marks the range for SwitchSMIFMemory(). Until the 
+* request completes the memory still holds the old data, so the cached copies
+* stay valid while the request is queued or running. StartEraseSMIFSector() 
+* drops the sector of an erase request when the erase starts.
+*
+* \param req
+* Completed request.
+*
+* \return
+*  None
+*******************************************************************************/
+static void DropCachedRange(const smif_async_req_t *req)
+{
+    if(req->op == SMIF_ASYNC_PROGRAM)
+    {
+        InvalidateReadCache(req->address, req->size);
+        MarkSMIFModified(req->address, req->size);
+    }
+}
+
+/* [] END OF FILE */
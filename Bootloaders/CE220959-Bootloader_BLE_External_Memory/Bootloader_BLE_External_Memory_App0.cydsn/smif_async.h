@@ -0,0 +1,108 @@
+/******************************************************************************
+* File Name: smif_async.h
+*
+* Version: 1.0
+*
+* Description: This header file contains the defines for the asynchronous
+*              SMIF request engine. Requests are queued and executed from
+*              ProcessSMIFRequests(), the data is moved by a DataWire
+*              channel, so the CPU is free while data is moved and the
+*              memory is busy. The blocking
+*              functions of smif_mem.c must not be called while the queue is
+*              not idle.
+*
+* Related Document: CE220959.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef __SMIF_ASYNC_H
+#define __SMIF_ASYNC_H
+
+#include <stdbool.h>
+#include <cy_smif_memconfig.h>
+
+/*******************************************************************************
+*            Constants
+*******************************************************************************/
+
+#define SMIF_ASYNC_QUEUE_DEPTH      (8u)    /* Maximum number of outstanding requests */
+#define SMIF_ASYNC_MAX_CHUNK        (0x10000u) /* Largest data phase of one command (256 x 256 DMA elements) */
+
+/* DataWire channel moving the data between the SMIF FIFOs and SRAM */
+#define SMIF_ASYNC_DMA_HW           (DW0)   /* DataWire block */
+#define SMIF_ASYNC_DMA_CHANNEL      (14u)   /* Channel of the block, must not be used elsewhere */
+#define SMIF_ASYNC_DMA_PRIORITY     (3u)    /* Lowest channel priority */
+
+/* Operations served by the request engine */
+typedef enum
+{
+    SMIF_ASYNC_READ = 0u,                   /* Quad read of any length            */
+    SMIF_ASYNC_PROGRAM,                     /* Page program, split at page borders */
+    SMIF_ASYNC_ERASE                        /* Erase of the sector holding address */
+} smif_async_op_t;
+
+struct smif_async_req;
+
+/* Completion callback, called from ProcessSMIFRequests() */
+typedef void (*smif_async_cb_t)(struct smif_async_req *req);
+
+/* Request descriptor. The storage is owned by the caller and must stay valid
+*  until the request is done.
+*/
+typedef struct smif_async_req
+{
+    smif_async_op_t op;                     /* Operation to perform                */
+    uint32_t address;                       /* External memory address             */
+    uint8_t *buffer;                        /* Data to program or read buffer      */
+    uint32_t size;                          /* Number of bytes, unused for erase   */
+    smif_async_cb_t callback;               /* Called on completion, can be NULL   */
+    void *arg;                              /* User argument for the callback      */
+    cy_en_smif_status_t status;             /* Result, valid when done is set      */
+    volatile bool done;                     /* Set when the request is completed   */
+} smif_async_req_t;
+
+/*******************************************************************************
+*            Function Prototypes
+*******************************************************************************/
+bool SubmitSMIFRequest(smif_async_req_t *req);  /* Queue a request, false if full or out of range */
+
+void ProcessSMIFRequests(void);             /* Advance the engine, call from the main loop */
+
+bool IsSMIFQueueIdle(void);                 /* True if no request is queued or running */
+
+uint32_t GetSMIFQueueCount(void);           /* Number of queued and running requests */
+
+#endif /*__SMIF_ASYNC_H*/
+    
+/* [] END OF FILE */
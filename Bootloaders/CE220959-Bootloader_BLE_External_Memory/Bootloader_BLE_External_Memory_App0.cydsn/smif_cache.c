@@ -0,0 +1,317 @@
+/******************************************************************************
+* File Name: smif_cache.c
+*
+* Version: 1.0
+*
+* Description: Functions in this file implement a RAM read cache in front of
+*              ReadMemory(). Lines are replaced in LRU order and the next line
+*              is fetched ahead when the reads are sequential. The cache is
+*              only valid for normal mode reads; all writes and erases done
+*              through smif_mem.c and smif_async.c invalidate the lines they
+*              touch.
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_cache.h"
+#include "smif_mem.h"
+#include "project.h"
+#include <string.h>
+
+#if (SMIF_CACHE_ENABLED != 0u)
+
+/* No line was accessed yet */
+#define SMIF_CACHE_NO_LINE          (0xFFFFFFFFu)
+
+/* Line index returned when the address is not cached */
+#define SMIF_CACHE_MISS             (SMIF_CACHE_LINES)
+
+/* Line data and tags */
+CY_ALIGN(4) static uint8_t cacheData[SMIF_CACHE_LINES][SMIF_CACHE_LINE_SIZE];
+static uint32_t cacheTag[SMIF_CACHE_LINES];
+static bool cacheValid[SMIF_CACHE_LINES];
+static uint32_t cacheAge[SMIF_CACHE_LINES];
+
+/* Incremented on every access, a line with the lowest age is replaced first */
+static uint32_t accessClock = 0u;
+
+/* Line accessed last, used to detect sequential reads */
+static uint32_t lastLine = SMIF_CACHE_NO_LINE;
+
+static smif_cache_stats_t cacheStats;
+
+/* Local functions */
+static uint32_t FindLine(uint32_t lineAddress);
+static uint32_t FillLine(uint32_t lineAddress);
+
+/*******************************************************************************
+* Function Name: FindLine
+********************************************************************************
+*
+* This function looks up the line holding an address.
+*
+* \param lineAddress
+* Line aligned address.
+*
+* \return
+* Index of the line, SMIF_CACHE_MISS if the address is not cached.
+*******************************************************************************/
+static uint32_t FindLine(uint32_t lineAddress)
+{
+    uint32_t line;
+    
+    for(line = 0u; line < SMIF_CACHE_LINES; line++)
+    {
+        if(cacheValid[line] && (cacheTag[line] == lineAddress))
+        {
+            break;
+        }
+    }
+    return line;
+}
+
+/*******************************************************************************
+* Function Name: FillLine
+********************************************************************************
+*
+* This function reads a line from the memory into the least recently used 
+* cache line.
+*
+* \param lineAddress
+* Line aligned address.
+*
+* \return
+* Index of the filled line.
+*******************************************************************************/
+static uint32_t FillLine(uint32_t lineAddress)
+{
+    uint32_t victim = 0u;
+    uint32_t line;
+    
+    for(line = 0u; line < SMIF_CACHE_LINES; line++)
+    {
+        if(!cacheValid[line])
+        {
+            victim = line;
+            break;
+        }
+        if(cacheAge[line] < cacheAge[victim])
+        {
+            victim = line;
+        }
+    }
+    
+    cacheValid[victim] = false;
+    ReadMemory(&cacheData[victim][0], SMIF_CACHE_LINE_SIZE, lineAddress);
+    cacheTag[victim] = lineAddress;
+    cacheValid[victim] = true;
+    cacheAge[victim] = ++accessClock;
+    
+    return victim;
+}
+
+/*******************************************************************************
+* Function Name: ReadMemoryCached
+********************************************************************************
+*
+* This function reads data from the external memory through the RAM cache. 
+* Reads larger than the whole cache go directly to the memory so they do not 
+* flush the cache.
+*
+* \param rxBuffer
+* Holds the address of where the data will be stored.
+*
+* \param rxSize
+* The size of the data.
+*
+* \param Address 
+* The address from where data will be read.
+*
+* \return
+* None
+*******************************************************************************/
+void ReadMemoryCached(uint8_t rxBuffer[], uint32_t rxSize, uint32_t Address)
+{
+    uint32_t lineAddress;
+    uint32_t lineOffset;
+    uint32_t chunk;
+    uint32_t line;
+    
+    if(rxSize > (SMIF_CACHE_LINES * SMIF_CACHE_LINE_SIZE))
+    {
+        cacheStats.bypasses++;
+        ReadMemory(rxBuffer, rxSize, Address);
+        return;
+    }
+    
+    while(rxSize > 0u)
+    {
+        lineOffset = Address & (SMIF_CACHE_LINE_SIZE - 1u);
+        lineAddress = Address - lineOffset;
+        
+        line = FindLine(lineAddress);
+        if(line == SMIF_CACHE_MISS)
+        {
+            cacheStats.misses++;
+            line = FillLine(lineAddress);
+            
+        #if (SMIF_CACHE_READ_AHEAD != 0u) && (SMIF_CACHE_LINES > 1u)
+            /* The reader streams through the memory, fetch the next line too */
+            if((lineAddress == (lastLine + SMIF_CACHE_LINE_SIZE)) 
+                && ((lineAddress + SMIF_CACHE_LINE_SIZE) < smifMemConfigs[0]->deviceCfg->memSize)
+                && (FindLine(lineAddress + SMIF_CACHE_LINE_SIZE) == SMIF_CACHE_MISS))
+            {
+                cacheStats.readAheads++;
+                (void)FillLine(lineAddress + SMIF_CACHE_LINE_SIZE);
+                
+                /* The requested line stays the most recently used one */
+                cacheAge[line] = ++accessClock;
+            }
+        #endif /* (SMIF_CACHE_READ_AHEAD != 0u) && (SMIF_CACHE_LINES > 1u) */
+        }
+        else
+        {
+            cacheStats.hits++;
+            cacheAge[line] = ++accessClock;
+        }
+        lastLine = lineAddress;
+        
+        chunk = SMIF_CACHE_LINE_SIZE - lineOffset;
+        if(chunk > rxSize)
+        {
+            chunk = rxSize;
+        }
+        (void)memcpy(rxBuffer, &cacheData[line][lineOffset], chunk);
+        
+        rxBuffer += chunk;
+        rxSize -= chunk;
+        Address += chunk;
+    }
+}
+
+/*******************************************************************************
+* Function Name: InvalidateReadCache
+********************************************************************************
+*
+* This function drops all lines overlapping an address range. Must be called 
+* before the range is programmed or erased.
+*
+* \param Address
+* Start of the range.
+*
+* \param size
+* Size of the range in bytes.
+*
+* \return
+* None
+*******************************************************************************/
+void InvalidateReadCache(uint32_t Address, uint32_t size)
+{
+    uint32_t line;
+    
+    for(line = 0u; line < SMIF_CACHE_LINES; line++)
+    {
+        if(cacheValid[line] 
+            && ((cacheTag[line] + SMIF_CACHE_LINE_SIZE) > Address)
+            && (cacheTag[line] < (Address + size)))
+        {
+            cacheValid[line] = false;
+            cacheStats.invalidations++;
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: InvalidateReadCacheAll
+********************************************************************************
+*
+* This function drops all lines, e.g. after a chip erase.
+*
+* \param
+*  None
+*
+* \return
+* None
+*******************************************************************************/
+void InvalidateReadCacheAll(void)
+{
+    uint32_t line;
+    
+    for(line = 0u; line < SMIF_CACHE_LINES; line++)
+    {
+        if(cacheValid[line])
+        {
+            cacheValid[line] = false;
+            cacheStats.invalidations++;
+        }
+    }
+    lastLine = SMIF_CACHE_NO_LINE;
+}
+
+/*******************************************************************************
+* Function Name: GetReadCacheStats
+********************************************************************************
+*
+* This function copies the cache statistics.
+*
+* \param stats
+* Pointer to where the statistics are written.
+*
+* \return
+* None
+*******************************************************************************/
+void GetReadCacheStats(smif_cache_stats_t *stats)
+{
+    *stats = cacheStats;
+}
+
+/*******************************************************************************
+* Function Name: ResetReadCacheStats
+********************************************************************************
+*
+* This function clears the cache statistics.
+*
+* \param
+*  None
+*
+* \return
+* None
+*******************************************************************************/
+void ResetReadCacheStats(void)
+{
+    (void)memset(&cacheStats, 0, sizeof(cacheStats));
+}
+
+#endif /* (SMIF_CACHE_ENABLED != 0u) */
+
+/* [] END OF FILE */
@@ -0,0 +1,118 @@
+/******************************************************************************
+* File Name: smif_cache.h
+*
+* Version: 1.0
+*
+* Description: This header file contains the defines for the RAM read cache
+*              in front of the normal mode SMIF read path.
+*
+* Related Document: CE220959.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef __SMIF_CACHE_H
+#define __SMIF_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*            Conditional Compilation Parameters
+*******************************************************************************/
+/* Set to non-zero to serve ReadMemoryCached() from a RAM cache. Pays off
+*  only for repeated small reads such as the key-value store lookups and the
+*  rows Cy_Bootload_ReadData() reads again to verify them, a single pass over
+*  the memory only adds copies.
+*/
+#ifndef SMIF_CACHE_ENABLED
+#define SMIF_CACHE_ENABLED          (1u)
+#endif /* SMIF_CACHE_ENABLED */
+
+/* Size of a cache line in bytes, must be a power of two */
+#define SMIF_CACHE_LINE_SIZE        (512u)
+
+/* Number of cache lines */
+#define SMIF_CACHE_LINES            (4u)
+
+/* Set to non-zero to fetch the next line when a sequential read misses */
+#ifndef SMIF_CACHE_READ_AHEAD
+#define SMIF_CACHE_READ_AHEAD       (0u)
+#endif /* SMIF_CACHE_READ_AHEAD */
+
+/*******************************************************************************
+*            Constants
+*******************************************************************************/
+/* Cache statistics */
+typedef struct
+{
+    uint32_t hits;                          /* Lines served from RAM               */
+    uint32_t misses;                        /* Lines read from the memory          */
+    uint32_t readAheads;                    /* Lines fetched ahead of the reader   */
+    uint32_t bypasses;                      /* Reads larger than the cache         */
+    uint32_t invalidations;                 /* Lines dropped on a write or erase   */
+} smif_cache_stats_t;
+
+/*******************************************************************************
+*            Function Prototypes
+*******************************************************************************/
+#if (SMIF_CACHE_ENABLED != 0u)
+
+void ReadMemoryCached(
+                    uint8_t rxBuffer[],
+                    uint32_t rxSize,
+                    uint32_t address);      /* Read data through the RAM cache */
+
+void InvalidateReadCache(
+                    uint32_t address,
+                    uint32_t size);         /* Drop lines overlapping a range */
+
+void InvalidateReadCacheAll(void);          /* Drop all lines */
+
+void GetReadCacheStats(smif_cache_stats_t *stats); /* Copy the statistics */
+
+void ResetReadCacheStats(void);             /* Clear the statistics */
+
+#else
+
+#define ReadMemoryCached(rxBuffer, rxSize, address) ReadMemory((rxBuffer), (rxSize), (address))
+#define InvalidateReadCache(address, size)
+#define InvalidateReadCacheAll()
+#define GetReadCacheStats(stats)
+#define ResetReadCacheStats()
+
+#endif /* (SMIF_CACHE_ENABLED != 0u) */
+
+#endif /*__SMIF_CACHE_H*/
+    
+/* [] END OF FILE */
@@ -0,0 +1,296 @@
+/******************************************************************************
+* File Name: smif_dma.c
+*
+* Version: 1.0
+*
+* Description: Functions in this file copy data from the XIP region of the
+*              external memory into SRAM with a DataWire channel. The copy is
+*              split into chunks and the CPU is handed each chunk while the
+*              DMA reads the next one through the SMIF cache.
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_dma.h"
+#include "smif_mem.h"
+#include "project.h"
+#include <string.h>
+
+/* Elements of one X loop of a DataWire descriptor */
+#define DMA_X_COUNT_MAX             (256u)
+
+/* Descriptor of the chunk in progress */
+static cy_stc_dma_descriptor_t dmaDescriptor;
+
+static cy_stc_dma_descriptor_config_t dmaDescriptorConfig =
+{
+    .retrigger       = CY_DMA_RETRIG_IM,
+    .interruptType   = CY_DMA_DESCR,
+    .triggerOutType  = CY_DMA_DESCR,
+    .channelState    = CY_DMA_CHANNEL_DISABLED,
+    .triggerInType   = CY_DMA_DESCR,
+    .dataSize        = CY_DMA_WORD,
+    .srcTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+    .dstTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+    .descriptorType  = CY_DMA_1D_TRANSFER,
+    .srcAddress      = NULL,
+    .dstAddress      = NULL,
+    .srcXincrement   = 1,
+    .dstXincrement   = 1,
+    .xCount          = 1u,
+    .srcYincrement   = 0,
+    .dstYincrement   = 0,
+    .yCount          = 1u,
+    .nextDescriptor  = NULL
+};
+
+static bool dmaInitialized = false;
+
+/* Local functions */
+static uint32_t StartChunk(uint8_t dst[], const uint8_t src[], uint32_t size, uint32_t elementSize);
+
+/*******************************************************************************
+* Function Name: StartChunk
+********************************************************************************
+*
+* Starts the DMA copy of one chunk. Chunks over one X loop are rounded down to
+* whole X loops and copied by a 2D descriptor.
+*
+* \return
+* The number of bytes the DMA copies.
+*******************************************************************************/
+static uint32_t StartChunk(uint8_t dst[], const uint8_t src[], uint32_t size, uint32_t elementSize)
+{
+    uint32_t elements = size / elementSize;
+    
+    if(elements > (SMIF_DMA_CHUNK_SIZE / elementSize))
+    {
+        elements = SMIF_DMA_CHUNK_SIZE / elementSize;
+    }
+    
+    dmaDescriptorConfig.dataSize = (elementSize == 4u) ? CY_DMA_WORD : CY_DMA_BYTE;
+    dmaDescriptorConfig.srcAddress = (void *)src;
+    dmaDescriptorConfig.dstAddress = (void *)dst;
+    
+    if(elements > DMA_X_COUNT_MAX)
+    {
+        elements -= elements % DMA_X_COUNT_MAX;
+        dmaDescriptorConfig.descriptorType = CY_DMA_2D_TRANSFER;
+        dmaDescriptorConfig.xCount = DMA_X_COUNT_MAX;
+        dmaDescriptorConfig.srcYincrement = (int32_t)DMA_X_COUNT_MAX;
+        dmaDescriptorConfig.dstYincrement = (int32_t)DMA_X_COUNT_MAX;
+        dmaDescriptorConfig.yCount = elements / DMA_X_COUNT_MAX;
+    }
+    else
+    {
+        dmaDescriptorConfig.descriptorType = CY_DMA_1D_TRANSFER;
+        dmaDescriptorConfig.xCount = elements;
+        dmaDescriptorConfig.yCount = 1u;
+    }
+    
+    (void)Cy_DMA_Descriptor_Init(&dmaDescriptor, &dmaDescriptorConfig);
+    Cy_DMA_Channel_SetDescriptor(SMIF_DMA_HW, SMIF_DMA_CHANNEL, &dmaDescriptor);
+    Cy_DMA_Channel_Enable(SMIF_DMA_HW, SMIF_DMA_CHANNEL);
+    
+    /* Memory to memory, the trigger is given by software */
+    (void)Cy_TrigMux_SwTrigger((uint32_t)TRIG0_OUT_CPUSS_DW0_TR_IN0 + SMIF_DMA_CHANNEL, CY_TRIGGER_TWO_CYCLES);
+    
+    return (elements * elementSize);
+}
+
+/*******************************************************************************
+* Function Name: ReadXIPDma
+********************************************************************************
+*
+* This function copies data from the XIP region into SRAM with a DataWire 
+* channel. The SMIF must be in the memory mode. SwitchSMIFMemory() invalidates
+* the SMIF cache, so data written in the normal mode is read from the memory.
+* Word transfers are used if the buffer, address and size are word aligned, 
+* byte transfers otherwise.
+*
+* If a callback is given, it is called with each chunk as soon as it is in 
+* SRAM, while the DMA already copies the next chunk. The callback must not 
+* change the part of the buffer after the chunk.
+*
+* \param rxBuffer
+* Holds the address of where the data will be stored.
+*
+* \param rxSize
+* The size of the data.
+*
+* \param address
+* The address in the external memory from where data will be read.
+*
+* \param callback
+* Function called with every chunk. May be NULL.
+*
+* \param arg
+* Passed to the callback.
+*
+* \return
+* false if the SMIF is not in the memory mode or the DMA reported an error.
+*******************************************************************************/
+bool ReadXIPDma(uint8_t rxBuffer[], uint32_t rxSize, uint32_t address, smif_dma_chunk_cb_t callback, void *arg)
+{
+    cy_stc_dma_channel_config_t channelConfig;
+    SMIF_Type *base;
+    cy_stc_smif_context_t *context;
+    const uint8_t *src = (const uint8_t *)(CY_XIP_BASE + address);
+    uint32_t elementSize;
+    uint32_t offset = 0u;
+    uint32_t chunk = 0u;
+    uint32_t next = 0u;
+    uint32_t nextChunk = 0u;
+    
+    GetSMIFPointers(&base, &context);
+    if(Cy_SMIF_GetMode(base) != CY_SMIF_MEMORY)
+    {
+        return false;
+    }
+    
+    if(!dmaInitialized)
+    {
+        channelConfig.descriptor  = &dmaDescriptor;
+        channelConfig.preemptable = true;
+        channelConfig.priority    = SMIF_DMA_PRIORITY;
+        channelConfig.enable      = false;
+        (void)Cy_DMA_Descriptor_Init(&dmaDescriptor, &dmaDescriptorConfig);
+        (void)Cy_DMA_Channel_Init(SMIF_DMA_HW, SMIF_DMA_CHANNEL, &channelConfig);
+        Cy_DMA_Enable(SMIF_DMA_HW);
+        dmaInitialized = true;
+    }
+    
+    elementSize = ((((uint32_t)rxBuffer | address | rxSize) & 0x03u) == 0u) ? 4u : 1u;
+    
+    if(rxSize != 0u)
+    {
+        chunk = StartChunk(rxBuffer, src, rxSize, elementSize);
+    }
+    
+    while(offset < rxSize)
+    {
+        /* Wait for the chunk in progress */
+        while(Cy_DMA_Channel_GetInterruptStatus(SMIF_DMA_HW, SMIF_DMA_CHANNEL) == 0u)
+        {
+        }
+        Cy_DMA_Channel_ClearInterrupt(SMIF_DMA_HW, SMIF_DMA_CHANNEL);
+        if(Cy_DMA_Channel_GetStatus(SMIF_DMA_HW, SMIF_DMA_CHANNEL) != CY_DMA_INTR_CAUSE_COMPLETION)
+        {
+            return false;
+        }
+        
+        /* Start the next chunk before the CPU works on this one */
+        next = offset + chunk;
+        if(next < rxSize)
+        {
+            nextChunk = StartChunk(&rxBuffer[next], &src[next], rxSize - next, elementSize);
+        }
+        
+        if(callback != NULL)
+        {
+            callback(&rxBuffer[offset], chunk, arg);
+        }
+        
+        offset = next;
+        chunk = nextChunk;
+    }
+    
+    return true;
+}
+
+#if (SMIF_DMA_BENCHMARK != 0u)
+/*******************************************************************************
+* Function Name: BenchmarkXIPRead
+********************************************************************************
+*
+* This function reads the same data by CPU memcpy from the XIP region, by
+* ReadMemory() in the normal mode and by ReadXIPDma(), and reports the 
+* throughput of each. The SMIF cache is invalidated before each XIP read, so
+* all data comes from the memory. The SMIF is left in the memory mode.
+*
+* \param buffer
+* SRAM buffer of size bytes.
+*
+* \param size
+* The size of the data.
+*
+* \param address
+* The address in the external memory from where data will be read.
+*
+* \param result
+* Throughput in KB/s.
+*
+* \return
+* None
+*******************************************************************************/
+void BenchmarkXIPRead(uint8_t buffer[], uint32_t size, uint32_t address, smif_dma_bench_t *result)
+{
+    SMIF_Type *base;
+    cy_stc_smif_context_t *context;
+    uint32_t startCycles;
+    uint32_t cycles[3u];
+    uint32_t i;
+    
+    GetSMIFPointers(&base, &context);
+    
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    SwitchSMIFMemory();
+    startCycles = DWT->CYCCNT;
+    (void)memcpy(buffer, (const void *)(CY_XIP_BASE + address), size);
+    cycles[0u] = DWT->CYCCNT - startCycles;
+    
+    SwitchSMIFNormal();
+    startCycles = DWT->CYCCNT;
+    ReadMemory(buffer, size, address);
+    cycles[1u] = DWT->CYCCNT - startCycles;
+    
+    SwitchSMIFMemory();
+    startCycles = DWT->CYCCNT;
+    (void)ReadXIPDma(buffer, size, address, NULL, NULL);
+    cycles[2u] = DWT->CYCCNT - startCycles;
+    
+    for(i = 0u; i < 3u; i++)
+    {
+        /* KB/s = bytes * (cycles / s) / cycles / 1024 */
+        cycles[i] = (cycles[i] == 0u) ? 0u : 
+                    (uint32_t)(((uint64_t)size * SystemCoreClock) / ((uint64_t)cycles[i] * 1024u));
+    }
+    result->memcpyXip = cycles[0u];
+    result->readMemory = cycles[1u];
+    result->dmaXip = cycles[2u];
+}
+#endif /* (SMIF_DMA_BENCHMARK != 0u) */
+
+/* [] END OF FILE */
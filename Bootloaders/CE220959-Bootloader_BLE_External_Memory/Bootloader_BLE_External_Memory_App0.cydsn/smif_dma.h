@@ -0,0 +1,97 @@
+/******************************************************************************
+* File Name: smif_dma.h
+*
+* Version: 1.0
+*
+* Description: This header file contains the defines for the DMA copy from the
+*              XIP region of the external memory into SRAM.
+*
+* Related Document: CE220959.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef __SMIF_DMA_H
+#define __SMIF_DMA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*            Conditional Compilation Parameters
+*******************************************************************************/
+/* Set to non-zero to build BenchmarkXIPRead() */
+#define SMIF_DMA_BENCHMARK          (0u)
+
+/*******************************************************************************
+*            Constants
+*******************************************************************************/
+#define SMIF_DMA_HW                 (DW0)       /* DataWire block used for the copy */
+#define SMIF_DMA_CHANNEL            (15u)       /* Channel of the block, must not be used elsewhere */
+#define SMIF_DMA_PRIORITY           (3u)        /* Lowest channel priority */
+#define SMIF_DMA_CHUNK_SIZE         (4096u)     /* Bytes moved by the DMA per chunk */
+
+/* Called with every chunk copied into SRAM while the DMA moves the next one */
+typedef void (*smif_dma_chunk_cb_t)(uint8_t chunk[], uint32_t size, void *arg);
+
+#if (SMIF_DMA_BENCHMARK != 0u)
+/* Throughput of the three ways to read the external memory in KB/s */
+typedef struct
+{
+    uint32_t memcpyXip;                     /* CPU memcpy from the XIP region  */
+    uint32_t readMemory;                    /* ReadMemory() in the normal mode */
+    uint32_t dmaXip;                        /* ReadXIPDma() from the XIP region */
+} smif_dma_bench_t;
+#endif /* (SMIF_DMA_BENCHMARK != 0u) */
+
+/*******************************************************************************
+*            Function Prototypes
+*******************************************************************************/
+bool ReadXIPDma(
+                    uint8_t rxBuffer[],
+                    uint32_t rxSize,
+                    uint32_t address,
+                    smif_dma_chunk_cb_t callback,
+                    void *arg);             /* Copy from the XIP region by DMA */
+
+#if (SMIF_DMA_BENCHMARK != 0u)
+void BenchmarkXIPRead(
+                    uint8_t buffer[],
+                    uint32_t size,
+                    uint32_t address,
+                    smif_dma_bench_t *result); /* Compare memcpy, ReadMemory and DMA */
+#endif /* (SMIF_DMA_BENCHMARK != 0u) */
+
+#endif /*__SMIF_DMA_H*/
+    
+/* [] END OF FILE */
@@ -0,0 +1,1126 @@
+/******************************************************************************
+* File Name: smif_kv.c
+*
+* Version: 1.0
+*
+* Description: Functions in this file implement a log structured key-value
+*              store on the external memory. Records are only appended, so a
+*              value is never updated in place. Appends are collected in a RAM
+*              page buffer and programmed a page at a time, or on
+*              SyncKVStore(). The sectors of the region form a circular log:
+*              the collector moves the live records out of the oldest sector
+*              and erases it, and new sectors are taken in order of the
+*              lowest erase count. A RAM hash index maps every key to its
+*              latest record and is rebuilt by MountKVStore(). Every erase
+*              is followed by an erase stamp at the start of the sector, so
+*              the erase counts survive a reset.
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products
+* where a malfunction or failure may reasonably be expected to result in
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_kv.h"
+#include "smif_mem.h"
+#include "smif_cache.h"
+#include "project.h"
+#include <string.h>
+
+/* Sector header markers */
+#define SMIF_KV_MAGIC               (0x3153564Bu)   /* "KVS1" */
+#define SMIF_KV_ERASED_MAGIC        (0x3145564Bu)   /* "KVE1" */
+
+/* Record header values */
+#define SMIF_KV_ERASED_KEY          (0xFFFFu)       /* End of the log in a sector */
+#define SMIF_KV_DELETED             (0xFFFEu)       /* Length of a deletion marker */
+
+/* Record size including the header, values are padded to 4 bytes */
+#define SMIF_KV_RECORD_SIZE(length) (sizeof(smif_kv_record_t) + (((uint32_t)(length) + 3u) & ~3u))
+
+/* Index slot is not used */
+#define SMIF_KV_EMPTY_SLOT          (0xFFFFu)
+
+/* Sector states */
+typedef enum
+{
+    SMIF_KV_SECTOR_FREE = 0u,               /* Not in the log, not known to be erased */
+    SMIF_KV_SECTOR_ERASING,                 /* Not in the log, erase started          */
+    SMIF_KV_SECTOR_ERASED,                  /* Not in the log, erased and stamped     */
+    SMIF_KV_SECTOR_USED                     /* Holds a part of the log                */
+} smif_kv_sector_state_t;
+
+/* Sector header. The erase stamp at the start of a sector is programmed
+*  after every erase, the log header behind it when the sector joins the log.
+*/
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;                      /* Age of the sector in the log */
+    uint32_t eraseCount;
+    uint32_t check;                         /* Inverted XOR of the fields above */
+} smif_kv_sector_t;
+
+/* Offsets of the erase stamp, the log header and the first record */
+#define SMIF_KV_STAMP_OFFSET        (0u)
+#define SMIF_KV_HEADER_OFFSET       (sizeof(smif_kv_sector_t))
+#define SMIF_KV_DATA_OFFSET         (2u * sizeof(smif_kv_sector_t))
+
+/* Header of every record */
+typedef struct
+{
+    uint16_t key;
+    uint16_t length;                        /* Value size or SMIF_KV_DELETED */
+    uint16_t crc;                           /* CRC-16 of key, length and value */
+    uint16_t reserved;
+} smif_kv_record_t;
+
+/* Sector bookkeeping */
+static smif_kv_sector_state_t sectorState[SMIF_KV_SECTOR_COUNT];
+static uint32_t sectorSequence[SMIF_KV_SECTOR_COUNT];
+static uint32_t sectorEraseCount[SMIF_KV_SECTOR_COUNT];
+static uint32_t nextSequence;
+
+/* Head of the log */
+static uint32_t headSector;
+static uint32_t writeAddress;
+
+/* Page buffer, holds the page at bufferBase */
+CY_ALIGN(4) static uint8_t pageBuffer[SMIF_KV_PAGE_SIZE];
+static uint32_t bufferBase;
+static uint32_t bufferFill;                 /* Bytes appended to the page */
+static uint32_t bufferFlushed;              /* Bytes already programmed   */
+
+/* Hash index */
+static uint16_t indexKey[SMIF_KV_INDEX_SIZE];
+static uint32_t indexAddress[SMIF_KV_INDEX_SIZE];
+static uint32_t indexCount;
+
+/* Garbage collection */
+static bool gcActive = false;
+static uint32_t gcVictim;
+static uint32_t gcSlot;
+
+/* Value buffer used by mount and the collector */
+CY_ALIGN(4) static uint8_t valueBuffer[SMIF_KV_MAX_VALUE_SIZE];
+
+static smif_kv_stats_t kvStats;
+
+/* Local functions */
+static uint16_t Crc16(uint16_t crc, const uint8_t data[], uint32_t size);
+static uint16_t RecordCrc(const smif_kv_record_t *record, const uint8_t value[]);
+static uint32_t HashKey(uint16_t key);
+static uint32_t IndexFind(uint16_t key);
+static bool IndexUpdate(uint16_t key, uint32_t address);
+static void IndexRemove(uint32_t slot);
+static uint32_t SectorAddress(uint32_t sector);
+static uint32_t SectorOf(uint32_t address);
+static uint32_t FreeSectorCount(void);
+static void MakeHeader(smif_kv_sector_t *header, uint32_t magic, uint32_t sequence, uint32_t eraseCount);
+static bool ReadHeader(smif_kv_sector_t *header, uint32_t magic, uint32_t address);
+static void StampSector(uint32_t sector);
+static void ReadLog(uint8_t data[], uint32_t size, uint32_t address);
+static void AppendLog(const uint8_t data[], uint32_t size);
+static bool OpenSector(bool useReserve);
+static smif_kv_status_t AppendRecord(uint16_t key, const uint8_t value[], uint16_t length, bool useReserve, uint32_t *address);
+static smif_kv_status_t AppendUserRecord(uint16_t key, const uint8_t value[], uint16_t length);
+static bool IsErased(uint32_t address, uint32_t end);
+static void ScanSector(uint32_t sector);
+static bool StepGC(uint32_t records);
+
+/*******************************************************************************
+* Function Name: Crc16
+********************************************************************************
+*
+* This function calculates the CRC-16/CCITT of a buffer.
+*
+*******************************************************************************/
+static uint16_t Crc16(uint16_t crc, const uint8_t data[], uint32_t size)
+{
+    uint32_t i;
+    uint32_t bit;
+
+    for(i = 0u; i < size; i++)
+    {
+        crc ^= (uint16_t)((uint16_t)data[i] << 8u);
+        for(bit = 0u; bit < 8u; bit++)
+        {
+            crc = ((crc & 0x8000u) != 0u) ? (uint16_t)((crc << 1u) ^ 0x1021u) : (uint16_t)(crc << 1u);
+        }
+    }
+    return crc;
+}
+
+/*******************************************************************************
+* Function Name: RecordCrc
+********************************************************************************
+*
+* This function calculates the CRC of a record.
+*
+*******************************************************************************/
+static uint16_t RecordCrc(const smif_kv_record_t *record, const uint8_t value[])
+{
+    uint16_t crc = Crc16(0xFFFFu, (const uint8_t *)record, 4u);
+
+    if(record->length != SMIF_KV_DELETED)
+    {
+        crc = Crc16(crc, value, record->length);
+    }
+    return crc;
+}
+
+/*******************************************************************************
+* Function Name: HashKey
+********************************************************************************
+*
+* This function returns the first index slot to probe for a key.
+*
+*******************************************************************************/
+static uint32_t HashKey(uint16_t key)
+{
+    return (((uint32_t)key * 0x9E3779B1u) >> 16u) & (SMIF_KV_INDEX_SIZE - 1u);
+}
+
+/*******************************************************************************
+* Function Name: IndexFind
+********************************************************************************
+*
+* This function looks up a key in the index.
+*
+* \return
+* Slot of the key, SMIF_KV_INDEX_SIZE if the key is not in the index.
+*******************************************************************************/
+static uint32_t IndexFind(uint16_t key)
+{
+    uint32_t slot = HashKey(key);
+    uint32_t probes;
+
+    for(probes = 0u; probes < SMIF_KV_INDEX_SIZE; probes++)
+    {
+        if(indexKey[slot] == key)
+        {
+            return slot;
+        }
+        if(indexKey[slot] == SMIF_KV_EMPTY_SLOT)
+        {
+            break;
+        }
+        slot = (slot + 1u) & (SMIF_KV_INDEX_SIZE - 1u);
+    }
+    return SMIF_KV_INDEX_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: IndexUpdate
+********************************************************************************
+*
+* This function points a key to a record, adding the key if needed.
+*
+* \return
+* false if the key is new and the index is full.
+*******************************************************************************/
+static bool IndexUpdate(uint16_t key, uint32_t address)
+{
+    uint32_t slot = HashKey(key);
+
+    while((indexKey[slot] != key) && (indexKey[slot] != SMIF_KV_EMPTY_SLOT))
+    {
+        slot = (slot + 1u) & (SMIF_KV_INDEX_SIZE - 1u);
+    }
+
+    if(indexKey[slot] == SMIF_KV_EMPTY_SLOT)
+    {
+        if(indexCount >= ((SMIF_KV_INDEX_SIZE * 3u) / 4u))
+        {
+            return false;
+        }
+        indexKey[slot] = key;
+        indexCount++;
+    }
+    indexAddress[slot] = address;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: IndexRemove
+********************************************************************************
+*
+* This function removes a key from the index. The following keys of the probe
+* chain are moved back, so no deletion markers are needed in the index.
+*
+*******************************************************************************/
+static void IndexRemove(uint32_t slot)
+{
+    uint32_t next = slot;
+    uint32_t home;
+
+    for(;;)
+    {
+        next = (next + 1u) & (SMIF_KV_INDEX_SIZE - 1u);
+        if(indexKey[next] == SMIF_KV_EMPTY_SLOT)
+        {
+            break;
+        }
+
+        /* Move the key back if the free slot lies between its home and it */
+        home = HashKey(indexKey[next]);
+        if(((next - home) & (SMIF_KV_INDEX_SIZE - 1u)) >= ((next - slot) & (SMIF_KV_INDEX_SIZE - 1u)))
+        {
+            indexKey[slot] = indexKey[next];
+            indexAddress[slot] = indexAddress[next];
+            slot = next;
+        }
+    }
+    indexKey[slot] = SMIF_KV_EMPTY_SLOT;
+    indexCount--;
+}
+
+/*******************************************************************************
+* Function Name: SectorAddress
+********************************************************************************
+*
+* This function returns the start address of a sector of the store.
+*
+*******************************************************************************/
+static uint32_t SectorAddress(uint32_t sector)
+{
+    return SMIF_KV_START_ADDRESS + (sector * SMIF_KV_SECTOR_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: SectorOf
+********************************************************************************
+*
+* This function returns the sector of the store holding an address.
+*
+*******************************************************************************/
+static uint32_t SectorOf(uint32_t address)
+{
+    return (address - SMIF_KV_START_ADDRESS) / SMIF_KV_SECTOR_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: FreeSectorCount
+********************************************************************************
+*
+* This function returns the number of sectors not holding the log.
+*
+*******************************************************************************/
+static uint32_t FreeSectorCount(void)
+{
+    uint32_t sector;
+    uint32_t count = 0u;
+
+    for(sector = 0u; sector < SMIF_KV_SECTOR_COUNT; sector++)
+    {
+        if(sectorState[sector] != SMIF_KV_SECTOR_USED)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+/*******************************************************************************
+* Function Name: MakeHeader
+********************************************************************************
+*
+* This function fills a sector header and its check word.
+*
+*******************************************************************************/
+static void MakeHeader(smif_kv_sector_t *header, uint32_t magic, uint32_t sequence, uint32_t eraseCount)
+{
+    header->magic = magic;
+    header->sequence = sequence;
+    header->eraseCount = eraseCount;
+    header->check = ~(header->magic ^ header->sequence ^ header->eraseCount);
+}
+
+/*******************************************************************************
+* Function Name: ReadHeader
+********************************************************************************
+*
+* This function reads a sector header and checks its marker and check word.
+*
+*******************************************************************************/
+static bool ReadHeader(smif_kv_sector_t *header, uint32_t magic, uint32_t address)
+{
+    ReadMemoryCached((uint8_t *)header, sizeof(*header), address);
+    return (header->magic == magic)
+        && (header->check == ~(header->magic ^ header->sequence ^ header->eraseCount));
+}
+
+/*******************************************************************************
+* Function Name: StampSector
+********************************************************************************
+*
+* This function programs the erase stamp of an erased sector. It waits for a
+* started erase of the sector to end.
+*
+*******************************************************************************/
+static void StampSector(uint32_t sector)
+{
+    smif_kv_sector_t stamp;
+
+    MakeHeader(&stamp, SMIF_KV_ERASED_MAGIC, 0u, sectorEraseCount[sector]);
+    WriteMemory((uint8_t *)&stamp, sizeof(stamp), SectorAddress(sector) + SMIF_KV_STAMP_OFFSET);
+    sectorState[sector] = SMIF_KV_SECTOR_ERASED;
+}
+
+/*******************************************************************************
+* Function Name: ReadLog
+********************************************************************************
+*
+* This function reads from the log. The bytes of the buffered page are taken
+* from RAM, as they may not be programmed yet. The SMIF cannot transfer zero
+* bytes, so empty reads return at once.
+*
+*******************************************************************************/
+static void ReadLog(uint8_t data[], uint32_t size, uint32_t address)
+{
+    uint32_t chunk;
+
+    if(size == 0u)
+    {
+        return;
+    }
+
+    /* Part before the buffered page */
+    if(address < bufferBase)
+    {
+        chunk = bufferBase - address;
+        if(chunk > size)
+        {
+            chunk = size;
+        }
+        ReadMemoryCached(data, chunk, address);
+        data += chunk;
+        address += chunk;
+        size -= chunk;
+    }
+
+    /* Part inside the buffered page */
+    if(size > 0u)
+    {
+        (void)memcpy(data, &pageBuffer[address - bufferBase], size);
+    }
+}
+
+/*******************************************************************************
+* Function Name: AppendLog
+********************************************************************************
+*
+* This function appends bytes to the page buffer. A page is programmed when it
+* is full.
+*
+*******************************************************************************/
+static void AppendLog(const uint8_t data[], uint32_t size)
+{
+    uint32_t chunk;
+
+    while(size > 0u)
+    {
+        chunk = SMIF_KV_PAGE_SIZE - bufferFill;
+        if(chunk > size)
+        {
+            chunk = size;
+        }
+        (void)memcpy(&pageBuffer[bufferFill], data, chunk);
+        bufferFill += chunk;
+        writeAddress += chunk;
+        data += chunk;
+        size -= chunk;
+
+        if(bufferFill == SMIF_KV_PAGE_SIZE)
+        {
+            /* Moves the buffer to the next page */
+            SyncKVStore();
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: OpenSector
+********************************************************************************
+*
+* This function moves the head of the log to the free sector with the lowest
+* erase count. The last free sector is kept for the collector.
+*
+* \param useReserve
+* true to allow taking the last free sector.
+*
+* \return
+* false if no sector is available.
+*******************************************************************************/
+static bool OpenSector(bool useReserve)
+{
+    smif_kv_sector_t header;
+    uint32_t sector;
+    uint32_t best = SMIF_KV_SECTOR_COUNT;
+
+    if((FreeSectorCount() < 2u) && (!useReserve))
+    {
+        return false;
+    }
+
+    for(sector = 0u; sector < SMIF_KV_SECTOR_COUNT; sector++)
+    {
+        if((sectorState[sector] != SMIF_KV_SECTOR_USED)
+            && ((best == SMIF_KV_SECTOR_COUNT) || (sectorEraseCount[sector] < sectorEraseCount[best])))
+        {
+            best = sector;
+        }
+    }
+    if(best == SMIF_KV_SECTOR_COUNT)
+    {
+        return false;
+    }
+
+    /* Records of the previous head must be programmed first */
+    SyncKVStore();
+
+    if(sectorState[best] == SMIF_KV_SECTOR_FREE)
+    {
+        EraseSMIFSector(SectorAddress(best));
+        sectorEraseCount[best]++;
+        sectorState[best] = SMIF_KV_SECTOR_ERASING;
+    }
+    if(sectorState[best] == SMIF_KV_SECTOR_ERASING)
+    {
+        StampSector(best);
+    }
+
+    sectorState[best] = SMIF_KV_SECTOR_USED;
+    sectorSequence[best] = nextSequence++;
+    headSector = best;
+
+    /* The page buffer starts with the stamp, which is already programmed */
+    bufferBase = SectorAddress(best);
+    bufferFill = SMIF_KV_HEADER_OFFSET;
+    bufferFlushed = SMIF_KV_HEADER_OFFSET;
+    writeAddress = bufferBase + SMIF_KV_HEADER_OFFSET;
+    (void)memset(pageBuffer, 0xFF, SMIF_KV_PAGE_SIZE);
+    MakeHeader((smif_kv_sector_t *)&pageBuffer[SMIF_KV_STAMP_OFFSET], SMIF_KV_ERASED_MAGIC, 0u, sectorEraseCount[best]);
+    MakeHeader(&header, SMIF_KV_MAGIC, sectorSequence[best], sectorEraseCount[best]);
+    AppendLog((const uint8_t *)&header, sizeof(header));
+    SyncKVStore();
+
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: AppendRecord
+********************************************************************************
+*
+* This function appends a record to the head of the log. A record never
+* crosses a sector border.
+*
+*******************************************************************************/
+static smif_kv_status_t AppendRecord(uint16_t key, const uint8_t value[], uint16_t length, bool useReserve, uint32_t *address)
+{
+    static const uint8_t padding[3u] = {0xFFu, 0xFFu, 0xFFu};
+    smif_kv_record_t record;
+    uint32_t valueSize = (length == SMIF_KV_DELETED) ? 0u : length;
+    uint32_t recordSize = SMIF_KV_RECORD_SIZE(valueSize);
+
+    if((writeAddress + recordSize) > (SectorAddress(headSector) + SMIF_KV_SECTOR_SIZE))
+    {
+        if(!OpenSector(useReserve))
+        {
+            return SMIF_KV_FULL;
+        }
+    }
+
+    record.key = key;
+    record.length = length;
+    record.reserved = 0xFFFFu;
+    record.crc = RecordCrc(&record, value);
+
+    *address = writeAddress;
+    AppendLog((const uint8_t *)&record, sizeof(record));
+    AppendLog(value, valueSize);
+    AppendLog(padding, recordSize - sizeof(record) - valueSize);
+
+    return SMIF_KV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: AppendUserRecord
+********************************************************************************
+*
+* This function appends a record on behalf of the user and points the index to
+* it. When the log is full, sectors are collected in the foreground until the
+* record fits or nothing more can be reclaimed.
+*
+*******************************************************************************/
+static smif_kv_status_t AppendUserRecord(uint16_t key, const uint8_t value[], uint16_t length)
+{
+    smif_kv_status_t status;
+    uint32_t address;
+    uint32_t attempts;
+    uint32_t gcRuns;
+
+    status = AppendRecord(key, value, length, false, &address);
+    for(attempts = 0u; (status == SMIF_KV_FULL) && (attempts < SMIF_KV_SECTOR_COUNT); attempts++)
+    {
+        gcRuns = kvStats.gcRuns;
+        while(StepGC(SMIF_KV_INDEX_SIZE))
+        {
+        }
+        if(kvStats.gcRuns == gcRuns)
+        {
+            break;
+        }
+        status = AppendRecord(key, value, length, false, &address);
+    }
+
+    if(status == SMIF_KV_SUCCESS)
+    {
+        (void)IndexUpdate(key, address);
+        kvStats.recordsWritten++;
+    }
+    return status;
+}
+
+/*******************************************************************************
+* Function Name: IsErased
+********************************************************************************
+*
+* This function checks that a range of the log is erased. It runs at mount,
+* when the page buffer is not in use yet, so the buffer holds the data read.
+*
+*******************************************************************************/
+static bool IsErased(uint32_t address, uint32_t end)
+{
+    uint32_t chunk;
+    uint32_t i;
+
+    while(address < end)
+    {
+        chunk = end - address;
+        if(chunk > SMIF_KV_PAGE_SIZE)
+        {
+            chunk = SMIF_KV_PAGE_SIZE;
+        }
+        ReadMemory(pageBuffer, chunk, address);
+        for(i = 0u; i < chunk; i++)
+        {
+            if(pageBuffer[i] != 0xFFu)
+            {
+                return false;
+            }
+        }
+        address += chunk;
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: ScanSector
+********************************************************************************
+*
+* This function adds the records of a sector to the index. An erased key at
+* an address inside a program unit is the padding of a sync, the scan goes on
+* at the next unit. An erased key at the start of a unit is the end of the
+* log if the rest of the sector is erased too. The scan stops at the first
+* damaged record, e.g. one torn by a reset during programming, or at bytes
+* programmed behind the end of the log. Nothing more is appended to such a
+* sector, as its remaining units may already be programmed.
+*
+*******************************************************************************/
+static void ScanSector(uint32_t sector)
+{
+    smif_kv_record_t record;
+    uint32_t address = SectorAddress(sector) + SMIF_KV_DATA_OFFSET;
+    uint32_t end = SectorAddress(sector) + SMIF_KV_SECTOR_SIZE;
+    uint32_t valueSize;
+
+    while((address + sizeof(record)) <= end)
+    {
+        ReadMemoryCached((uint8_t *)&record, sizeof(record), address);
+        if(record.key == SMIF_KV_ERASED_KEY)
+        {
+            if((address % SMIF_KV_PROGRAM_UNIT) != 0u)
+            {
+                address += SMIF_KV_PROGRAM_UNIT - (address % SMIF_KV_PROGRAM_UNIT);
+                continue;
+            }
+            if(!IsErased(address, end))
+            {
+                address = end;
+            }
+            break;
+        }
+
+        valueSize = (record.length == SMIF_KV_DELETED) ? 0u : record.length;
+        if((record.key > SMIF_KV_MAX_KEY) || (valueSize > SMIF_KV_MAX_VALUE_SIZE)
+            || ((address + SMIF_KV_RECORD_SIZE(valueSize)) > end))
+        {
+            /* Nothing more can be appended to this sector */
+            address = end;
+            break;
+        }
+
+        if(valueSize != 0u)
+        {
+            ReadMemoryCached(valueBuffer, valueSize, address + sizeof(record));
+        }
+        if(RecordCrc(&record, valueBuffer) != record.crc)
+        {
+            address = end;
+            break;
+        }
+
+        (void)IndexUpdate(record.key, address);
+        address += SMIF_KV_RECORD_SIZE(valueSize);
+    }
+
+    writeAddress = address;
+}
+
+/*******************************************************************************
+* Function Name: MountKVStore
+********************************************************************************
+*
+* This function reads the sector headers, replays the log from the oldest to
+* the newest sector to rebuild the index and loads the head page into the page
+* buffer. An empty region is formatted.
+*
+* \param
+*  None
+*
+* \return
+* SMIF_KV_SUCCESS, or SMIF_KV_FULL if the log holds more keys than the index.
+*******************************************************************************/
+smif_kv_status_t MountKVStore(void)
+{
+    smif_kv_sector_t header;
+    uint32_t sector;
+    uint32_t oldest;
+    uint32_t lastSequence = 0u;
+    bool found = true;
+
+    (void)memset(indexKey, 0xFF, sizeof(indexKey));
+    (void)memset(&kvStats, 0, sizeof(kvStats));
+    indexCount = 0u;
+    gcActive = false;
+    nextSequence = 1u;
+
+    /* Sectors are replayed by the scan, so the buffer is not used yet */
+    bufferBase = 0xFFFFFFFFu;
+    bufferFill = 0u;
+    bufferFlushed = 0u;
+
+    for(sector = 0u; sector < SMIF_KV_SECTOR_COUNT; sector++)
+    {
+        /* The stamp keeps the erase count also while the sector is not in the log */
+        sectorState[sector] = SMIF_KV_SECTOR_FREE;
+        sectorEraseCount[sector] = 0u;
+        if(ReadHeader(&header, SMIF_KV_ERASED_MAGIC, SectorAddress(sector) + SMIF_KV_STAMP_OFFSET))
+        {
+            sectorEraseCount[sector] = header.eraseCount;
+            
+            if(ReadHeader(&header, SMIF_KV_MAGIC, SectorAddress(sector) + SMIF_KV_HEADER_OFFSET))
+            {
+                sectorState[sector] = SMIF_KV_SECTOR_USED;
+                sectorSequence[sector] = header.sequence;
+                if(header.sequence >= nextSequence)
+                {
+                    nextSequence = header.sequence + 1u;
+                }
+            }
+            else if((header.magic & header.sequence & header.eraseCount & header.check) == 0xFFFFFFFFu)
+            {
+                /* Stamped, the log header is still erased */
+                sectorState[sector] = SMIF_KV_SECTOR_ERASED;
+            }
+            else
+            {
+                /* Interrupted while joining the log, erased again before use */
+            }
+        }
+    }
+
+    /* Replay in the order the sectors were written */
+    while(found)
+    {
+        found = false;
+        oldest = 0u;
+        for(sector = 0u; sector < SMIF_KV_SECTOR_COUNT; sector++)
+        {
+            if((sectorState[sector] == SMIF_KV_SECTOR_USED) && (sectorSequence[sector] > lastSequence)
+                && ((!found) || (sectorSequence[sector] < sectorSequence[oldest])))
+            {
+                oldest = sector;
+                found = true;
+            }
+        }
+        if(found)
+        {
+            ScanSector(oldest);
+            headSector = oldest;
+            lastSequence = sectorSequence[oldest];
+        }
+    }
+
+    if(lastSequence == 0u)
+    {
+        /* Empty region */
+        if(!OpenSector(true))
+        {
+            return SMIF_KV_FULL;
+        }
+    }
+    else
+    {
+        /* Continue the head sector, its last page goes back to the buffer */
+        bufferFill = writeAddress % SMIF_KV_PAGE_SIZE;
+        bufferBase = writeAddress - bufferFill;
+        bufferFlushed = bufferFill;
+        (void)memset(pageBuffer, 0xFF, SMIF_KV_PAGE_SIZE);
+        if((bufferFill != 0u) && (writeAddress < (SectorAddress(headSector) + SMIF_KV_SECTOR_SIZE)))
+        {
+            ReadMemoryCached(pageBuffer, bufferFill, bufferBase);
+        }
+    }
+
+    return (indexCount < ((SMIF_KV_INDEX_SIZE * 3u) / 4u)) ? SMIF_KV_SUCCESS : SMIF_KV_FULL;
+}
+
+/*******************************************************************************
+* Function Name: SetKVRecord
+********************************************************************************
+*
+* This function appends a new value of a key. The value is in RAM until its
+* page is full or SyncKVStore() is called. If the log is full, the oldest
+* sector is collected before returning.
+*
+* \param key
+* Key, up to SMIF_KV_MAX_KEY.
+*
+* \param value
+* Value to store.
+*
+* \param size
+* Size of the value, up to SMIF_KV_MAX_VALUE_SIZE.
+*
+* \return
+* Status of the operation.
+*******************************************************************************/
+smif_kv_status_t SetKVRecord(uint16_t key, const uint8_t value[], uint16_t size)
+{
+    if((key > SMIF_KV_MAX_KEY) || (size > SMIF_KV_MAX_VALUE_SIZE) || ((value == NULL) && (size != 0u)))
+    {
+        return SMIF_KV_BAD_PARAM;
+    }
+    if((IndexFind(key) == SMIF_KV_INDEX_SIZE) && (indexCount >= ((SMIF_KV_INDEX_SIZE * 3u) / 4u)))
+    {
+        return SMIF_KV_FULL;
+    }
+
+    return AppendUserRecord(key, value, size);
+}
+
+/*******************************************************************************
+* Function Name: GetKVRecord
+********************************************************************************
+*
+* This function reads the latest value of a key.
+*
+* \param key
+* Key to look up.
+*
+* \param value
+* Buffer for the value.
+*
+* \param size
+* In: size of the buffer. Out: size of the value.
+*
+* \return
+* Status of the operation.
+*******************************************************************************/
+smif_kv_status_t GetKVRecord(uint16_t key, uint8_t value[], uint16_t *size)
+{
+    smif_kv_record_t record;
+    uint32_t slot = IndexFind(key);
+
+    if(slot == SMIF_KV_INDEX_SIZE)
+    {
+        return SMIF_KV_NOT_FOUND;
+    }
+
+    ReadLog((uint8_t *)&record, sizeof(record), indexAddress[slot]);
+    if(record.length == SMIF_KV_DELETED)
+    {
+        return SMIF_KV_NOT_FOUND;
+    }
+    if(record.length > *size)
+    {
+        *size = record.length;
+        return SMIF_KV_BAD_PARAM;
+    }
+
+    ReadLog(value, record.length, indexAddress[slot] + sizeof(record));
+    *size = record.length;
+    return SMIF_KV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: DeleteKVRecord
+********************************************************************************
+*
+* This function deletes a key by appending a deletion marker. The key is
+* removed from the index when the collector reclaims the marker.
+*
+* \param key
+* Key to delete.
+*
+* \return
+* Status of the operation.
+*******************************************************************************/
+smif_kv_status_t DeleteKVRecord(uint16_t key)
+{
+    smif_kv_record_t record;
+    uint32_t slot = IndexFind(key);
+
+    if(slot == SMIF_KV_INDEX_SIZE)
+    {
+        return SMIF_KV_NOT_FOUND;
+    }
+    ReadLog((uint8_t *)&record, sizeof(record), indexAddress[slot]);
+    if(record.length == SMIF_KV_DELETED)
+    {
+        return SMIF_KV_NOT_FOUND;
+    }
+
+    return AppendUserRecord(key, NULL, SMIF_KV_DELETED);
+}
+
+/*******************************************************************************
+* Function Name: SyncKVStore
+********************************************************************************
+*
+* This function programs the records appended since the last sync. Records
+* are only kept over a reset after this function or a full page. The range is
+* padded to whole program units, so no unit is programmed twice; the next
+* record starts at the next unit.
+*
+* \param
+*  None
+*
+* \return
+*  None
+*******************************************************************************/
+void SyncKVStore(void)
+{
+    uint32_t padding;
+
+    if(bufferFill > bufferFlushed)
+    {
+        padding = (SMIF_KV_PROGRAM_UNIT - (bufferFill % SMIF_KV_PROGRAM_UNIT)) % SMIF_KV_PROGRAM_UNIT;
+        bufferFill += padding;
+        writeAddress += padding;
+
+        WriteMemoryLarge(&pageBuffer[bufferFlushed], bufferFill - bufferFlushed, bufferBase + bufferFlushed);
+        bufferFlushed = bufferFill;
+
+        if(bufferFill == SMIF_KV_PAGE_SIZE)
+        {
+            bufferBase += SMIF_KV_PAGE_SIZE;
+            bufferFill = 0u;
+            bufferFlushed = 0u;
+            (void)memset(pageBuffer, 0xFF, SMIF_KV_PAGE_SIZE);
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: StepGC
+********************************************************************************
+*
+* This function runs one step of the collector. The oldest sector is chosen as
+* the victim, its live records are appended to the head and it is erased once
+* no index entry points into it. Deletion markers in the oldest sector have
+* no older record left to hide, so they are dropped with their key.
+*
+* \param records
+* Maximum number of records to move.
+*
+* \return
+* true while the collection is not completed.
+*******************************************************************************/
+static bool StepGC(uint32_t records)
+{
+    smif_kv_record_t record;
+    uint32_t sector;
+    uint32_t address;
+
+    if(!gcActive)
+    {
+        gcVictim = SMIF_KV_SECTOR_COUNT;
+        for(sector = 0u; sector < SMIF_KV_SECTOR_COUNT; sector++)
+        {
+            if((sectorState[sector] == SMIF_KV_SECTOR_USED) && (sector != headSector)
+                && ((gcVictim == SMIF_KV_SECTOR_COUNT) || (sectorSequence[sector] < sectorSequence[gcVictim])))
+            {
+                gcVictim = sector;
+            }
+        }
+        if(gcVictim == SMIF_KV_SECTOR_COUNT)
+        {
+            return false;
+        }
+        gcSlot = 0u;
+        gcActive = true;
+    }
+
+    while((records > 0u) && (gcSlot < SMIF_KV_INDEX_SIZE))
+    {
+        if((indexKey[gcSlot] != SMIF_KV_EMPTY_SLOT) && (SectorOf(indexAddress[gcSlot]) == gcVictim))
+        {
+            ReadLog((uint8_t *)&record, sizeof(record), indexAddress[gcSlot]);
+            if(record.length == SMIF_KV_DELETED)
+            {
+                /* The slot is refilled by the probe chain, check it again */
+                IndexRemove(gcSlot);
+                continue;
+            }
+
+            ReadLog(valueBuffer, record.length, indexAddress[gcSlot] + sizeof(record));
+            if(AppendRecord(record.key, valueBuffer, record.length, true, &address) != SMIF_KV_SUCCESS)
+            {
+                /* Live data does not fit, keep the victim */
+                gcActive = false;
+                return false;
+            }
+            indexAddress[gcSlot] = address;
+            kvStats.recordsMoved++;
+            records--;
+        }
+        gcSlot++;
+    }
+
+    if(gcSlot == SMIF_KV_INDEX_SIZE)
+    {
+        /* Moved records must be programmed before the originals are erased */
+        SyncKVStore();
+        EraseSMIFSector(SectorAddress(gcVictim));
+        sectorEraseCount[gcVictim]++;
+        StampSector(gcVictim);
+        gcActive = false;
+        kvStats.gcRuns++;
+    }
+    return gcActive;
+}
+
+/*******************************************************************************
+* Function Name: ProcessKVStore
+********************************************************************************
+*
+* This function does the background work of the store, call it from the main
+* loop. It moves up to SMIF_KV_GC_RECORDS_PER_PASS records of the sector being
+* collected, or starts the erase of one free sector ahead of time so the head
+* can move without waiting for an erase.
+*
+* \param
+*  None
+*
+* \return
+*  None
+*******************************************************************************/
+void ProcessKVStore(void)
+{
+    uint32_t sector;
+
+    if(gcActive || (FreeSectorCount() < SMIF_KV_GC_FREE_SECTORS))
+    {
+        (void)StepGC(SMIF_KV_GC_RECORDS_PER_PASS);
+    }
+    else if(!IsSMIFEraseBusy())
+    {
+        /* Stamp a finished erase before the next one is started */
+        for(sector = 0u; sector < SMIF_KV_SECTOR_COUNT; sector++)
+        {
+            if(sectorState[sector] == SMIF_KV_SECTOR_ERASING)
+            {
+                StampSector(sector);
+                return;
+            }
+        }
+        
+        for(sector = 0u; sector < SMIF_KV_SECTOR_COUNT; sector++)
+        {
+            if(sectorState[sector] == SMIF_KV_SECTOR_FREE)
+            {
+                /* Reads suspend the erase, programs wait for its end */
+                StartEraseSMIFSector(SectorAddress(sector));
+                sectorEraseCount[sector]++;
+                sectorState[sector] = SMIF_KV_SECTOR_ERASING;
+                break;
+            }
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: GetKVStoreStats
+********************************************************************************
+*
+* This function copies the statistics of the store.
+*
+* \param stats
+* Pointer to where the statistics are written.
+*
+* \return
+*  None
+*******************************************************************************/
+void GetKVStoreStats(smif_kv_stats_t *stats)
+{
+    uint32_t sector;
+
+    kvStats.keys = indexCount;
+    kvStats.freeSectors = FreeSectorCount();
+    kvStats.minEraseCount = 0xFFFFFFFFu;
+    kvStats.maxEraseCount = 0u;
+    for(sector = 0u; sector < SMIF_KV_SECTOR_COUNT; sector++)
+    {
+        if(sectorEraseCount[sector] < kvStats.minEraseCount)
+        {
+            kvStats.minEraseCount = sectorEraseCount[sector];
+        }
+        if(sectorEraseCount[sector] > kvStats.maxEraseCount)
+        {
+            kvStats.maxEraseCount = sectorEraseCount[sector];
+        }
+    }
+    *stats = kvStats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,127 @@
+/******************************************************************************
+* File Name: smif_kv.h
+*
+* Version: 1.0
+*
+* Description: This header file contains the defines for the log structured
+*              key-value store on the external memory.
+*
+* Related Document: CE220959.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and
+* foreign), United States copyright laws and international treaty provisions.
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the
+* Cypress source code and derivative works for the sole purpose of creating
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited
+* without the express written permission of Cypress.
+*
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND,
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice.
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products
+* where a malfunction or failure may reasonably be expected to result in
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef __SMIF_KV_H
+#define __SMIF_KV_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*            Constants
+*******************************************************************************/
+/* Region of the external memory used by the store, must be sector aligned */
+#define SMIF_KV_START_ADDRESS       (0x03F00000u)
+#define SMIF_KV_SECTOR_SIZE         (0x00040000u)   /* Must match eraseSize */
+#define SMIF_KV_SECTOR_COUNT        (4u)            /* At least 3 sectors */
+
+/* Page buffer size, must match programSize */
+#define SMIF_KV_PAGE_SIZE           (512u)
+
+/* ECC unit of the memory. A unit programmed twice between erases loses its
+*  ECC, so every sync is padded to a whole unit and the rest is not used.
+*/
+#define SMIF_KV_PROGRAM_UNIT        (16u)
+
+/* Number of index slots, a power of two. Up to 3/4 of them can hold keys */
+#define SMIF_KV_INDEX_SIZE          (256u)
+
+/* Largest value in bytes */
+#define SMIF_KV_MAX_VALUE_SIZE      (256u)
+
+/* Garbage collection starts when fewer sectors than this are free */
+#define SMIF_KV_GC_FREE_SECTORS     (2u)
+
+/* Records moved by one call of ProcessKVStore() */
+#define SMIF_KV_GC_RECORDS_PER_PASS (8u)
+
+/* Keys 0xFFFE and 0xFFFF are reserved */
+#define SMIF_KV_MAX_KEY             (0xFFFDu)
+
+/* Status codes */
+typedef enum
+{
+    SMIF_KV_SUCCESS = 0u,                   /* Operation completed               */
+    SMIF_KV_NOT_FOUND,                      /* Key does not exist                */
+    SMIF_KV_BAD_PARAM,                      /* Bad key, size or buffer           */
+    SMIF_KV_FULL                            /* No space left in the log or index */
+} smif_kv_status_t;
+
+/* Store statistics */
+typedef struct
+{
+    uint32_t keys;                          /* Keys in the index                 */
+    uint32_t freeSectors;                   /* Sectors not holding the log       */
+    uint32_t minEraseCount;                 /* Lowest sector erase count         */
+    uint32_t maxEraseCount;                 /* Highest sector erase count        */
+    uint32_t recordsWritten;                /* Records appended by the user      */
+    uint32_t recordsMoved;                  /* Records appended by the collector */
+    uint32_t gcRuns;                        /* Sectors reclaimed                 */
+} smif_kv_stats_t;
+
+/*******************************************************************************
+*            Function Prototypes
+*******************************************************************************/
+smif_kv_status_t MountKVStore(void);        /* Rebuild the index from the log */
+
+smif_kv_status_t SetKVRecord(
+                    uint16_t key,
+                    const uint8_t value[],
+                    uint16_t size);         /* Append a new value of a key */
+
+smif_kv_status_t GetKVRecord(
+                    uint16_t key,
+                    uint8_t value[],
+                    uint16_t *size);        /* Read the latest value of a key */
+
+smif_kv_status_t DeleteKVRecord(uint16_t key); /* Append a deletion marker */
+
+void SyncKVStore(void);                     /* Program the buffered records */
+
+void ProcessKVStore(void);                  /* Background collection and pre-erase */
+
+void GetKVStoreStats(smif_kv_stats_t *stats); /* Copy the statistics */
+
+#endif /*__SMIF_KV_H*/
+
+/* [] END OF FILE */
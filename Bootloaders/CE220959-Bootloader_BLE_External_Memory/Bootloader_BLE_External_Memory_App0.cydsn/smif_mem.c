@@ -39,7 +39,12 @@
 *****************************************************************************/
 
 #include "smif_mem.h"
+#include "smif_cache.h"
+#if (SMIF_MEM_SFDP_DISCOVERY != 0u)
+#include "smif_sfdp.h"
+#endif /* (SMIF_MEM_SFDP_DISCOVERY != 0u) */
 #include "project.h"
+#include <string.h>
 
 /* Macro to wait until a next operation can be issued */
 #define WaitMemBusy(Hardware, Context)  while(Cy_SMIF_Memslot_IsBusy(Hardware, (cy_stc_smif_mem_config_t*)smifMemConfigs[0], Context)){}
@@ -51,6 +56,78 @@ void SetSMIFPointers(SMIF_Type *base, cy_stc_smif_context_t *context); /* Sets l
 static SMIF_Type* SMIFHardware;
 static cy_stc_smif_context_t* SMIFcontext;
 
+/* Set by the SMIF interrupt when the data phase of a command is completed */
+static volatile bool TxfrCmplt = true;
+
+/* Set when the memory was changed in the normal mode since the SMIF cache was last invalidated */
+static bool xipModified = false;
+
+/* SwitchSMIFMemory() calls which invalidated or kept the SMIF cache */
+static uint32_t xipInvalidateCount = 0u;
+static uint32_t xipKeepCount = 0u;
+
+/* Sector erase started by StartEraseSMIFSector() */
+static bool eraseInProgress = false;
+static uint32_t eraseSector;
+
+/* Read command settings of the S25FL512S, 4-byte address commands */
+typedef struct
+{
+    uint8_t command;
+    cy_en_smif_txfr_width_t addrWidth;
+    cy_en_smif_txfr_width_t dataWidth;
+    uint32_t modeClocks;        /* Cycles of the mode byte, 0 if there is none */
+    uint32_t dummyCycles;       /* Dummy cycles at the default latency code */
+    uint32_t maxClock;          /* Highest SPI clock in Hz */
+} read_mode_cfg_t;
+
+static const read_mode_cfg_t readModes[SMIF_READ_MODE_COUNT] =
+{
+    {0xECu, CY_SMIF_WIDTH_QUAD,   CY_SMIF_WIDTH_QUAD,   2u, 4u, 104000000u},
+    {0x6Cu, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_QUAD,   0u, 8u, 104000000u},
+    {0xBCu, CY_SMIF_WIDTH_DUAL,   CY_SMIF_WIDTH_DUAL,   4u, 0u, 104000000u},
+    {0x3Cu, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_DUAL,   0u, 8u, 104000000u},
+    {0x0Cu, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 8u, 133000000u},
+    {0x13u, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u,  50000000u}
+};
+
+/* Read command in use, the default configuration is the Quad I/O Read */
+static smif_read_mode_t readMode = SMIF_READ_QUAD_IO;
+
+/* Local functions */
+static void ApplyReadMode(smif_read_mode_t mode, uint32_t dummyCycles);
+static void UpdateReadCommand(void);
+static bool ReadsPattern(uint32_t address, const uint8_t expected[]);
+static void WaitMemIdle(void);
+
+#if (SMIF_MEM_ERASE_SUSPEND != 0u)
+/* S25FL512S erase suspend commands and status */
+#define CMD_ERASE_SUSPEND       (0x75u)
+#define CMD_ERASE_RESUME        (0x7Au)
+#define CMD_READ_STS_REG2       (0x07u)
+#define STS_REG2_ES_MASK        (0x02u)
+
+/* Cycles per microsecond of the CM4 cycle counter */
+#define CYCLES_PER_US           (SystemCoreClock / 1000000u)
+
+/* End of the last resume */
+static uint32_t eraseResumeCycles;
+
+/* Latency of reads served while an erase was in progress */
+static uint32_t eraseReadCount = 0u;
+static uint32_t eraseReadMaxCycles = 0u;
+
+/* Local functions */
+static bool SuspendSMIFErase(uint32_t Address, uint32_t size);
+static void ResumeSMIFErase(void);
+#endif /* (SMIF_MEM_ERASE_SUSPEND != 0u) */
+
+#if (SMIF_MEM_MEASURE_THROUGHPUT != 0u)
+/* Bytes written and CPU cycles spent by WriteMemoryLarge() */
+static uint64_t measuredBytes = 0u;
+static uint64_t measuredCycles = 0u;
+#endif /* (SMIF_MEM_MEASURE_THROUGHPUT != 0u) */
+
 /*******************************************************************************
 * Function Name: handle_error
 ********************************************************************************
@@ -95,6 +172,7 @@ void RxCmpltCallback (uint32_t event)
     {
         /*The process event is 0*/
     }
+    TxfrCmplt = true;
 }
 
 /*******************************************************************************
@@ -135,6 +213,14 @@ void configureSMIF(SMIF_Type *base, cy_stc_smif_context_t *context)
     /* Enables the SMIF interrupt */
     NVIC_EnableIRQ(SMIF_SMIF_IRQ_cfg.intrSrc);
 
+#if (SMIF_MEM_SFDP_DISCOVERY != 0u)
+    /* Read the SFDP tables before the XIP registers take the command set */
+    Cy_SMIF_SetDataSelect(base, smifMemConfigs[0]->slaveSelect, smifMemConfigs[0]->dataSelect);
+    Cy_SMIF_Enable(base, context);
+    (void)DiscoverSFDP(base, context, smifMemConfigs[0]->slaveSelect, smifMemConfigs[0]->deviceCfg);
+    Cy_SMIF_Disable(base);
+#endif /* (SMIF_MEM_SFDP_DISCOVERY != 0u) */
+
     /* Configure the SMIF XIP registers */
     Cy_SMIF_Memslot_Init(base,(cy_stc_smif_block_config_t*) &smifBlockConfig, context);
     
@@ -143,6 +229,12 @@ void configureSMIF(SMIF_Type *base, cy_stc_smif_context_t *context)
     
     /* Sets global pointers */
     SetSMIFPointers(base, context);
+    
+#if (SMIF_MEM_ERASE_SUSPEND != 0u)
+    /* The cycle counter times the erase suspend and resume */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif /* (SMIF_MEM_ERASE_SUSPEND != 0u) */
         
     /* Enable Quad Mode */
     WaitMemBusy(SMIFHardware, SMIFcontext);
@@ -151,6 +243,11 @@ void configureSMIF(SMIF_Type *base, cy_stc_smif_context_t *context)
     
     WaitMemBusy(SMIFHardware, SMIFcontext);
     
+#if (SMIF_MEM_READ_CALIBRATION != 0u)
+    /* The SPI clock is half of the SMIF clock (HFCLK2) */
+    (void)CalibrateSMIFReadMode(SMIF_MEM_CALIB_ADDRESS, Cy_SysClk_ClkHfGetFrequency(2u) / 2u);
+#endif /* (SMIF_MEM_READ_CALIBRATION != 0u) */
+    
     return;
 }
 
@@ -178,11 +275,15 @@ void WriteMemory(uint8_t txBuffer[],uint32_t txSize,uint32_t Address)
 {
     cy_en_smif_status_t smif_status;
     
+    /* Cached copies of the page become stale */
+    InvalidateReadCache(Address, txSize);
+    MarkSMIFModified(Address, txSize);
+    
     /* Reverse address byte order */
     Address = __REV(Address);
     
     /* Wait until memory is available */
-    WaitMemBusy(SMIFHardware, SMIFcontext);
+    WaitMemIdle();
     
     /* Send Write Enable to external memory */	
     smif_status = Cy_SMIF_Memslot_CmdWriteEnable(SMIFHardware, smifMemConfigs[0], SMIFcontext);
@@ -201,12 +302,148 @@ void WriteMemory(uint8_t txBuffer[],uint32_t txSize,uint32_t Address)
     }
 }
 
+/*******************************************************************************
+* Function Name: WriteMemoryLarge
+********************************************************************************
+*
+* This function writes data of any length and alignment to the external memory
+* in the quad mode. The data is split at the page borders of the memory and
+* every page is programmed by a Write Enable and Quad Page Program pair. The 
+* next page is started as soon as the WIP bit of the previous one is cleared.
+* This is a blocking function, it returns when the last page is programmed.
+*
+* \param txBuffer
+* Holds the address of the data to be sent.
+*
+* \param txSize
+* The size of the data.
+*
+* \param Address 
+* The address to write data to.
+* 
+* \return
+* None
+*******************************************************************************/
+void WriteMemoryLarge(uint8_t txBuffer[], uint32_t txSize, uint32_t Address)
+{
+    cy_en_smif_status_t smif_status;
+    uint32_t pageSize = smifMemConfigs[0]->deviceCfg->programSize;
+    uint32_t offset = 0u;
+    uint32_t chunk;
+    uint32_t pageAddress;
+    
+#if (SMIF_MEM_MEASURE_THROUGHPUT != 0u)
+    uint32_t startCycles = DWT->CYCCNT;
+#endif /* (SMIF_MEM_MEASURE_THROUGHPUT != 0u) */
+    
+    /* Cached copies of the pages become stale */
+    InvalidateReadCache(Address, txSize);
+    MarkSMIFModified(Address, txSize);
+    
+    while(offset < txSize)
+    {
+        /* Bytes left until the end of the page */
+        chunk = pageSize - ((Address + offset) % pageSize);
+        if(chunk > (txSize - offset))
+        {
+            chunk = txSize - offset;
+        }
+        
+        /* Reverse address byte order */
+        pageAddress = __REV(Address + offset);
+        
+        /* Wait until the previous page is programmed */
+        WaitMemIdle();
+        
+        /* Send Write Enable to external memory */	
+        smif_status = Cy_SMIF_Memslot_CmdWriteEnable(SMIFHardware, smifMemConfigs[0], SMIFcontext);
+        if(smif_status!=CY_SMIF_SUCCESS)
+        {
+            handle_error();
+        }
+        
+        /* Quad Page Program command */
+        TxfrCmplt = false;
+        smif_status = Cy_SMIF_Memslot_CmdProgram(SMIFHardware, smifMemConfigs[0], (uint8_t*)&pageAddress, &txBuffer[offset], chunk, &RxCmpltCallback, SMIFcontext);
+        if(smif_status!=CY_SMIF_SUCCESS)
+        {
+            handle_error();
+        }
+        
+        /* The status poll must not be queued behind the page data */
+        while((!TxfrCmplt) || Cy_SMIF_BusyCheck(SMIFHardware)){}
+        
+        offset += chunk;
+    }
+    
+    /* Wait until the last page is programmed */
+    WaitMemBusy(SMIFHardware, SMIFcontext);
+    
+#if (SMIF_MEM_MEASURE_THROUGHPUT != 0u)
+    measuredCycles += (uint32_t)(DWT->CYCCNT - startCycles);
+    measuredBytes += txSize;
+#endif /* (SMIF_MEM_MEASURE_THROUGHPUT != 0u) */
+}
+
+#if (SMIF_MEM_MEASURE_THROUGHPUT != 0u)
+/*******************************************************************************
+* Function Name: GetWriteThroughput
+********************************************************************************
+*
+* This function returns the write throughput of WriteMemoryLarge() since the
+* last call of ResetWriteThroughput(). Calling WriteMemoryLarge() with one page
+* per call gives the single-page baseline.
+*
+* \param
+*  None
+*
+* \return
+* Throughput in KB/s, 0 if nothing was written.
+*******************************************************************************/
+uint32_t GetWriteThroughput(void)
+{
+    uint32_t throughput = 0u;
+    
+    if(measuredCycles != 0u)
+    {
+        throughput = (uint32_t)((measuredBytes * SystemCoreClock) / (measuredCycles * 1024u));
+    }
+    return throughput;
+}
+
+/*******************************************************************************
+* Function Name: ResetWriteThroughput
+********************************************************************************
+*
+* This function clears the throughput counters and starts the CPU cycle 
+* counter used to time WriteMemoryLarge().
+*
+* \param
+*  None
+*
+* \return
+*  None
+*******************************************************************************/
+void ResetWriteThroughput(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    measuredBytes = 0u;
+    measuredCycles = 0u;
+}
+#endif /* (SMIF_MEM_MEASURE_THROUGHPUT != 0u) */
+
 /*******************************************************************************
 * Function Name: ReadMemory
 ********************************************************************************
 *
 * This function reads data from the external memory in the quad mode. 
-* The function sends the Quad I/O Read command. 
+* The function sends the Quad I/O Read command, or the read command selected
+* by SetSMIFReadMode(). If a sector erase started by
+* StartEraseSMIFSector() is in progress, the erase is suspended for the read
+* and resumed afterwards. A read of the sector being erased waits for the end
+* of the erase.
 *
 * \param rxBuffer
 * Holds the address of where the data will be stored.
@@ -223,6 +460,12 @@ void WriteMemory(uint8_t txBuffer[],uint32_t txSize,uint32_t Address)
 void ReadMemory(uint8_t rxBuffer[], uint32_t rxSize, uint32_t Address)
 {   
     cy_en_smif_status_t smif_status;
+    
+#if (SMIF_MEM_ERASE_SUSPEND != 0u)
+    uint32_t startCycles = DWT->CYCCNT;
+    bool erasing = eraseInProgress;
+    bool suspended = SuspendSMIFErase(Address, rxSize);
+#endif /* (SMIF_MEM_ERASE_SUSPEND != 0u) */
 
     /* Reverse address byte order */
     Address = __REV(Address);
@@ -239,6 +482,22 @@ void ReadMemory(uint8_t rxBuffer[], uint32_t rxSize, uint32_t Address)
     
     /* Wait until data has been read */
     WaitMemBusy(SMIFHardware, SMIFcontext);
+    
+#if (SMIF_MEM_ERASE_SUSPEND != 0u)
+    if(suspended)
+    {
+        ResumeSMIFErase();
+    }
+    
+    if(erasing)
+    {
+        eraseReadCount++;
+        if((uint32_t)(DWT->CYCCNT - startCycles) > eraseReadMaxCycles)
+        {
+            eraseReadMaxCycles = (uint32_t)(DWT->CYCCNT - startCycles);
+        }
+    }
+#endif /* (SMIF_MEM_ERASE_SUSPEND != 0u) */
 }
 
 /*******************************************************************************
@@ -248,6 +507,10 @@ void ReadMemory(uint8_t rxBuffer[], uint32_t rxSize, uint32_t Address)
 * This function switches the SMIF device from normal to memory mode. 
 * Maps the external memory into the XIP memory region of the PSoC device.
 * SMIF Device must be already initialized before calling this function.
+* The SMIF cache is only invalidated if the memory was changed in the normal
+* mode, otherwise XIP code and data stay cached. The whole memory is mapped
+* and the cache has no per-line invalidation, so any change invalidates all
+* of it.
 * 
 * \param
 *  None
@@ -260,7 +523,16 @@ void SwitchSMIFMemory(void)
     /* SMIF must be already running */
     Cy_SMIF_SetMode(SMIFHardware, CY_SMIF_MEMORY);
     
-    Cy_SMIF_CacheInvalidate(SMIFHardware, CY_SMIF_CACHE_BOTH);
+    if(xipModified)
+    {
+        Cy_SMIF_CacheInvalidate(SMIFHardware, CY_SMIF_CACHE_BOTH);
+        xipInvalidateCount++;
+    }
+    else
+    {
+        xipKeepCount++;
+    }
+    xipModified = false;
 }
 
 /*******************************************************************************
@@ -268,6 +540,8 @@ void SwitchSMIFMemory(void)
 ********************************************************************************
 *
 * This function switches the SMIF device from memory to normal mode. 
+* The SMIF cache is kept, changes made in the normal mode are tracked by
+* MarkSMIFModified() and dropped by SwitchSMIFMemory().
 * 
 * \param
 *  None
@@ -279,8 +553,55 @@ void SwitchSMIFNormal(void)
 {
     /* SMIF must be already running */
     Cy_SMIF_SetMode(SMIFHardware, CY_SMIF_NORMAL);
+}
+
+/*******************************************************************************
+* Function Name: MarkSMIFModified
+********************************************************************************
+*
+* This function records a change of the external memory by a program or 
+* erase, so SwitchSMIFMemory() invalidates the SMIF cache. The functions 
+* of this file call it, other code which programs or erases the memory must
+* call it too.
+*
+* \param Address
+* Start of the changed range. Not used, the whole memory is mapped.
+*
+* \param size
+* Size of the changed range.
+*
+* \return
+* None
+*******************************************************************************/
+void MarkSMIFModified(uint32_t Address, uint32_t size)
+{
+    (void)Address;
     
-    Cy_SMIF_CacheInvalidate(SMIFHardware, CY_SMIF_CACHE_BOTH);    
+    if(size != 0u)
+    {
+        xipModified = true;
+    }
+}
+
+/*******************************************************************************
+* Function Name: GetXIPInvalidateCount
+********************************************************************************
+*
+* Returns how many SwitchSMIFMemory() calls invalidated the SMIF cache.
+*
+* \param keepCount
+* Set to the number of calls which kept the cache. May be NULL.
+*
+* \return
+* The number of calls which invalidated the cache.
+*******************************************************************************/
+uint32_t GetXIPInvalidateCount(uint32_t *keepCount)
+{
+    if(keepCount != NULL)
+    {
+        *keepCount = xipKeepCount;
+    }
+    return xipInvalidateCount;
 }
 
 /*******************************************************************************
@@ -299,6 +620,12 @@ void EraseSMIFChip(void)
 {
     cy_en_smif_status_t smif_status;
     
+    InvalidateReadCacheAll();
+    MarkSMIFModified(0u, smifMemConfigs[0]->deviceCfg->memSize);
+    
+    /* Wait until a previous erase or program is completed */
+    WaitMemIdle();
+    
     smif_status = Cy_SMIF_Memslot_CmdWriteEnable(SMIFHardware, smifMemConfigs[0], SMIFcontext);
     if(smif_status!=CY_SMIF_SUCCESS)
     {
@@ -319,6 +646,7 @@ void EraseSMIFChip(void)
 ********************************************************************************
 *
 * This function erases the sector where the passed address is located. 
+* This is a blocking function.
 *
 * \param Address
 * Address to be deleted (Including sector where address is located).
@@ -327,8 +655,42 @@ void EraseSMIFChip(void)
 *  None
 *******************************************************************************/
 void EraseSMIFSector(uint32_t Address)
+{
+    StartEraseSMIFSector(Address);
+    
+    while(IsSMIFEraseBusy())
+    {
+    }
+}
+
+/*******************************************************************************
+* Function Name: StartEraseSMIFSector
+********************************************************************************
+*
+* This function starts the erase of the sector where the passed address is
+* located and returns without waiting. Reads issued by ReadMemory() while the 
+* erase is in progress suspend it. Poll IsSMIFEraseBusy() for the end of the
+* erase; the program and erase functions wait for it.
+*
+* \param Address
+* Address to be deleted (Including sector where address is located).
+* 
+* \return
+*  None
+*******************************************************************************/
+void StartEraseSMIFSector(uint32_t Address)
 {
     cy_en_smif_status_t smif_status;
+    uint32_t sectorSize = smifMemConfigs[0]->deviceCfg->eraseSize;
+    
+    /* Cached copies of the sector become stale */
+    InvalidateReadCache(Address - (Address % sectorSize), sectorSize);
+    MarkSMIFModified(Address - (Address % sectorSize), sectorSize);
+    
+    /* Wait until a previous erase or program is completed */
+    WaitMemIdle();
+    
+    eraseSector = Address / sectorSize;
     
     /* Reverse address byte order */
     Address = __REV(Address);
@@ -345,7 +707,385 @@ void EraseSMIFSector(uint32_t Address)
         handle_error();
     }
     
+    eraseInProgress = true;
+#if (SMIF_MEM_ERASE_SUSPEND != 0u)
+    eraseResumeCycles = DWT->CYCCNT;
+#endif /* (SMIF_MEM_ERASE_SUSPEND != 0u) */
+}
+
+/*******************************************************************************
+* Function Name: WaitMemIdle
+********************************************************************************
+*
+* This function waits until the memory has completed a program or erase,
+* including an erase started by StartEraseSMIFSector(), which then no longer
+* needs to be suspended for reads. Must not be called while that erase is
+* suspended, as WIP reads 0 then.
+*
+* \param
+*  None
+*
+* \return
+*  None
+*******************************************************************************/
+static void WaitMemIdle(void)
+{
     WaitMemBusy(SMIFHardware, SMIFcontext);
+    eraseInProgress = false;
+}
+
+/*******************************************************************************
+* Function Name: IsSMIFEraseBusy
+********************************************************************************
+*
+* This function checks if the erase started by StartEraseSMIFSector() is still
+* in progress.
+*
+* \param
+*  None
+*
+* \return
+* true while the erase is in progress.
+*******************************************************************************/
+bool IsSMIFEraseBusy(void)
+{
+    if(eraseInProgress && 
+       (!Cy_SMIF_Memslot_IsBusy(SMIFHardware, (cy_stc_smif_mem_config_t*)smifMemConfigs[0], SMIFcontext)))
+    {
+        eraseInProgress = false;
+    }
+    return eraseInProgress;
+}
+
+#if (SMIF_MEM_ERASE_SUSPEND != 0u)
+/*******************************************************************************
+* Function Name: SuspendSMIFErase
+********************************************************************************
+*
+* This function suspends the erase in progress so a read can be issued. The
+* erase gets at least SMIF_MEM_ERASE_RESUME_US after each resume, so repeated
+* reads cannot stall it. A read of the sector being erased waits for the end
+* of the erase instead. The read latency is therefore bounded by the resume
+* time, the suspend latency of the memory and the read itself.
+*
+* \param Address
+* Start of the range to be read.
+*
+* \param size
+* Size of the range to be read.
+*
+* \return
+* true if the erase was suspended and must be resumed. false for an empty range.
+*******************************************************************************/
+static bool SuspendSMIFErase(uint32_t Address, uint32_t size)
+{
+    uint32_t sectorSize = smifMemConfigs[0]->deviceCfg->eraseSize;
+    uint8_t status = 0u;
+    
+    /* Nothing is read, the end of the range below would wrap around */
+    if((size == 0u) || !IsSMIFEraseBusy())
+    {
+        return false;
+    }
+    
+    if(((Address / sectorSize) <= eraseSector) && (((Address + size - 1u) / sectorSize) >= eraseSector))
+    {
+        /* Data of the sector is undefined until the erase is completed */
+        WaitMemBusy(SMIFHardware, SMIFcontext);
+        eraseInProgress = false;
+        return false;
+    }
+    
+    /* Let the erase progress before it is suspended again */
+    while((uint32_t)(DWT->CYCCNT - eraseResumeCycles) < (SMIF_MEM_ERASE_RESUME_US * CYCLES_PER_US))
+    {
+    }
+    
+    (void)Cy_SMIF_TransmitCommand(SMIFHardware, CMD_ERASE_SUSPEND, CY_SMIF_WIDTH_SINGLE, NULL, 0u, 
+                                  CY_SMIF_WIDTH_SINGLE, smifMemConfigs[0]->slaveSelect, CY_SMIF_TX_LAST_BYTE, SMIFcontext);
+    
+    /* WIP is cleared when the erase is suspended or completed */
+    WaitMemBusy(SMIFHardware, SMIFcontext);
+    
+    (void)Cy_SMIF_Memslot_CmdReadSts(SMIFHardware, smifMemConfigs[0], &status, CMD_READ_STS_REG2, SMIFcontext);
+    if((status & STS_REG2_ES_MASK) == 0u)
+    {
+        /* The erase completed before the suspend */
+        eraseInProgress = false;
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: ResumeSMIFErase
+********************************************************************************
+*
+* This function resumes the erase suspended by SuspendSMIFErase().
+*
+* \param
+*  None
+*
+* \return
+*  None
+*******************************************************************************/
+static void ResumeSMIFErase(void)
+{
+    (void)Cy_SMIF_TransmitCommand(SMIFHardware, CMD_ERASE_RESUME, CY_SMIF_WIDTH_SINGLE, NULL, 0u, 
+                                  CY_SMIF_WIDTH_SINGLE, smifMemConfigs[0]->slaveSelect, CY_SMIF_TX_LAST_BYTE, SMIFcontext);
+    eraseResumeCycles = DWT->CYCCNT;
+}
+
+/*******************************************************************************
+* Function Name: GetEraseReadLatency
+********************************************************************************
+*
+* This function returns the latency of the reads issued while a sector erase
+* was in progress, including the suspend and resume.
+*
+* \param maxLatency
+* Pointer to where the worst case latency in microseconds is written.
+*
+* \return
+* Number of reads issued while an erase was in progress.
+*******************************************************************************/
+uint32_t GetEraseReadLatency(uint32_t *maxLatency)
+{
+    *maxLatency = eraseReadMaxCycles / CYCLES_PER_US;
+    return eraseReadCount;
+}
+
+/*******************************************************************************
+* Function Name: ResetEraseReadLatency
+********************************************************************************
+*
+* This function clears the erase read latency statistics.
+*
+* \param
+*  None
+*
+* \return
+*  None
+*******************************************************************************/
+void ResetEraseReadLatency(void)
+{
+    eraseReadCount = 0u;
+    eraseReadMaxCycles = 0u;
+}
+#endif /* (SMIF_MEM_ERASE_SUSPEND != 0u) */
+
+/*******************************************************************************
+* Function Name: ApplyReadMode
+********************************************************************************
+*
+* Writes a read mode into the read command of the memory configuration. The
+* XIP registers are not updated.
+*
+*******************************************************************************/
+static void ApplyReadMode(smif_read_mode_t mode, uint32_t dummyCycles)
+{
+    cy_stc_smif_mem_cmd_t *readCmd = smifMemConfigs[0]->deviceCfg->readCmd;
+    
+    readCmd->command = readModes[mode].command;
+    readCmd->cmdWidth = CY_SMIF_WIDTH_SINGLE;
+    readCmd->addrWidth = readModes[mode].addrWidth;
+    readCmd->dataWidth = readModes[mode].dataWidth;
+    readCmd->dummyCycles = dummyCycles;
+    
+    if(readModes[mode].modeClocks != 0u)
+    {
+        /* Not Axh, so the memory does not enter the continuous read mode */
+        readCmd->mode = 0x01u;
+        readCmd->modeWidth = readModes[mode].addrWidth;
+    }
+    else
+    {
+        readCmd->mode = 0xFFFFFFFFu;
+        readCmd->modeWidth = CY_SMIF_WIDTH_SINGLE;
+    }
+    readMode = mode;
+}
+
+/*******************************************************************************
+* Function Name: UpdateReadCommand
+********************************************************************************
+*
+* Takes the read command of the memory configuration into the XIP registers 
+* and drops data read with the old command.
+*
+*******************************************************************************/
+static void UpdateReadCommand(void)
+{
+    Cy_SMIF_Memslot_Init(SMIFHardware, (cy_stc_smif_block_config_t*) &smifBlockConfig, SMIFcontext);
+    (void)Cy_SMIF_CacheInvalidate(SMIFHardware, CY_SMIF_CACHE_BOTH);
+}
+
+/*******************************************************************************
+* Function Name: SetSMIFReadMode
+********************************************************************************
+*
+* This function selects the read command used by ReadMemory() and by the XIP
+* mode. The dummy cycles must match the latency code in the configuration 
+* register of the memory, GetSMIFReadModeDummyCycles() returns the values of
+* the default latency code. The SMIF must be in the normal mode.
+*
+* \param mode
+* Read mode.
+*
+* \param dummyCycles
+* Dummy cycles after the address and the mode byte.
+*
+* \return
+* None
+*******************************************************************************/
+void SetSMIFReadMode(smif_read_mode_t mode, uint32_t dummyCycles)
+{
+    ApplyReadMode(mode, dummyCycles);
+    UpdateReadCommand();
+}
+
+/*******************************************************************************
+* Function Name: GetSMIFReadMode
+********************************************************************************
+*
+* Returns the read mode in use.
+*
+* \param dummyCycles
+* Dummy cycles of the read mode. May be NULL.
+*
+* \return
+* Read mode.
+*******************************************************************************/
+smif_read_mode_t GetSMIFReadMode(uint32_t *dummyCycles)
+{
+    if(dummyCycles != NULL)
+    {
+        *dummyCycles = smifMemConfigs[0]->deviceCfg->readCmd->dummyCycles;
+    }
+    return readMode;
+}
+
+/*******************************************************************************
+* Function Name: GetSMIFReadModeDummyCycles
+********************************************************************************
+*
+* Returns the dummy cycles of a read mode at the default latency code.
+*
+*******************************************************************************/
+uint32_t GetSMIFReadModeDummyCycles(smif_read_mode_t mode)
+{
+    return readModes[mode].dummyCycles;
+}
+
+/*******************************************************************************
+* Function Name: ReadsPattern
+********************************************************************************
+*
+* Reads the test pattern with the read command of the memory configuration.
+*
+* \return
+* true if the pattern was read back exactly.
+*******************************************************************************/
+static bool ReadsPattern(uint32_t address, const uint8_t expected[])
+{
+    uint8_t data[SMIF_MEM_CALIB_SIZE];
+    
+    (void)memset(data, 0, SMIF_MEM_CALIB_SIZE);
+    ReadMemory(data, SMIF_MEM_CALIB_SIZE, address);
+    return (memcmp(data, expected, SMIF_MEM_CALIB_SIZE) == 0);
+}
+
+/*******************************************************************************
+* Function Name: CalibrateSMIFReadMode
+********************************************************************************
+*
+* This function checks the read command in use, as set by the configuration
+* or by SFDP discovery, and if it does not read a test pattern back, selects
+* the fastest read mode which does. The modes rated below the SPI clock are
+* tried fastest first. For each mode the dummy cycles of the default latency
+* code are tried first, then all counts up to SMIF_MEM_CALIB_MAX_DUMMY, so a
+* changed latency code is found as well. The pattern is programmed if the
+* area is erased; an erased area reads as all 1s with any dummy count, so 
+* the check needs no reference read with the Read command (13h), which is 
+* rated for 50 MHz only. DDR reads are not tried, the SMIF block does not
+* support them.
+*
+* \param address
+* Address of SMIF_MEM_CALIB_SIZE bytes reserved for the test pattern.
+*
+* \param spiClock
+* SPI clock in Hz.
+*
+* \return
+* The selected mode, or SMIF_READ_MODE_COUNT if no mode read the pattern. The
+* previous read command is kept in this case. If the read command in use
+* reads the pattern, it is kept and the mode in use is returned.
+*******************************************************************************/
+smif_read_mode_t CalibrateSMIFReadMode(uint32_t address, uint32_t spiClock)
+{
+    uint8_t expected[SMIF_MEM_CALIB_SIZE];
+    uint8_t data[SMIF_MEM_CALIB_SIZE];
+    cy_stc_smif_mem_cmd_t *readCmd = smifMemConfigs[0]->deviceCfg->readCmd;
+    cy_stc_smif_mem_cmd_t oldCmd = *readCmd;
+    smif_read_mode_t oldMode = readMode;
+    smif_read_mode_t mode;
+    uint32_t dummy;
+    uint32_t i;
+    bool erased = true;
+    
+    /* Every nibble value on every data line */
+    for(i = 0u; i < SMIF_MEM_CALIB_SIZE; i++)
+    {
+        expected[i] = (uint8_t)((i * 0x1Du) ^ 0xA5u);
+    }
+    
+    ReadMemory(data, SMIF_MEM_CALIB_SIZE, address);
+    for(i = 0u; i < SMIF_MEM_CALIB_SIZE; i++)
+    {
+        erased = erased && (data[i] == 0xFFu);
+    }
+    if(erased)
+    {
+        WriteMemory(expected, SMIF_MEM_CALIB_SIZE, address);
+        WaitMemBusy(SMIFHardware, SMIFcontext);
+    }
+    
+    /* The command in use may come from the SFDP tables, keep it if it works */
+    if(ReadsPattern(address, expected))
+    {
+        return oldMode;
+    }
+    
+    for(mode = SMIF_READ_QUAD_IO; mode < SMIF_READ_MODE_COUNT; mode++)
+    {
+        if(readModes[mode].maxClock < spiClock)
+        {
+            continue;
+        }
+        
+        for(i = 0u; i <= (SMIF_MEM_CALIB_MAX_DUMMY + 1u); i++)
+        {
+            /* The default dummy cycles first, then all the others */
+            dummy = (i == 0u) ? readModes[mode].dummyCycles : (i - 1u);
+            if((i != 0u) && (dummy == readModes[mode].dummyCycles))
+            {
+                continue;
+            }
+            
+            ApplyReadMode(mode, dummy);
+            if(ReadsPattern(address, expected))
+            {
+                UpdateReadCommand();
+                return mode;
+            }
+        }
+    }
+    
+    /* The area holds other data or no mode works */
+    *readCmd = oldCmd;
+    readMode = oldMode;
+    UpdateReadCommand();
+    return SMIF_READ_MODE_COUNT;
 }
 
 /*******************************************************************************
@@ -373,5 +1113,27 @@ void SetSMIFPointers(SMIF_Type *base, cy_stc_smif_context_t *context)
     }
 }
 
+/*******************************************************************************
+* Function Name: GetSMIFPointers
+********************************************************************************
+*
+* Returns the pointers saved by SetSMIFPointers(), so other modules can issue
+* SMIF commands on the same component.
+*
+* \param base
+*  pointer to where the SMIF hardware pointer is written.
+*
+* \param context
+* pointer to where the SMIF context pointer is written.
+*
+* \return
+*  None
+*******************************************************************************/
+void GetSMIFPointers(SMIF_Type **base, cy_stc_smif_context_t **context)
+{
+    *base = SMIFHardware;
+    *context = SMIFcontext;
+}
+
 /* [] END OF FILE */
 
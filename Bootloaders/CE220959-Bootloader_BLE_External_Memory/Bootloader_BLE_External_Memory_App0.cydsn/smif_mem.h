@@ -44,6 +44,36 @@
 #define __SMIF_MEM_H
 
 #include <cy_smif_memconfig.h>
+
+/*******************************************************************************
+*            Conditional Compilation Parameters
+*******************************************************************************/
+/* Set to non-zero to time WriteMemoryLarge() with the CM4 cycle counter */
+#define SMIF_MEM_MEASURE_THROUGHPUT     (0u)
+
+/* Set to non-zero to let reads suspend a sector erase in progress */
+#define SMIF_MEM_ERASE_SUSPEND          (1u)
+
+/* Set to non-zero to build the memory commands from the SFDP tables at start-up */
+#define SMIF_MEM_SFDP_DISCOVERY         (0u)
+
+/* Set to non-zero to pick the fastest reliable read mode at start-up */
+#define SMIF_MEM_READ_CALIBRATION       (0u)
+
+/*******************************************************************************
+*            Data Types
+*******************************************************************************/
+/* Read modes of the S25FL512S, fastest first */
+typedef enum
+{
+    SMIF_READ_QUAD_IO = 0u,     /* 1-4-4, ECh */
+    SMIF_READ_QUAD_OUT,         /* 1-1-4, 6Ch */
+    SMIF_READ_DUAL_IO,          /* 1-2-2, BCh */
+    SMIF_READ_DUAL_OUT,         /* 1-1-2, 3Ch */
+    SMIF_READ_FAST,             /* 1-1-1, 0Ch */
+    SMIF_READ_NORMAL,           /* 1-1-1, 13h, up to 50 MHz */
+    SMIF_READ_MODE_COUNT
+} smif_read_mode_t;
     
 /*******************************************************************************
 *            Function Prototypes
@@ -54,6 +84,10 @@ void WriteMemory(
                     uint8_t txBuffer[], 	
                     uint32_t txSize, 	
                     uint32_t address);    	/* Program memory in the quad mode */
+void WriteMemoryLarge(
+                    uint8_t txBuffer[], 	
+                    uint32_t txSize, 	
+                    uint32_t address);    	/* Program any length, split at page borders */
 void ReadMemory(	
                     uint8_t rxBuffer[], 	
                     uint32_t rxSize, 	
@@ -63,16 +97,60 @@ void SwitchSMIFMemory(void);                /* Switch to XIP mode */
 
 void SwitchSMIFNormal(void);                /* Switch to Normal mode */
 
+void MarkSMIFModified(
+                    uint32_t address,
+                    uint32_t size);         /* Record a change for the next switch to XIP mode */
+
+uint32_t GetXIPInvalidateCount(uint32_t *keepCount); /* SMIF cache invalidations by SwitchSMIFMemory */
+
 void EraseSMIFChip(void);                   /* Bulk erase the chip */
 
 void EraseSMIFSector(uint32_t Address);     /* Erase a sector */
 
+void StartEraseSMIFSector(uint32_t Address); /* Start a sector erase, do not wait */
+
+bool IsSMIFEraseBusy(void);                 /* True while the started erase runs */
+
+#if (SMIF_MEM_ERASE_SUSPEND != 0u)
+uint32_t GetEraseReadLatency(uint32_t *maxLatency); /* Worst read latency during erase in us */
+
+void ResetEraseReadLatency(void);           /* Clear the erase read latency */
+#endif /* (SMIF_MEM_ERASE_SUSPEND != 0u) */
+
+#if (SMIF_MEM_MEASURE_THROUGHPUT != 0u)
+uint32_t GetWriteThroughput(void);          /* WriteMemoryLarge throughput in KB/s */
+
+void ResetWriteThroughput(void);            /* Clear and start the throughput counters */
+#endif /* (SMIF_MEM_MEASURE_THROUGHPUT != 0u) */
+
+void SetSMIFReadMode(
+                    smif_read_mode_t mode,
+                    uint32_t dummyCycles);  /* Select the read command for normal and XIP reads */
+
+smif_read_mode_t GetSMIFReadMode(uint32_t *dummyCycles); /* Read command in use */
+
+uint32_t GetSMIFReadModeDummyCycles(smif_read_mode_t mode); /* Dummy cycles at the default latency code */
+
+smif_read_mode_t CalibrateSMIFReadMode(
+                    uint32_t address,
+                    uint32_t spiClock);     /* Pick the fastest mode which reads a test pattern */
+
+void GetSMIFPointers(
+                    SMIF_Type **base,
+                    cy_stc_smif_context_t **context); /* Get the pointers set by configureSMIF */
+
 /*******************************************************************************
 *            Constants
 *******************************************************************************/
 
 #define TIMEOUT_1_MS        (1000ul)  /* 1 ms timeout for all blocking functions */
 
+#define SMIF_MEM_ERASE_RESUME_US (100u)   /* Minimum erase time between two suspends */
+
+#define SMIF_MEM_CALIB_ADDRESS  (0x03EC0000u) /* Test pattern, in the sector below the KV store */
+#define SMIF_MEM_CALIB_SIZE     (64u)         /* Bytes of the test pattern */
+#define SMIF_MEM_CALIB_MAX_DUMMY (15u)        /* Highest dummy cycle count tried */
+
 #endif /*__SMIF_MEM_H*/
     
 /* [] END OF FILE */
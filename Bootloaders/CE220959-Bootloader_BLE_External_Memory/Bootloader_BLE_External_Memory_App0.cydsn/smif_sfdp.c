@@ -0,0 +1,462 @@
+/******************************************************************************
+* File Name: smif_sfdp.c
+*
+* Version: 1.0
+*
+* Description: Functions in this file read the JEDEC SFDP tables of a serial
+*              memory and build the SMIF device configuration from them. The
+*              fastest read mode listed by the Basic Flash Parameter Table is
+*              used, together with the page size, the largest erase type and
+*              the Quad Enable method. ParseSFDP() works on an SFDP image in
+*              RAM only, so it can be checked against dumps of real parts.
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_sfdp.h"
+#include "project.h"
+
+/* SFDP header */
+#define SFDP_CMD_READ               (0x5Au)
+#define SFDP_DUMMY_CYCLES           (8u)
+#define SFDP_SIGNATURE              (0x50444653u)   /* "SFDP" */
+#define SFDP_HEADER_SIZE            (8u)
+
+/* Parameter table IDs */
+#define SFDP_ID_BASIC               (0xFF00u)       /* Basic Flash Parameter Table */
+#define SFDP_ID_4BYTE_ADDR          (0xFF84u)       /* 4-byte Address Instruction Table */
+
+/* Basic Flash Parameter Table limits in DWORDs */
+#define BFPT_MIN_DWORDS             (9u)
+#define BFPT_MAX_DWORDS             (16u)
+
+/* Commands not described by the tables */
+#define CMD_WRITE_ENABLE            (0x06u)
+#define CMD_WRITE_DISABLE           (0x04u)
+#define CMD_CHIP_ERASE              (0x60u)
+#define CMD_READ_STS_REG1           (0x05u)
+#define CMD_PAGE_PROGRAM            (0x02u)
+#define CMD_FAST_READ               (0x0Bu)
+
+/* Local functions */
+static uint32_t GetDword(const uint8_t data[], uint32_t offset);
+static bool FindTable(const uint8_t sfdp[], uint32_t size, uint32_t id, uint32_t *offset, uint32_t *dwords);
+static uint8_t FourByteOpcode(uint8_t opcode);
+static void SetCmd(cy_stc_smif_mem_cmd_t *cmd, uint8_t opcode, cy_en_smif_txfr_width_t addrWidth, 
+                   cy_en_smif_txfr_width_t dataWidth, uint32_t dummyCycles, uint32_t modeClocks);
+
+/*******************************************************************************
+* Function Name: GetDword
+********************************************************************************
+*
+* Returns a little-endian DWORD of the SFDP image.
+*
+*******************************************************************************/
+static uint32_t GetDword(const uint8_t data[], uint32_t offset)
+{
+    return ((uint32_t)data[offset]) | ((uint32_t)data[offset + 1u] << 8u) |
+           ((uint32_t)data[offset + 2u] << 16u) | ((uint32_t)data[offset + 3u] << 24u);
+}
+
+/*******************************************************************************
+* Function Name: FindTable
+********************************************************************************
+*
+* Looks up a parameter table by its ID in the parameter headers.
+*
+* \return
+* true if the table was found and lies inside the image.
+*******************************************************************************/
+static bool FindTable(const uint8_t sfdp[], uint32_t size, uint32_t id, uint32_t *offset, uint32_t *dwords)
+{
+    uint32_t headers = (uint32_t)sfdp[6u] + 1u;
+    uint32_t header;
+    uint32_t i;
+    
+    for(i = 0u; i < headers; i++)
+    {
+        header = SFDP_HEADER_SIZE + (i * SFDP_HEADER_SIZE);
+        if((header + SFDP_HEADER_SIZE) > size)
+        {
+            break;
+        }
+        
+        /* ID LSB in byte 0, ID MSB in byte 7 */
+        if((((uint32_t)sfdp[header + 7u] << 8u) | sfdp[header]) == id)
+        {
+            *dwords = sfdp[header + 3u];
+            *offset = GetDword(sfdp, header + 4u) & 0x00FFFFFFu;
+            return ((*offset + (*dwords * 4u)) <= size);
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: FourByteOpcode
+********************************************************************************
+*
+* Returns the 4-byte address variant of a 3-byte address opcode, for memories
+* which start in the 3-byte address mode. Quad page programs have no common
+* 3-byte opcode, they are taken from the 4-byte Address Instruction Table.
+*
+*******************************************************************************/
+static uint8_t FourByteOpcode(uint8_t opcode)
+{
+    switch(opcode)
+    {
+    case 0x03u: opcode = 0x13u; break;
+    case 0x0Bu: opcode = 0x0Cu; break;
+    case 0x3Bu: opcode = 0x3Cu; break;
+    case 0xBBu: opcode = 0xBCu; break;
+    case 0x6Bu: opcode = 0x6Cu; break;
+    case 0xEBu: opcode = 0xECu; break;
+    case 0x02u: opcode = 0x12u; break;
+    case 0x20u: opcode = 0x21u; break;
+    case 0x52u: opcode = 0x5Cu; break;
+    case 0xD8u: opcode = 0xDCu; break;
+    default: break;
+    }
+    return opcode;
+}
+
+/*******************************************************************************
+* Function Name: SetCmd
+********************************************************************************
+*
+* Fills a command structure. Mode clocks are sent as a mode byte of 0x00 if 
+* they match one byte on the address lines, otherwise they are added to the 
+* dummy cycles.
+*
+*******************************************************************************/
+static void SetCmd(cy_stc_smif_mem_cmd_t *cmd, uint8_t opcode, cy_en_smif_txfr_width_t addrWidth, 
+                   cy_en_smif_txfr_width_t dataWidth, uint32_t dummyCycles, uint32_t modeClocks)
+{
+    uint32_t byteClocks = (addrWidth == CY_SMIF_WIDTH_QUAD) ? 2u : ((addrWidth == CY_SMIF_WIDTH_DUAL) ? 4u : 8u);
+    
+    cmd->command = opcode;
+    cmd->cmdWidth = CY_SMIF_WIDTH_SINGLE;
+    cmd->addrWidth = addrWidth;
+    cmd->dataWidth = dataWidth;
+    
+    if((modeClocks != 0u) && (modeClocks == byteClocks))
+    {
+        /* Not Axh, so the memory does not enter the continuous read mode */
+        cmd->mode = 0x00u;
+        cmd->modeWidth = addrWidth;
+        cmd->dummyCycles = dummyCycles;
+    }
+    else
+    {
+        cmd->mode = 0xFFFFFFFFu;
+        cmd->modeWidth = CY_SMIF_WIDTH_SINGLE;
+        cmd->dummyCycles = dummyCycles + modeClocks;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ParseSFDP
+********************************************************************************
+*
+* This function parses an SFDP image and fills a device configuration. The
+* command structures pointed to by cfg are overwritten, so they must not be 
+* shared with another device. Values not described by the tables of an older 
+* JESD216 revision are left unchanged, except the page size which defaults to
+* 256 bytes.
+*
+* \param sfdp
+* SFDP image, starting at SFDP address 0.
+*
+* \param size
+* Size of the image in bytes.
+*
+* \param cfg
+* Device configuration to fill.
+*
+* \return
+* true if a valid Basic Flash Parameter Table was found.
+*******************************************************************************/
+bool ParseSFDP(const uint8_t sfdp[], uint32_t size, cy_stc_smif_mem_device_cfg_t *cfg)
+{
+    uint32_t bfpt[BFPT_MAX_DWORDS] = {0u};
+    uint32_t offset;
+    uint32_t dwords;
+    uint32_t i;
+    uint32_t addrMode;
+    uint32_t value;
+    uint32_t unit;
+    uint32_t eraseExp = 0u;
+    uint32_t eraseType = 0u;
+    uint32_t programOpcode = CMD_PAGE_PROGRAM;
+    cy_en_smif_txfr_width_t programAddrWidth = CY_SMIF_WIDTH_SINGLE;
+    cy_en_smif_txfr_width_t programDataWidth = CY_SMIF_WIDTH_SINGLE;
+    bool fourByteOpcodes;
+    bool fourByteProgram = false;
+    bool fourByteErase = false;
+    
+    if((size < (2u * SFDP_HEADER_SIZE)) || (GetDword(sfdp, 0u) != SFDP_SIGNATURE))
+    {
+        return false;
+    }
+    if((!FindTable(sfdp, size, SFDP_ID_BASIC, &offset, &dwords)) || (dwords < BFPT_MIN_DWORDS))
+    {
+        return false;
+    }
+    if(dwords > BFPT_MAX_DWORDS)
+    {
+        dwords = BFPT_MAX_DWORDS;
+    }
+    for(i = 0u; i < dwords; i++)
+    {
+        bfpt[i] = GetDword(sfdp, offset + (i * 4u));
+    }
+    
+    /* 2nd DWORD: density in bits */
+    if((bfpt[1] & 0x80000000u) != 0u)
+    {
+        cfg->memSize = 1uL << ((bfpt[1] & 0x7FFFFFFFu) - 3u);
+    }
+    else
+    {
+        cfg->memSize = (bfpt[1] + 1u) / 8u;
+    }
+    
+    /* 1st DWORD: address bytes, 0 - 3 only, 1 - 3 or 4, 2 - 4 only */
+    addrMode = (bfpt[0] >> 17u) & 0x03u;
+    cfg->numOfAddrBytes = ((addrMode == 2u) || ((addrMode == 1u) && (cfg->memSize > 0x1000000u))) ? 4u : 3u;
+    fourByteOpcodes = (addrMode == 1u) && (cfg->numOfAddrBytes == 4u);
+    
+    /* Fastest read mode: 1-4-4, 1-1-4, 1-2-2, 1-1-2, then Fast Read */
+    if((bfpt[0] & (1uL << 21u)) != 0u)
+    {
+        SetCmd(cfg->readCmd, (uint8_t)(bfpt[2] >> 8u), CY_SMIF_WIDTH_QUAD, CY_SMIF_WIDTH_QUAD, 
+               bfpt[2] & 0x1Fu, (bfpt[2] >> 5u) & 0x07u);
+    }
+    else if((bfpt[0] & (1uL << 22u)) != 0u)
+    {
+        SetCmd(cfg->readCmd, (uint8_t)(bfpt[2] >> 24u), CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_QUAD, 
+               (bfpt[2] >> 16u) & 0x1Fu, (bfpt[2] >> 21u) & 0x07u);
+    }
+    else if((bfpt[0] & (1uL << 20u)) != 0u)
+    {
+        SetCmd(cfg->readCmd, (uint8_t)(bfpt[3] >> 24u), CY_SMIF_WIDTH_DUAL, CY_SMIF_WIDTH_DUAL, 
+               (bfpt[3] >> 16u) & 0x1Fu, (bfpt[3] >> 21u) & 0x07u);
+    }
+    else if((bfpt[0] & (1uL << 16u)) != 0u)
+    {
+        SetCmd(cfg->readCmd, (uint8_t)(bfpt[3] >> 8u), CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_DUAL, 
+               bfpt[3] & 0x1Fu, (bfpt[3] >> 5u) & 0x07u);
+    }
+    else
+    {
+        SetCmd(cfg->readCmd, CMD_FAST_READ, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 8u, 0u);
+    }
+    
+    /* 8th and 9th DWORDs: erase types, the largest one is used */
+    for(i = 0u; i < 4u; i++)
+    {
+        value = (bfpt[7u + (i / 2u)] >> ((i % 2u) * 16u)) & 0xFFFFu;
+        if(((value & 0xFFu) != 0u) && ((value & 0xFFu) > eraseExp))
+        {
+            eraseExp = value & 0xFFu;
+            eraseType = i;
+            SetCmd(cfg->eraseCmd, (uint8_t)(value >> 8u), CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+        }
+    }
+    if(eraseExp != 0u)
+    {
+        cfg->eraseSize = 1uL << eraseExp;
+    }
+    
+    /* 10th DWORD: typical erase times and the multiplier to the maximum */
+    if(dwords >= 10u)
+    {
+        value = (bfpt[9] >> (4u + (eraseType * 7u))) & 0x7Fu;
+        unit = ((value >> 5u) == 0u) ? 1u : (((value >> 5u) == 1u) ? 16u : (((value >> 5u) == 2u) ? 128u : 1000u));
+        cfg->eraseTime = 2u * ((bfpt[9] & 0x0Fu) + 1u) * (((value & 0x1Fu) + 1u) * unit);
+    }
+    
+    /* 11th DWORD: page size, program and chip erase times */
+    cfg->programSize = 256u;
+    if(dwords >= 11u)
+    {
+        cfg->programSize = 1uL << ((bfpt[10] >> 4u) & 0x0Fu);
+        
+        unit = ((bfpt[10] & (1uL << 13u)) != 0u) ? 64u : 8u;
+        cfg->programTime = 2u * ((bfpt[10] & 0x0Fu) + 1u) * ((((bfpt[10] >> 8u) & 0x1Fu) + 1u) * unit);
+        
+        value = (bfpt[10] >> 29u) & 0x03u;
+        unit = (value == 0u) ? 16u : ((value == 1u) ? 256u : ((value == 2u) ? 4000u : 64000u));
+        cfg->chipEraseTime = 2u * ((bfpt[10] & 0x0Fu) + 1u) * ((((bfpt[10] >> 24u) & 0x1Fu) + 1u) * unit);
+    }
+    
+    /* 15th DWORD: Quad Enable requirements */
+    if(dwords >= 15u)
+    {
+        switch((bfpt[14] >> 20u) & 0x07u)
+        {
+        case 0u:    /* No QE bit */
+            SetCmd(cfg->readStsRegQeCmd, CMD_READ_STS_REG1, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+            SetCmd(cfg->writeStsRegQeCmd, 0x01u, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+            cfg->stsRegQuadEnableMask = 0x00u;
+            break;
+        case 2u:    /* Bit 6 of status register 1 */
+            SetCmd(cfg->readStsRegQeCmd, CMD_READ_STS_REG1, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+            SetCmd(cfg->writeStsRegQeCmd, 0x01u, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+            cfg->stsRegQuadEnableMask = 0x40u;
+            break;
+        case 3u:    /* Bit 7 of status register 2, own read and write commands */
+            SetCmd(cfg->readStsRegQeCmd, 0x3Fu, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+            SetCmd(cfg->writeStsRegQeCmd, 0x3Eu, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+            cfg->stsRegQuadEnableMask = 0x80u;
+            break;
+        case 6u:    /* Bit 1 of status register 2, written by 31h */
+            SetCmd(cfg->readStsRegQeCmd, 0x35u, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+            SetCmd(cfg->writeStsRegQeCmd, 0x31u, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+            cfg->stsRegQuadEnableMask = 0x02u;
+            break;
+        default:    /* Bit 1 of status register 2, written by 01h */
+            SetCmd(cfg->readStsRegQeCmd, 0x35u, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+            SetCmd(cfg->writeStsRegQeCmd, 0x01u, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+            cfg->stsRegQuadEnableMask = 0x02u;
+            break;
+        }
+    }
+    
+    /* 4-byte Address Instruction Table: 4-byte opcodes of quad page programs and erases */
+    if((cfg->numOfAddrBytes == 4u) && FindTable(sfdp, size, SFDP_ID_4BYTE_ADDR, &offset, &dwords) && (dwords >= 1u))
+    {
+        value = GetDword(sfdp, offset);
+        if((value & (1uL << 8u)) != 0u)
+        {
+            /* 1-4-4 page program */
+            programOpcode = 0x3Eu;
+            programAddrWidth = CY_SMIF_WIDTH_QUAD;
+            programDataWidth = CY_SMIF_WIDTH_QUAD;
+            fourByteProgram = true;
+        }
+        else if((value & (1uL << 7u)) != 0u)
+        {
+            /* 1-1-4 page program */
+            programOpcode = 0x34u;
+            programDataWidth = CY_SMIF_WIDTH_QUAD;
+            fourByteProgram = true;
+        }
+        else if((value & (1uL << 6u)) != 0u)
+        {
+            programOpcode = 0x12u;
+            fourByteProgram = true;
+        }
+        else
+        {
+            /* 3-byte opcode, converted below */
+        }
+        
+        /* 2nd DWORD: 4-byte opcode of each erase type supported by bits 9 to 12 */
+        if((eraseExp != 0u) && (dwords >= 2u) && ((value & (1uL << (9u + eraseType))) != 0u))
+        {
+            cfg->eraseCmd->command = (GetDword(sfdp, offset + 4u) >> (eraseType * 8u)) & 0xFFu;
+            fourByteErase = true;
+        }
+    }
+    SetCmd(cfg->programCmd, (uint8_t)programOpcode, programAddrWidth, programDataWidth, 0u, 0u);
+    
+    if(fourByteOpcodes)
+    {
+        cfg->readCmd->command = FourByteOpcode((uint8_t)cfg->readCmd->command);
+        if(!fourByteProgram)
+        {
+            cfg->programCmd->command = FourByteOpcode((uint8_t)cfg->programCmd->command);
+        }
+        if(!fourByteErase)
+        {
+            cfg->eraseCmd->command = FourByteOpcode((uint8_t)cfg->eraseCmd->command);
+        }
+    }
+    
+    /* Commands common to all memories */
+    SetCmd(cfg->writeEnCmd, CMD_WRITE_ENABLE, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+    SetCmd(cfg->writeDisCmd, CMD_WRITE_DISABLE, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+    SetCmd(cfg->chipEraseCmd, CMD_CHIP_ERASE, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+    SetCmd(cfg->readStsRegWipCmd, CMD_READ_STS_REG1, CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, 0u, 0u);
+    cfg->stsRegBusyMask = 0x01u;
+    
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: DiscoverSFDP
+********************************************************************************
+*
+* This function reads the SFDP space of a memory with the Read SFDP command
+* (5Ah, 3-byte address, 8 dummy cycles) and parses it into a device 
+* configuration. The configuration is not changed if the memory has no SFDP.
+* The SMIF must be enabled and in the normal mode.
+*
+* \param base
+*  pointer to the SMIF hardware.
+*
+* \param context
+* pointer to the SMIF context configuration.
+*
+* \param slaveSelect
+* Slave select of the memory.
+*
+* \param cfg
+* Device configuration to fill.
+*
+* \return
+* true if the configuration was filled from the SFDP tables.
+*******************************************************************************/
+bool DiscoverSFDP(SMIF_Type *base, cy_stc_smif_context_t *context, cy_en_smif_slave_select_t slaveSelect, 
+                  cy_stc_smif_mem_device_cfg_t *cfg)
+{
+    CY_ALIGN(4) static uint8_t sfdp[SFDP_READ_SIZE];
+    const uint8_t address[3u] = {0x00u, 0x00u, 0x00u};
+    cy_en_smif_status_t smif_status;
+    
+    smif_status = Cy_SMIF_TransmitCommand(base, SFDP_CMD_READ, CY_SMIF_WIDTH_SINGLE, address, sizeof(address), 
+                                          CY_SMIF_WIDTH_SINGLE, slaveSelect, CY_SMIF_TX_NOT_LAST_BYTE, context);
+    if(smif_status == CY_SMIF_SUCCESS)
+    {
+        smif_status = Cy_SMIF_SendDummyCycles(base, SFDP_DUMMY_CYCLES);
+    }
+    if(smif_status == CY_SMIF_SUCCESS)
+    {
+        smif_status = Cy_SMIF_ReceiveDataBlocking(base, sfdp, SFDP_READ_SIZE, CY_SMIF_WIDTH_SINGLE, context);
+    }
+    
+    return ((smif_status == CY_SMIF_SUCCESS) && ParseSFDP(sfdp, SFDP_READ_SIZE, cfg));
+}
+
+/* [] END OF FILE */
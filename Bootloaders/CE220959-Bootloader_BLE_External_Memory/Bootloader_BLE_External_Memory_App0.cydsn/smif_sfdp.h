@@ -0,0 +1,72 @@
+/******************************************************************************
+* File Name: smif_sfdp.h
+*
+* Version: 1.0
+*
+* Description: This header file contains the defines for the JEDEC SFDP
+*              (JESD216) discovery of the external memory command set.
+*
+* Related Document: CE220959.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef __SMIF_SFDP_H
+#define __SMIF_SFDP_H
+
+#include <stdbool.h>
+#include <cy_smif_memconfig.h>
+
+/*******************************************************************************
+*            Function Prototypes
+*******************************************************************************/
+bool ParseSFDP(
+                    const uint8_t sfdp[],
+                    uint32_t size,
+                    cy_stc_smif_mem_device_cfg_t *cfg); /* Fill a device configuration from an SFDP image */
+
+bool DiscoverSFDP(
+                    SMIF_Type *base,
+                    cy_stc_smif_context_t *context,
+                    cy_en_smif_slave_select_t slaveSelect,
+                    cy_stc_smif_mem_device_cfg_t *cfg); /* Read the SFDP of a memory and parse it */
+
+/*******************************************************************************
+*            Constants
+*******************************************************************************/
+
+#define SFDP_READ_SIZE      (256u)      /* Bytes of the SFDP space read by DiscoverSFDP */
+
+#endif /*__SMIF_SFDP_H*/
+    
+/* [] END OF FILE */
@@ -0,0 +1,116 @@
+/******************************************************************************
+* File Name: cy_bootload.h
+*
+* Version: 1.0
+*
+* Description: Host declarations of the Bootloader SDK used by bootload_user.c.
+*              The SDK functions bootload_user.c calls are implemented by the
+*              test. The addresses of the linker script symbols are not
+*              constants on a 64-bit host: built with CY_DOXYGEN,
+*              bootload_user.h skips them and they are given here with the
+*              values of bootload_common.ld.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef CY_BOOTLOAD_H
+#define CY_BOOTLOAD_H
+
+#include <stdint.h>
+#include "syslib/cy_syslib.h"
+#include "flash/cy_flash.h"
+
+/* Application formats */
+#define CY_BOOTLOAD_BASIC_APP           (0u)
+#define CY_BOOTLOAD_SIMPLIFIED_APP      (1u)
+
+/* Secondary application verification types */
+#define CY_BOOTLOAD_VERIFY_FAST         (0u)
+
+#include "bootload_user.h"
+
+/* Application ranges of bootload_common.ld */
+#define CY_BOOTLOAD_APP0_VERIFY_START   (0x10000000u)
+#define CY_BOOTLOAD_APP0_VERIFY_LENGTH  (0x00040000u - CY_BOOTLOAD_SIGNATURE_SIZE)
+#define CY_BOOTLOAD_APP1_VERIFY_START   (0x10040000u)
+#define CY_BOOTLOAD_APP1_VERIFY_LENGTH  (0x00034000u - CY_BOOTLOAD_SIGNATURE_SIZE)
+#define CY_BOOTLOAD_SIGNATURE_SIZE      (4u)
+
+/* Flags of Cy_Bootload_ReadData() and Cy_Bootload_WriteData() */
+#define CY_BOOTLOAD_IOCTL_COMPARE       (0x01u)
+#define CY_BOOTLOAD_IOCTL_ERASE         (0x02u)
+
+/* Status codes */
+typedef enum
+{
+    CY_BOOTLOAD_SUCCESS = 0x00u,
+    CY_BOOTLOAD_ERROR_VERIFY = 0x02u,
+    CY_BOOTLOAD_ERROR_LENGTH = 0x03u,
+    CY_BOOTLOAD_ERROR_DATA = 0x04u,
+    CY_BOOTLOAD_ERROR_CMD = 0x05u,
+    CY_BOOTLOAD_ERROR_CHECKSUM = 0x08u,
+    CY_BOOTLOAD_ERROR_ADDRESS = 0x0Au,
+    CY_BOOTLOAD_ERROR_TIMEOUT = 0x0Du,
+    CY_BOOTLOAD_ERROR_UNKNOWN = 0x0Fu
+} cy_en_bootload_status_t;
+
+/* Bootloader parameters, the fields bootload_user.c uses */
+typedef struct
+{
+    uint32_t timeout;
+    uint8_t *dataBuffer;
+    uint32_t dataOffset;
+    uint8_t *packetBuffer;
+    uint32_t appId;
+} cy_stc_bootload_params_t;
+
+/* Bootloader SDK metadata row, the addresses are the values */
+#define __cy_boot_metadata_addr         (*(uint8_t *)(uintptr_t)0x100FFA00u)
+#define __cy_boot_metadata_length       (*(uint8_t *)(uintptr_t)0x00000200u)
+
+cy_en_bootload_status_t Cy_Bootload_GetAppMetadata(uint32_t appId, uint32_t *verifyAddress, uint32_t *verifySize);
+uint32_t Cy_Bootload_GetRunningApp(void);
+uint32_t Cy_Bootload_DataChecksum(const uint8_t *address, uint32_t length, cy_stc_bootload_params_t *params);
+
+/* Implemented by bootload_user.c */
+cy_en_bootload_status_t Cy_Bootload_WriteData(uint32_t address, uint32_t length, uint32_t ctl,
+                                              cy_stc_bootload_params_t *params);
+cy_en_bootload_status_t Cy_Bootload_ReadData(uint32_t address, uint32_t length, uint32_t ctl,
+                                             cy_stc_bootload_params_t *params);
+cy_en_bootload_status_t Cy_Bootload_ValidateApp(uint32_t appId, cy_stc_bootload_params_t *params);
+cy_en_bootload_status_t EraseExternalApp(void);
+
+#endif /* CY_BOOTLOAD_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,56 @@
+/******************************************************************************
+* File Name: cy_device_headers.h
+*
+* Version: 1.0
+*
+* Description: Host replacement of the device header, the memory map of the
+*              PSoC 63 used by the bootloader functions of App0.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef CY_DEVICE_HEADERS_H
+#define CY_DEVICE_HEADERS_H
+
+/* Address ranges of the flash, the emulated EEPROM and the XIP window */
+#define CY_FLASH_BASE                   (0x10000000UL)
+#define CY_FLASH_SIZE                   (0x00100000UL)
+#define CY_EM_EEPROM_BASE               (0x14000000UL)
+#define CY_EM_EEPROM_SIZE               (0x00008000UL)
+#define CY_XIP_BASE                     (0x18000000UL)
+#define CY_XIP_SIZE                     (0x08000000UL)
+
+#endif /* CY_DEVICE_HEADERS_H */
+
+
+/* [] END OF FILE */
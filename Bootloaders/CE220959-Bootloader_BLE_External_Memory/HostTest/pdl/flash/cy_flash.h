@@ -0,0 +1,64 @@
+/******************************************************************************
+* File Name: cy_flash.h
+*
+* Version: 1.0
+*
+* Description: Host declarations of the PDL flash driver used by
+*              bootload_user.c. Cy_Flash_WriteRow() is implemented by the test.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef CY_FLASH_H
+#define CY_FLASH_H
+
+#include <stdint.h>
+#include "cy_device_headers.h"
+
+#define CY_FLASH_SIZEOF_ROW             (512u)
+
+/* Driver status */
+typedef enum
+{
+    CY_FLASH_DRV_SUCCESS = 0u,
+    CY_FLASH_DRV_INV_PROT,
+    CY_FLASH_DRV_INVALID_INPUT_PARAMETERS,
+    CY_FLASH_DRV_ERR_UNC
+} cy_en_flashdrv_status_t;
+
+cy_en_flashdrv_status_t Cy_Flash_WriteRow(uint32_t rowAddr, const uint32_t *data);
+
+#endif /* CY_FLASH_H */
+
+
+/* [] END OF FILE */
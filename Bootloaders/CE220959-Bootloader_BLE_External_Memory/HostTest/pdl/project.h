@@ -0,0 +1,113 @@
+/******************************************************************************
+* File Name: project.h
+*
+* Version: 1.0
+*
+* Description: Host replacement of the generated project.h, for building
+*              the SMIF helpers of App0 on a PC. The functions are
+*              implemented by s25fl512s_sim.c.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef PROJECT_H
+#define PROJECT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "smif/cy_smif_memslot.h"
+
+#define CY_ALIGN(align)                 __attribute__((aligned(align)))
+
+/*******************************************************************************
+*            Core and system functions
+*******************************************************************************/
+/* CPU clock of the simulated CM4 */
+extern uint32_t SystemCoreClock;
+
+/* The cycle counter follows the simulated time, every access takes a CPU step */
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+DWT_Type *SimDwt(void);
+extern CoreDebug_Type simCoreDebug;
+
+#define DWT                             (SimDwt())
+#define CoreDebug                       (&simCoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk          (1uL)
+#define CoreDebug_DEMCR_TRCENA_Msk      (1uL << 24u)
+
+uint32_t __REV(uint32_t value);
+void __disable_irq(void);               /* Only called by fatal error handlers, aborts */
+
+typedef int IRQn_Type;
+void NVIC_EnableIRQ(IRQn_Type irq);
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+typedef void (*cy_israddress)(void);
+void Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr);
+
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+void Cy_SysLib_DelayUs(uint16_t microseconds);
+uint32_t Cy_SysClk_ClkHfGetFrequency(uint32_t clkHf);
+
+/*******************************************************************************
+*            SMIF component
+*******************************************************************************/
+extern cy_stc_smif_config_t SMIF_config;
+extern cy_stc_sysint_t SMIF_SMIF_IRQ_cfg;
+void SMIF_Interrupt(void);
+
+#define SMIF_SMIF_INTR_MASK             (0u)
+#define SMIF_TX_FIFO_TRIGEER_LEVEL      (0u)
+#define SMIF_RX_FIFO_TRIGEER_LEVEL      (0u)
+
+#endif /* PROJECT_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,244 @@
+/******************************************************************************
+* File Name: cy_smif_memslot.h
+*
+* Version: 1.0
+*
+* Description: Host declarations of the PDL SMIF types and the driver
+*              functions used by the SMIF helpers of App0. Only what the
+*              helpers use is declared; the fields match the PDL.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef CY_SMIF_MEMSLOT_H
+#define CY_SMIF_MEMSLOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*            PDL types used by the SMIF helpers
+*******************************************************************************/
+
+/* Driver status */
+typedef enum
+{
+    CY_SMIF_SUCCESS = 0u,
+    CY_SMIF_CMD_FIFO_FULL,
+    CY_SMIF_EXCEED_TIMEOUT,
+    CY_SMIF_NO_QE_BIT,
+    CY_SMIF_BAD_PARAM,
+    CY_SMIF_NO_SFDP_SUPPORT
+} cy_en_smif_status_t;
+
+/* Number of data lines of a command phase */
+typedef enum
+{
+    CY_SMIF_WIDTH_SINGLE = 0u,
+    CY_SMIF_WIDTH_DUAL,
+    CY_SMIF_WIDTH_QUAD,
+    CY_SMIF_WIDTH_OCTAL
+} cy_en_smif_txfr_width_t;
+
+typedef enum
+{
+    CY_SMIF_SLAVE_SELECT_0 = 1u,
+    CY_SMIF_SLAVE_SELECT_1 = 2u,
+    CY_SMIF_SLAVE_SELECT_2 = 4u,
+    CY_SMIF_SLAVE_SELECT_3 = 8u
+} cy_en_smif_slave_select_t;
+
+typedef enum
+{
+    CY_SMIF_DATA_SEL0 = 0u,
+    CY_SMIF_DATA_SEL1,
+    CY_SMIF_DATA_SEL2,
+    CY_SMIF_DATA_SEL3
+} cy_en_smif_data_select_t;
+
+typedef enum
+{
+    CY_SMIF_NORMAL = 0u,
+    CY_SMIF_MEMORY
+} cy_en_smif_mode_t;
+
+typedef enum
+{
+    CY_SMIF_CACHE_SLOW = 0u,
+    CY_SMIF_CACHE_FAST,
+    CY_SMIF_CACHE_BOTH
+} cy_en_smif_cache_en_t;
+
+/* The host has no SMIF block, the shim keeps its state elsewhere */
+typedef struct
+{
+    uint32_t mode;
+} SMIF_Type;
+
+typedef struct
+{
+    volatile uint32_t transferStatus;
+} cy_stc_smif_context_t;
+
+typedef void (*cy_smif_event_cb_t)(uint32_t event);
+
+typedef struct
+{
+    uint32_t command;
+    cy_en_smif_txfr_width_t cmdWidth;
+    cy_en_smif_txfr_width_t addrWidth;
+    uint32_t mode;
+    cy_en_smif_txfr_width_t modeWidth;
+    uint32_t dummyCycles;
+    cy_en_smif_txfr_width_t dataWidth;
+} cy_stc_smif_mem_cmd_t;
+
+typedef struct
+{
+    uint32_t numOfAddrBytes;
+    uint32_t memSize;
+    cy_stc_smif_mem_cmd_t* readCmd;
+    cy_stc_smif_mem_cmd_t* writeEnCmd;
+    cy_stc_smif_mem_cmd_t* writeDisCmd;
+    cy_stc_smif_mem_cmd_t* eraseCmd;
+    uint32_t eraseSize;
+    cy_stc_smif_mem_cmd_t* chipEraseCmd;
+    cy_stc_smif_mem_cmd_t* programCmd;
+    uint32_t programSize;
+    cy_stc_smif_mem_cmd_t* readStsRegQeCmd;
+    cy_stc_smif_mem_cmd_t* readStsRegWipCmd;
+    cy_stc_smif_mem_cmd_t* writeStsRegQeCmd;
+    uint32_t stsRegBusyMask;
+    uint32_t stsRegQuadEnableMask;
+    uint32_t eraseTime;
+    uint32_t chipEraseTime;
+    uint32_t programTime;
+} cy_stc_smif_mem_device_cfg_t;
+
+typedef struct
+{
+    cy_en_smif_slave_select_t slaveSelect;
+    uint32_t flags;
+    cy_en_smif_data_select_t dataSelect;
+    uint32_t baseAddress;
+    uint32_t memMappedSize;
+    uint32_t dualQuadSlots;
+    cy_stc_smif_mem_device_cfg_t* deviceCfg;
+} cy_stc_smif_mem_config_t;
+
+/* Block configuration of the SMIF component, not used by the shim */
+typedef struct
+{
+    uint32_t mode;
+    uint32_t deselectDelay;
+    uint32_t rxClockSel;
+    uint32_t blockEvent;
+} cy_stc_smif_config_t;
+
+typedef struct
+{
+    uint32_t memCount;
+    cy_stc_smif_mem_config_t** memConfig;
+    uint32_t majorVersion;
+    uint32_t minorVersion;
+} cy_stc_smif_block_config_t;
+
+#define CY_SMIF_DRV_VERSION_MAJOR       (1)
+#define CY_SMIF_DRV_VERSION_MINOR       (10)
+
+#define CY_SMIF_FLAG_MEMORY_MAPPED      (1u)
+#define CY_SMIF_FLAG_WR_EN              (2u)
+
+/* Events passed to the completion callbacks */
+#define CY_SMIF_SEND_CMPLT              (1u)
+#define CY_SMIF_REC_CMPLT               (3u)
+
+#define CY_SMIF_TX_NOT_LAST_BYTE        (0u)
+#define CY_SMIF_TX_LAST_BYTE            (1u)
+
+/*******************************************************************************
+*            PDL functions used by the SMIF helpers
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Init(SMIF_Type *base, cy_stc_smif_config_t const *config, uint32_t timeout,
+                                 cy_stc_smif_context_t *context);
+void Cy_SMIF_Enable(SMIF_Type *base, cy_stc_smif_context_t *context);
+void Cy_SMIF_Disable(SMIF_Type *base);
+void Cy_SMIF_SetInterruptMask(SMIF_Type *base, uint32_t interrupt);
+void Cy_SMIF_SetTxFifoTriggerLevel(SMIF_Type *base, uint32_t level);
+void Cy_SMIF_SetRxFifoTriggerLevel(SMIF_Type *base, uint32_t level);
+void Cy_SMIF_SetDataSelect(SMIF_Type *base, cy_en_smif_slave_select_t slaveSelect,
+                           cy_en_smif_data_select_t dataSelect);
+void Cy_SMIF_SetMode(SMIF_Type *base, cy_en_smif_mode_t mode);
+bool Cy_SMIF_BusyCheck(SMIF_Type const *base);
+cy_en_smif_status_t Cy_SMIF_CacheEnable(SMIF_Type *base, cy_en_smif_cache_en_t cacheType);
+cy_en_smif_status_t Cy_SMIF_CacheDisable(SMIF_Type *base, cy_en_smif_cache_en_t cacheType);
+cy_en_smif_status_t Cy_SMIF_CachePrefetchingEnable(SMIF_Type *base, cy_en_smif_cache_en_t cacheType);
+cy_en_smif_status_t Cy_SMIF_CacheInvalidate(SMIF_Type *base, cy_en_smif_cache_en_t cacheType);
+
+cy_en_smif_status_t Cy_SMIF_Memslot_Init(SMIF_Type *base, cy_stc_smif_block_config_t * const blockConfig,
+                                         cy_stc_smif_context_t *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdWriteEnable(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+                                                   cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdProgram(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+                                               uint8_t const *addr, uint8_t *writeBuff, uint32_t size,
+                                               cy_smif_event_cb_t cmdCmpltCb, cy_stc_smif_context_t *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdRead(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+                                            uint8_t const *addr, uint8_t *readBuff, uint32_t size,
+                                            cy_smif_event_cb_t cmdCmpltCb, cy_stc_smif_context_t *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdSectorErase(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+                                                   uint8_t const *sectorAddr, cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdChipErase(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+                                                 cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdReadSts(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+                                               uint8_t *status, uint8_t command,
+                                               cy_stc_smif_context_t const *context);
+bool Cy_SMIF_Memslot_IsBusy(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+                            cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_Memslot_QuadEnable(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+                                               cy_stc_smif_context_t const *context);
+
+cy_en_smif_status_t Cy_SMIF_TransmitCommand(SMIF_Type *base, uint8_t cmd, cy_en_smif_txfr_width_t cmdTxfrWidth,
+                                            uint8_t const cmdParam[], uint32_t paramSize,
+                                            cy_en_smif_txfr_width_t paramTxfrWidth,
+                                            cy_en_smif_slave_select_t slaveSelect, uint32_t completeTxfr,
+                                            cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_SendDummyCycles(SMIF_Type *base, uint32_t cycles);
+cy_en_smif_status_t Cy_SMIF_ReceiveDataBlocking(SMIF_Type *base, uint8_t *rxBuffer, uint32_t size,
+                                                cy_en_smif_txfr_width_t transferWidth,
+                                                cy_stc_smif_context_t const *context);
+
+#endif /* CY_SMIF_MEMSLOT_H */
+
+
+/* [] END OF FILE */
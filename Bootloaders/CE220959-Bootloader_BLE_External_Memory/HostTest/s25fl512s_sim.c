@@ -0,0 +1,1508 @@
+/******************************************************************************
+* File Name: s25fl512s_sim.c
+*
+* Version: 1.0
+*
+* Description: Host replacement of the SMIF driver, backed by a behavioral
+*              model of the S25FL512S. The Cy_SMIF_Memslot functions and the
+*              raw command functions are decoded into transactions on the
+*              model, which keeps SR1, SR2 and CR1, the 512-byte page buffer,
+*              256 KB sector and chip erase with suspend and resume, and the
+*              SFDP space. Every transaction advances a simulated clock by its
+*              SPI clocks, the program and erase times follow the datasheet
+*              and the CM4 cycle counter follows the simulated clock, so the
+*              busy loops of smif_mem.c run unmodified. Callbacks are called
+*              before the driver functions return. SimMapXip() maps the array
+*              behind the XIP window, readable in the memory mode only.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#define _GNU_SOURCE
+#include "s25fl512s_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*******************************************************************************
+*            Constants
+*******************************************************************************/
+#define SIM_CALL_NS             (1000u)         /* CPU time of a driver call */
+#define SIM_CPU_STEP_NS         (10u)           /* CPU time of a cycle counter read */
+#define SIM_SFDP_SIZE           (0x200u)
+#define SIM_NO_MODE             (0xFFFFFFFFu)
+
+/* Opcodes decoded outside of the opcode table */
+#define CMD_WRITE_REGS          (0x01u)
+#define CMD_WRITE_DISABLE       (0x04u)
+#define CMD_READ_SR1            (0x05u)
+#define CMD_WRITE_ENABLE        (0x06u)
+#define CMD_READ_SR2            (0x07u)
+#define CMD_CLEAR_SR            (0x30u)
+#define CMD_READ_CR1            (0x35u)
+#define CMD_READ_SFDP           (0x5Au)
+#define CMD_ERASE_SUSPEND       (0x75u)
+#define CMD_ERASE_RESUME        (0x7Au)
+
+#define SFDP_ADDR_BYTES         (3u)
+#define SFDP_DUMMY_CYCLES       (8u)
+
+/* CR1 bits kept by WRR */
+#define CR1_WRITE_MASK          (SIM_CR1_QUAD | (3u << SIM_CR1_LC_POS))
+
+/*******************************************************************************
+*            Data Types
+*******************************************************************************/
+typedef enum
+{
+    SIM_READ = 0u,
+    SIM_PROGRAM,
+    SIM_ERASE,
+    SIM_CHIP_ERASE
+} sim_class_t;
+
+/* Array commands of the S25FL512S */
+typedef struct
+{
+    uint8_t opcode;
+    sim_class_t cls;
+    uint8_t addrBytes;
+    uint8_t addrLines;
+    uint8_t dataLines;
+    uint8_t modeClocks;         /* Clocks of the mode byte */
+    uint8_t dummyCycles;        /* Dummy cycles at latency code 0 */
+    uint32_t maxClock;          /* Highest SPI clock in Hz */
+} sim_opcode_t;
+
+/* Operation which sets WIP */
+typedef enum
+{
+    SIM_OP_NONE = 0u,
+    SIM_OP_PROGRAM,
+    SIM_OP_WRITE_REGS
+} sim_op_t;
+
+typedef enum
+{
+    SIM_ERASE_NONE = 0u,
+    SIM_ERASE_RUNNING,
+    SIM_ERASE_SUSPENDING,
+    SIM_ERASE_SUSPENDED
+} sim_erase_t;
+
+/* One transaction on the bus, from CS low to CS high */
+typedef struct
+{
+    uint8_t cmd;
+    uint32_t cmdLines;
+    const uint8_t *addr;
+    uint32_t addrBytes;
+    uint32_t addrLines;
+    uint32_t latency;           /* Mode and dummy clocks */
+    uint8_t *data;
+    uint32_t size;
+    uint32_t dataLines;
+} sim_txn_t;
+
+static const sim_opcode_t opcodes[] =
+{
+    {0x03u, SIM_READ,       3u, 1u, 1u, 0u, 0u,  50000000u},
+    {0x13u, SIM_READ,       4u, 1u, 1u, 0u, 0u,  50000000u},
+    {0x0Bu, SIM_READ,       3u, 1u, 1u, 0u, 8u, 133000000u},
+    {0x0Cu, SIM_READ,       4u, 1u, 1u, 0u, 8u, 133000000u},
+    {0x3Bu, SIM_READ,       3u, 1u, 2u, 0u, 8u, 104000000u},
+    {0x3Cu, SIM_READ,       4u, 1u, 2u, 0u, 8u, 104000000u},
+    {0xBBu, SIM_READ,       3u, 2u, 2u, 4u, 0u, 104000000u},
+    {0xBCu, SIM_READ,       4u, 2u, 2u, 4u, 0u, 104000000u},
+    {0x6Bu, SIM_READ,       3u, 1u, 4u, 0u, 8u, 104000000u},
+    {0x6Cu, SIM_READ,       4u, 1u, 4u, 0u, 8u, 104000000u},
+    {0xEBu, SIM_READ,       3u, 4u, 4u, 2u, 4u, 104000000u},
+    {0xECu, SIM_READ,       4u, 4u, 4u, 2u, 4u, 104000000u},
+    {0x02u, SIM_PROGRAM,    3u, 1u, 1u, 0u, 0u, 133000000u},
+    {0x12u, SIM_PROGRAM,    4u, 1u, 1u, 0u, 0u, 133000000u},
+    {0x32u, SIM_PROGRAM,    3u, 1u, 4u, 0u, 0u, 104000000u},
+    {0x38u, SIM_PROGRAM,    3u, 1u, 4u, 0u, 0u, 104000000u},
+    {0x34u, SIM_PROGRAM,    4u, 1u, 4u, 0u, 0u, 104000000u},
+    {0xD8u, SIM_ERASE,      3u, 1u, 0u, 0u, 0u, 133000000u},
+    {0xDCu, SIM_ERASE,      4u, 1u, 0u, 0u, 0u, 133000000u},
+    {0x60u, SIM_CHIP_ERASE, 0u, 1u, 0u, 0u, 0u, 133000000u},
+    {0xC7u, SIM_CHIP_ERASE, 0u, 1u, 0u, 0u, 0u, 133000000u}
+};
+
+/*******************************************************************************
+*            Model state
+*******************************************************************************/
+static uint8_t *array;
+static int arrayFd = -1;            /* Shared with the XIP window */
+static bool xipMapped;
+static uint8_t sfdp[SIM_SFDP_SIZE];
+static uint32_t eraseCounts[SIM_SECTOR_COUNT];
+
+/* Registers, WIP is derived from the operations */
+static uint8_t sr1;
+static uint8_t sr2;
+static uint8_t cr1;
+static uint8_t newSr1;
+static uint8_t newCr1;
+
+static sim_op_t op;
+static uint64_t opEnd;
+
+static sim_erase_t erase;
+static bool eraseChip;
+static uint32_t eraseSector;
+static uint64_t eraseEnd;           /* Valid while running or suspending */
+static uint64_t eraseLeft;          /* Valid while suspended */
+static uint64_t suspendEnd;
+
+static uint64_t now;
+static uint32_t spiClock;
+static sim_stats_t stats;
+static uint32_t noise;
+
+/* Driver state */
+static bool smifEnabled;
+static cy_en_smif_mode_t smifMode;
+static bool xipValid;
+static cy_stc_smif_mem_cmd_t xipReadCmd;
+static uint32_t xipAddrBytes;
+static uint32_t xipMappedSize;
+
+/* Raw transaction opened by Cy_SMIF_TransmitCommand() */
+static bool rawOpen;
+static uint8_t rawCmd;
+static uint32_t rawCmdLines;
+static uint8_t rawParams[8u];
+static uint32_t rawParamSize;
+static uint32_t rawParamLines;
+static uint32_t rawDummy;
+
+/* Symbols of the generated sources */
+uint32_t SystemCoreClock = 100000000u;
+CoreDebug_Type simCoreDebug;
+cy_stc_smif_config_t SMIF_config;
+cy_stc_sysint_t SMIF_SMIF_IRQ_cfg = {0, 7u};
+static DWT_Type dwt;
+
+/*******************************************************************************
+* Function Name: Lines
+********************************************************************************
+*
+* Returns the number of data lines of a transfer width.
+*
+*******************************************************************************/
+static uint32_t Lines(cy_en_smif_txfr_width_t width)
+{
+    return 1uL << (uint32_t)width;
+}
+
+/*******************************************************************************
+* Function Name: FindOpcode
+********************************************************************************
+*
+* Returns the array command of an opcode, NULL if it is not one.
+*
+*******************************************************************************/
+static const sim_opcode_t *FindOpcode(uint8_t opcode)
+{
+    uint32_t i;
+    
+    for(i = 0u; i < (sizeof(opcodes) / sizeof(opcodes[0])); i++)
+    {
+        if(opcodes[i].opcode == opcode)
+        {
+            return &opcodes[i];
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: IsWip
+********************************************************************************
+*
+* Returns true while a program, register write or erase runs. A suspended
+* erase does not set WIP.
+*
+*******************************************************************************/
+static bool IsWip(void)
+{
+    return (op != SIM_OP_NONE) || (erase == SIM_ERASE_RUNNING) || (erase == SIM_ERASE_SUSPENDING);
+}
+
+/*******************************************************************************
+* Function Name: CompleteErase
+********************************************************************************
+*
+* Erases the sector or the chip at the end of the erase time.
+*
+*******************************************************************************/
+static void CompleteErase(void)
+{
+    uint32_t sector;
+    
+    if(eraseChip)
+    {
+        (void)memset(array, 0xFF, SIM_MEM_SIZE);
+        for(sector = 0u; sector < SIM_SECTOR_COUNT; sector++)
+        {
+            eraseCounts[sector]++;
+        }
+        stats.chipErases++;
+    }
+    else
+    {
+        (void)memset(&array[eraseSector * SIM_SECTOR_SIZE], 0xFF, SIM_SECTOR_SIZE);
+        eraseCounts[eraseSector]++;
+        stats.sectorErases++;
+    }
+    erase = SIM_ERASE_NONE;
+    sr2 &= (uint8_t)~SIM_SR2_ES;
+}
+
+/*******************************************************************************
+* Function Name: Update
+********************************************************************************
+*
+* Completes the operations whose time has passed.
+*
+*******************************************************************************/
+static void Update(void)
+{
+    if((op != SIM_OP_NONE) && (now >= opEnd))
+    {
+        if(op == SIM_OP_WRITE_REGS)
+        {
+            sr1 = (uint8_t)(newSr1 & ~(SIM_SR1_WIP | SIM_SR1_WEL));
+            cr1 = (uint8_t)(newCr1 & CR1_WRITE_MASK);
+        }
+        op = SIM_OP_NONE;
+    }
+    
+    if((erase == SIM_ERASE_SUSPENDING) && (suspendEnd < eraseEnd) && (now >= suspendEnd))
+    {
+        eraseLeft = eraseEnd - suspendEnd;
+        erase = SIM_ERASE_SUSPENDED;
+        sr2 |= SIM_SR2_ES;
+    }
+    else if(((erase == SIM_ERASE_RUNNING) || (erase == SIM_ERASE_SUSPENDING)) && (now >= eraseEnd))
+    {
+        CompleteErase();
+    }
+    else
+    {
+        /* Nothing completed */
+    }
+}
+
+/*******************************************************************************
+* Function Name: UpdateXipWindow
+********************************************************************************
+*
+* Makes the mapped range of the XIP window readable in the memory mode and
+* inaccessible otherwise, so a load outside of the memory mode faults as the
+* bus error of the device does. The memory must not be busy when the memory
+* mode is entered, XIP reads would return the status instead of the data.
+*
+*******************************************************************************/
+static void UpdateXipWindow(void)
+{
+    bool readable = smifEnabled && (smifMode == CY_SMIF_MEMORY) && xipValid;
+    
+    if(!xipMapped)
+    {
+        return;
+    }
+    
+    if(readable)
+    {
+        Update();
+        if(IsWip())
+        {
+            stats.driverErrors++;
+        }
+    }
+    
+    if(mprotect((void *)(uintptr_t)SIM_XIP_BASE, SIM_MEM_SIZE, PROT_NONE) != 0)
+    {
+        fprintf(stderr, "s25fl512s_sim: cannot protect the XIP window\n");
+        exit(1);
+    }
+    if(readable && (xipMappedSize != 0u) &&
+       (mprotect((void *)(uintptr_t)SIM_XIP_BASE, xipMappedSize, PROT_READ) != 0))
+    {
+        fprintf(stderr, "s25fl512s_sim: cannot map the XIP window\n");
+        exit(1);
+    }
+}
+
+/*******************************************************************************
+* Function Name: Advance
+********************************************************************************
+*
+* Moves the simulated clock and completes the operations which end.
+*
+*******************************************************************************/
+static void Advance(uint64_t ns)
+{
+    uint64_t wipEnd = now;
+    
+    if(op != SIM_OP_NONE)
+    {
+        wipEnd = opEnd;
+    }
+    else if(erase == SIM_ERASE_RUNNING)
+    {
+        wipEnd = eraseEnd;
+    }
+    else if(erase == SIM_ERASE_SUSPENDING)
+    {
+        wipEnd = (eraseEnd < suspendEnd) ? eraseEnd : suspendEnd;
+    }
+    else
+    {
+        /* Idle */
+    }
+    
+    if(wipEnd > now)
+    {
+        stats.busyNs += ((wipEnd - now) < ns) ? (wipEnd - now) : ns;
+    }
+    
+    now += ns;
+    Update();
+}
+
+/*******************************************************************************
+* Function Name: Transfer
+********************************************************************************
+*
+* Accounts a transaction of the given SPI clocks.
+*
+*******************************************************************************/
+static void Transfer(uint64_t clocks)
+{
+    stats.commands++;
+    stats.busClocks += clocks;
+    stats.busNs += ((clocks * 1000000000uLL) + spiClock - 1u) / spiClock;
+    Advance((((clocks * 1000000000uLL) + spiClock - 1u) / spiClock) + SIM_CALL_NS);
+}
+
+/*******************************************************************************
+* Function Name: GetAddress
+********************************************************************************
+*
+* Returns the address sent MSB first. Without the extended address mode the
+* 3-byte commands reach the lowest 16 MB.
+*
+*******************************************************************************/
+static uint32_t GetAddress(const uint8_t addr[], uint32_t addrBytes)
+{
+    uint32_t address = 0u;
+    uint32_t i;
+    
+    for(i = 0u; i < addrBytes; i++)
+    {
+        address = (address << 8u) | addr[i];
+    }
+    return address % SIM_MEM_SIZE;
+}
+
+/*******************************************************************************
+* Function Name: ShiftOut
+********************************************************************************
+*
+* Copies bytes of a data stream as sampled by the host. A positive shift is
+* the number of bits the host missed because it waited too long, a negative
+* one the number of bits sampled before the memory drove the lines, which
+* read as 1.
+*
+*******************************************************************************/
+static void ShiftOut(const uint8_t stream[], uint32_t streamSize, uint32_t start,
+                     int32_t shift, uint8_t data[], uint32_t size)
+{
+    uint32_t i;
+    uint32_t bit;
+    int64_t src;
+    uint8_t value;
+    
+    for(i = 0u; i < size; i++)
+    {
+        value = 0u;
+        for(bit = 0u; bit < 8u; bit++)
+        {
+            src = ((int64_t)i * 8) + bit + shift;
+            value <<= 1u;
+            if(src < 0)
+            {
+                value |= 1u;
+            }
+            else
+            {
+                value |= (uint8_t)((stream[(start + (uint32_t)(src / 8)) % streamSize] >> (7u - (uint32_t)(src % 8))) & 1u);
+            }
+        }
+        data[i] = value;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ReadArray
+********************************************************************************
+*
+* Returns the data of a read command. A latency which does not match the
+* command and latency code shifts the data, a clock above the rating of the
+* command shifts it by one bit. Quad commands read 1s while QE is clear, as
+* IO2 and IO3 are WP# and HOLD#. Data of a sector with a suspended erase is
+* undefined.
+*
+*******************************************************************************/
+static void ReadArray(const sim_opcode_t *opcode, uint32_t address, uint32_t latency, uint8_t data[], uint32_t size)
+{
+    uint32_t required = opcode->modeClocks + opcode->dummyCycles;
+    int32_t shift;
+    uint32_t i;
+    
+    if(required != 0u)
+    {
+        required += (uint32_t)(cr1 >> SIM_CR1_LC_POS);
+    }
+    shift = ((int32_t)latency - (int32_t)required) * (int32_t)opcode->dataLines;
+    
+    if(spiClock > opcode->maxClock)
+    {
+        shift++;
+    }
+    
+    if(((opcode->dataLines == 4u) && ((cr1 & SIM_CR1_QUAD) == 0u)) || (shift != 0))
+    {
+        stats.badReads++;
+    }
+    if((opcode->dataLines == 4u) && ((cr1 & SIM_CR1_QUAD) == 0u))
+    {
+        (void)memset(data, 0xFF, size);
+        return;
+    }
+    
+    ShiftOut(array, SIM_MEM_SIZE, address, shift, data, size);
+    
+    if(erase == SIM_ERASE_SUSPENDED)
+    {
+        for(i = 0u; i < size; i++)
+        {
+            if(eraseChip || ((((address + i) % SIM_MEM_SIZE) / SIM_SECTOR_SIZE) == eraseSector))
+            {
+                data[i] ^= 0x5Au;
+            }
+        }
+    }
+    
+    stats.reads++;
+    stats.bytesRead += size;
+}
+
+/*******************************************************************************
+* Function Name: ProgramArray
+********************************************************************************
+*
+* Loads the page buffer and programs it. The data wraps at the end of the 
+* page and can only clear bits. The memory sets WIP for the page program time.
+*
+*******************************************************************************/
+static void ProgramArray(const sim_opcode_t *opcode, uint32_t address, const uint8_t data[], uint32_t size)
+{
+    uint8_t page[SIM_PAGE_SIZE];
+    uint32_t pageStart = address & ~(SIM_PAGE_SIZE - 1u);
+    uint32_t i;
+    
+    if(((sr1 & SIM_SR1_WEL) == 0u) || 
+       ((opcode->dataLines == 4u) && ((cr1 & SIM_CR1_QUAD) == 0u)) ||
+       ((erase == SIM_ERASE_SUSPENDED) && (eraseChip || ((address / SIM_SECTOR_SIZE) == eraseSector))))
+    {
+        stats.ignored++;
+        return;
+    }
+    
+    (void)memset(page, 0xFF, sizeof(page));
+    for(i = 0u; i < size; i++)
+    {
+        page[(address + i) % SIM_PAGE_SIZE] = data[i];
+    }
+    for(i = 0u; i < SIM_PAGE_SIZE; i++)
+    {
+        array[pageStart + i] &= page[i];
+    }
+    
+    sr1 &= (uint8_t)~SIM_SR1_WEL;
+    op = SIM_OP_PROGRAM;
+    opEnd = now + SIM_PROGRAM_NS;
+    stats.pagePrograms++;
+    stats.bytesProgrammed += size;
+}
+
+/*******************************************************************************
+* Function Name: StartErase
+********************************************************************************
+*
+* Starts a sector or chip erase, the array is erased when the time has passed.
+*
+*******************************************************************************/
+static void StartErase(bool chip, uint32_t address)
+{
+    if(((sr1 & SIM_SR1_WEL) == 0u) || (erase != SIM_ERASE_NONE))
+    {
+        stats.ignored++;
+        return;
+    }
+    
+    sr1 &= (uint8_t)~SIM_SR1_WEL;
+    erase = SIM_ERASE_RUNNING;
+    eraseChip = chip;
+    eraseSector = address / SIM_SECTOR_SIZE;
+    eraseEnd = now + (chip ? SIM_CHIP_ERASE_NS : SIM_SECTOR_ERASE_NS);
+}
+
+/*******************************************************************************
+* Function Name: Execute
+********************************************************************************
+*
+* Decodes a transaction. While WIP is set the memory only takes the status
+* reads and the erase suspend, other commands are dropped and read as 1s.
+* WEL is cleared when a program, erase or register write is accepted; the
+* memory clears it at the end of the operation, which no driver here can tell
+* apart.
+*
+*******************************************************************************/
+static void Execute(const sim_txn_t *txn)
+{
+    const sim_opcode_t *opcode = FindOpcode(txn->cmd);
+    uint64_t clocks;
+    uint32_t address;
+    uint8_t value;
+    
+    clocks = (8u / txn->cmdLines) + ((txn->addrBytes * 8u) / txn->addrLines) + txn->latency + 
+             (((uint64_t)txn->size * 8u) / txn->dataLines);
+    Transfer(clocks);
+    
+    if(txn->cmdLines != 1u)
+    {
+        /* The memory has no QPI mode */
+        stats.badCommands++;
+        (void)memset(txn->data, 0xFF, txn->size);
+        return;
+    }
+    
+    switch(txn->cmd)
+    {
+        case CMD_READ_SR1:
+        case CMD_READ_SR2:
+        case CMD_READ_CR1:
+            value = (txn->cmd == CMD_READ_SR1) ? (uint8_t)(sr1 | (IsWip() ? SIM_SR1_WIP : 0u)) :
+                    ((txn->cmd == CMD_READ_SR2) ? sr2 : cr1);
+            (void)memset(txn->data, value, txn->size);
+            stats.statusReads++;
+            return;
+            
+        case CMD_ERASE_SUSPEND:
+            if((erase == SIM_ERASE_RUNNING) && (!eraseChip))
+            {
+                erase = SIM_ERASE_SUSPENDING;
+                suspendEnd = now + SIM_SUSPEND_NS;
+                stats.suspends++;
+            }
+            return;
+        
+        default:
+            break;
+    }
+    
+    if(IsWip())
+    {
+        stats.ignored++;
+        (void)memset(txn->data, 0xFF, txn->size);
+        return;
+    }
+    
+    switch(txn->cmd)
+    {
+        case CMD_WRITE_ENABLE:
+            sr1 |= SIM_SR1_WEL;
+            return;
+            
+        case CMD_WRITE_DISABLE:
+            sr1 &= (uint8_t)~SIM_SR1_WEL;
+            return;
+            
+        case CMD_CLEAR_SR:
+            return;
+            
+        case CMD_WRITE_REGS:
+            if(((sr1 & SIM_SR1_WEL) == 0u) || (txn->size == 0u))
+            {
+                stats.ignored++;
+                return;
+            }
+            newSr1 = txn->data[0];
+            newCr1 = (txn->size > 1u) ? txn->data[1] : cr1;
+            sr1 &= (uint8_t)~SIM_SR1_WEL;
+            op = SIM_OP_WRITE_REGS;
+            opEnd = now + SIM_WRITE_REG_NS;
+            return;
+            
+        case CMD_ERASE_RESUME:
+            if(erase == SIM_ERASE_SUSPENDED)
+            {
+                erase = SIM_ERASE_RUNNING;
+                eraseEnd = now + eraseLeft;
+                sr2 &= (uint8_t)~SIM_SR2_ES;
+                stats.resumes++;
+            }
+            return;
+            
+        case CMD_READ_SFDP:
+            if((txn->addrBytes != SFDP_ADDR_BYTES) || (txn->dataLines != 1u))
+            {
+                stats.badCommands++;
+                (void)memset(txn->data, 0xFF, txn->size);
+                return;
+            }
+            ShiftOut(sfdp, SIM_SFDP_SIZE, GetAddress(txn->addr, txn->addrBytes) % SIM_SFDP_SIZE,
+                     (int32_t)txn->latency - (int32_t)SFDP_DUMMY_CYCLES, txn->data, txn->size);
+            return;
+            
+        default:
+            break;
+    }
+    
+    if((opcode == NULL) || (txn->addrBytes != opcode->addrBytes) || (txn->addrLines != opcode->addrLines) ||
+       ((opcode->cls <= SIM_PROGRAM) && (txn->dataLines != opcode->dataLines)))
+    {
+        stats.badCommands++;
+        (void)memset(txn->data, 0xFF, txn->size);
+        return;
+    }
+    
+    address = GetAddress(txn->addr, txn->addrBytes);
+    switch(opcode->cls)
+    {
+        case SIM_READ:
+            ReadArray(opcode, address, txn->latency, txn->data, txn->size);
+            break;
+            
+        case SIM_PROGRAM:
+            ProgramArray(opcode, address, txn->data, txn->size);
+            break;
+            
+        case SIM_ERASE:
+            StartErase(false, address);
+            break;
+            
+        default:
+            StartErase(true, 0u);
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: CmdTxn
+********************************************************************************
+*
+* Builds a transaction from a command of the memory configuration.
+*
+*******************************************************************************/
+static void CmdTxn(sim_txn_t *txn, const cy_stc_smif_mem_cmd_t *cmd, const uint8_t addr[], uint32_t addrBytes,
+                   uint8_t data[], uint32_t size)
+{
+    txn->cmd = (uint8_t)cmd->command;
+    txn->cmdLines = Lines(cmd->cmdWidth);
+    txn->addr = addr;
+    txn->addrBytes = addrBytes;
+    txn->addrLines = Lines(cmd->addrWidth);
+    txn->latency = cmd->dummyCycles;
+    if(cmd->mode != SIM_NO_MODE)
+    {
+        txn->latency += 8u / Lines(cmd->modeWidth);
+    }
+    txn->data = data;
+    txn->size = size;
+    txn->dataLines = Lines(cmd->dataWidth);
+}
+
+/*******************************************************************************
+* Function Name: DriverReady
+********************************************************************************
+*
+* Checks the driver can issue commands: the block is enabled and in the 
+* normal mode.
+*
+*******************************************************************************/
+static bool DriverReady(void)
+{
+    if((!smifEnabled) || (smifMode != CY_SMIF_NORMAL))
+    {
+        stats.driverErrors++;
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: StatusCmd
+********************************************************************************
+*
+* Reads one status or configuration register.
+*
+*******************************************************************************/
+static uint8_t StatusCmd(uint8_t command)
+{
+    sim_txn_t txn = {command, 1u, NULL, 0u, 1u, 0u, NULL, 1u, 1u};
+    uint8_t value = 0xFFu;
+    
+    txn.data = &value;
+    Execute(&txn);
+    return value;
+}
+
+/*******************************************************************************
+*            Test functions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: SimReset
+********************************************************************************
+*
+* Puts the model in the factory state: the array erased, the registers and
+* the SFDP space cleared, the clock and counters at 0. The driver is
+* uninitialized.
+*
+*******************************************************************************/
+void SimReset(void)
+{
+    if(array == NULL)
+    {
+        /* A shared file, so the XIP window can map it too */
+        arrayFd = memfd_create("s25fl512s", 0u);
+        if((arrayFd < 0) || (ftruncate(arrayFd, SIM_MEM_SIZE) != 0))
+        {
+            fprintf(stderr, "s25fl512s_sim: out of memory\n");
+            exit(1);
+        }
+        array = mmap(NULL, SIM_MEM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, arrayFd, 0);
+        if(array == MAP_FAILED)
+        {
+            fprintf(stderr, "s25fl512s_sim: out of memory\n");
+            exit(1);
+        }
+    }
+    (void)memset(array, 0xFF, SIM_MEM_SIZE);
+    (void)memset(sfdp, 0xFF, sizeof(sfdp));
+    (void)memset(eraseCounts, 0, sizeof(eraseCounts));
+    cr1 = 0u;
+    now = 0u;
+    spiClock = SIM_DEFAULT_SPI_CLOCK;
+    noise = 1u;
+    SimPowerCycle();
+    SimClearStats();
+}
+
+/*******************************************************************************
+* Function Name: SimPowerCycle
+********************************************************************************
+*
+* Removes the power. An erase in progress or suspended leaves its sector
+* partly erased, the volatile bits are cleared and the driver must be
+* initialized again. The array, CR1 and the SFDP space are kept.
+*
+*******************************************************************************/
+void SimPowerCycle(void)
+{
+    uint32_t i;
+    
+    if((erase != SIM_ERASE_NONE) && (array != NULL))
+    {
+        for(i = 0u; i < (eraseChip ? SIM_MEM_SIZE : SIM_SECTOR_SIZE); i++)
+        {
+            noise = (noise * 1103515245u) + 12345u;
+            array[(eraseChip ? 0u : (eraseSector * SIM_SECTOR_SIZE)) + i] |= (uint8_t)(noise >> 16u);
+        }
+    }
+    
+    sr1 = 0u;
+    sr2 = 0u;
+    op = SIM_OP_NONE;
+    erase = SIM_ERASE_NONE;
+    smifEnabled = false;
+    smifMode = CY_SMIF_NORMAL;
+    xipValid = false;
+    rawOpen = false;
+    UpdateXipWindow();
+}
+
+/*******************************************************************************
+* Function Name: SimSetSpiClock
+********************************************************************************
+*
+* Sets the SPI clock of the timing and of the read clock ratings.
+*
+*******************************************************************************/
+void SimSetSpiClock(uint32_t hz)
+{
+    spiClock = hz;
+}
+
+/*******************************************************************************
+* Function Name: SimLoadSfdp
+********************************************************************************
+*
+* Sets the SFDP space, the rest of it reads as erased.
+*
+*******************************************************************************/
+void SimLoadSfdp(const uint8_t image[], uint32_t size)
+{
+    (void)memset(sfdp, 0xFF, sizeof(sfdp));
+    (void)memcpy(sfdp, image, (size < SIM_SFDP_SIZE) ? size : SIM_SFDP_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: SimSetLatencyCode
+********************************************************************************
+*
+* Sets the latency code of CR1. The model adds the code to the mode and
+* dummy clocks of the fast reads, a simplification of the latency tables of
+* the datasheet.
+*
+*******************************************************************************/
+void SimSetLatencyCode(uint8_t code)
+{
+    cr1 = (uint8_t)((cr1 & SIM_CR1_QUAD) | ((code & 3u) << SIM_CR1_LC_POS));
+}
+
+/*******************************************************************************
+* Function Name: SimArray
+********************************************************************************
+*
+* Returns the memory array.
+*
+*******************************************************************************/
+uint8_t *SimArray(void)
+{
+    return array;
+}
+
+/*******************************************************************************
+* Function Name: SimEraseCount
+********************************************************************************
+*
+* Returns the number of completed erases of a sector.
+*
+*******************************************************************************/
+uint32_t SimEraseCount(uint32_t sector)
+{
+    return eraseCounts[sector];
+}
+
+/*******************************************************************************
+* Function Name: SimXipRead
+********************************************************************************
+*
+* Reads through the XIP registers set by Cy_SMIF_Memslot_Init(), as the CPU
+* would read the memory mapped range. The SMIF cache is not modeled.
+*
+* \return
+* false if the block is not in the memory mode or the range is not mapped.
+*
+*******************************************************************************/
+bool SimXipRead(uint32_t offset, uint8_t buffer[], uint32_t size)
+{
+    sim_txn_t txn;
+    uint8_t addr[4u];
+    uint32_t i;
+    
+    if((!smifEnabled) || (smifMode != CY_SMIF_MEMORY) || (!xipValid) || 
+       (offset > xipMappedSize) || (size > (xipMappedSize - offset)))
+    {
+        stats.driverErrors++;
+        return false;
+    }
+    
+    for(i = 0u; i < xipAddrBytes; i++)
+    {
+        addr[i] = (uint8_t)(offset >> (8u * (xipAddrBytes - 1u - i)));
+    }
+    CmdTxn(&txn, &xipReadCmd, addr, xipAddrBytes, buffer, size);
+    Execute(&txn);
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: SimMapXip
+********************************************************************************
+*
+* Maps the array at SIM_XIP_BASE, so code which reads the memory mapped range
+* directly runs unmodified. The range set by Cy_SMIF_Memslot_Init() can be
+* read in the memory mode, loads fault otherwise. The loads are not timed or
+* counted, SimXipRead() is.
+*
+* \return
+* false if the window address is in use on the host.
+*
+*******************************************************************************/
+bool SimMapXip(void)
+{
+    void *window;
+    
+    if(array == NULL)
+    {
+        SimReset();
+    }
+    if(!xipMapped)
+    {
+        window = mmap((void *)(uintptr_t)SIM_XIP_BASE, SIM_MEM_SIZE, PROT_NONE,
+                      MAP_SHARED | MAP_FIXED_NOREPLACE, arrayFd, 0);
+        if(window != (void *)(uintptr_t)SIM_XIP_BASE)
+        {
+            if(window != MAP_FAILED)
+            {
+                (void)munmap(window, SIM_MEM_SIZE);
+            }
+            return false;
+        }
+        xipMapped = true;
+    }
+    UpdateXipWindow();
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: SimTimeNs
+********************************************************************************
+*
+* Returns the simulated time.
+*
+*******************************************************************************/
+uint64_t SimTimeNs(void)
+{
+    return now;
+}
+
+/*******************************************************************************
+* Function Name: SimAdvance
+********************************************************************************
+*
+* Lets time pass without bus traffic.
+*
+*******************************************************************************/
+void SimAdvance(uint64_t ns)
+{
+    Advance(ns);
+}
+
+/*******************************************************************************
+* Function Name: SimGetStats
+********************************************************************************
+*
+* Copies the counters.
+*
+*******************************************************************************/
+void SimGetStats(sim_stats_t *result)
+{
+    *result = stats;
+    result->timeNs = now;
+}
+
+/*******************************************************************************
+* Function Name: SimClearStats
+********************************************************************************
+*
+* Clears the counters.
+*
+*******************************************************************************/
+void SimClearStats(void)
+{
+    (void)memset(&stats, 0, sizeof(stats));
+}
+
+/*******************************************************************************
+* Function Name: SimPrintStats
+********************************************************************************
+*
+* Prints the timing report of the counters.
+*
+*******************************************************************************/
+void SimPrintStats(const char *name)
+{
+    printf("%s: %.3f ms, bus %.3f ms in %u commands (%llu clocks at %u MHz), busy %.3f ms\n",
+           name, (double)now / 1e6, (double)stats.busNs / 1e6, (unsigned)stats.commands,
+           (unsigned long long)stats.busClocks, (unsigned)(spiClock / 1000000u), (double)stats.busyNs / 1e6);
+    printf("%s: %u status reads, %u reads (%llu B), %u pages (%llu B), %u sector erases, %u suspends\n",
+           name, (unsigned)stats.statusReads, (unsigned)stats.reads, (unsigned long long)stats.bytesRead,
+           (unsigned)stats.pagePrograms, (unsigned long long)stats.bytesProgrammed,
+           (unsigned)stats.sectorErases, (unsigned)stats.suspends);
+}
+
+/*******************************************************************************
+*            Core and system functions
+*******************************************************************************/
+DWT_Type *SimDwt(void)
+{
+    Advance(SIM_CPU_STEP_NS);
+    dwt.CYCCNT = (uint32_t)((now * (SystemCoreClock / 1000000u)) / 1000u);
+    return &dwt;
+}
+
+uint32_t __REV(uint32_t value)
+{
+    return __builtin_bswap32(value);
+}
+
+void __disable_irq(void)
+{
+    fprintf(stderr, "s25fl512s_sim: fatal error handler called\n");
+    abort();
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+    (void)irq;
+}
+
+void Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr)
+{
+    (void)config;
+    (void)userIsr;
+}
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    return 0u;
+}
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    (void)savedIntrStatus;
+}
+
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+    Advance((uint64_t)microseconds * 1000u);
+}
+
+uint32_t Cy_SysClk_ClkHfGetFrequency(uint32_t clkHf)
+{
+    (void)clkHf;
+    return spiClock * 2u;
+}
+
+void SMIF_Interrupt(void)
+{
+}
+
+/*******************************************************************************
+*            SMIF driver
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Init(SMIF_Type *base, cy_stc_smif_config_t const *config, uint32_t timeout,
+                                 cy_stc_smif_context_t *context)
+{
+    (void)base; (void)config; (void)timeout; (void)context;
+    return CY_SMIF_SUCCESS;
+}
+
+void Cy_SMIF_Enable(SMIF_Type *base, cy_stc_smif_context_t *context)
+{
+    (void)base; (void)context;
+    smifEnabled = true;
+}
+
+void Cy_SMIF_Disable(SMIF_Type *base)
+{
+    (void)base;
+    smifEnabled = false;
+}
+
+void Cy_SMIF_SetInterruptMask(SMIF_Type *base, uint32_t interrupt)
+{
+    (void)base; (void)interrupt;
+}
+
+void Cy_SMIF_SetTxFifoTriggerLevel(SMIF_Type *base, uint32_t level)
+{
+    (void)base; (void)level;
+}
+
+void Cy_SMIF_SetRxFifoTriggerLevel(SMIF_Type *base, uint32_t level)
+{
+    (void)base; (void)level;
+}
+
+void Cy_SMIF_SetDataSelect(SMIF_Type *base, cy_en_smif_slave_select_t slaveSelect,
+                           cy_en_smif_data_select_t dataSelect)
+{
+    (void)base; (void)slaveSelect; (void)dataSelect;
+}
+
+void Cy_SMIF_SetMode(SMIF_Type *base, cy_en_smif_mode_t mode)
+{
+    (void)base;
+    smifMode = mode;
+    UpdateXipWindow();
+}
+
+bool Cy_SMIF_BusyCheck(SMIF_Type const *base)
+{
+    (void)base;
+    return false;
+}
+
+cy_en_smif_status_t Cy_SMIF_CacheEnable(SMIF_Type *base, cy_en_smif_cache_en_t cacheType)
+{
+    (void)base; (void)cacheType;
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_CacheDisable(SMIF_Type *base, cy_en_smif_cache_en_t cacheType)
+{
+    (void)base; (void)cacheType;
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_CachePrefetchingEnable(SMIF_Type *base, cy_en_smif_cache_en_t cacheType)
+{
+    (void)base; (void)cacheType;
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_CacheInvalidate(SMIF_Type *base, cy_en_smif_cache_en_t cacheType)
+{
+    (void)base; (void)cacheType;
+    stats.cacheInvalidates++;
+    return CY_SMIF_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_TransmitCommand
+********************************************************************************
+*
+* Opens a raw transaction. It is decoded when the last byte is sent or when
+* the data is received.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_TransmitCommand(SMIF_Type *base, uint8_t cmd, cy_en_smif_txfr_width_t cmdTxfrWidth,
+                                            uint8_t const cmdParam[], uint32_t paramSize,
+                                            cy_en_smif_txfr_width_t paramTxfrWidth,
+                                            cy_en_smif_slave_select_t slaveSelect, uint32_t completeTxfr,
+                                            cy_stc_smif_context_t const *context)
+{
+    sim_txn_t txn;
+    
+    (void)base; (void)slaveSelect; (void)context;
+    
+    if((!DriverReady()) || (paramSize > sizeof(rawParams)))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+    
+    rawOpen = true;
+    rawCmd = cmd;
+    rawCmdLines = Lines(cmdTxfrWidth);
+    rawParamSize = paramSize;
+    rawParamLines = Lines(paramTxfrWidth);
+    rawDummy = 0u;
+    if(paramSize != 0u)
+    {
+        (void)memcpy(rawParams, cmdParam, paramSize);
+    }
+    
+    if(completeTxfr == CY_SMIF_TX_LAST_BYTE)
+    {
+        /* The parameters are the data of the commands without an address */
+        txn = (sim_txn_t){rawCmd, rawCmdLines, NULL, 0u, 1u, 0u, rawParams, rawParamSize, rawParamLines};
+        rawOpen = false;
+        Execute(&txn);
+    }
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_SendDummyCycles(SMIF_Type *base, uint32_t cycles)
+{
+    (void)base;
+    
+    if((!DriverReady()) || (!rawOpen))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+    rawDummy += cycles;
+    return CY_SMIF_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_ReceiveDataBlocking
+********************************************************************************
+*
+* Completes a raw transaction with a data phase. The leading parameters are
+* the address of the command, parameters after it count as latency clocks.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_ReceiveDataBlocking(SMIF_Type *base, uint8_t *rxBuffer, uint32_t size,
+                                                cy_en_smif_txfr_width_t transferWidth,
+                                                cy_stc_smif_context_t const *context)
+{
+    const sim_opcode_t *opcode = FindOpcode(rawCmd);
+    uint32_t addrBytes = 0u;
+    sim_txn_t txn;
+    
+    (void)base; (void)context;
+    
+    if((!DriverReady()) || (!rawOpen))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+    
+    if(rawCmd == CMD_READ_SFDP)
+    {
+        addrBytes = SFDP_ADDR_BYTES;
+    }
+    else if(opcode != NULL)
+    {
+        addrBytes = opcode->addrBytes;
+    }
+    else
+    {
+        /* Register read */
+    }
+    if(addrBytes > rawParamSize)
+    {
+        addrBytes = rawParamSize;
+    }
+    
+    txn = (sim_txn_t){rawCmd, rawCmdLines, rawParams, addrBytes, rawParamLines, 
+                      rawDummy + (((rawParamSize - addrBytes) * 8u) / rawParamLines),
+                      rxBuffer, size, Lines(transferWidth)};
+    rawOpen = false;
+    Execute(&txn);
+    return CY_SMIF_SUCCESS;
+}
+
+/*******************************************************************************
+*            Memory slot driver
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Memslot_Init
+********************************************************************************
+*
+* Takes the read command of the first memory into the XIP registers.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Memslot_Init(SMIF_Type *base, cy_stc_smif_block_config_t * const blockConfig,
+                                         cy_stc_smif_context_t *context)
+{
+    cy_stc_smif_mem_config_t *memConfig = blockConfig->memConfig[0];
+    
+    (void)base; (void)context;
+    
+    xipValid = ((memConfig->flags & CY_SMIF_FLAG_MEMORY_MAPPED) != 0u);
+    xipReadCmd = *memConfig->deviceCfg->readCmd;
+    xipAddrBytes = memConfig->deviceCfg->numOfAddrBytes;
+    xipMappedSize = memConfig->memMappedSize;
+    UpdateXipWindow();
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdWriteEnable(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+                                                   cy_stc_smif_context_t const *context)
+{
+    sim_txn_t txn;
+    
+    (void)base; (void)context;
+    
+    if(!DriverReady())
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+    CmdTxn(&txn, memDevice->deviceCfg->writeEnCmd, NULL, 0u, NULL, 0u);
+    Execute(&txn);
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdProgram(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+                                               uint8_t const *addr, uint8_t *writeBuff, uint32_t size,
+                                               cy_smif_event_cb_t cmdCmpltCb, cy_stc_smif_context_t *context)
+{
+    sim_txn_t txn;
+    
+    (void)base; (void)context;
+    
+    if((!DriverReady()) || (size == 0u))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+    CmdTxn(&txn, memDevice->deviceCfg->programCmd, addr, memDevice->deviceCfg->numOfAddrBytes, writeBuff, size);
+    Execute(&txn);
+    if(cmdCmpltCb != NULL)
+    {
+        cmdCmpltCb(CY_SMIF_SEND_CMPLT);
+    }
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdRead(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+                                            uint8_t const *addr, uint8_t *readBuff, uint32_t size,
+                                            cy_smif_event_cb_t cmdCmpltCb, cy_stc_smif_context_t *context)
+{
+    sim_txn_t txn;
+    
+    (void)base; (void)context;
+    
+    if((!DriverReady()) || (size == 0u))
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+    CmdTxn(&txn, memDevice->deviceCfg->readCmd, addr, memDevice->deviceCfg->numOfAddrBytes, readBuff, size);
+    Execute(&txn);
+    if(cmdCmpltCb != NULL)
+    {
+        cmdCmpltCb(CY_SMIF_REC_CMPLT);
+    }
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdSectorErase(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+                                                   uint8_t const *sectorAddr, cy_stc_smif_context_t const *context)
+{
+    sim_txn_t txn;
+    
+    (void)base; (void)context;
+    
+    if(!DriverReady())
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+    CmdTxn(&txn, memDevice->deviceCfg->eraseCmd, sectorAddr, memDevice->deviceCfg->numOfAddrBytes, NULL, 0u);
+    Execute(&txn);
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdChipErase(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+                                                 cy_stc_smif_context_t const *context)
+{
+    sim_txn_t txn;
+    
+    (void)base; (void)context;
+    
+    if(!DriverReady())
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+    CmdTxn(&txn, memDevice->deviceCfg->chipEraseCmd, NULL, 0u, NULL, 0u);
+    Execute(&txn);
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_Memslot_CmdReadSts(SMIF_Type *base, cy_stc_smif_mem_config_t const *memDevice,
+                                               uint8_t *status, uint8_t command,
+                                               cy_stc_smif_context_t const *context)
+{
+    (void)base; (void)memDevice; (void)context;
+    
+    if(!DriverReady())
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+    *status = StatusCmd(command);
+    return CY_SMIF_SUCCESS;
+}
+
+bool Cy_SMIF_Memslot_IsBusy(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+                            cy_stc_smif_context_t const *context)
+{
+    (void)base; (void)context;
+    
+    if(!DriverReady())
+    {
+        return false;
+    }
+    return ((StatusCmd((uint8_t)memDevice->deviceCfg->readStsRegWipCmd->command) & 
+             memDevice->deviceCfg->stsRegBusyMask) != 0u);
+}
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Memslot_QuadEnable
+********************************************************************************
+*
+* Sets the QE bit if it is clear. A QE bit read with 35h is in CR1, which 01h
+* writes as the second byte after SR1.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Memslot_QuadEnable(SMIF_Type *base, cy_stc_smif_mem_config_t *memDevice,
+                                               cy_stc_smif_context_t const *context)
+{
+    cy_stc_smif_mem_device_cfg_t *cfg = memDevice->deviceCfg;
+    uint8_t regs[2u];
+    uint8_t qe;
+    sim_txn_t txn;
+    
+    (void)base; (void)context;
+    
+    if(!DriverReady())
+    {
+        return CY_SMIF_BAD_PARAM;
+    }
+    
+    qe = StatusCmd((uint8_t)cfg->readStsRegQeCmd->command);
+    if((qe & cfg->stsRegQuadEnableMask) != 0u)
+    {
+        return CY_SMIF_SUCCESS;
+    }
+    
+    CmdTxn(&txn, cfg->writeEnCmd, NULL, 0u, NULL, 0u);
+    Execute(&txn);
+    
+    if(cfg->readStsRegQeCmd->command == CMD_READ_CR1)
+    {
+        regs[0] = StatusCmd(CMD_READ_SR1);
+        regs[1] = (uint8_t)(qe | cfg->stsRegQuadEnableMask);
+        CmdTxn(&txn, cfg->writeStsRegQeCmd, NULL, 0u, regs, 2u);
+    }
+    else
+    {
+        regs[0] = (uint8_t)(qe | cfg->stsRegQuadEnableMask);
+        CmdTxn(&txn, cfg->writeStsRegQeCmd, NULL, 0u, regs, 1u);
+    }
+    Execute(&txn);
+    return CY_SMIF_SUCCESS;
+}
+
+/* [] END OF FILE */
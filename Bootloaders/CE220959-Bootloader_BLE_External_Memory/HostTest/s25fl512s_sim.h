@@ -0,0 +1,139 @@
+/******************************************************************************
+* File Name: s25fl512s_sim.h
+*
+* Version: 1.0
+*
+* Description: Behavioral model of the S25FL512S behind the host SMIF
+*              driver. The test functions below reset and inspect the model
+*              and report the simulated bus and busy time.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef __S25FL512S_SIM_H
+#define __S25FL512S_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*            Constants
+*******************************************************************************/
+#define SIM_MEM_SIZE            (0x04000000u)   /* 512 Mbit */
+#define SIM_PAGE_SIZE           (512u)          /* Page program buffer */
+#define SIM_SECTOR_SIZE         (0x00040000u)   /* Uniform 256 KB sectors */
+#define SIM_SECTOR_COUNT        (SIM_MEM_SIZE / SIM_SECTOR_SIZE)
+#define SIM_XIP_BASE            (0x18000000u)   /* CY_XIP_BASE of the device */
+
+/* Typical times of the datasheet */
+#define SIM_PROGRAM_NS          (340000u)       /* tPP, 512-byte page */
+#define SIM_SECTOR_ERASE_NS     (520000000u)    /* tSE, 256 KB sector */
+#define SIM_CHIP_ERASE_NS       (103000000000ull) /* tBE */
+#define SIM_WRITE_REG_NS        (200000000u)    /* tW, WRR */
+#define SIM_SUSPEND_NS          (45000u)        /* tESL, erase suspend latency */
+
+#define SIM_DEFAULT_SPI_CLOCK   (50000000u)     /* Half of HFCLK2 at 100 MHz */
+
+/* Status and configuration register bits */
+#define SIM_SR1_WIP             (0x01u)
+#define SIM_SR1_WEL             (0x02u)
+#define SIM_SR2_ES              (0x02u)
+#define SIM_CR1_QUAD            (0x02u)
+#define SIM_CR1_LC_POS          (6u)
+
+/*******************************************************************************
+*            Data Types
+*******************************************************************************/
+/* Counters of the model, times in simulated nanoseconds */
+typedef struct
+{
+    uint64_t timeNs;            /* Simulated time                               */
+    uint64_t busClocks;         /* SPI clocks of all transactions               */
+    uint64_t busNs;             /* Time the bus was driven, including CS gaps   */
+    uint64_t busyNs;            /* Time WIP was set                             */
+    uint32_t commands;          /* Transactions on the bus                      */
+    uint32_t statusReads;       /* Status and configuration register reads      */
+    uint32_t reads;             /* Array reads, not counting SFDP               */
+    uint64_t bytesRead;
+    uint32_t pagePrograms;
+    uint64_t bytesProgrammed;
+    uint32_t sectorErases;      /* Completed sector erases                      */
+    uint32_t chipErases;        /* Completed chip erases                        */
+    uint32_t suspends;
+    uint32_t resumes;
+    uint32_t ignored;           /* Commands the memory dropped: busy, no WEL    */
+    uint32_t badCommands;       /* Unknown opcode, wrong widths or address size */
+    uint32_t badReads;          /* Reads with wrong latency or above the rated clock */
+    uint32_t driverErrors;      /* Driver calls in the memory mode or disabled  */
+    uint32_t cacheInvalidates;  /* Cy_SMIF_CacheInvalidate() calls             */
+} sim_stats_t;
+
+/*******************************************************************************
+*            Function Prototypes
+*******************************************************************************/
+void SimReset(void);                        /* Factory state: erased, QE clear, time 0 */
+
+void SimPowerCycle(void);                   /* Abort the operation in progress, keep the array */
+
+void SimSetSpiClock(uint32_t hz);           /* SPI clock used for the timing */
+
+void SimLoadSfdp(
+                    const uint8_t image[],
+                    uint32_t size);         /* SFDP space returned by 5Ah */
+
+void SimSetLatencyCode(uint8_t code);       /* CR1 latency code, adds dummy cycles */
+
+uint8_t *SimArray(void);                    /* The memory array, for direct checks */
+
+uint32_t SimEraseCount(uint32_t sector);    /* Completed erases of a sector */
+
+bool SimXipRead(
+                    uint32_t offset,
+                    uint8_t buffer[],
+                    uint32_t size);         /* Read through the XIP registers */
+
+bool SimMapXip(void);                       /* Map the array at SIM_XIP_BASE */
+
+uint64_t SimTimeNs(void);                   /* Simulated time */
+
+void SimAdvance(uint64_t ns);               /* Let time pass */
+
+void SimGetStats(sim_stats_t *stats);       /* Copy the counters */
+
+void SimClearStats(void);                   /* Clear the counters, keep the time */
+
+void SimPrintStats(const char *name);       /* Print a timing report */
+
+#endif /*__S25FL512S_SIM_H*/
+
+/* [] END OF FILE */
@@ -0,0 +1,318 @@
+/******************************************************************************
+* File Name: test_bootload.c
+*
+* Version: 1.0
+*
+* Description: Host tests of the bootloader functions of App0 with the
+*              S25FL512S model mapped behind the XIP window:
+*              Cy_Bootload_WriteData() and Cy_Bootload_ReadData() move an
+*              application staged at the App1 addresses to the external
+*              memory, read and compare it, and Cy_Bootload_ValidateApp()
+*              checks it through the memory mapped range.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "bootloader/cy_bootload.h"
+#include "transport_ble.h"
+#include "smif_mem.h"
+#include "s25fl512s_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Checks a condition and counts the failures */
+#define CHECK(cond)     Check((cond), #cond, __LINE__)
+
+/* The external application is staged at the App1 addresses, with the footer */
+#define TEST_APP_ID             (2u)
+#define TEST_APP_START          (CY_BOOTLOAD_APP1_VERIFY_START)
+#define TEST_APP_LENGTH         (CY_BOOTLOAD_APP1_VERIFY_LENGTH)
+#define TEST_APP_ROWS           ((TEST_APP_LENGTH + CY_BOOTLOAD_SIGNATURE_SIZE) / CY_FLASH_SIZEOF_ROW)
+
+/* CRC-32C polynomial, reversed */
+#define TEST_CRC_POLY           (0x82F63B78u)
+
+static uint32_t failures = 0u;
+
+static SMIF_Type smifHw;
+static cy_stc_smif_context_t smifContext;
+
+static uint8_t image[TEST_APP_ROWS * CY_FLASH_SIZEOF_ROW];
+static uint8_t dataBuffer[CY_BOOTLOAD_SIZEOF_DATA_BUFFER];
+static cy_stc_bootload_params_t params;
+
+static uint32_t flashWrites;
+
+/*******************************************************************************
+* Function Name: Check
+********************************************************************************
+*
+* Reports a failed check.
+*
+*******************************************************************************/
+static void Check(bool cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("test_bootload.c:%d: check failed: %s\n", line, text);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+*            Bootloader SDK and transport
+*******************************************************************************/
+cy_en_bootload_status_t Cy_Bootload_GetAppMetadata(uint32_t appId, uint32_t *verifyAddress, uint32_t *verifySize)
+{
+    static const uint32_t metadata[CY_BOOTLOAD_MAX_APPS][2u] =
+    {
+        {CY_BOOTLOAD_APP0_VERIFY_START, CY_BOOTLOAD_APP0_VERIFY_LENGTH},
+        {CY_BOOTLOAD_APP1_VERIFY_START, CY_BOOTLOAD_APP1_VERIFY_LENGTH},
+        {TEST_APP_START, TEST_APP_LENGTH}
+    };
+    
+    if(appId >= CY_BOOTLOAD_MAX_APPS)
+    {
+        return CY_BOOTLOAD_ERROR_VERIFY;
+    }
+    if(verifyAddress != NULL)
+    {
+        *verifyAddress = metadata[appId][0u];
+    }
+    if(verifySize != NULL)
+    {
+        *verifySize = metadata[appId][1u];
+    }
+    return CY_BOOTLOAD_SUCCESS;
+}
+
+uint32_t Cy_Bootload_GetRunningApp(void)
+{
+    return 0u;
+}
+
+uint32_t Cy_Bootload_DataChecksum(const uint8_t *address, uint32_t length, cy_stc_bootload_params_t *params)
+{
+    uint32_t crc = 0xFFFFFFFFu;
+    uint32_t i;
+    uint32_t bit;
+    
+    for(i = 0u; i < length; i++)
+    {
+        crc ^= address[i];
+        for(bit = 0u; bit < 8u; bit++)
+        {
+            crc = ((crc & 1u) != 0u) ? ((crc >> 1u) ^ TEST_CRC_POLY) : (crc >> 1u);
+        }
+    }
+    return ~crc;
+}
+
+cy_en_flashdrv_status_t Cy_Flash_WriteRow(uint32_t rowAddr, const uint32_t *data)
+{
+    flashWrites++;
+    return CY_FLASH_DRV_SUCCESS;
+}
+
+void CyBLE_CyBtldrCommStart(void)
+{
+}
+
+void CyBLE_CyBtldrCommStop(void)
+{
+}
+
+void CyBLE_CyBtldrCommReset(void)
+{
+}
+
+cy_en_bootload_status_t CyBLE_CyBtldrCommRead(uint8_t pData[], uint32_t size, uint32_t *count, uint32_t timeout)
+{
+    *count = 0u;
+    return CY_BOOTLOAD_ERROR_TIMEOUT;
+}
+
+cy_en_bootload_status_t CyBLE_CyBtldrCommWrite(const uint8_t pData[], uint32_t size, uint32_t *count, uint32_t timeout)
+{
+    *count = size;
+    return CY_BOOTLOAD_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: CheckModel
+********************************************************************************
+*
+* The driver used the memory correctly: no command was dropped or malformed,
+* and the memory mode was only entered while the memory was idle.
+*
+*******************************************************************************/
+static void CheckModel(void)
+{
+    sim_stats_t stats;
+
+    SimGetStats(&stats);
+    CHECK(stats.ignored == 0u);
+    CHECK(stats.badCommands == 0u);
+    CHECK(stats.badReads == 0u);
+    CHECK(stats.driverErrors == 0u);
+}
+
+/*******************************************************************************
+* Function Name: MakeImage
+********************************************************************************
+*
+* Makes the application image, its last word is the checksum of the rest.
+*
+*******************************************************************************/
+static void MakeImage(void)
+{
+    uint32_t crc;
+    uint32_t i;
+
+    for(i = 0u; i < TEST_APP_LENGTH; i++)
+    {
+        image[i] = (uint8_t)((i * 7u) ^ (i >> 9u));
+    }
+    crc = Cy_Bootload_DataChecksum(image, TEST_APP_LENGTH, &params);
+    (void)memcpy(&image[TEST_APP_LENGTH], &crc, sizeof(crc));
+}
+
+/*******************************************************************************
+* Function Name: TestWriteRead
+********************************************************************************
+*
+* The rows of the external application are written to the external memory,
+* the first row erases the sectors of the application. They are read back
+* and compared, a changed row fails the compare and bad lengths are refused.
+*
+*******************************************************************************/
+static void TestWriteRead(void)
+{
+    uint32_t row;
+    uint32_t address;
+    uint32_t bad = 0u;
+
+    /* Left over from an earlier image, erased by the first row */
+    (void)memset(SimArray(), 0x00, CY_FLASH_SIZEOF_ROW * 4u);
+
+    for(row = 0u; row < TEST_APP_ROWS; row++)
+    {
+        (void)memcpy(dataBuffer, &image[row * CY_FLASH_SIZEOF_ROW], CY_FLASH_SIZEOF_ROW);
+        bad += (Cy_Bootload_WriteData(TEST_APP_START + (row * CY_FLASH_SIZEOF_ROW), CY_FLASH_SIZEOF_ROW, 0u,
+                                      &params) != CY_BOOTLOAD_SUCCESS) ? 1u : 0u;
+    }
+    CHECK(bad == 0u);
+    CHECK(flashWrites == 0u);
+    CHECK(SimEraseCount(0u) == 1u);
+    CHECK(memcmp(SimArray(), image, sizeof(image)) == 0);
+
+    for(row = 0u; row < TEST_APP_ROWS; row++)
+    {
+        address = TEST_APP_START + (row * CY_FLASH_SIZEOF_ROW);
+        (void)memset(dataBuffer, 0, sizeof(dataBuffer));
+        bad += ((Cy_Bootload_ReadData(address, CY_FLASH_SIZEOF_ROW, 0u, &params) != CY_BOOTLOAD_SUCCESS)
+                || (memcmp(dataBuffer, &image[row * CY_FLASH_SIZEOF_ROW], CY_FLASH_SIZEOF_ROW) != 0)) ? 1u : 0u;
+        bad += (Cy_Bootload_ReadData(address, CY_FLASH_SIZEOF_ROW, CY_BOOTLOAD_IOCTL_COMPARE,
+                                     &params) != CY_BOOTLOAD_SUCCESS) ? 1u : 0u;
+    }
+    CHECK(bad == 0u);
+
+    address = TEST_APP_START + CY_FLASH_SIZEOF_ROW;
+    (void)memcpy(dataBuffer, &image[CY_FLASH_SIZEOF_ROW], CY_FLASH_SIZEOF_ROW);
+    dataBuffer[5u] ^= 0x01u;
+    CHECK(Cy_Bootload_ReadData(address, CY_FLASH_SIZEOF_ROW, CY_BOOTLOAD_IOCTL_COMPARE, &params)
+          == CY_BOOTLOAD_ERROR_VERIFY);
+    CHECK(Cy_Bootload_WriteData(address, CY_FLASH_SIZEOF_ROW / 2u, 0u, &params) == CY_BOOTLOAD_ERROR_LENGTH);
+    CHECK(Cy_Bootload_ReadData(address, CY_FLASH_SIZEOF_ROW / 2u, 0u, &params) == CY_BOOTLOAD_ERROR_LENGTH);
+    CHECK(memcmp(SimArray(), image, sizeof(image)) == 0);
+    CheckModel();
+}
+
+/*******************************************************************************
+* Function Name: TestXipWindow
+********************************************************************************
+*
+* In the memory mode the application reads back through the XIP window.
+* Cy_Bootload_ValidateApp() computes the checksum there, passes for the
+* written image and fails once a byte of the memory changed.
+*
+*******************************************************************************/
+static void TestXipWindow(void)
+{
+    SwitchSMIFMemory();
+    CHECK(memcmp((const void *)(uintptr_t)CY_XIP_BASE, image, sizeof(image)) == 0);
+    SwitchSMIFNormal();
+
+    CHECK(Cy_Bootload_ValidateApp(TEST_APP_ID, &params) == CY_BOOTLOAD_SUCCESS);
+
+    SimArray()[0x1000u] ^= 0x10u;
+    CHECK(Cy_Bootload_ValidateApp(TEST_APP_ID, &params) == CY_BOOTLOAD_ERROR_VERIFY);
+    SimArray()[0x1000u] ^= 0x10u;
+
+    /* Back in the normal mode */
+    CHECK(Cy_Bootload_ReadData(TEST_APP_START, CY_FLASH_SIZEOF_ROW, 0u, &params) == CY_BOOTLOAD_SUCCESS);
+    CHECK(memcmp(dataBuffer, image, CY_FLASH_SIZEOF_ROW) == 0);
+    CheckModel();
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests, returns non-zero if a check failed.
+*
+*******************************************************************************/
+int main(void)
+{
+    SimReset();
+    if(!SimMapXip())
+    {
+        printf("test_bootload: FAIL (XIP window 0x%08X in use)\n", (unsigned)SIM_XIP_BASE);
+        return 1;
+    }
+    configureSMIF(&smifHw, &smifContext);
+
+    params.dataBuffer = dataBuffer;
+    params.appId = TEST_APP_ID;
+    MakeImage();
+
+    TestWriteRead();
+    TestXipWindow();
+
+    SimPrintStats("test_bootload");
+    printf("test_bootload: %s (%u failed)\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,313 @@
+/******************************************************************************
+* File Name: test_cache.c
+*
+* Version: 1.0
+*
+* Description: Host tests of the RAM read cache of App0 on the S25FL512S
+*              model, built with the cache and the read-ahead on: hits,
+*              misses, the read-ahead, the replacement of the least
+*              recently used line, large reads passing the cache and the
+*              invalidation on a program and on an erase.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_cache.h"
+#include "smif_mem.h"
+#include "s25fl512s_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <string.h>
+
+#if (SMIF_CACHE_ENABLED == 0u) || (SMIF_CACHE_READ_AHEAD == 0u)
+#error "Build with -DSMIF_CACHE_ENABLED=1u -DSMIF_CACHE_READ_AHEAD=1u"
+#endif /* (SMIF_CACHE_ENABLED == 0u) || (SMIF_CACHE_READ_AHEAD == 0u) */
+
+/* Checks a condition and counts the failures */
+#define CHECK(cond)     Check((cond), #cond, __LINE__)
+
+/* Lines of the read tests, filled with a pattern */
+#define TEST_READ_ADDRESS       (0x01000000u)
+
+/* Erased sector of the program and erase tests */
+#define TEST_WRITE_ADDRESS      (0x01100000u)
+
+static uint32_t failures = 0u;
+
+static SMIF_Type smifHw;
+static cy_stc_smif_context_t smifContext;
+
+/*******************************************************************************
+* Function Name: Check
+********************************************************************************
+*
+* Reports a failed check.
+*
+*******************************************************************************/
+static void Check(bool cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("test_cache.c:%d: check failed: %s\n", line, text);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ReadLine
+********************************************************************************
+*
+* Reads a few bytes of a line through the cache and compares them with the
+* array.
+*
+*******************************************************************************/
+static void ReadLine(uint32_t address)
+{
+    uint8_t data[16];
+
+    (void)memset(data, 0, sizeof(data));
+    ReadMemoryCached(data, sizeof(data), address);
+    CHECK(memcmp(data, &SimArray()[address], sizeof(data)) == 0);
+}
+
+/*******************************************************************************
+* Function Name: Restart
+********************************************************************************
+*
+* Empties the cache and clears the counters.
+*
+*******************************************************************************/
+static void Restart(void)
+{
+    InvalidateReadCacheAll();
+    ResetReadCacheStats();
+    SimClearStats();
+}
+
+/*******************************************************************************
+* Function Name: TestHitMiss
+********************************************************************************
+*
+* The first read of a line reads it from the memory, the next reads of the 
+* line are served from RAM without a command.
+*
+*******************************************************************************/
+static void TestHitMiss(void)
+{
+    smif_cache_stats_t cache;
+    sim_stats_t stats;
+
+    Restart();
+    ReadLine(TEST_READ_ADDRESS + 0x20u);
+    ReadLine(TEST_READ_ADDRESS + 0x40u);
+    ReadLine(TEST_READ_ADDRESS + SMIF_CACHE_LINE_SIZE - 16u);
+
+    GetReadCacheStats(&cache);
+    CHECK(cache.misses == 1u);
+    CHECK(cache.hits == 2u);
+    CHECK(cache.readAheads == 0u);
+    SimGetStats(&stats);
+    CHECK(stats.reads == 1u);
+    CHECK(stats.bytesRead == SMIF_CACHE_LINE_SIZE);
+
+    /* A read across a line border takes both lines */
+    ReadLine(TEST_READ_ADDRESS + (3u * SMIF_CACHE_LINE_SIZE) - 8u);
+    GetReadCacheStats(&cache);
+    CHECK(cache.misses == 3u);
+}
+
+/*******************************************************************************
+* Function Name: TestReadAhead
+********************************************************************************
+*
+* A miss on the line after the last one read fetches the following line too, 
+* so a reader streaming through the memory hits on every second line.
+*
+*******************************************************************************/
+static void TestReadAhead(void)
+{
+    smif_cache_stats_t cache;
+    uint32_t line;
+
+    Restart();
+    for(line = 0u; line < 6u; line++)
+    {
+        ReadLine(TEST_READ_ADDRESS + (line * SMIF_CACHE_LINE_SIZE));
+    }
+
+    /* Lines 0, 1, 3 and 5 miss, 1, 3 and 5 fetch the next line */
+    GetReadCacheStats(&cache);
+    CHECK(cache.misses == 4u);
+    CHECK(cache.readAheads == 3u);
+    CHECK(cache.hits == 2u);
+
+    /* A jump back is not sequential */
+    Restart();
+    ReadLine(TEST_READ_ADDRESS + (4u * SMIF_CACHE_LINE_SIZE));
+    ReadLine(TEST_READ_ADDRESS);
+    GetReadCacheStats(&cache);
+    CHECK(cache.readAheads == 0u);
+}
+
+/*******************************************************************************
+* Function Name: TestEviction
+********************************************************************************
+*
+* With all lines in use, a miss replaces the least recently used line.
+*
+*******************************************************************************/
+static void TestEviction(void)
+{
+    smif_cache_stats_t cache;
+    uint32_t line;
+
+    Restart();
+
+    /* Every second line, so nothing is read ahead */
+    for(line = 0u; line < SMIF_CACHE_LINES; line++)
+    {
+        ReadLine(TEST_READ_ADDRESS + (2u * line * SMIF_CACHE_LINE_SIZE));
+    }
+
+    /* Line 0 becomes the most recently used, line 2 the least */
+    ReadLine(TEST_READ_ADDRESS);
+    ReadLine(TEST_READ_ADDRESS + (2u * SMIF_CACHE_LINES * SMIF_CACHE_LINE_SIZE));
+    GetReadCacheStats(&cache);
+    CHECK(cache.misses == (SMIF_CACHE_LINES + 1u));
+    CHECK(cache.hits == 1u);
+
+    ReadLine(TEST_READ_ADDRESS);
+    GetReadCacheStats(&cache);
+    CHECK(cache.hits == 2u);
+
+    ReadLine(TEST_READ_ADDRESS + (2u * SMIF_CACHE_LINE_SIZE));
+    GetReadCacheStats(&cache);
+    CHECK(cache.misses == (SMIF_CACHE_LINES + 2u));
+    CHECK(cache.readAheads == 0u);
+}
+
+/*******************************************************************************
+* Function Name: TestBypass
+********************************************************************************
+*
+* A read larger than the whole cache goes to the memory and keeps the lines.
+*
+*******************************************************************************/
+static void TestBypass(void)
+{
+    static uint8_t data[(SMIF_CACHE_LINES * SMIF_CACHE_LINE_SIZE) + 1u];
+    smif_cache_stats_t cache;
+
+    Restart();
+    ReadLine(TEST_READ_ADDRESS);
+    ReadMemoryCached(data, sizeof(data), TEST_READ_ADDRESS);
+    CHECK(memcmp(data, &SimArray()[TEST_READ_ADDRESS], sizeof(data)) == 0);
+    ReadLine(TEST_READ_ADDRESS);
+
+    GetReadCacheStats(&cache);
+    CHECK(cache.bypasses == 1u);
+    CHECK(cache.misses == 1u);
+    CHECK(cache.hits == 1u);
+}
+
+/*******************************************************************************
+* Function Name: TestInvalidate
+********************************************************************************
+*
+* A program drops the lines it overlaps and an erase drops the lines of the 
+* sector, so the next read returns the new contents. Other lines are kept.
+*
+*******************************************************************************/
+static void TestInvalidate(void)
+{
+    uint8_t data[32];
+    smif_cache_stats_t cache;
+
+    Restart();
+    ReadLine(TEST_WRITE_ADDRESS);
+    ReadLine(TEST_READ_ADDRESS);
+
+    (void)memset(data, 0x3C, sizeof(data));
+    WriteMemory(data, sizeof(data), TEST_WRITE_ADDRESS + 0x10u);
+    GetReadCacheStats(&cache);
+    CHECK(cache.invalidations == 1u);
+
+    ReadLine(TEST_WRITE_ADDRESS + 0x10u);
+    ReadLine(TEST_READ_ADDRESS);
+    GetReadCacheStats(&cache);
+    CHECK(cache.misses == 3u);
+    CHECK(cache.hits == 1u);
+    CHECK(SimArray()[TEST_WRITE_ADDRESS + 0x10u] == 0x3Cu);
+
+    EraseSMIFSector(TEST_WRITE_ADDRESS + 0x200u);
+    GetReadCacheStats(&cache);
+    CHECK(cache.invalidations == 2u);
+
+    (void)memset(data, 0, sizeof(data));
+    ReadMemoryCached(data, sizeof(data), TEST_WRITE_ADDRESS + 0x10u);
+    CHECK((data[0] == 0xFFu) && (data[sizeof(data) - 1u] == 0xFFu));
+    ReadLine(TEST_READ_ADDRESS);
+    GetReadCacheStats(&cache);
+    CHECK(cache.misses == 4u);
+    CHECK(cache.hits == 2u);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests, returns non-zero if a check failed.
+*
+*******************************************************************************/
+int main(void)
+{
+    uint32_t i;
+
+    SimReset();
+    for(i = 0u; i < (16u * SMIF_CACHE_LINE_SIZE); i++)
+    {
+        SimArray()[TEST_READ_ADDRESS + i] = (uint8_t)((i * 7u) + (i >> 9u));
+    }
+    configureSMIF(&smifHw, &smifContext);
+
+    TestHitMiss();
+    TestReadAhead();
+    TestEviction();
+    TestBypass();
+    TestInvalidate();
+
+    printf("test_cache: %s (%u failed)\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
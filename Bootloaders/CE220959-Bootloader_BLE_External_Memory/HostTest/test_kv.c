@@ -0,0 +1,542 @@
+/******************************************************************************
+* File Name: test_kv.c
+*
+* Version: 1.0
+*
+* Description: Host tests of the key-value store and the SMIF helpers of
+*              App0 on the S25FL512S model: format, update, delete, garbage
+*              collection, erase counts over a mount, erase suspend, the
+*              erase flag of the blocking calls, programs torn by a power
+*              loss and the rate of small record writes.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_kv.h"
+#include "smif_mem.h"
+#include "s25fl512s_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Checks a condition and counts the failures */
+#define CHECK(cond)     Check((cond), #cond, __LINE__)
+
+/* Keys and value sizes of the update test */
+#define TEST_KEYS               (40u)
+#define TEST_UPDATES            (20000u)
+
+/* Small records of the rate test and the rate aimed at, in writes/s */
+#define TEST_SMALL_SIZE         (8u)
+#define TEST_SMALL_RECORDS      (200000u)
+#define TEST_SMALL_TARGET       (20000u)
+
+/* Sector outside of the store, erased by the suspend test */
+#define TEST_ERASE_ADDRESS      (SMIF_KV_START_ADDRESS - (2u * SIM_SECTOR_SIZE))
+
+static uint32_t failures = 0u;
+
+static SMIF_Type smifHw;
+static cy_stc_smif_context_t smifContext;
+
+/* Latest value of every key written by the tests, 0 size if deleted */
+static uint8_t shadow[TEST_KEYS][SMIF_KV_MAX_VALUE_SIZE];
+static uint16_t shadowSize[TEST_KEYS];
+
+/*******************************************************************************
+* Function Name: Check
+********************************************************************************
+*
+* Reports a failed check.
+*
+*******************************************************************************/
+static void Check(bool cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("test_kv.c:%d: check failed: %s\n", line, text);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Start
+********************************************************************************
+*
+* Powers up the memory and initializes the SMIF as main_cm4.c does.
+*
+*******************************************************************************/
+static void Start(void)
+{
+    SimPowerCycle();
+    configureSMIF(&smifHw, &smifContext);
+}
+
+/*******************************************************************************
+* Function Name: Fill
+********************************************************************************
+*
+* Makes a value which depends on the key and the update.
+*
+*******************************************************************************/
+static uint16_t Fill(uint8_t value[], uint16_t key, uint32_t update)
+{
+    uint16_t size = (uint16_t)(((key * 37u) + (update * 11u)) % SMIF_KV_MAX_VALUE_SIZE) + 1u;
+    uint16_t i;
+
+    for(i = 0u; i < size; i++)
+    {
+        value[i] = (uint8_t)((key * 7u) + (update * 3u) + i);
+    }
+    return size;
+}
+
+/*******************************************************************************
+* Function Name: CheckShadow
+********************************************************************************
+*
+* Compares all keys with the values the tests wrote.
+*
+*******************************************************************************/
+static void CheckShadow(void)
+{
+    uint8_t value[SMIF_KV_MAX_VALUE_SIZE];
+    uint16_t size;
+    uint16_t key;
+    uint32_t bad = 0u;
+
+    for(key = 0u; key < TEST_KEYS; key++)
+    {
+        size = sizeof(value);
+        if(shadowSize[key] == 0u)
+        {
+            bad += (GetKVRecord(key, value, &size) != SMIF_KV_NOT_FOUND) ? 1u : 0u;
+        }
+        else
+        {
+            bad += ((GetKVRecord(key, value, &size) != SMIF_KV_SUCCESS) || (size != shadowSize[key])
+                    || (memcmp(value, shadow[key], size) != 0)) ? 1u : 0u;
+        }
+    }
+    CHECK(bad == 0u);
+}
+
+/*******************************************************************************
+* Function Name: CheckModel
+********************************************************************************
+*
+* The driver used the memory correctly: no command was dropped for a missing
+* WEL or a busy memory, every command was understood and read with the right
+* latency, and no driver call was made in the memory mode.
+*
+*******************************************************************************/
+static void CheckModel(void)
+{
+    sim_stats_t stats;
+
+    SimGetStats(&stats);
+    CHECK(stats.ignored == 0u);
+    CHECK(stats.badCommands == 0u);
+    CHECK(stats.badReads == 0u);
+    CHECK(stats.driverErrors == 0u);
+}
+
+/*******************************************************************************
+* Function Name: SectorCountRange
+********************************************************************************
+*
+* Returns the lowest and highest erase count the model recorded for the
+* sectors of the store.
+*
+*******************************************************************************/
+static void SectorCountRange(uint32_t *minCount, uint32_t *maxCount)
+{
+    uint32_t sector;
+    uint32_t count;
+
+    *minCount = 0xFFFFFFFFu;
+    *maxCount = 0u;
+    for(sector = 0u; sector < SMIF_KV_SECTOR_COUNT; sector++)
+    {
+        count = SimEraseCount((SMIF_KV_START_ADDRESS / SIM_SECTOR_SIZE) + sector);
+        *minCount = (count < *minCount) ? count : *minCount;
+        *maxCount = (count > *maxCount) ? count : *maxCount;
+    }
+}
+
+/*******************************************************************************
+* Function Name: LogSector
+********************************************************************************
+*
+* Returns a sector of the store the store erased, other than the one passed.
+* After a reset of the model, these are the sectors the log was written to.
+*
+*******************************************************************************/
+static uint32_t LogSector(uint32_t other)
+{
+    uint32_t sector;
+
+    for(sector = 0u; sector < SMIF_KV_SECTOR_COUNT; sector++)
+    {
+        if((sector != other) && (SimEraseCount((SMIF_KV_START_ADDRESS / SIM_SECTOR_SIZE) + sector) != 0u))
+        {
+            break;
+        }
+    }
+    return sector;
+}
+
+/*******************************************************************************
+* Function Name: UsedEnd
+********************************************************************************
+*
+* Returns the address after the last programmed byte of a sector, rounded up
+* to the program unit.
+*
+*******************************************************************************/
+static uint32_t UsedEnd(uint32_t sector)
+{
+    uint32_t start = SMIF_KV_START_ADDRESS + (sector * SMIF_KV_SECTOR_SIZE);
+    uint32_t address = start + SMIF_KV_SECTOR_SIZE;
+
+    while((address > start) && (SimArray()[address - 1u] == 0xFFu))
+    {
+        address--;
+    }
+    return (address + SMIF_KV_PROGRAM_UNIT - 1u) & ~(SMIF_KV_PROGRAM_UNIT - 1u);
+}
+
+/*******************************************************************************
+* Function Name: TestFormat
+********************************************************************************
+*
+* An erased region is formatted with one erase and is empty.
+*
+*******************************************************************************/
+static void TestFormat(void)
+{
+    smif_kv_stats_t stats;
+    uint8_t value[4u];
+    uint16_t size = sizeof(value);
+
+    CHECK(MountKVStore() == SMIF_KV_SUCCESS);
+    GetKVStoreStats(&stats);
+    CHECK(stats.keys == 0u);
+    CHECK(stats.freeSectors == (SMIF_KV_SECTOR_COUNT - 1u));
+    CHECK(stats.maxEraseCount == 1u);
+    CHECK(GetKVRecord(1u, value, &size) == SMIF_KV_NOT_FOUND);
+    CheckModel();
+}
+
+/*******************************************************************************
+* Function Name: TestSetGet
+********************************************************************************
+*
+* Values are read back before and after a sync, a power cycle and a mount,
+* deleted keys stay deleted and bad parameters are refused.
+*
+*******************************************************************************/
+static void TestSetGet(void)
+{
+    uint8_t value[SMIF_KV_MAX_VALUE_SIZE + 1u];
+    uint16_t size;
+    uint16_t key;
+
+    for(key = 0u; key < TEST_KEYS; key++)
+    {
+        shadowSize[key] = Fill(shadow[key], key, 0u);
+        CHECK(SetKVRecord(key, shadow[key], shadowSize[key]) == SMIF_KV_SUCCESS);
+    }
+    CheckShadow();
+
+    CHECK(DeleteKVRecord(3u) == SMIF_KV_SUCCESS);
+    shadowSize[3u] = 0u;
+    CHECK(DeleteKVRecord(3u) == SMIF_KV_NOT_FOUND);
+    CheckShadow();
+
+    size = 1u;
+    CHECK(GetKVRecord(4u, value, &size) == SMIF_KV_BAD_PARAM);
+    CHECK(size == shadowSize[4u]);
+    CHECK(SetKVRecord(SMIF_KV_MAX_KEY + 1u, value, 1u) == SMIF_KV_BAD_PARAM);
+    CHECK(SetKVRecord(1u, value, SMIF_KV_MAX_VALUE_SIZE + 1u) == SMIF_KV_BAD_PARAM);
+
+    SyncKVStore();
+    Start();
+    CHECK(MountKVStore() == SMIF_KV_SUCCESS);
+    CheckShadow();
+    CheckModel();
+}
+
+/*******************************************************************************
+* Function Name: TestGarbageCollection
+********************************************************************************
+*
+* Enough updates for several passes over all sectors, with the background 
+* work between them. The erase counts of the store match the erases the
+* memory did, also after a mount, when most sectors are not in the log.
+*
+*******************************************************************************/
+static void TestGarbageCollection(void)
+{
+    smif_kv_stats_t stats;
+    uint32_t update;
+    uint32_t minCount;
+    uint32_t maxCount;
+    uint16_t key;
+
+    for(update = 1u; update <= TEST_UPDATES; update++)
+    {
+        key = (uint16_t)((update * 7u) % TEST_KEYS);
+        shadowSize[key] = Fill(shadow[key], key, update);
+        if(SetKVRecord(key, shadow[key], shadowSize[key]) != SMIF_KV_SUCCESS)
+        {
+            CHECK(false);
+            break;
+        }
+        ProcessKVStore();
+    }
+    CheckShadow();
+
+    GetKVStoreStats(&stats);
+    SectorCountRange(&minCount, &maxCount);
+    CHECK(stats.gcRuns >= (2u * SMIF_KV_SECTOR_COUNT));
+    CHECK(stats.minEraseCount == minCount);
+    CHECK(stats.maxEraseCount == maxCount);
+    CHECK((maxCount - minCount) <= 1u);
+
+    /* Let a started pre-erase end so its stamp is written */
+    while(IsSMIFEraseBusy())
+    {
+    }
+    ProcessKVStore();
+    SectorCountRange(&minCount, &maxCount);
+
+    SyncKVStore();
+    Start();
+    CHECK(MountKVStore() == SMIF_KV_SUCCESS);
+    CheckShadow();
+    GetKVStoreStats(&stats);
+    CHECK(stats.minEraseCount == minCount);
+    CHECK(stats.maxEraseCount == maxCount);
+    CheckModel();
+    SimPrintStats("test_kv updates");
+}
+
+/*******************************************************************************
+* Function Name: TestEraseSuspend
+********************************************************************************
+*
+* A read during a sector erase suspends it and gets the data with a bounded
+* latency. Once a blocking program has waited for the erase, reads no longer
+* suspend.
+*
+*******************************************************************************/
+static void TestEraseSuspend(void)
+{
+    sim_stats_t simStats;
+    uint8_t data[16u];
+    uint8_t expected[16u];
+    uint32_t maxLatency;
+    uint32_t erases = SimEraseCount(TEST_ERASE_ADDRESS / SIM_SECTOR_SIZE);
+
+    StartEraseSMIFSector(TEST_ERASE_ADDRESS);
+    CHECK(IsSMIFEraseBusy());
+
+    ResetEraseReadLatency();
+    SimClearStats();
+    (void)memcpy(expected, &SimArray()[SMIF_KV_START_ADDRESS], sizeof(expected));
+    ReadMemory(data, sizeof(data), SMIF_KV_START_ADDRESS);
+    CHECK(memcmp(data, expected, sizeof(data)) == 0);
+    SimGetStats(&simStats);
+    CHECK(simStats.suspends == 1u);
+    CHECK(simStats.resumes == 1u);
+    CHECK(GetEraseReadLatency(&maxLatency) == 1u);
+    CHECK(maxLatency < 1000u);
+    CHECK(IsSMIFEraseBusy());
+
+    /* The program waits for the erase, reads after it do not suspend */
+    shadowSize[0u] = Fill(shadow[0u], 0u, TEST_UPDATES + 1u);
+    CHECK(SetKVRecord(0u, shadow[0u], shadowSize[0u]) == SMIF_KV_SUCCESS);
+    SyncKVStore();
+    CHECK(SimEraseCount(TEST_ERASE_ADDRESS / SIM_SECTOR_SIZE) == (erases + 1u));
+    ReadMemory(data, sizeof(data), SMIF_KV_START_ADDRESS);
+    SimGetStats(&simStats);
+    CHECK(simStats.suspends == 1u);
+    CHECK(GetEraseReadLatency(&maxLatency) == 1u);
+    CHECK(!IsSMIFEraseBusy());
+    CheckShadow();
+    CheckModel();
+}
+
+/*******************************************************************************
+* Function Name: TestPowerFail
+********************************************************************************
+*
+* Records synced one by one are padded to the program unit and read back over
+* a mount. A program torn by a power loss, either in the value or with the
+* key still erased, ends the log of its sector: the older records are kept,
+* the torn bytes are never programmed again and new records go to another
+* sector.
+*
+*******************************************************************************/
+static void TestPowerFail(void)
+{
+    static const uint8_t tornValue[] = {0x05u, 0x00u, 0x20u, 0x00u, 0x34u, 0x12u, 0xFFu, 0xFFu,
+                                        0xA5u, 0xA5u, 0xA5u, 0xA5u, 0xA5u, 0xA5u};
+    static const uint8_t tornKey[] = {0xFFu, 0xFFu, 0xFFu, 0xFFu, 0x5Au, 0x5Au, 0x5Au, 0x5Au};
+    uint32_t first;
+    uint32_t second;
+    uint32_t end;
+    uint16_t key;
+
+    SimReset();
+    Start();
+    CHECK(MountKVStore() == SMIF_KV_SUCCESS);
+    for(key = 0u; key < TEST_KEYS; key++)
+    {
+        shadowSize[key] = (uint16_t)(key + 1u);
+        (void)memset(shadow[key], (int)key, shadowSize[key]);
+        CHECK(SetKVRecord(key, shadow[key], shadowSize[key]) == SMIF_KV_SUCCESS);
+        SyncKVStore();
+        CHECK((UsedEnd(LogSector(SMIF_KV_SECTOR_COUNT)) % SMIF_KV_PROGRAM_UNIT) == 0u);
+    }
+    Start();
+    CHECK(MountKVStore() == SMIF_KV_SUCCESS);
+    CheckShadow();
+
+    /* Header and a part of the value programmed */
+    first = LogSector(SMIF_KV_SECTOR_COUNT);
+    end = UsedEnd(first);
+    (void)memcpy(&SimArray()[end], tornValue, sizeof(tornValue));
+    Start();
+    CHECK(MountKVStore() == SMIF_KV_SUCCESS);
+    CheckShadow();
+    (void)memset(shadow[5u], 0x55, 16u);
+    shadowSize[5u] = 16u;
+    CHECK(SetKVRecord(5u, shadow[5u], shadowSize[5u]) == SMIF_KV_SUCCESS);
+    SyncKVStore();
+    CHECK(memcmp(&SimArray()[end], tornValue, sizeof(tornValue)) == 0);
+    second = LogSector(first);
+    CHECK(second < SMIF_KV_SECTOR_COUNT);
+
+    /* Key still erased, the bytes after it programmed */
+    end = UsedEnd(second);
+    (void)memcpy(&SimArray()[end], tornKey, sizeof(tornKey));
+    Start();
+    CHECK(MountKVStore() == SMIF_KV_SUCCESS);
+    CheckShadow();
+    (void)memset(shadow[6u], 0x66, 16u);
+    shadowSize[6u] = 16u;
+    CHECK(SetKVRecord(6u, shadow[6u], shadowSize[6u]) == SMIF_KV_SUCCESS);
+    SyncKVStore();
+    CHECK(memcmp(&SimArray()[end], tornKey, sizeof(tornKey)) == 0);
+    CHECK(UsedEnd(second) == (end + SMIF_KV_PROGRAM_UNIT));
+
+    Start();
+    CHECK(MountKVStore() == SMIF_KV_SUCCESS);
+    CheckShadow();
+    CheckModel();
+}
+
+/*******************************************************************************
+* Function Name: TestSmallRecords
+********************************************************************************
+*
+* Measures the rate of small record writes in the model time, including the
+* garbage collection and the erases they cause, and compares it with the 
+* target. The erase of a sector per SMIF_KV_SECTOR_SIZE bytes of records 
+* bounds the rate.
+*
+*******************************************************************************/
+static void TestSmallRecords(void)
+{
+    uint64_t start;
+    uint64_t rate;
+    uint32_t update;
+    uint16_t key;
+
+    SimReset();
+    Start();
+    CHECK(MountKVStore() == SMIF_KV_SUCCESS);
+    (void)memset(shadowSize, 0, sizeof(shadowSize));
+
+    SimClearStats();
+    start = SimTimeNs();
+    for(update = 0u; update < TEST_SMALL_RECORDS; update++)
+    {
+        key = (uint16_t)(update % TEST_KEYS);
+        shadowSize[key] = TEST_SMALL_SIZE;
+        (void)memcpy(shadow[key], &update, sizeof(update));
+        (void)memcpy(&shadow[key][sizeof(update)], &update, sizeof(update));
+        if(SetKVRecord(key, shadow[key], shadowSize[key]) != SMIF_KV_SUCCESS)
+        {
+            CHECK(false);
+            break;
+        }
+        ProcessKVStore();
+    }
+    SyncKVStore();
+    rate = ((uint64_t)TEST_SMALL_RECORDS * 1000000000uLL) / (SimTimeNs() - start);
+    printf("test_kv small records: %u writes/s of %u bytes, target %u\n", (unsigned)rate,
+           (unsigned)TEST_SMALL_SIZE, (unsigned)TEST_SMALL_TARGET);
+    CHECK(rate >= TEST_SMALL_TARGET);
+    CheckShadow();
+    CheckModel();
+    SimPrintStats("test_kv small records");
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests, returns non-zero if a check failed.
+*
+*******************************************************************************/
+int main(void)
+{
+    SimReset();
+    Start();
+
+    TestFormat();
+    TestSetGet();
+    TestGarbageCollection();
+    TestEraseSuspend();
+    SimPrintStats("test_kv erase suspend");
+    TestPowerFail();
+    TestSmallRecords();
+
+    printf("test_kv: %s (%u failed)\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
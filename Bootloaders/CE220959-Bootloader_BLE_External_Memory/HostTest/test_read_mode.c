@@ -0,0 +1,276 @@
+/******************************************************************************
+* File Name: test_read_mode.c
+*
+* Version: 1.0
+*
+* Description: Host tests of the read mode calibration of App0 on the
+*              S25FL512S model, at an SPI clock above the rating of the Read
+*              command (13h), and of the SMIF cache kept by the switch to
+*              the memory mode.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_mem.h"
+#include "s25fl512s_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Checks a condition and counts the failures */
+#define CHECK(cond)     Check((cond), #cond, __LINE__)
+
+/* SPI clock of the tests, above the 50 MHz of 13h */
+#define TEST_SPI_CLOCK          (100000000u)
+
+/* Data which is not the test pattern */
+#define TEST_OTHER_ADDRESS      (SMIF_MEM_CALIB_ADDRESS + 0x1000u)
+
+static uint32_t failures = 0u;
+
+static SMIF_Type smifHw;
+static cy_stc_smif_context_t smifContext;
+
+/*******************************************************************************
+* Function Name: Check
+********************************************************************************
+*
+* Reports a failed check.
+*
+*******************************************************************************/
+static void Check(bool cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("test_read_mode.c:%d: check failed: %s\n", line, text);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: CheckReads
+********************************************************************************
+*
+* Normal and XIP reads of the pattern area return the array contents with 
+* the latency the memory expects.
+*
+*******************************************************************************/
+static void CheckReads(void)
+{
+    uint8_t data[SMIF_MEM_CALIB_SIZE];
+    const uint8_t *expected = &SimArray()[SMIF_MEM_CALIB_ADDRESS];
+    sim_stats_t stats;
+
+    SimClearStats();
+    ReadMemory(data, sizeof(data), SMIF_MEM_CALIB_ADDRESS);
+    CHECK(memcmp(data, expected, sizeof(data)) == 0);
+
+    SwitchSMIFMemory();
+    (void)memset(data, 0, sizeof(data));
+    CHECK(SimXipRead(SMIF_MEM_CALIB_ADDRESS, data, sizeof(data)));
+    CHECK(memcmp(data, expected, sizeof(data)) == 0);
+    SwitchSMIFNormal();
+
+    SimGetStats(&stats);
+    CHECK(stats.badReads == 0u);
+    CHECK(stats.driverErrors == 0u);
+}
+
+/*******************************************************************************
+* Function Name: TestDefault
+********************************************************************************
+*
+* The pattern is programmed into the erased area and the Quad I/O Read of the
+* configuration is kept.
+*
+*******************************************************************************/
+static void TestDefault(void)
+{
+    uint32_t dummy;
+
+    CHECK(CalibrateSMIFReadMode(SMIF_MEM_CALIB_ADDRESS, TEST_SPI_CLOCK) == SMIF_READ_QUAD_IO);
+    CHECK(GetSMIFReadMode(&dummy) == SMIF_READ_QUAD_IO);
+    CHECK(dummy == GetSMIFReadModeDummyCycles(SMIF_READ_QUAD_IO));
+    CHECK(SimArray()[SMIF_MEM_CALIB_ADDRESS] == 0xA5u);
+    CheckReads();
+}
+
+/*******************************************************************************
+* Function Name: TestLatencyCode
+********************************************************************************
+*
+* With a latency code which adds a dummy cycle, the Quad I/O Read is found 
+* with one more dummy cycle and the XIP registers get it too.
+*
+*******************************************************************************/
+static void TestLatencyCode(void)
+{
+    uint32_t dummy;
+
+    SimSetLatencyCode(1u);
+    CHECK(CalibrateSMIFReadMode(SMIF_MEM_CALIB_ADDRESS, TEST_SPI_CLOCK) == SMIF_READ_QUAD_IO);
+    CHECK(GetSMIFReadMode(&dummy) == SMIF_READ_QUAD_IO);
+    CHECK(dummy == (GetSMIFReadModeDummyCycles(SMIF_READ_QUAD_IO) + 1u));
+    CheckReads();
+
+    SimSetLatencyCode(0u);
+    SetSMIFReadMode(SMIF_READ_QUAD_IO, GetSMIFReadModeDummyCycles(SMIF_READ_QUAD_IO));
+}
+
+/*******************************************************************************
+* Function Name: TestKeepsCommand
+********************************************************************************
+*
+* A working read command which is not the one of the mode table, as SFDP 
+* discovery may set, is kept.
+*
+*******************************************************************************/
+static void TestKeepsCommand(void)
+{
+    cy_stc_smif_mem_cmd_t *readCmd = smifMemConfigs[0]->deviceCfg->readCmd;
+
+    readCmd->command = 0x6Cu;
+    readCmd->addrWidth = CY_SMIF_WIDTH_SINGLE;
+    readCmd->mode = 0xFFFFFFFFu;
+    readCmd->dataWidth = CY_SMIF_WIDTH_QUAD;
+    readCmd->dummyCycles = 8u;
+
+    (void)CalibrateSMIFReadMode(SMIF_MEM_CALIB_ADDRESS, TEST_SPI_CLOCK);
+    CHECK(readCmd->command == 0x6Cu);
+    CHECK(readCmd->dummyCycles == 8u);
+    CheckReads();
+
+    SetSMIFReadMode(SMIF_READ_QUAD_IO, GetSMIFReadModeDummyCycles(SMIF_READ_QUAD_IO));
+}
+
+/*******************************************************************************
+* Function Name: TestOtherData
+********************************************************************************
+*
+* An area holding other data fails the calibration and leaves the read
+* command as it was.
+*
+*******************************************************************************/
+static void TestOtherData(void)
+{
+    cy_stc_smif_mem_cmd_t before = *smifMemConfigs[0]->deviceCfg->readCmd;
+    uint8_t other[SMIF_MEM_CALIB_SIZE];
+
+    (void)memset(other, 0x3C, sizeof(other));
+    WriteMemory(other, sizeof(other), TEST_OTHER_ADDRESS);
+
+    CHECK(CalibrateSMIFReadMode(TEST_OTHER_ADDRESS, TEST_SPI_CLOCK) == SMIF_READ_MODE_COUNT);
+    CHECK(memcmp(&before, smifMemConfigs[0]->deviceCfg->readCmd, sizeof(before)) == 0);
+    CHECK(SimArray()[TEST_OTHER_ADDRESS] == 0x3Cu);
+    CheckReads();
+}
+
+/*******************************************************************************
+* Function Name: TestXipCache
+********************************************************************************
+*
+* Switching to the memory mode keeps the SMIF cache unless the memory was 
+* programmed or erased in the normal mode, anywhere in the memory.
+*
+*******************************************************************************/
+static void TestXipCache(void)
+{
+    uint8_t data[16];
+    uint32_t invalidates;
+    uint32_t keeps;
+    uint32_t keepsBefore;
+    uint32_t invalidatesBefore;
+    sim_stats_t stats;
+
+    /* Flush the changes made by the earlier tests */
+    SwitchSMIFMemory();
+    SwitchSMIFNormal();
+    invalidatesBefore = GetXIPInvalidateCount(&keepsBefore);
+    SimClearStats();
+
+    /* Reads and empty changes keep the cache */
+    ReadMemory(data, sizeof(data), TEST_OTHER_ADDRESS);
+    MarkSMIFModified(TEST_OTHER_ADDRESS, 0u);
+    SwitchSMIFMemory();
+    SwitchSMIFNormal();
+    invalidates = GetXIPInvalidateCount(&keeps);
+    CHECK(invalidates == invalidatesBefore);
+    CHECK(keeps == (keepsBefore + 1u));
+
+    /* A program invalidates it once, the next switch keeps it again */
+    (void)memset(data, 0x5A, sizeof(data));
+    WriteMemory(data, sizeof(data), TEST_OTHER_ADDRESS + 0x100u);
+    SwitchSMIFMemory();
+    SwitchSMIFNormal();
+    SwitchSMIFMemory();
+    SwitchSMIFNormal();
+    invalidates = GetXIPInvalidateCount(&keeps);
+    CHECK(invalidates == (invalidatesBefore + 1u));
+    CHECK(keeps == (keepsBefore + 2u));
+
+    /* A change at the top of the memory is in the mapped window too */
+    MarkSMIFModified(smifMemConfigs[0]->deviceCfg->memSize - 1u, 1u);
+    SwitchSMIFMemory();
+    SwitchSMIFNormal();
+    invalidates = GetXIPInvalidateCount(&keeps);
+    CHECK(invalidates == (invalidatesBefore + 2u));
+    CHECK(keeps == (keepsBefore + 2u));
+
+    SimGetStats(&stats);
+    CHECK(stats.cacheInvalidates == 2u);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests, returns non-zero if a check failed.
+*
+*******************************************************************************/
+int main(void)
+{
+    SimReset();
+    SimSetSpiClock(TEST_SPI_CLOCK);
+    configureSMIF(&smifHw, &smifContext);
+
+    TestDefault();
+    TestLatencyCode();
+    TestKeepsCommand();
+    TestOtherData();
+    TestXipCache();
+
+    printf("test_read_mode: %s (%u failed)\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,483 @@
+/******************************************************************************
+* File Name: test_sfdp.c
+*
+* Version: 1.0
+*
+* Description: Host tests of ParseSFDP() and DiscoverSFDP(). The SFDP
+*              images encode the parameters given in the datasheets of the
+*              S25FL512S, W25Q128JV and MX25L51245G.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_sfdp.h"
+#include "s25fl512s_sim.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Build a DWORD of an image in little-endian byte order */
+#define DW(x)   (uint8_t)(x), (uint8_t)((x) >> 8u), (uint8_t)((x) >> 16u), (uint8_t)((x) >> 24u)
+
+/* Offsets of the parameter tables in the images */
+#define BFPT_OFFSET             (0x80u)
+#define FOUR_BYTE_OFFSET        (0xC0u)
+#define IMAGE_SIZE              (0x100u)
+
+/* Checks a condition and counts the failures */
+#define CHECK(cond)     Check((cond), #cond, __LINE__)
+
+static uint32_t failures = 0u;
+
+/* S25FL512S: 512 Mbit, 3 or 4 address bytes, uniform 256 KB sectors with no
+*  4 KB erase, 512 byte page, QE in CR1 written by 01h, 4-byte Address
+*  Instruction Table with 12h, 34h and DCh but no 3Eh.
+*/
+static uint8_t imageS25FL512S[IMAGE_SIZE] =
+{
+    /* SFDP header, JESD216B, two parameter headers */
+    DW(0x50444653u), 0x06u, 0x01u, 0x01u, 0xFFu,
+    /* Basic Flash Parameter Table, 16 DWORDs */
+    0x00u, 0x06u, 0x01u, 16u, DW(0xFF000000u | BFPT_OFFSET),
+    /* 4-byte Address Instruction Table, 2 DWORDs */
+    0x84u, 0x00u, 0x01u, 2u, DW(0xFF000000u | FOUR_BYTE_OFFSET),
+};
+
+static const uint32_t bfptS25FL512S[16u] =
+{
+    0xFFFBFFE7u,    /* No 4 KB erase, 3 or 4 address bytes, 1-1-2, 1-2-2, 1-4-4, 1-1-4 */
+    0x1FFFFFFFu,    /* 512 Mbit */
+    0x6B08EB44u,    /* EBh: 2 mode clocks, 4 dummy cycles; 6Bh: 8 dummy cycles */
+    0xBB803B08u,    /* 3Bh: 8 dummy cycles; BBh: 4 mode clocks */
+    0xFFFFFFEEu,    /* No 2-2-2 or 4-4-4 */
+    0x0000FFFFu,
+    0x0000FFFFu,
+    0x0000D812u,    /* Erase type 1: 256 KB, D8h */
+    0x00000000u,
+    0x00000432u,    /* Type 1 erase 4 x 128 ms typical, maximum 6 x typical */
+    0xD9002592u,    /* 512 byte page, 6 x 64 us program, 26 x 4 s chip erase */
+    0x00000000u,
+    0x00000000u,
+    0x00000000u,
+    0x00500000u,    /* QE is bit 1 of SR2, read by 35h, written by 01h with SR1 */
+    0x00000000u
+};
+
+static const uint32_t fourByteS25FL512S[2u] =
+{
+    0x0000E2FFu,    /* 13h to ECh, 12h, 34h, DCh and DTR reads, no 3Eh */
+    0xFFFFFFDCu     /* Erase type 1: DCh */
+};
+
+/* W25Q128JV in a JESD216 rev 1.0 table of 9 DWORDs: 128 Mbit, 3 address
+*  bytes, 4, 32 and 64 KB erases.
+*/
+static uint8_t imageW25Q128JV[IMAGE_SIZE] =
+{
+    DW(0x50444653u), 0x00u, 0x01u, 0x00u, 0xFFu,
+    0x00u, 0x00u, 0x01u, 9u, DW(0xFF000000u | BFPT_OFFSET),
+};
+
+static const uint32_t bfptW25Q128JV[9u] =
+{
+    0xFFF120E5u,    /* 4 KB erase by 20h, 3 address bytes, 1-1-2, 1-2-2, 1-4-4, 1-1-4 */
+    0x07FFFFFFu,    /* 128 Mbit */
+    0x6B08EB44u,
+    0xBB423B08u,
+    0xFFFFFFEEu,
+    0x0000FFFFu,
+    0x0000FFFFu,
+    0x520F200Cu,    /* 4 KB by 20h, 32 KB by 52h */
+    0x0000D810u     /* 64 KB by D8h */
+};
+
+/* MX25L51245G: 512 Mbit, 3 or 4 address bytes, QE in SR1, 4-byte Address
+*  Instruction Table with 3Eh and all three erase types.
+*/
+static uint8_t imageMX25L51245G[IMAGE_SIZE] =
+{
+    DW(0x50444653u), 0x06u, 0x01u, 0x01u, 0xFFu,
+    0x00u, 0x06u, 0x01u, 16u, DW(0xFF000000u | BFPT_OFFSET),
+    0x84u, 0x00u, 0x01u, 2u, DW(0xFF000000u | FOUR_BYTE_OFFSET),
+};
+
+static const uint32_t bfptMX25L51245G[16u] =
+{
+    0xFFFB20E5u,
+    0x1FFFFFFFu,
+    0x6B08EB44u,
+    0xBB043B08u,
+    0xFFFFFFEEu,
+    0x0000FFFFu,
+    0x0000FFFFu,
+    0x520F200Cu,
+    0x0000D810u,
+    0x00000000u,
+    0x00000082u,    /* 256 byte page */
+    0x00000000u,
+    0x00000000u,
+    0x00000000u,
+    0x00200000u,    /* QE is bit 6 of SR1 */
+    0x00000000u
+};
+
+static const uint32_t fourByteMX25L51245G[2u] =
+{
+    0x00000FFFu,    /* 13h to ECh, 12h, 34h, 3Eh, 21h, 5Ch, DCh */
+    0xFFDC5C21u
+};
+
+/* Command structures filled by the parser */
+static cy_stc_smif_mem_cmd_t readCmd;
+static cy_stc_smif_mem_cmd_t writeEnCmd;
+static cy_stc_smif_mem_cmd_t writeDisCmd;
+static cy_stc_smif_mem_cmd_t eraseCmd;
+static cy_stc_smif_mem_cmd_t chipEraseCmd;
+static cy_stc_smif_mem_cmd_t programCmd;
+static cy_stc_smif_mem_cmd_t readStsRegQeCmd;
+static cy_stc_smif_mem_cmd_t readStsRegWipCmd;
+static cy_stc_smif_mem_cmd_t writeStsRegQeCmd;
+static cy_stc_smif_mem_device_cfg_t cfg;
+
+/*******************************************************************************
+* Function Name: Check
+********************************************************************************
+*
+* Reports a failed check.
+*
+*******************************************************************************/
+static void Check(bool cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("test_sfdp.c:%d: check failed: %s\n", line, text);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: PutTable
+********************************************************************************
+*
+* Copies the DWORDs of a parameter table into an image, the rest of the image
+* reads as erased.
+*
+*******************************************************************************/
+static void PutTable(uint8_t image[], uint32_t offset, const uint32_t table[], uint32_t dwords)
+{
+    uint32_t i;
+
+    for(i = 0u; i < dwords; i++)
+    {
+        image[offset + (i * 4u)] = (uint8_t)table[i];
+        image[offset + (i * 4u) + 1u] = (uint8_t)(table[i] >> 8u);
+        image[offset + (i * 4u) + 2u] = (uint8_t)(table[i] >> 16u);
+        image[offset + (i * 4u) + 3u] = (uint8_t)(table[i] >> 24u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: FillImages
+********************************************************************************
+*
+* Builds the three SFDP images.
+*
+*******************************************************************************/
+static void FillImages(void)
+{
+    (void)memset(&imageS25FL512S[24u], 0xFF, IMAGE_SIZE - 24u);
+    PutTable(imageS25FL512S, BFPT_OFFSET, bfptS25FL512S, 16u);
+    PutTable(imageS25FL512S, FOUR_BYTE_OFFSET, fourByteS25FL512S, 2u);
+
+    (void)memset(&imageW25Q128JV[16u], 0xFF, IMAGE_SIZE - 16u);
+    PutTable(imageW25Q128JV, BFPT_OFFSET, bfptW25Q128JV, 9u);
+
+    (void)memset(&imageMX25L51245G[24u], 0xFF, IMAGE_SIZE - 24u);
+    PutTable(imageMX25L51245G, BFPT_OFFSET, bfptMX25L51245G, 16u);
+    PutTable(imageMX25L51245G, FOUR_BYTE_OFFSET, fourByteMX25L51245G, 2u);
+}
+
+/*******************************************************************************
+* Function Name: ResetConfig
+********************************************************************************
+*
+* Clears the device configuration, values the parser does not set stay zero.
+*
+*******************************************************************************/
+static void ResetConfig(void)
+{
+    (void)memset(&cfg, 0, sizeof(cfg));
+    cfg.readCmd = &readCmd;
+    cfg.writeEnCmd = &writeEnCmd;
+    cfg.writeDisCmd = &writeDisCmd;
+    cfg.eraseCmd = &eraseCmd;
+    cfg.chipEraseCmd = &chipEraseCmd;
+    cfg.programCmd = &programCmd;
+    cfg.readStsRegQeCmd = &readStsRegQeCmd;
+    cfg.readStsRegWipCmd = &readStsRegWipCmd;
+    cfg.writeStsRegQeCmd = &writeStsRegQeCmd;
+    (void)memset(&readStsRegQeCmd, 0, sizeof(readStsRegQeCmd));
+}
+
+/*******************************************************************************
+* Function Name: TestS25FL512S
+********************************************************************************
+*
+* The 4-byte opcodes of the program and erase come from the 4-byte Address
+* Instruction Table, the read opcode is converted from the BFPT.
+*
+*******************************************************************************/
+static void TestS25FL512S(void)
+{
+    ResetConfig();
+    CHECK(ParseSFDP(imageS25FL512S, IMAGE_SIZE, &cfg));
+
+    CHECK(cfg.memSize == 0x04000000u);
+    CHECK(cfg.numOfAddrBytes == 4u);
+
+    CHECK(readCmd.command == 0xECu);
+    CHECK(readCmd.addrWidth == CY_SMIF_WIDTH_QUAD);
+    CHECK(readCmd.dataWidth == CY_SMIF_WIDTH_QUAD);
+    CHECK(readCmd.mode == 0x00u);
+    CHECK(readCmd.modeWidth == CY_SMIF_WIDTH_QUAD);
+    CHECK(readCmd.dummyCycles == 4u);
+
+    /* 1-1-4 program, not the 1-4-4 3Eh the memory does not have */
+    CHECK(programCmd.command == 0x34u);
+    CHECK(programCmd.addrWidth == CY_SMIF_WIDTH_SINGLE);
+    CHECK(programCmd.dataWidth == CY_SMIF_WIDTH_QUAD);
+    CHECK(cfg.programSize == 512u);
+
+    CHECK(eraseCmd.command == 0xDCu);
+    CHECK(cfg.eraseSize == 0x40000u);
+    CHECK(cfg.eraseTime == 3072u);
+    CHECK(cfg.programTime == 2304u);
+    CHECK(cfg.chipEraseTime == 624000u);
+
+    CHECK(readStsRegQeCmd.command == 0x35u);
+    CHECK(writeStsRegQeCmd.command == 0x01u);
+    CHECK(cfg.stsRegQuadEnableMask == 0x02u);
+    CHECK(readStsRegWipCmd.command == 0x05u);
+    CHECK(cfg.stsRegBusyMask == 0x01u);
+    CHECK(writeEnCmd.command == 0x06u);
+    CHECK(chipEraseCmd.command == 0x60u);
+}
+
+/*******************************************************************************
+* Function Name: TestNoFourByteTable
+********************************************************************************
+*
+* Without the 4-byte Address Instruction Table the 3-byte opcodes are
+* converted, and the program stays single.
+*
+*******************************************************************************/
+static void TestNoFourByteTable(void)
+{
+    uint8_t image[IMAGE_SIZE];
+
+    (void)memcpy(image, imageS25FL512S, IMAGE_SIZE);
+    image[6u] = 0x00u;
+
+    ResetConfig();
+    CHECK(ParseSFDP(image, IMAGE_SIZE, &cfg));
+    CHECK(readCmd.command == 0xECu);
+    CHECK(programCmd.command == 0x12u);
+    CHECK(programCmd.dataWidth == CY_SMIF_WIDTH_SINGLE);
+    CHECK(eraseCmd.command == 0xDCu);
+}
+
+/*******************************************************************************
+* Function Name: TestW25Q128JV
+********************************************************************************
+*
+* A 3-byte memory keeps the 3-byte opcodes. Values not described by the rev
+* 1.0 table keep their defaults.
+*
+*******************************************************************************/
+static void TestW25Q128JV(void)
+{
+    ResetConfig();
+    CHECK(ParseSFDP(imageW25Q128JV, IMAGE_SIZE, &cfg));
+
+    CHECK(cfg.memSize == 0x01000000u);
+    CHECK(cfg.numOfAddrBytes == 3u);
+    CHECK(readCmd.command == 0xEBu);
+    CHECK(readCmd.dummyCycles == 4u);
+    CHECK(programCmd.command == 0x02u);
+    CHECK(programCmd.dataWidth == CY_SMIF_WIDTH_SINGLE);
+    CHECK(cfg.programSize == 256u);
+    CHECK(eraseCmd.command == 0xD8u);
+    CHECK(cfg.eraseSize == 0x10000u);
+    CHECK(cfg.eraseTime == 0u);
+    CHECK(readStsRegQeCmd.command == 0x00u);
+}
+
+/*******************************************************************************
+* Function Name: TestMX25L51245G
+********************************************************************************
+*
+* The 1-4-4 program 3Eh is taken with quad address and data, the erase opcode
+* of the largest erase type comes from the 2nd DWORD of the table.
+*
+*******************************************************************************/
+static void TestMX25L51245G(void)
+{
+    ResetConfig();
+    CHECK(ParseSFDP(imageMX25L51245G, IMAGE_SIZE, &cfg));
+
+    CHECK(cfg.numOfAddrBytes == 4u);
+    CHECK(readCmd.command == 0xECu);
+    CHECK(programCmd.command == 0x3Eu);
+    CHECK(programCmd.addrWidth == CY_SMIF_WIDTH_QUAD);
+    CHECK(programCmd.dataWidth == CY_SMIF_WIDTH_QUAD);
+    CHECK(cfg.programSize == 256u);
+    CHECK(eraseCmd.command == 0xDCu);
+    CHECK(cfg.eraseSize == 0x10000u);
+    CHECK(writeStsRegQeCmd.command == 0x01u);
+    CHECK(cfg.stsRegQuadEnableMask == 0x40u);
+}
+
+/*******************************************************************************
+* Function Name: TestFourByteOnly
+********************************************************************************
+*
+* A memory which only takes 4 address bytes keeps its read opcode, but the
+* program and erase still come from the 4-byte Address Instruction Table.
+*
+*******************************************************************************/
+static void TestFourByteOnly(void)
+{
+    uint8_t image[IMAGE_SIZE];
+
+    (void)memcpy(image, imageMX25L51245G, IMAGE_SIZE);
+    image[BFPT_OFFSET + 2u] = 0xFDu;
+
+    ResetConfig();
+    CHECK(ParseSFDP(image, IMAGE_SIZE, &cfg));
+    CHECK(cfg.numOfAddrBytes == 4u);
+    CHECK(readCmd.command == 0xEBu);
+    CHECK(programCmd.command == 0x3Eu);
+    CHECK(programCmd.addrWidth == CY_SMIF_WIDTH_QUAD);
+    CHECK(eraseCmd.command == 0xDCu);
+}
+
+/*******************************************************************************
+* Function Name: TestBadImages
+********************************************************************************
+*
+* Images without the signature or a complete BFPT are rejected.
+*
+*******************************************************************************/
+static void TestBadImages(void)
+{
+    uint8_t image[IMAGE_SIZE];
+
+    (void)memcpy(image, imageS25FL512S, IMAGE_SIZE);
+    image[0u] = 0x00u;
+    ResetConfig();
+    CHECK(!ParseSFDP(image, IMAGE_SIZE, &cfg));
+
+    /* Table ends past the image */
+    ResetConfig();
+    CHECK(!ParseSFDP(imageS25FL512S, BFPT_OFFSET + 32u, &cfg));
+
+    (void)memcpy(image, imageW25Q128JV, IMAGE_SIZE);
+    image[11u] = 8u;
+    ResetConfig();
+    CHECK(!ParseSFDP(image, IMAGE_SIZE, &cfg));
+}
+
+/*******************************************************************************
+* Function Name: TestDiscoverSFDP
+********************************************************************************
+*
+* DiscoverSFDP() reads the tables of the modeled S25FL512S with 5Ah and
+* gets the same configuration as the parser does from the image. Without an
+* enabled block nothing is read.
+*
+*******************************************************************************/
+static void TestDiscoverSFDP(void)
+{
+    SMIF_Type smifHw;
+    cy_stc_smif_context_t smifContext;
+    sim_stats_t stats;
+
+    SimReset();
+    SimLoadSfdp(imageS25FL512S, IMAGE_SIZE);
+
+    ResetConfig();
+    CHECK(!DiscoverSFDP(&smifHw, &smifContext, CY_SMIF_SLAVE_SELECT_0, &cfg));
+
+    Cy_SMIF_Enable(&smifHw, &smifContext);
+    ResetConfig();
+    CHECK(DiscoverSFDP(&smifHw, &smifContext, CY_SMIF_SLAVE_SELECT_0, &cfg));
+    CHECK(cfg.memSize == 0x04000000u);
+    CHECK(cfg.numOfAddrBytes == 4u);
+    CHECK(readCmd.command == 0xECu);
+    CHECK(readCmd.dummyCycles == 4u);
+    CHECK(programCmd.command == 0x34u);
+    CHECK(eraseCmd.command == 0xDCu);
+    CHECK(cfg.eraseSize == 0x40000u);
+    CHECK(cfg.programSize == 512u);
+
+    /* One transaction of 256 bytes after the opcode, address and dummy cycles */
+    SimGetStats(&stats);
+    CHECK(stats.commands == 1u);
+    CHECK(stats.busClocks == (8u + 24u + 8u + (256u * 8u)));
+    CHECK(stats.badCommands == 0u);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests, returns non-zero if a check failed.
+*
+*******************************************************************************/
+int main(void)
+{
+    FillImages();
+
+    TestS25FL512S();
+    TestNoFourByteTable();
+    TestW25Q128JV();
+    TestMX25L51245G();
+    TestFourByteOnly();
+    TestBadImages();
+    TestDiscoverSFDP();
+
+    printf("test_sfdp: %s (%u failed)\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+
+/* [] END OF FILE */
@@ -48,6 +48,9 @@
 *******************************************************************************/
 #include "project.h"
 #include <string.h>
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+#include "smif_mem.h"
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
 
 #if defined (__GNUC__) || defined (__ARMCC_VERSION)
 /* Flag which signals a Stack update is available and must be copied */
@@ -67,6 +70,9 @@ CY_SECTION(".cy_boot_noinit") __USED static uint32_t CyReturnToBootloaddableAddr
 static bool IsButtonPressed(uint16_t timeoutInMilis);
 static cy_en_bootload_status_t CopyRow(uint32_t dest, uint32_t src, uint32_t rowSize, cy_stc_bootload_params_t * params);
 static cy_en_bootload_status_t HandleMetadata(cy_stc_bootload_params_t *params);
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+static cy_en_bootload_status_t StreamCopyApp(uint32_t dest, uint32_t src, uint32_t length, cy_stc_bootload_params_t * params);
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
 
 /*******************************************************************************
 * Function Name: main
@@ -125,8 +131,19 @@ int main(void)
         Cy_GPIO_Write(PIN_LED_RED_PORT, PIN_LED_RED_NUM, 0u);
         Cy_GPIO_Write(PIN_LED_BLUE_PORT, PIN_LED_BLUE_NUM, 0u);        
         
-        /* Copy Stack update to proper location */
-        status = Cy_Bootload_CopyApp(destAddress, srcAddress, copyLength, CY_FLASH_SIZEOF_ROW, &bootParams);
+    #if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+        if ( (CY_XIP_BASE <= srcAddress) && (srcAddress < (CY_XIP_BASE + CY_XIP_SIZE)) )
+        {
+            /* Stack update is staged in the external memory, stream it to proper location */
+            configureSMIF(SMIF_HW, &SMIF_context);
+            status = StreamCopyApp(destAddress, srcAddress, copyLength, &bootParams);
+        }
+        else
+    #endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
+        {
+            /* Copy Stack update to proper location */
+            status = Cy_Bootload_CopyApp(destAddress, srcAddress, copyLength, CY_FLASH_SIZEOF_ROW, &bootParams);
+        }
         
         if(status == CY_BOOTLOAD_SUCCESS)
         {
@@ -280,6 +297,45 @@ static cy_en_bootload_status_t CopyRow(uint32_t dest, uint32_t src, uint32_t row
     return (status);
 }
 
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+/*******************************************************************************
+* Function Name: StreamCopyApp
+********************************************************************************
+* Copies an application staged in the external memory to internal flash, one
+* flash row at a time. Each row is read with ReadMemory() into the
+* params->dataBuffer and then written to flash, so the SMIF stays in normal
+* mode and no more RAM than one row is needed.
+*
+* Parameters:
+*  dest     Destination address. Has to be an address of the start of flash row.
+*  src      Source address in the XIP region. Has to be row aligned.
+*  length   Number of bytes to copy, rounded up to whole flash rows.
+*  params   A pointer to a Bootloader SDK parameters structure.
+*
+* Returns:
+*  CY_BOOTLAOD_SUCCESS if operation is successful.
+*  Error code in a case of failure.
+*******************************************************************************/
+static cy_en_bootload_status_t StreamCopyApp(uint32_t dest, uint32_t src, uint32_t length, cy_stc_bootload_params_t * params)
+{
+    cy_en_bootload_status_t status = CY_BOOTLOAD_SUCCESS;
+    uint32_t offset;
+    
+    for(offset = 0u; (offset < length) && (status == CY_BOOTLOAD_SUCCESS); offset += CY_FLASH_SIZEOF_ROW)
+    {
+        if (ReadMemory(params->dataBuffer, CY_FLASH_SIZEOF_ROW, (src - CY_XIP_BASE) + offset) != CY_SMIF_SUCCESS)
+        {
+            status = CY_BOOTLOAD_ERROR_DATA;
+        }
+        else
+        {
+            status = Cy_Bootload_WriteData(dest + offset, CY_FLASH_SIZEOF_ROW, CY_BOOTLOAD_IOCTL_WRITE, params);
+        }
+    }
+    return (status);
+}
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
+
 /*******************************************************************************
 * Function Name: HandleMetadata
 ********************************************************************************
@@ -26,11 +26,20 @@
 #include "syslib/cy_syslib.h"
 #include "flash/cy_flash.h"
 #include "bootloader/cy_bootload.h"
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+#include "smif_mem.h"
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
 
 
 static uint32_t IsMultipleOf(uint32_t value, uint32_t multiple);
 static void GetStartEndAddress(uint32_t appId, uint32_t *startAddress, uint32_t *endAddress);
 
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+/* External sector erased last in this session, rows of a sector arrive in order */
+#define NO_ERASED_SECTOR    (0xFFFFFFFFu)
+static uint32_t lastErasedSector = NO_ERASED_SECTOR;
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
+
 
 /*******************************************************************************
 * Function Name: IsMultipleOf
@@ -99,6 +108,11 @@ cy_en_bootload_status_t Cy_Bootload_WriteData (uint32_t address, uint32_t length
     /* EM_EEPROM Limits*/
     const uint32_t minEmEepromAddress = CY_EM_EEPROM_BASE;
     const uint32_t maxEmEepromAddress = CY_EM_EEPROM_BASE + CY_EM_EEPROM_SIZE;
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+    /* XIP Limits */
+    const uint32_t minXIPAddress = CY_XIP_BASE;
+    const uint32_t maxXIPAddress = CY_XIP_BASE + CY_XIP_SIZE;
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
     
     cy_en_bootload_status_t status = CY_BOOTLOAD_SUCCESS;
 
@@ -151,12 +165,17 @@ cy_en_bootload_status_t Cy_Bootload_WriteData (uint32_t address, uint32_t length
                 memcpy( &params->dataBuffer[(4 * METADATA_BYTES_PER_APP)], 
                         &params->dataBuffer[(3 * METADATA_BYTES_PER_APP)], METADATA_BYTES_PER_APP);
 
+            #if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+                /* Set temporal location as the start of the external memory, App2 is kept intact */
+                temporalLocation = minXIPAddress;
+            #else
                 /* 
                 *  Set temporal location as App2 start address. If another address is desired
                 *  to store the stack temporarilly. Remove the following line and set the
                 *  desired address to temporalLocation variable.
                 */
                 Cy_Bootload_GetAppMetadata(2u, &temporalLocation, NULL);
+            #endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
                 
                 memcpy( &params->dataBuffer[(3 * METADATA_BYTES_PER_APP)], &temporalLocation, sizeof(uint32_t));
                 
@@ -198,6 +217,12 @@ cy_en_bootload_status_t Cy_Bootload_WriteData (uint32_t address, uint32_t length
                 }
                 /* Else: Do nothing, this is an allowed memory range to bootload to */
             }
+        #if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+            else if ( (params->appId == 3u) && (minXIPAddress <= address) && (address < maxXIPAddress) )
+            {
+                /* Do nothing, the stack update is staged in the external memory */
+            }
+        #endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
             else
             {
                 status = CY_BOOTLOAD_ERROR_ADDRESS;   
@@ -233,12 +258,41 @@ cy_en_bootload_status_t Cy_Bootload_WriteData (uint32_t address, uint32_t length
     
     if (status == CY_BOOTLOAD_SUCCESS)
     {
-        if ((ctl & CY_BOOTLOAD_IOCTL_ERASE) != 0u)
+    #if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+        if ( (minXIPAddress <= address) && (address < maxXIPAddress) )
         {
-            (void) memset(params->dataBuffer, 0, CY_FLASH_SIZEOF_ROW);
+            uint32_t offset = address - minXIPAddress;
+            uint32_t sector = offset / deviceCfg_S25FL512S_0.eraseSize;
+            cy_en_smif_status_t smifStatus = CY_SMIF_SUCCESS;
+            
+            /* 
+            * Erase each external sector when the first row inside it is received,
+            * so only the sectors used by the stack update are erased. The update
+            * may start in the middle of a sector.
+            */
+            if (sector != lastErasedSector)
+            {
+                smifStatus = EraseSMIFSector(sector * deviceCfg_S25FL512S_0.eraseSize);
+                lastErasedSector = sector;
+            }
+            
+            /* An erase-only row stays erased */
+            if ( (smifStatus == CY_SMIF_SUCCESS) && ((ctl & CY_BOOTLOAD_IOCTL_ERASE) == 0u) )
+            {
+                smifStatus = WriteMemory(params->dataBuffer, length, offset);
+            }
+            status = (smifStatus == CY_SMIF_SUCCESS) ? CY_BOOTLOAD_SUCCESS : CY_BOOTLOAD_ERROR_DATA;
+        }
+        else
+    #endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
+        {
+            if ((ctl & CY_BOOTLOAD_IOCTL_ERASE) != 0u)
+            {
+                (void) memset(params->dataBuffer, 0, CY_FLASH_SIZEOF_ROW);
+            }
+            cy_en_flashdrv_status_t fstatus =  Cy_Flash_WriteRow(address, (uint32_t*)params->dataBuffer);
+            status = (fstatus == CY_FLASH_DRV_SUCCESS) ? CY_BOOTLOAD_SUCCESS : CY_BOOTLOAD_ERROR_DATA;
         }
-        cy_en_flashdrv_status_t fstatus =  Cy_Flash_WriteRow(address, (uint32_t*)params->dataBuffer);
-        status = (fstatus == CY_FLASH_DRV_SUCCESS) ? CY_BOOTLOAD_SUCCESS : CY_BOOTLOAD_ERROR_DATA;
     }
     return (status);
 }
@@ -262,6 +316,11 @@ cy_en_bootload_status_t Cy_Bootload_ReadData (uint32_t address, uint32_t length,
     /* EM_EEPROM Limits*/
     const uint32_t minEmEepromAddress = CY_EM_EEPROM_BASE;
     const uint32_t maxEmEepromAddress = CY_EM_EEPROM_BASE + CY_EM_EEPROM_SIZE;
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+    /* XIP Limits */
+    const uint32_t minXIPAddress = CY_XIP_BASE;
+    const uint32_t maxXIPAddress = CY_XIP_BASE + CY_XIP_SIZE;
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
     
     cy_en_bootload_status_t status = CY_BOOTLOAD_SUCCESS;
 
@@ -297,6 +356,11 @@ cy_en_bootload_status_t Cy_Bootload_ReadData (uint32_t address, uint32_t length,
           || ( (minEmEepromAddress <= address) && (address < maxEmEepromAddress) )  )
         {   /* Do nothing, this is an allowed memory range to bootload to */
         }
+    #if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+        else if ( (minXIPAddress <= address) && (address < maxXIPAddress) )
+        {   /* Do nothing, the stack update is staged in the external memory */
+        }
+    #endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
         else
         {
             status = CY_BOOTLOAD_ERROR_ADDRESS;   
@@ -304,6 +368,30 @@ cy_en_bootload_status_t Cy_Bootload_ReadData (uint32_t address, uint32_t length,
     }
 
     /* Read or Compare */
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+    if ( (status == CY_BOOTLOAD_SUCCESS) && (minXIPAddress <= address) && (address < maxXIPAddress) )
+    {
+        if ((ctl & CY_BOOTLOAD_IOCTL_COMPARE) == 0u)
+        {
+            status = (ReadMemory(params->dataBuffer, length, address - minXIPAddress) == CY_SMIF_SUCCESS)
+                     ? CY_BOOTLOAD_SUCCESS : CY_BOOTLOAD_ERROR_DATA;
+        }
+        else
+        {
+            uint8_t buffer[CY_BOOTLOAD_SIZEOF_DATA_BUFFER];
+            if (ReadMemory(&buffer[0], length, address - minXIPAddress) != CY_SMIF_SUCCESS)
+            {
+                status = CY_BOOTLOAD_ERROR_DATA;
+            }
+            else
+            {
+                status = ( memcmp(params->dataBuffer, &buffer[0], length) == 0 )
+                         ? CY_BOOTLOAD_SUCCESS : CY_BOOTLOAD_ERROR_VERIFY;
+            }
+        }
+    }
+    else
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
     if (status == CY_BOOTLOAD_SUCCESS)
     {
         if ((ctl & CY_BOOTLOAD_IOCTL_COMPARE) == 0u)
@@ -321,6 +409,63 @@ cy_en_bootload_status_t Cy_Bootload_ReadData (uint32_t address, uint32_t length,
 }
 
 
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+/*******************************************************************************
+* Function Name: Cy_Bootload_ValidateApp
+****************************************************************************//**
+*
+* Modified implementation of this weak function. Switches the SMIF to memory
+* mode when the application (a staged stack update) is in the external memory.
+*
+* \note It is assumed appId is valid application number.
+*
+* \param appId      An application number of the application to be validated.
+*
+* \param params     A pointer to a bootloader parameters structure.
+*                   See \ref cy_stc_bootload_params_t .
+* \returns
+* - \ref CY_BOOTLOAD_SUCCESS if application is valid.
+* - \ref CY_BOOTLOAD_ERROR_VERIFY if application in invalid.
+*
+*******************************************************************************/
+cy_en_bootload_status_t Cy_Bootload_ValidateApp(uint32_t appId, cy_stc_bootload_params_t *params)
+{
+    const uint32_t minXIPAddress = CY_XIP_BASE;
+    const uint32_t maxXIPAddress = CY_XIP_BASE + CY_XIP_SIZE;
+    uint32_t appStartAddress;
+    uint32_t appSize;
+    
+    CY_ASSERT(appId < CY_BOOTLOAD_MAX_APPS);
+    
+    cy_en_bootload_status_t status = Cy_Bootload_GetAppMetadata(appId, &appStartAddress, &appSize);
+    
+    if (status == CY_BOOTLOAD_SUCCESS)
+    {
+        bool isExternal = (minXIPAddress <= appStartAddress) && (appStartAddress < maxXIPAddress);
+        
+        if (isExternal)
+        {
+            /* Switch to XIP mode to enable direct access and avoid reimplementing the crc algorithm */
+            SwitchSMIFMemory();
+        }
+        
+        /* Calculate CRC */
+        uint32_t appCrc = Cy_Bootload_DataChecksum((uint8_t *)appStartAddress, appSize, params);
+        uint32_t appFooterAddress = appStartAddress + appSize;
+
+        status = (*(uint32_t*)appFooterAddress == appCrc) ? CY_BOOTLOAD_SUCCESS : CY_BOOTLOAD_ERROR_VERIFY;
+        
+        if (isExternal)
+        {
+            /* Return to normal SMIF mode, to use regular read/write functions */
+            SwitchSMIFNormal();
+        }
+    }
+    return (status);
+}
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
+
+
 /*******************************************************************************
 * Function Name: Cy_Bootload_TransportRead
 ****************************************************************************//**
@@ -370,6 +515,10 @@ void Cy_Bootload_TransportReset(void)
 *******************************************************************************/
 void Cy_Bootload_TransportStart(void)
 {
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+    /* A new session erases its sectors again */
+    lastErasedSector = NO_ERASED_SECTOR;
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
     CyBLE_CyBtldrCommStart();
 }
 
@@ -130,6 +130,14 @@
 
 /** \} group_bootload_macro_config */
 
+/**
+* A non-zero value stages a stack update (vApp3) in the external SMIF memory
+* instead of the App2 flash area, so App2 survives a stack update. The
+* launcher (App0) streams the staged image into internal flash.
+* Requires a SMIF component named "SMIF" in the App0 and App1 TopDesign.
+*/
+#define CY_BOOTLOAD_OPT_EXTERNAL_STAGING    (0)
+
 #if !defined(CY_DOXYGEN)
     #if defined(__GNUC__) || defined(__ICCARM__)
         /*
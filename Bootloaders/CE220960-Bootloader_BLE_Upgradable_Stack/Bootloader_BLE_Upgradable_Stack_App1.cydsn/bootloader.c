@@ -53,6 +53,9 @@
 #include "debug.h"
 #include "ias.h"
 #include "transport_ble.h"
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+#include "smif_mem.h"
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
 
 /* BLE GAPP Connection Settings */
 #define CYBLE_GAPP_CONNECTION_INTERVAL_MIN  (0x000Cu) /* 15 ms - (N * 1,25)*/
@@ -116,6 +119,11 @@ void BootloaderMain(void)
     
     /* Initializes LEDs */
     InitLED();
+    
+#if (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0)
+    /* Initialize the external memory, stack updates are staged there */
+    configureSMIF(SMIF_HW, &SMIF_context);
+#endif /* (CY_BOOTLOAD_OPT_EXTERNAL_STAGING != 0) */
 
     /* Initialize bootParams structure and Bootloader SDK state */
     bootParams.timeout          = paramsTimeout;
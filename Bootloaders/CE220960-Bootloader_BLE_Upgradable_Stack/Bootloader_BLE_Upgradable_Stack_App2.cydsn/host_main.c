@@ -129,6 +129,9 @@ void AppCallBack(uint32_t event, void* eventParam)
                 
                 /* Press and hold the mechanical button (SW2) during 4 seconds to clear the bond list. */
                 App_RemoveDevicesFromBondListBySW2Press(SW2_PRESS_TIME_DEL_BOND_LIST);     
+                
+                /* Count down the bond store hold-off time */
+                App_BondStoreTick();
             }
             break;
             
@@ -386,6 +389,7 @@ void AppCallBack(uint32_t event, void* eventParam)
             * structures are modified and require to be stored in Flash using 
             * Cy_BLE_StoreBondingData() */
             DBG_PRINTF("CY_BLE_EVT_PENDING_FLASH_WRITE\r\n");
+            App_BondStoreRequest();
             break;
             
         default:
@@ -490,14 +494,8 @@ int HostMain(void)
             App_RemoveDevicesFromBondList();
         }  
         
-    #if(CY_BLE_BONDING_REQUIREMENT == CY_BLE_BONDING_YES)
-        /* Store bonding data to flash only when all debug information has been sent */    
-        if(cy_ble_pendingFlashWrite != 0u) 
-        {   
-            apiResult = Cy_BLE_StoreBondingData();    
-            DBG_PRINTF("Store bonding data, status: %x, pending: %x \r\n", apiResult, cy_ble_pendingFlashWrite);
-        }
-    #endif /* CY_BLE_BONDING_REQUIREMENT == CY_BLE_BONDING_YES */
+        /* Commit coalesced bonding data updates, at most one row write per pass */
+        App_BondStoreTask();
         
         if (alertLevel != 0u)
         {
@@ -518,6 +516,9 @@ int HostMain(void)
                     Cy_BLE_ProcessEvents();
                 }
             }
+            /* Store bonding data which is still pending before leaving the application */
+            App_BondStoreFlush();
+            
             /* Stop BLE component. */
             Cy_BLE_Disable();
             Cy_Bootload_ExecuteApp(1u);
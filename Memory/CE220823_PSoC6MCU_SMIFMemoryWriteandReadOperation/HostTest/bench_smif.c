@@ -0,0 +1,89 @@
+/******************************************************************************
+* File Name: bench_smif.c
+*
+* Version: 1.0
+*
+* Description: Runs the SMIF benchmark of CE220823 on the S25FL512S model of
+*              CE220959 with the memory configuration of the example. The
+*              CSV goes to stdout. The run fails if the model saw a command
+*              it does not take.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_bench.h"
+#include "s25fl512s_sim.h"
+#include "project.h"
+#include <stdio.h>
+
+static SMIF_Type smifHw;
+static cy_stc_smif_context_t smifContext;
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Starts the SMIF, sets the QE bit and runs the benchmark, returns non-zero 
+* if the model reported an error.
+*
+*******************************************************************************/
+int main(void)
+{
+    cy_stc_smif_mem_config_t *memConfig = (cy_stc_smif_mem_config_t*)smifMemConfigs[0];
+    sim_stats_t stats;
+    bool pass;
+    
+    SimReset();
+    (void)Cy_SMIF_Init(&smifHw, &SMIF_config, 1000u, &smifContext);
+    Cy_SMIF_Enable(&smifHw, &smifContext);
+    (void)Cy_SMIF_Memslot_Init(&smifHw, (cy_stc_smif_block_config_t*)&smifBlockConfig, &smifContext);
+    
+    (void)Cy_SMIF_Memslot_QuadEnable(&smifHw, memConfig, &smifContext);
+    while(Cy_SMIF_Memslot_IsBusy(&smifHw, memConfig, &smifContext))
+    {
+        /* Wait until the status register is written */
+    }
+    
+    SimClearStats();
+    RunSMIFBenchmark(&smifHw, &smifContext, memConfig, &smifBenchS25FL512S, BENCH_ADDRESS);
+    
+    SimGetStats(&stats);
+    pass = (stats.ignored == 0u) && (stats.badCommands == 0u) &&
+           (stats.badReads == 0u) && (stats.driverErrors == 0u);
+    fprintf(stderr, "bench_smif: %s (%u ignored, %u bad commands, %u bad reads, %u driver errors)\n",
+            pass ? "PASS" : "FAIL", (unsigned)stats.ignored, (unsigned)stats.badCommands,
+            (unsigned)stats.badReads, (unsigned)stats.driverErrors);
+    return pass ? 0 : 1;
+}
+
+/* [] END OF FILE */
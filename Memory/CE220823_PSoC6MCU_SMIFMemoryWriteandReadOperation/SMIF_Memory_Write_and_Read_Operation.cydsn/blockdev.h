@@ -0,0 +1,93 @@
+/******************************************************************************
+* File Name: blockdev.h
+*
+* Version: 1.0
+*
+* Description: This header file contains the block device interface shared
+*              by the external memory drivers.
+*
+* Related Document: CE220823_PSoC6MCU_SMIFMemoryWriteandReadOperation.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef BLOCKDEV_H
+#define BLOCKDEV_H
+
+#include <stdint.h>
+
+/*******************************************************************************
+*            Block device interface
+*******************************************************************************/
+/* The same interface is used by the NOR flash (CE220823), the SPI F-RAM 
+* (CE222460) and the QSPI F-RAM (CE222967) drivers, so the code on top of it 
+* runs on any of these memories.
+*/
+
+/* Status of the block device operations */
+typedef enum
+{
+    BLOCKDEV_SUCCESS = 0u,      /* The operation is completed               */
+    BLOCKDEV_BAD_PARAM,         /* Out of range or not aligned to the erase unit */
+    BLOCKDEV_DEVICE_ERROR       /* The memory command failed                */
+} blockdev_status_t;
+
+/* Capability flags */
+#define BLOCKDEV_ERASE_NEEDED   (0x01u)     /* Program can only clear bits, erase first */
+
+/* Capabilities of a memory */
+typedef struct
+{
+    const char *name;           /* Memory part name */
+    uint32_t size;              /* Addressable size in bytes */
+    uint32_t pageSize;          /* Program page, 1 for byte-writable memories */
+    uint32_t eraseSize;         /* Erase unit, 1 if any range can be erased */
+    uint8_t  maxWidth;          /* Data lines of the fastest transfer: 1, 2 or 4 */
+    uint8_t  flags;             /* BLOCKDEV_ERASE_NEEDED */
+} blockdev_caps_t;
+
+/* Block device: the capabilities and the driver functions. All functions 
+* block until the memory is ready again. Read and program accept any 
+* alignment and length inside the memory. Erased memory reads 0xFF.
+*/
+typedef struct
+{
+    blockdev_caps_t caps;
+    blockdev_status_t (*read)(uint32_t address, uint8_t buffer[], uint32_t size);
+    blockdev_status_t (*program)(uint32_t address, const uint8_t buffer[], uint32_t size);
+    blockdev_status_t (*erase)(uint32_t address, uint32_t size);
+} blockdev_t;
+
+#endif /* BLOCKDEV_H */
+
+/* [] END OF FILE */
@@ -219,7 +219,7 @@ cy_stc_smif_mem_device_cfg_t deviceCfg_S25FL512S_0 =
     /**< This specifies the erase command */
     .eraseCmd = &S25FL512S_0_eraseCmd,
     /**< This specifies the sector size of each erase */
-    .eraseSize = 0x0001000U,
+    .eraseSize = 0x0040000U,
     /**< This specifies the chip erase command */
     .chipEraseCmd = &S25FL512S_0_chipEraseCmd,
     /**< This specifies the program command */
@@ -237,7 +237,7 @@ cy_stc_smif_mem_device_cfg_t deviceCfg_S25FL512S_0 =
     /**< Mask for the status register */
     .stsRegQuadEnableMask = 0x02U,
     /**< Max time for erase type 1 cycle time in ms */
-    .eraseTime = 140U,
+    .eraseTime = 2600U,
     /**< Max time for chip erase cycle time in ms */
     .chipEraseTime = 70000U,
     /**< Max time for page program cycle time in us */
@@ -265,8 +265,34 @@ const cy_stc_smif_mem_config_t S25FL512S_SlaveSlot_0 =
     .deviceCfg = &deviceCfg_S25FL512S_0
 };
 
+#if (SMIF_STRIPED_ENABLED != 0u)
+const cy_stc_smif_mem_config_t S25FL512S_SlaveSlot_1 =
+{
+    /**< Determines the slot number where the memory device is placed */
+    .slaveSelect = CY_SMIF_SLAVE_SELECT_2,
+    /**< Flags */
+    .flags = CY_SMIF_FLAG_MEMORY_MAPPED | CY_SMIF_FLAG_WR_EN,
+    /**< Data line selection options for a slave device */
+    .dataSelect = CY_SMIF_DATA_SEL2,
+    /**< The base address the memory slave is mapped to in the PSoC memory map.
+    Valid when memory mapped mode is enabled */
+    .baseAddress = 0x18010000U,
+    /**< The size allocated in the PSoC memory map, for the memory slave device.
+    The size is allocated from the base address Valid when memory mapped mode is enabled */
+    .memMappedSize = 0x10000U,
+    /**< Is this memory device one of the devices in a dual quad SPI configuration.
+    Valid when memory mapped mode is enabled */
+    .dualQuadSlots = 0,
+    /**< Configuration of the device */
+    .deviceCfg = &deviceCfg_S25FL512S_0
+};
+#endif /* (SMIF_STRIPED_ENABLED != 0u) */
+
 const cy_stc_smif_mem_config_t* smifMemConfigs[] = {
    &S25FL512S_SlaveSlot_0
+#if (SMIF_STRIPED_ENABLED != 0u)
+   ,&S25FL512S_SlaveSlot_1
+#endif /* (SMIF_STRIPED_ENABLED != 0u) */
 };
 
 const cy_stc_smif_block_config_t smifBlockConfig =
@@ -44,7 +44,16 @@
 #define CY_SMIF_MEMCONFIG_H
 #include "smif/cy_smif_memslot.h"
 
+/* Set to non-zero to add a second S25FL512S on slave select 2 and data
+* lines 4-7, used by the striped mode of smif_stripe.c
+*/
+#define SMIF_STRIPED_ENABLED (0u)
+
+#if (SMIF_STRIPED_ENABLED != 0u)
+#define CY_SMIF_DEVICE_NUM 2
+#else
 #define CY_SMIF_DEVICE_NUM 1
+#endif /* (SMIF_STRIPED_ENABLED != 0u) */
 
 extern cy_stc_smif_mem_cmd_t S25FL512S_0_readCmd;
 extern cy_stc_smif_mem_cmd_t S25FL512S_0_writeEnCmd;
@@ -60,6 +69,10 @@ extern cy_stc_smif_mem_device_cfg_t S25FL512S_0_DeviceCfg;
 
 extern const cy_stc_smif_mem_config_t S25FL512S_0;
 
+#if (SMIF_STRIPED_ENABLED != 0u)
+extern const cy_stc_smif_mem_config_t S25FL512S_SlaveSlot_1;
+#endif /* (SMIF_STRIPED_ENABLED != 0u) */
+
 extern const cy_stc_smif_mem_config_t* smifMemConfigs[CY_SMIF_DEVICE_NUM];
 
 extern const cy_stc_smif_block_config_t smifBlockConfig;
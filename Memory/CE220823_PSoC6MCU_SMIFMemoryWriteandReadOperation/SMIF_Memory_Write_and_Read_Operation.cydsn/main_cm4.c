@@ -43,6 +43,9 @@
 *******************************************************************************/
 
 #include "smif_mem.h"
+#include "smif_stripe.h"
+#include "smif_bench.h"
+#include <string.h>
 
 /*******************************************************************************
 *            Function Prototypes
@@ -54,6 +57,9 @@ void SMIF_Interrupt_User(void);
 /*******************************************************************************
 *            Constants
 *******************************************************************************/
+#if (SMIF_STRIPED_ENABLED != 0u)
+#define STRIPE_PACKET_SIZE  (4u * PACKET_SIZE)  /* Spans two units of each memory */
+#endif /* (SMIF_STRIPED_ENABLED != 0u) */
 
 /*******************************************************************************
 *            Global variables
@@ -78,6 +84,9 @@ void SMIF_Interrupt_User(void);
 *  8. Reads 256-bytes of data from memory in quad mode and compares with the 
 *     written data.
 *  9. Indicates Pass or Fail LED status
+*  10. With SMIF_STRIPED_ENABLED, repeats the write and read across both 
+*      memories in the striped mode
+*  11. With SMIF_BENCH_ENABLED, prints the SMIF benchmark results as CSV
 *
 * Parameters:
 *  None
@@ -101,6 +110,11 @@ int main(void)
     uint8_t txBuffer[PACKET_SIZE] = {0};
     uint8_t rxBuffer[PACKET_SIZE] = {0};  
     uint8_t extMemAddress[ADDRESS_SIZE] = {0x00, 0x00, 0x00};
+    
+#if (SMIF_STRIPED_ENABLED != 0u)
+    static uint8_t stripeTxBuffer[STRIPE_PACKET_SIZE];
+    static uint8_t stripeRxBuffer[STRIPE_PACKET_SIZE];
+#endif /* (SMIF_STRIPED_ENABLED != 0u) */
 
     /* Turn OFF Error and status LEDs */
     Cy_GPIO_Write(ERROR_LED_0_PORT, ERROR_LED_0_NUM, LED_OFF);
@@ -209,6 +223,37 @@ int main(void)
 		Cy_SCB_UART_PutString(UART_HW, "\r\nRead data does not match with written data in quad mode\r\n");
 		Cy_SCB_UART_PutString(UART_HW, "\r\nSMIF operation is failed in quad mode\r\n");		
 	}
+    
+#if (SMIF_STRIPED_ENABLED != 0u)
+    Cy_SCB_UART_PutString(UART_HW, "=========================================================\r\n");
+    Cy_SCB_UART_PutString(UART_HW, "\r\nSMIF operation in striped mode\r\n");
+    
+    /* Connect the second memory and erase the first stripe sector */
+    StripedInit(SMIF_1_HW, &SMIF_1_context);
+    StripedErase(SMIF_1_HW, &SMIF_1_context, 0u);
+    
+    InitBuffers(stripeTxBuffer, stripeRxBuffer, STRIPE_PACKET_SIZE);
+    StripedWrite(SMIF_1_HW, &SMIF_1_context, stripeTxBuffer, STRIPE_PACKET_SIZE, 0u);
+    StripedRead(SMIF_1_HW, &SMIF_1_context, stripeRxBuffer, STRIPE_PACKET_SIZE, 0u);
+    
+    if (memcmp(stripeTxBuffer, stripeRxBuffer, STRIPE_PACKET_SIZE) == 0)
+    {
+        Cy_SCB_UART_PutString(UART_HW, "\r\nSMIF operation is successful in striped mode\r\n");
+    }
+    else
+    {
+        Cy_GPIO_Write(SUCCESS_LED_0_PORT, SUCCESS_LED_0_NUM, LED_OFF);
+        Cy_GPIO_Write(ERROR_LED_0_PORT, ERROR_LED_0_NUM, LED_ON);
+        Cy_SCB_UART_PutString(UART_HW, "\r\nSMIF operation is failed in striped mode\r\n");
+    }
+#endif /* (SMIF_STRIPED_ENABLED != 0u) */
+
+#if (SMIF_BENCH_ENABLED != 0u)
+    Cy_SCB_UART_PutString(UART_HW, "=========================================================\r\n");
+    Cy_SCB_UART_PutString(UART_HW, "\r\nSMIF benchmark\r\n");
+    RunSMIFBenchmark(SMIF_1_HW, &SMIF_1_context, (cy_stc_smif_mem_config_t*)smifMemConfigs[0], 
+                     &smifBenchS25FL512S, BENCH_ADDRESS);
+#endif /* (SMIF_BENCH_ENABLED != 0u) */
 
     for(;;)
     {  
@@ -0,0 +1,338 @@
+/******************************************************************************
+* File Name: smif_bench.c
+*
+* Version: 1.0
+*
+* Description: Functions in this file time the SMIF operations and print the
+*              results over the UART as CSV lines of the form
+*              "op,width,cache,size,cycles,us,kbps". Reads and page programs
+*              are timed at a sweep of sizes with each command of a command
+*              set, and sector erases with the configured command. XIP reads
+*              are timed with the SMIF cache disabled, cold and warm. A 1 byte
+*              read gives the command overhead. Times come from the CM4 cycle
+*              counter, so they include the driver overhead.
+*
+* Related Document: CE220823_PSoC6MCU_SMIFMemoryWriteandReadOperation.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_bench.h"
+#include <stdio.h>
+#include <string.h>
+
+#if (SMIF_BENCH_ENABLED != 0u)
+
+/* Longest address of a command */
+#define BENCH_MAX_ADDR_BYTES    (4u)
+
+/* Read commands of the S25FL512S, 3-byte address */
+static cy_stc_smif_mem_cmd_t s25fl512sReadCmd[3u] =
+{
+    /* Fast Read */
+    {.command = 0x0BU, .cmdWidth = CY_SMIF_WIDTH_SINGLE, .addrWidth = CY_SMIF_WIDTH_SINGLE, .mode = 0xFFFFFFFFU,
+     .modeWidth = CY_SMIF_WIDTH_SINGLE, .dummyCycles = 8U, .dataWidth = CY_SMIF_WIDTH_SINGLE},
+    /* Dual I/O Read */
+    {.command = 0xBBU, .cmdWidth = CY_SMIF_WIDTH_SINGLE, .addrWidth = CY_SMIF_WIDTH_DUAL, .mode = 0x01U,
+     .modeWidth = CY_SMIF_WIDTH_DUAL, .dummyCycles = 0U, .dataWidth = CY_SMIF_WIDTH_DUAL},
+    /* Quad I/O Read */
+    {.command = 0xEBU, .cmdWidth = CY_SMIF_WIDTH_SINGLE, .addrWidth = CY_SMIF_WIDTH_QUAD, .mode = 0x01U,
+     .modeWidth = CY_SMIF_WIDTH_QUAD, .dummyCycles = 4U, .dataWidth = CY_SMIF_WIDTH_QUAD}
+};
+
+/* Program commands of the S25FL512S */
+static cy_stc_smif_mem_cmd_t s25fl512sProgramCmd[2u] =
+{
+    /* Page Program */
+    {.command = 0x02U, .cmdWidth = CY_SMIF_WIDTH_SINGLE, .addrWidth = CY_SMIF_WIDTH_SINGLE, .mode = 0xFFFFFFFFU,
+     .modeWidth = CY_SMIF_WIDTH_SINGLE, .dummyCycles = 0U, .dataWidth = CY_SMIF_WIDTH_SINGLE},
+    /* Quad Page Program */
+    {.command = 0x32U, .cmdWidth = CY_SMIF_WIDTH_SINGLE, .addrWidth = CY_SMIF_WIDTH_SINGLE, .mode = 0xFFFFFFFFU,
+     .modeWidth = CY_SMIF_WIDTH_SINGLE, .dummyCycles = 0U, .dataWidth = CY_SMIF_WIDTH_QUAD}
+};
+
+/* The memory has no dual page program */
+static const smif_bench_width_t s25fl512sWidths[] =
+{
+    {"single", &s25fl512sReadCmd[0u], &s25fl512sProgramCmd[0u]},
+    {"dual",   &s25fl512sReadCmd[1u], NULL},
+    {"quad",   &s25fl512sReadCmd[2u], &s25fl512sProgramCmd[1u]}
+};
+
+const smif_bench_cmds_t smifBenchS25FL512S =
+{
+    s25fl512sWidths, sizeof(s25fl512sWidths) / sizeof(s25fl512sWidths[0])
+};
+
+static const char * const widthName[] = {"single", "dual", "quad", "octal"};
+
+/* Sizes of the sweep */
+static const uint32_t readSizes[] = {1u, 16u, 64u, 256u, 1024u, BENCH_MAX_SIZE};
+static const uint32_t programSizes[] = {1u, 16u, 64u, 256u};
+
+static uint8_t benchBuffer[BENCH_MAX_SIZE];
+
+/* Local functions */
+static void SetAddressBytes(uint8_t addrBytes[], uint32_t address, uint32_t size);
+static void WaitMemory(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, cy_stc_smif_mem_config_t *memConfig);
+static void EraseSector(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, cy_stc_smif_mem_config_t *memConfig,
+                        uint32_t address);
+static void PrintResult(const char *op, const char *width, const char *cache, uint32_t size, uint32_t cycles);
+
+/*******************************************************************************
+* Function Name: SetAddressBytes
+****************************************************************************//**
+*
+* Converts an address to the byte order sent to the memory, most significant
+* byte first.
+*
+*******************************************************************************/
+static void SetAddressBytes(uint8_t addrBytes[], uint32_t address, uint32_t size)
+{
+    uint32_t i;
+    
+    for(i = 0u; i < size; i++)
+    {
+        addrBytes[i] = (uint8_t)(address >> (8u * (size - 1u - i)));
+    }
+}
+
+/*******************************************************************************
+* Function Name: WaitMemory
+****************************************************************************//**
+*
+* Waits until the data phase of a command and a program or erase operation 
+* of the memory are completed.
+*
+*******************************************************************************/
+static void WaitMemory(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, cy_stc_smif_mem_config_t *memConfig)
+{
+    while(Cy_SMIF_BusyCheck(baseaddr))
+    {
+        /* Wait until the SMIF IP operation is completed. */
+    }
+    while(Cy_SMIF_Memslot_IsBusy(baseaddr, memConfig, smifContext))
+    {
+        /* Wait until the memory is ready */
+    }
+}
+
+/*******************************************************************************
+* Function Name: EraseSector
+****************************************************************************//**
+*
+* Erases the sector at an address and waits for the end of the erase.
+*
+*******************************************************************************/
+static void EraseSector(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, cy_stc_smif_mem_config_t *memConfig,
+                        uint32_t address)
+{
+    uint8_t addrBytes[BENCH_MAX_ADDR_BYTES];
+    
+    SetAddressBytes(addrBytes, address, memConfig->deviceCfg->numOfAddrBytes);
+    (void)Cy_SMIF_Memslot_CmdWriteEnable(baseaddr, memConfig, smifContext);
+    (void)Cy_SMIF_Memslot_CmdSectorErase(baseaddr, memConfig, addrBytes, smifContext);
+    WaitMemory(baseaddr, smifContext, memConfig);
+}
+
+/*******************************************************************************
+* Function Name: PrintResult
+****************************************************************************//**
+*
+* Prints one CSV line.
+*
+*******************************************************************************/
+static void PrintResult(const char *op, const char *width, const char *cache, uint32_t size, uint32_t cycles)
+{
+    uint32_t cyclesPerUs = SystemCoreClock / 1000000u;
+    uint32_t kbps = (cycles == 0u) ? 0u : (uint32_t)(((uint64_t)size * SystemCoreClock) / ((uint64_t)cycles * 1024u));
+    
+    printf("%s,%s,%s,%lu,%lu,%lu,%lu\r\n", op, width, cache, (unsigned long)size, (unsigned long)cycles,
+           (unsigned long)(cycles / cyclesPerUs), (unsigned long)kbps);
+}
+
+/*******************************************************************************
+* Function Name: RunSMIFBenchmark
+****************************************************************************//**
+*
+* This function erases the sector at an address, times all operations on it 
+* and prints the results as CSV. Every result is the average of BENCH_REPEAT
+* runs. The SMIF must be enabled in the normal mode and the QE bit set. The
+* SMIF is left in the normal mode with the cache enabled.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param memConfig
+* The memory to time. Its read and program commands are swapped during the
+* sweep and restored at the end.
+*
+* \param cmds
+* The read and program commands of the memory, in the address length of
+* memConfig. NULL times the configured commands only.
+*
+* \param address
+* Address of a sector which may be erased. The XIP reads need address plus
+* BENCH_MAX_SIZE inside the memory mapped window of the memory, otherwise
+* nothing is run.
+*
+*******************************************************************************/
+void RunSMIFBenchmark(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, cy_stc_smif_mem_config_t *memConfig,
+                      const smif_bench_cmds_t *cmds, uint32_t address)
+{
+    cy_stc_smif_mem_device_cfg_t *device = memConfig->deviceCfg;
+    cy_stc_smif_mem_cmd_t *readCmd = device->readCmd;
+    cy_stc_smif_mem_cmd_t *programCmd = device->programCmd;
+    const uint8_t *xipAddress = (const uint8_t *)(memConfig->baseAddress + address);
+    smif_bench_width_t configured;
+    smif_bench_cmds_t configuredCmds = {&configured, 1u};
+    uint8_t addrBytes[BENCH_MAX_ADDR_BYTES];
+    uint32_t width;
+    uint32_t size;
+    uint32_t run;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t pageAddress = address;
+    
+    if((address >= memConfig->memMappedSize) ||
+       (BENCH_MAX_SIZE > (memConfig->memMappedSize - address)))
+    {
+        printf("Benchmark region 0x%lx is outside the mapped window\r\n", (unsigned long)address);
+        return;
+    }
+    
+    if(cmds == NULL)
+    {
+        configured.name = widthName[readCmd->dataWidth];
+        configured.readCmd = readCmd;
+        configured.programCmd = programCmd;
+        cmds = &configuredCmds;
+    }
+    
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    for(size = 0u; size < BENCH_MAX_SIZE; size++)
+    {
+        benchBuffer[size] = (uint8_t)size;
+    }
+    
+    printf("op,width,cache,size,cycles,us,kbps\r\n");
+    
+    /* Sector erase */
+    start = DWT->CYCCNT;
+    EraseSector(baseaddr, smifContext, memConfig, address);
+    PrintResult("erase", widthName[device->eraseCmd->addrWidth], "-", device->eraseSize, DWT->CYCCNT - start);
+    
+    /* Page program, each run on a new page. The erased sector holds all of them. */
+    for(width = 0u; width < cmds->count; width++)
+    {
+        if(cmds->widths[width].programCmd == NULL)
+        {
+            continue;
+        }
+        device->programCmd = cmds->widths[width].programCmd;
+        
+        for(size = 0u; size < (sizeof(programSizes) / sizeof(programSizes[0])); size++)
+        {
+            cycles = 0u;
+            for(run = 0u; run < BENCH_REPEAT; run++)
+            {
+                SetAddressBytes(addrBytes, pageAddress, device->numOfAddrBytes);
+                start = DWT->CYCCNT;
+                (void)Cy_SMIF_Memslot_CmdWriteEnable(baseaddr, memConfig, smifContext);
+                (void)Cy_SMIF_Memslot_CmdProgram(baseaddr, memConfig, addrBytes, benchBuffer, 
+                                                 programSizes[size], NULL, smifContext);
+                WaitMemory(baseaddr, smifContext, memConfig);
+                cycles += DWT->CYCCNT - start;
+                pageAddress += device->programSize;
+            }
+            PrintResult("program", cmds->widths[width].name, "-", programSizes[size], cycles / BENCH_REPEAT);
+        }
+    }
+    device->programCmd = programCmd;
+    
+    /* Normal mode reads, the 1 byte read gives the command overhead */
+    for(width = 0u; width < cmds->count; width++)
+    {
+        if(cmds->widths[width].readCmd == NULL)
+        {
+            continue;
+        }
+        device->readCmd = cmds->widths[width].readCmd;
+        
+        for(size = 0u; size < (sizeof(readSizes) / sizeof(readSizes[0])); size++)
+        {
+            cycles = 0u;
+            for(run = 0u; run < BENCH_REPEAT; run++)
+            {
+                SetAddressBytes(addrBytes, address, device->numOfAddrBytes);
+                start = DWT->CYCCNT;
+                (void)Cy_SMIF_Memslot_CmdRead(baseaddr, memConfig, addrBytes, benchBuffer, 
+                                              readSizes[size], NULL, smifContext);
+                WaitMemory(baseaddr, smifContext, memConfig);
+                cycles += DWT->CYCCNT - start;
+            }
+            PrintResult("read", cmds->widths[width].name, "-", readSizes[size], cycles / BENCH_REPEAT);
+        }
+    }
+    device->readCmd = readCmd;
+    
+    /* XIP reads through the memory mapped region with the configured read command */
+    Cy_SMIF_SetMode(baseaddr, CY_SMIF_MEMORY);
+    for(size = 0u; size < (sizeof(readSizes) / sizeof(readSizes[0])); size++)
+    {
+        (void)Cy_SMIF_CacheDisable(baseaddr, CY_SMIF_CACHE_BOTH);
+        start = DWT->CYCCNT;
+        SMIF_BENCH_XIP_COPY(benchBuffer, xipAddress, readSizes[size]);
+        PrintResult("xip", widthName[readCmd->dataWidth], "off", readSizes[size], DWT->CYCCNT - start);
+        
+        (void)Cy_SMIF_CacheEnable(baseaddr, CY_SMIF_CACHE_BOTH);
+        (void)Cy_SMIF_CacheInvalidate(baseaddr, CY_SMIF_CACHE_BOTH);
+        start = DWT->CYCCNT;
+        SMIF_BENCH_XIP_COPY(benchBuffer, xipAddress, readSizes[size]);
+        PrintResult("xip", widthName[readCmd->dataWidth], "cold", readSizes[size], DWT->CYCCNT - start);
+        
+        start = DWT->CYCCNT;
+        SMIF_BENCH_XIP_COPY(benchBuffer, xipAddress, readSizes[size]);
+        PrintResult("xip", widthName[readCmd->dataWidth], "warm", readSizes[size], DWT->CYCCNT - start);
+    }
+    Cy_SMIF_SetMode(baseaddr, CY_SMIF_NORMAL);
+}
+
+#endif /* (SMIF_BENCH_ENABLED != 0u) */
+
+/* [] END OF FILE */
@@ -0,0 +1,111 @@
+/******************************************************************************
+* File Name: smif_bench.h
+*
+* Version: 1.0
+*
+* Description: This header file contains the defines for the SMIF throughput
+*              and latency benchmark.
+*
+* Related Document: CE220823_PSoC6MCU_SMIFMemoryWriteandReadOperation.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef __SMIF_BENCH_H
+#define __SMIF_BENCH_H
+
+#include <stdint.h>
+#include <string.h>
+#include "project.h"
+#include <cy_smif_memconfig.h>
+
+/*******************************************************************************
+*            Conditional Compilation Parameters
+*******************************************************************************/
+/* Set to non-zero to run the benchmark at the end of the example */
+#ifndef SMIF_BENCH_ENABLED
+#define SMIF_BENCH_ENABLED      (0u)
+#endif /* SMIF_BENCH_ENABLED */
+
+#if (SMIF_BENCH_ENABLED != 0u)
+
+/* Copies from the memory mapped window, a host build times it on its model */
+#ifndef SMIF_BENCH_XIP_COPY
+#define SMIF_BENCH_XIP_COPY(dst, src, size)     ((void)memcpy((dst), (src), (size)))
+#endif /* SMIF_BENCH_XIP_COPY */
+
+/*******************************************************************************
+*            Data Types
+*******************************************************************************/
+/* Commands timed at one transfer width, NULL if the memory has none */
+typedef struct
+{
+    const char *name;                               /* Width column of the CSV */
+    cy_stc_smif_mem_cmd_t *readCmd;
+    cy_stc_smif_mem_cmd_t *programCmd;
+} smif_bench_width_t;
+
+/* Command set of a memory, one entry per transfer width */
+typedef struct
+{
+    const smif_bench_width_t *widths;
+    uint32_t count;
+} smif_bench_cmds_t;
+
+/*******************************************************************************
+*            Function Prototypes
+*******************************************************************************/
+void RunSMIFBenchmark(SMIF_Type *baseaddr,
+                    cy_stc_smif_context_t *smifContext,
+                    cy_stc_smif_mem_config_t *memConfig,
+                    const smif_bench_cmds_t *cmds,
+                    uint32_t address);              /* Time all operations, print CSV */
+
+/*******************************************************************************
+*            Global variables
+*******************************************************************************/
+extern const smif_bench_cmds_t smifBenchS25FL512S;  /* Commands of the S25FL512S, 3-byte address */
+
+/*******************************************************************************
+*            Constants
+*******************************************************************************/
+#define BENCH_ADDRESS           (0x00008000u)       /* Erased and programmed by the benchmark, must be
+                                                       inside the memory mapped window of the memory */
+#define BENCH_MAX_SIZE          (4096u)             /* Largest read size of the sweep */
+#define BENCH_REPEAT            (4u)                /* Runs averaged per result */
+
+#endif /* (SMIF_BENCH_ENABLED != 0u) */
+
+#endif /*__SMIF_BENCH_H*/
+    
+/* [] END OF FILE */
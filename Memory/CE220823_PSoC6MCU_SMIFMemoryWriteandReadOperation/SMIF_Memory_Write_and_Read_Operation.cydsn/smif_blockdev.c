@@ -0,0 +1,275 @@
+/******************************************************************************
+* File Name: smif_blockdev.c
+*
+* Version: 1.0
+*
+* Description: Functions in this file implement the block device interface
+*              for the S25FL512S quad NOR flash with the memory slot API.
+*              Programs are split at the page boundaries, erase works on
+*              whole sectors.
+*
+* Related Document: CE220823_PSoC6MCU_SMIFMemoryWriteandReadOperation.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_blockdev.h"
+#include "smif_mem.h"
+
+static SMIF_Type *norBase;
+static cy_stc_smif_context_t *norContext;
+
+/* Local functions */
+static bool InRange(uint32_t address, uint32_t size);
+static void SetAddressBytes(uint8_t addrBytes[], uint32_t address);
+static void WaitMemory(void);
+static blockdev_status_t NorRead(uint32_t address, uint8_t buffer[], uint32_t size);
+static blockdev_status_t NorProgram(uint32_t address, const uint8_t buffer[], uint32_t size);
+static blockdev_status_t NorErase(uint32_t address, uint32_t size);
+
+/* The sizes are set from the memory configuration by SmifBlockDevInit() */
+static blockdev_t norBlockDev =
+{
+    {"S25FL512S", 0u, 0u, 0u, 4u, BLOCKDEV_ERASE_NEEDED},
+    &NorRead,
+    &NorProgram,
+    &NorErase
+};
+
+/*******************************************************************************
+* Function Name: InRange
+****************************************************************************//**
+*
+* Checks that an access is inside the memory.
+*
+*******************************************************************************/
+static bool InRange(uint32_t address, uint32_t size)
+{
+    return ((address <= norBlockDev.caps.size) && (size <= (norBlockDev.caps.size - address)));
+}
+
+/*******************************************************************************
+* Function Name: SetAddressBytes
+****************************************************************************//**
+*
+* Converts an address to the byte order sent to the memory.
+*
+*******************************************************************************/
+static void SetAddressBytes(uint8_t addrBytes[], uint32_t address)
+{
+    addrBytes[0] = (uint8_t)(address >> 16u);
+    addrBytes[1] = (uint8_t)(address >> 8u);
+    addrBytes[2] = (uint8_t)(address);
+}
+
+/*******************************************************************************
+* Function Name: WaitMemory
+****************************************************************************//**
+*
+* Waits until the memory has completed its program or erase operation.
+*
+*******************************************************************************/
+static void WaitMemory(void)
+{
+    while(Cy_SMIF_BusyCheck(norBase))
+    {
+        /* Wait until the SMIF transfer is completed */
+    }
+    while(Cy_SMIF_Memslot_IsBusy(norBase, (cy_stc_smif_mem_config_t*)smifMemConfigs[0], norContext))
+    {
+        /* Wait until the memory is ready */
+    }
+}
+
+/*******************************************************************************
+* Function Name: NorRead
+****************************************************************************//**
+*
+* Reads data in the quad mode, split in the largest SMIF transfers.
+*
+*******************************************************************************/
+static blockdev_status_t NorRead(uint32_t address, uint8_t buffer[], uint32_t size)
+{
+    uint8_t addrBytes[ADDRESS_SIZE];
+    uint32_t chunk;
+    
+    if(!InRange(address, size))
+    {
+        return BLOCKDEV_BAD_PARAM;
+    }
+    
+    while(size > 0u)
+    {
+        chunk = (size < SMIF_MAX_TRANSFER) ? size : SMIF_MAX_TRANSFER;
+        SetAddressBytes(addrBytes, address);
+        
+        if(Cy_SMIF_Memslot_CmdRead(norBase, smifMemConfigs[0], addrBytes, buffer, chunk, &RxCmpltCallback, norContext) != CY_SMIF_SUCCESS)
+        {
+            return BLOCKDEV_DEVICE_ERROR;
+        }
+        while(Cy_SMIF_BusyCheck(norBase))
+        {
+            /* Wait until the data is received */
+        }
+        
+        buffer += chunk;
+        size -= chunk;
+        address += chunk;
+    }
+    
+    return BLOCKDEV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: NorProgram
+****************************************************************************//**
+*
+* Programs data in the quad mode, one program command per page.
+*
+*******************************************************************************/
+static blockdev_status_t NorProgram(uint32_t address, const uint8_t buffer[], uint32_t size)
+{
+    uint32_t pageSize = norBlockDev.caps.pageSize;
+    uint8_t addrBytes[ADDRESS_SIZE];
+    uint32_t chunk;
+    
+    if(!InRange(address, size))
+    {
+        return BLOCKDEV_BAD_PARAM;
+    }
+    
+    while(size > 0u)
+    {
+        /* Bytes left until the end of the page */
+        chunk = pageSize - (address % pageSize);
+        if(chunk > size)
+        {
+            chunk = size;
+        }
+        SetAddressBytes(addrBytes, address);
+        
+        if((Cy_SMIF_Memslot_CmdWriteEnable(norBase, smifMemConfigs[0], norContext) != CY_SMIF_SUCCESS) ||
+           (Cy_SMIF_Memslot_CmdProgram(norBase, smifMemConfigs[0], addrBytes, (uint8_t *)buffer, chunk, &RxCmpltCallback, norContext) != CY_SMIF_SUCCESS))
+        {
+            return BLOCKDEV_DEVICE_ERROR;
+        }
+        WaitMemory();
+        
+        buffer += chunk;
+        size -= chunk;
+        address += chunk;
+    }
+    
+    return BLOCKDEV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: NorErase
+****************************************************************************//**
+*
+* Erases whole sectors. The erase command (D8h) erases 256 KB sectors, the 
+* eraseSize of the memory configuration.
+*
+*******************************************************************************/
+static blockdev_status_t NorErase(uint32_t address, uint32_t size)
+{
+    uint32_t eraseSize = norBlockDev.caps.eraseSize;
+    uint8_t addrBytes[ADDRESS_SIZE];
+    
+    if((!InRange(address, size)) || ((address % eraseSize) != 0u) || ((size % eraseSize) != 0u))
+    {
+        return BLOCKDEV_BAD_PARAM;
+    }
+    
+    while(size > 0u)
+    {
+        SetAddressBytes(addrBytes, address);
+        
+        if((Cy_SMIF_Memslot_CmdWriteEnable(norBase, smifMemConfigs[0], norContext) != CY_SMIF_SUCCESS) ||
+           (Cy_SMIF_Memslot_CmdSectorErase(norBase, (cy_stc_smif_mem_config_t*)smifMemConfigs[0], addrBytes, norContext) != CY_SMIF_SUCCESS))
+        {
+            return BLOCKDEV_DEVICE_ERROR;
+        }
+        WaitMemory();
+        
+        size -= eraseSize;
+        address += eraseSize;
+    }
+    
+    return BLOCKDEV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: SmifBlockDevInit
+****************************************************************************//**
+*
+* This function sets the QE bit of the S25FL512S and returns its block device. 
+* Call it after Cy_SMIF_Init(). The size is limited to the range of the 
+* configured address bytes.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \return
+* The block device, NULL if the memory could not be quad-enabled.
+*
+*******************************************************************************/
+const blockdev_t *SmifBlockDevInit(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext)
+{
+    const cy_stc_smif_mem_device_cfg_t *deviceCfg = smifMemConfigs[0]->deviceCfg;
+    uint32_t size = deviceCfg->memSize;
+    
+    norBase = baseaddr;
+    norContext = smifContext;
+    
+    if((deviceCfg->numOfAddrBytes < 4u) && (size > (1ul << (8u * deviceCfg->numOfAddrBytes))))
+    {
+        size = 1ul << (8u * deviceCfg->numOfAddrBytes);
+    }
+    norBlockDev.caps.size = size;
+    norBlockDev.caps.pageSize = deviceCfg->programSize;
+    norBlockDev.caps.eraseSize = deviceCfg->eraseSize;
+    
+    if(Cy_SMIF_Memslot_QuadEnable(baseaddr, (cy_stc_smif_mem_config_t*)smifMemConfigs[0], smifContext) != CY_SMIF_SUCCESS)
+    {
+        return NULL;
+    }
+    WaitMemory();
+    
+    return &norBlockDev;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,350 @@
+/******************************************************************************
+* File Name: smif_stripe.c
+*
+* Version: 1.0
+*
+* Description: Functions in this file implement the striped (RAID-0) access of
+*              two quad memories on separate data lines. The logical address
+*              space is split into units of one program page. Even units are
+*              stored on the memory of smifMemConfigs[0], odd units on the
+*              memory of smifMemConfigs[1]. While one memory programs or
+*              erases, the other one is sent its command, so program and erase
+*              throughput is doubled. Reads share the SMIF bus and run one
+*              memory after the other.
+*
+* Related Document: CE220823_PSoC6MCU_SMIFMemoryWriteandReadOperation.pdf
+*
+* Hardware Dependency: CY8CKIT-062-BLE PSoC 6 BLE Pioneer kit
+*
+******************************************************************************
+* Copyright (2017), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "smif_stripe.h"
+#include "smif_mem.h"
+
+#if (SMIF_STRIPED_ENABLED != 0u)
+
+/* Local functions */
+static uint32_t StripeDevice(uint32_t address);
+static uint32_t StripeAddress(uint32_t address);
+static void SetAddressBytes(uint8_t addrBytes[], uint32_t address);
+static void WaitDevice(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, uint32_t device);
+
+/*******************************************************************************
+* Function Name: StripeDevice
+****************************************************************************//**
+*
+* Returns the memory holding a logical address.
+*
+*******************************************************************************/
+static uint32_t StripeDevice(uint32_t address)
+{
+    return (address / smifMemConfigs[0]->deviceCfg->programSize) % STRIPE_DEVICES;
+}
+
+/*******************************************************************************
+* Function Name: StripeAddress
+****************************************************************************//**
+*
+* Returns the address inside its memory of a logical address.
+*
+*******************************************************************************/
+static uint32_t StripeAddress(uint32_t address)
+{
+    uint32_t unitSize = smifMemConfigs[0]->deviceCfg->programSize;
+    
+    return ((address / (unitSize * STRIPE_DEVICES)) * unitSize) + (address % unitSize);
+}
+
+/*******************************************************************************
+* Function Name: SetAddressBytes
+****************************************************************************//**
+*
+* Converts an address to the byte order sent to the memory.
+*
+*******************************************************************************/
+static void SetAddressBytes(uint8_t addrBytes[], uint32_t address)
+{
+    addrBytes[0] = (uint8_t)(address >> 16u);
+    addrBytes[1] = (uint8_t)(address >> 8u);
+    addrBytes[2] = (uint8_t)(address);
+}
+
+/*******************************************************************************
+* Function Name: WaitDevice
+****************************************************************************//**
+*
+* Waits until a memory has completed its program or erase operation.
+*
+*******************************************************************************/
+static void WaitDevice(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, uint32_t device)
+{
+    while(Cy_SMIF_Memslot_IsBusy(baseaddr, (cy_stc_smif_mem_config_t*)smifMemConfigs[device], smifContext))
+    {
+        /* Wait until the memory is ready */
+    }
+}
+
+/*******************************************************************************
+* Function Name: StripedInit
+****************************************************************************//**
+*
+* This function connects both memories to their data lines and sets the QE 
+* bit of both. Call it after Cy_SMIF_Init().
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+*******************************************************************************/
+void StripedInit(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext)
+{
+    cy_en_smif_status_t smif_status;
+    uint32_t device;
+    
+    for(device = 0u; device < STRIPE_DEVICES; device++)
+    {
+        Cy_SMIF_SetDataSelect(baseaddr, smifMemConfigs[device]->slaveSelect, smifMemConfigs[device]->dataSelect);
+    }
+    
+    for(device = 0u; device < STRIPE_DEVICES; device++)
+    {
+        smif_status = Cy_SMIF_Memslot_QuadEnable(baseaddr, (cy_stc_smif_mem_config_t*)smifMemConfigs[device], smifContext);
+        if(smif_status!=CY_SMIF_SUCCESS)
+        {
+            Cy_SCB_UART_PutString(UART_HW, "\r\n\r\nSMIF Cy_SMIF_Memslot_QuadEnable failed\r\n");
+            handle_error();
+        }
+        WaitDevice(baseaddr, smifContext, device);
+    }
+}
+
+/*******************************************************************************
+* Function Name: StripedErase
+****************************************************************************//**
+*
+* This function erases the stripe sector holding a logical address. A stripe 
+* sector is one sector of each memory, so it covers twice the sector size of
+* the memory. Both erases run at the same time.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param address 
+* A logical address inside the stripe sector.
+*
+*******************************************************************************/
+void StripedErase(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, uint32_t address)
+{
+    cy_en_smif_status_t smif_status;
+    uint8_t addrBytes[ADDRESS_SIZE];
+    uint32_t device;
+    
+    SetAddressBytes(addrBytes, StripeAddress(address));
+    
+    for(device = 0u; device < STRIPE_DEVICES; device++)
+    {
+        WaitDevice(baseaddr, smifContext, device);
+        
+        smif_status = Cy_SMIF_Memslot_CmdWriteEnable(baseaddr, smifMemConfigs[device], smifContext);
+        if(smif_status==CY_SMIF_SUCCESS)
+        {
+            smif_status = Cy_SMIF_Memslot_CmdSectorErase(baseaddr, (cy_stc_smif_mem_config_t*)smifMemConfigs[device], addrBytes, smifContext);
+        }
+        if(smif_status!=CY_SMIF_SUCCESS)
+        {
+            Cy_SCB_UART_PutString(UART_HW, "\r\n\r\nSMIF Cy_SMIF_Memslot_CmdSectorErase failed\r\n");
+            handle_error();
+        }
+    }
+    
+    for(device = 0u; device < STRIPE_DEVICES; device++)
+    {
+        WaitDevice(baseaddr, smifContext, device);
+    }
+}
+
+/*******************************************************************************
+* Function Name: StripedWrite
+****************************************************************************//**
+*
+* This function programs data of any length and alignment across both 
+* memories. Each unit is programmed by its own page program; the next unit 
+* goes to the other memory, which is ready while the first one programs.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param txBuffer 
+* Data to write in the external memory.
+* 
+* \param txSize 
+* The size of data.
+* 
+* \param address 
+* The logical address to write data to.   
+*
+*******************************************************************************/
+void StripedWrite(SMIF_Type *baseaddr,
+                    cy_stc_smif_context_t *smifContext, 
+                    uint8_t txBuffer[], 
+                    uint32_t txSize, 
+                    uint32_t address)
+{
+    cy_en_smif_status_t smif_status;
+    uint32_t unitSize = smifMemConfigs[0]->deviceCfg->programSize;
+    uint8_t addrBytes[ADDRESS_SIZE];
+    uint32_t device;
+    uint32_t chunk;
+    
+    while(txSize > 0u)
+    {
+        /* Bytes left until the end of the unit */
+        chunk = unitSize - (address % unitSize);
+        if(chunk > txSize)
+        {
+            chunk = txSize;
+        }
+        device = StripeDevice(address);
+        SetAddressBytes(addrBytes, StripeAddress(address));
+        
+        /* Only this memory must be ready, the other one may be programming */
+        WaitDevice(baseaddr, smifContext, device);
+        
+        smif_status = Cy_SMIF_Memslot_CmdWriteEnable(baseaddr, smifMemConfigs[device], smifContext);
+        if(smif_status==CY_SMIF_SUCCESS)
+        {
+            smif_status = Cy_SMIF_Memslot_CmdProgram(baseaddr, smifMemConfigs[device], addrBytes, txBuffer, chunk, &RxCmpltCallback, smifContext);
+        }
+        if(smif_status!=CY_SMIF_SUCCESS)
+        {
+            Cy_SCB_UART_PutString(UART_HW, "\r\n\r\nSMIF Cy_SMIF_Memslot_CmdProgram failed\r\n");
+            handle_error();
+        }
+        
+        while(Cy_SMIF_BusyCheck(baseaddr))
+        {
+            /* Wait until the page data is sent */
+        }
+        
+        txBuffer += chunk;
+        txSize -= chunk;
+        address += chunk;
+    }
+    
+    for(device = 0u; device < STRIPE_DEVICES; device++)
+    {
+        WaitDevice(baseaddr, smifContext, device);
+    }
+}
+
+/*******************************************************************************
+* Function Name: StripedRead
+****************************************************************************//**
+*
+* This function reads data of any length and alignment from both memories and
+* reassembles it in the logical order. Both memories must be ready, as a 
+* program or erase issued by other code may still run on either of them.
+* The units are read one after the other: the SMIF has a single command and
+* data path, so reads are not faster than from one memory.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param rxBuffer 
+* The buffer for read data.
+* 
+* \param rxSize 
+* The size of data to read.
+* 
+* \param address 
+* The logical address to read data from. 
+*
+*******************************************************************************/
+void StripedRead(SMIF_Type *baseaddr,
+                    cy_stc_smif_context_t *smifContext, 
+                    uint8_t rxBuffer[], 
+                    uint32_t rxSize, 
+                    uint32_t address)
+{
+    cy_en_smif_status_t smif_status;
+    uint32_t unitSize = smifMemConfigs[0]->deviceCfg->programSize;
+    uint8_t addrBytes[ADDRESS_SIZE];
+    uint32_t device;
+    uint32_t chunk;
+    
+    for(device = 0u; device < STRIPE_DEVICES; device++)
+    {
+        WaitDevice(baseaddr, smifContext, device);
+    }
+    
+    while(rxSize > 0u)
+    {
+        chunk = unitSize - (address % unitSize);
+        if(chunk > rxSize)
+        {
+            chunk = rxSize;
+        }
+        device = StripeDevice(address);
+        SetAddressBytes(addrBytes, StripeAddress(address));
+        
+        smif_status = Cy_SMIF_Memslot_CmdRead(baseaddr, smifMemConfigs[device], addrBytes, rxBuffer, chunk, &RxCmpltCallback, smifContext);
+        if(smif_status!=CY_SMIF_SUCCESS)
+        {
+            Cy_SCB_UART_PutString(UART_HW, "\r\n\r\nSMIF Cy_SMIF_Memslot_CmdRead failed\r\n");
+            handle_error();
+        }
+        
+        while(Cy_SMIF_BusyCheck(baseaddr))
+        {
+            /* Wait until the SMIF IP operation is completed. */
+        }
+        
+        rxBuffer += chunk;
+        rxSize -= chunk;
+        address += chunk;
+    }
+}
+
+#endif /* (SMIF_STRIPED_ENABLED != 0u) */
+
+/* [] END OF FILE */
@@ -0,0 +1,218 @@
+/****************************************************************************
+*File Name: FRAM_BLOCKDEV.c
+*
+* Version: 1.0
+*
+* Description: 
+* This file implements the block device interface for the SPI F-RAM 
+* with the single-line READ and WRITE commands. Erase fills the range 
+* with 0xFF.
+*
+* Related Document: CE222460.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#include "FRAM_BLOCKDEV.h"
+#include "project.h"
+#include <string.h>
+
+#define FRAM_ERASE_VALUE            (0xFFu)     /* Value written by the erase */
+
+static SMIF_Type *bdBase;
+static cy_stc_smif_context_t *bdContext;
+
+/* Local functions */
+static bool InRange(uint32_t address, uint32_t size);
+static void SetAddress(uint8_t addrBytes[], uint32_t address);
+static blockdev_status_t FramRead(uint32_t address, uint8_t buffer[], uint32_t size);
+static blockdev_status_t FramProgram(uint32_t address, const uint8_t buffer[], uint32_t size);
+static blockdev_status_t FramErase(uint32_t address, uint32_t size);
+
+/* F-RAM is byte-writable and needs no erase */
+static const blockdev_t framBlockDev =
+{
+    {"CY15B104Q", FRAM_BLOCKDEV_SIZE, 1u, 1u, 1u, 0u},
+    &FramRead,
+    &FramProgram,
+    &FramErase
+};
+
+/*******************************************************************************
+* Function Name: InRange
+****************************************************************************//**
+*
+* This function checks that an access is inside the F-RAM.
+*
+*******************************************************************************/
+static bool InRange(uint32_t address, uint32_t size)
+{
+    return ((address <= FRAM_BLOCKDEV_SIZE) && (size <= (FRAM_BLOCKDEV_SIZE - address)));
+}
+
+/*******************************************************************************
+* Function Name: SetAddress
+****************************************************************************//**
+*
+* This function converts an address to the bytes sent, MSB first.
+*
+*******************************************************************************/
+static void SetAddress(uint8_t addrBytes[], uint32_t address)
+{
+    addrBytes[0u] = (uint8_t)(address >> 16u);
+    addrBytes[1u] = (uint8_t)(address >> 8u);
+    addrBytes[2u] = (uint8_t)address;
+}
+
+/*******************************************************************************
+* Function Name: FramRead
+****************************************************************************//**
+*
+* This function reads with the READ command.
+*
+*******************************************************************************/
+static blockdev_status_t FramRead(uint32_t address, uint8_t buffer[], uint32_t size)
+{
+    uint8_t addrBytes[ADDRESS_SIZE];
+    uint32_t chunk;
+    
+    if (!InRange(address, size))
+    {
+        return BLOCKDEV_BAD_PARAM;
+    }
+    
+    while (size > 0u)
+    {
+        chunk = (size < FRAM_BLOCKDEV_MAX_TRANSFER) ? size : FRAM_BLOCKDEV_MAX_TRANSFER;
+        SetAddress(addrBytes, address);
+        WriteCmdSPIRead(bdBase, bdContext, buffer, chunk, addrBytes);
+        
+        buffer += chunk;
+        size -= chunk;
+        address += chunk;
+    }
+    
+    return BLOCKDEV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: FramProgram
+****************************************************************************//**
+*
+* This function writes with the WRITE command.
+*
+*******************************************************************************/
+static blockdev_status_t FramProgram(uint32_t address, const uint8_t buffer[], uint32_t size)
+{
+    uint8_t addrBytes[ADDRESS_SIZE];
+    uint32_t chunk;
+    
+    if (!InRange(address, size))
+    {
+        return BLOCKDEV_BAD_PARAM;
+    }
+    
+    while (size > 0u)
+    {
+        chunk = (size < FRAM_BLOCKDEV_MAX_TRANSFER) ? size : FRAM_BLOCKDEV_MAX_TRANSFER;
+        SetAddress(addrBytes, address);
+        WriteCmdSPIWrite(bdBase, bdContext, (uint8_t *)buffer, chunk, addrBytes);
+        
+        buffer += chunk;
+        size -= chunk;
+        address += chunk;
+    }
+    
+    return BLOCKDEV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: FramErase
+****************************************************************************//**
+*
+* This function fills a range with 0xFF, so the F-RAM reads as erased flash.
+*
+*******************************************************************************/
+static blockdev_status_t FramErase(uint32_t address, uint32_t size)
+{
+    uint8_t fill[PACKET_SIZE];
+    uint32_t chunk;
+    blockdev_status_t status;
+    
+    if (!InRange(address, size))
+    {
+        return BLOCKDEV_BAD_PARAM;
+    }
+    
+    memset(fill, FRAM_ERASE_VALUE, sizeof(fill));
+    while (size > 0u)
+    {
+        chunk = (size < PACKET_SIZE) ? size : PACKET_SIZE;
+        status = FramProgram(address, fill, chunk);
+        if (status != BLOCKDEV_SUCCESS)
+        {
+            return status;
+        }
+        
+        size -= chunk;
+        address += chunk;
+    }
+    
+    return BLOCKDEV_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_BlockDevInit
+****************************************************************************//**
+*
+* This function returns the block device of the SPI F-RAM.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \return
+* The block device.
+*
+*******************************************************************************/
+const blockdev_t *FRAM_BlockDevInit(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext)
+{
+    bdBase = baseaddr;
+    bdContext = smifContext;
+    
+    return (&framBlockDev);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,1634 @@
+/******************************************************************************
+* File Name: cy15x104qsn_sim.c
+*
+* Version: 1.0
+*
+* Description: Behavioral model of the CY15x104QSN QSPI F-RAM and host
+*              replacements of the PDL SMIF, DMA, trigger, interrupt and
+*              system functions used by the F-RAM sources. A transaction
+*              is decoded as the part would see it: the access mode of CR2
+*              sets the width of every phase, the latency codes of CR1 and
+*              CR5 the dummy cycles of the reads, and WEL gates the writes.
+*              The data phases given to the driver without a buffer are
+*              moved through the FIFO registers by the DataWire channel.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "cy15x104qsn_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+*            Constants
+*******************************************************************************/
+#define SIM_CALL_NS             (1000u)         /* CPU time of a driver call */
+#define SIM_CPU_STEP_NS         (10u)           /* CPU time of a register read */
+#define SIM_BUSY_SPIN_MAX       (1000000u)      /* Busy polls taken as a hang */
+#define SIM_ADDR_MASK           (SIM_MEM_SIZE - 1u)
+#define SIM_REG_COUNT           (8u)
+#define SIM_PARAM_MAX           (8u)            /* Largest parameter phase, WRSN */
+#define SIM_IRQ_COUNT           (64u)
+#define SIM_TEST_EXCEPTION      (16u + 3u)      /* Exception number of SimSetIsrContext() */
+
+/* Power-up registers of the model: the latency codes CE222967 uses at 100 MHz */
+#define SIM_DEFAULT_CR1         (8u << SIM_CR1_MLC_POS)
+#define SIM_DEFAULT_CR4         (0x08u)
+#define SIM_DEFAULT_CR5         (3u << SIM_CR5_RLC_POS)
+
+/* SR1 bits kept by WRSR and WRAR, WEL is set by WREN only */
+#define SIM_SR1_WRITE_MASK      (0x9Cu)
+
+/*******************************************************************************
+*            Data Types
+*******************************************************************************/
+typedef enum
+{
+    SIM_WREN = 0u,
+    SIM_WRDI,
+    SIM_WRSR,
+    SIM_RDREG,
+    SIM_WRAR,
+    SIM_RDAR,
+    SIM_WRITE,
+    SIM_READ,
+    SIM_SSWR,
+    SIM_SSRD,
+    SIM_WRSN,
+    SIM_RDSN,
+    SIM_RDID,
+    SIM_RUID,
+    SIM_SLEEP
+} sim_class_t;
+
+/* Data phase of a command */
+typedef enum
+{
+    SIM_DATA_NONE = 0u,
+    SIM_DATA_PARAM,             /* Register data sent as the parameters */
+    SIM_DATA_TX,
+    SIM_DATA_RX
+} sim_data_t;
+
+/* Latency code of a read */
+typedef enum
+{
+    SIM_LAT_NONE = 0u,
+    SIM_LAT_MEM,
+    SIM_LAT_REG
+} sim_lat_t;
+
+/* Commands of the CY15x104QSN, widths of the SPI mode */
+typedef struct
+{
+    uint8_t opcode;
+    sim_class_t cls;
+    uint8_t addrBytes;
+    uint8_t modeByte;           /* 1 if the mode byte follows the address */
+    uint8_t addrLines;
+    uint8_t dataLines;
+    sim_data_t data;
+    sim_lat_t latency;
+    bool wel;                   /* Needs WEL, which is cleared at CS high */
+    uint8_t reg;                /* Register of RDSRx and RDCRx */
+} sim_opcode_t;
+
+/* One transaction on the bus, from CS low to CS high */
+typedef struct
+{
+    uint8_t cmd;
+    uint32_t cmdLines;
+    const uint8_t *params;
+    uint32_t paramSize;
+    uint32_t paramLines;
+    uint32_t dummy;
+    bool hasData;
+    bool rx;
+    uint8_t *data;
+    uint32_t size;
+    uint32_t dataLines;
+} sim_txn_t;
+
+typedef enum
+{
+    SIM_AWAKE = 0u,
+    SIM_ASLEEP,                 /* DPD or hibernate */
+    SIM_WAKING                  /* Woken by a chip select, until wakeEnd */
+} sim_power_t;
+
+/* Data phase served through the FIFO registers */
+typedef enum
+{
+    SIM_FIFO_IDLE = 0u,
+    SIM_FIFO_RX,
+    SIM_FIFO_TX
+} sim_fifo_t;
+
+typedef struct
+{
+    bool enabled;
+    bool intrMask;
+    const cy_stc_dma_descriptor_t *descriptor;
+    cy_en_dma_intr_cause_t status;
+} sim_dma_channel_t;
+
+static const sim_opcode_t opcodes[] =
+{
+    {0x06u, SIM_WREN,  0u, 0u, 1u, 1u, SIM_DATA_NONE,  SIM_LAT_NONE, false, 0u},
+    {0x04u, SIM_WRDI,  0u, 0u, 1u, 1u, SIM_DATA_NONE,  SIM_LAT_NONE, false, 0u},
+    {0x01u, SIM_WRSR,  0u, 0u, 1u, 1u, SIM_DATA_PARAM, SIM_LAT_NONE, true,  0u},
+    {0x05u, SIM_RDREG, 0u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_REG,  false, SIM_REG_SR1},
+    {0x07u, SIM_RDREG, 0u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_REG,  false, SIM_REG_SR2},
+    {0x35u, SIM_RDREG, 0u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_REG,  false, SIM_REG_CR1},
+    {0x3Fu, SIM_RDREG, 0u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_REG,  false, SIM_REG_CR2},
+    {0x45u, SIM_RDREG, 0u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_REG,  false, SIM_REG_CR4},
+    {0x5Eu, SIM_RDREG, 0u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_REG,  false, SIM_REG_CR5},
+    {0x71u, SIM_WRAR,  3u, 0u, 1u, 1u, SIM_DATA_TX,    SIM_LAT_NONE, true,  0u},
+    {0x65u, SIM_RDAR,  3u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_REG,  false, 0u},
+    {0x02u, SIM_WRITE, 3u, 0u, 1u, 1u, SIM_DATA_TX,    SIM_LAT_NONE, true,  0u},
+    {0x03u, SIM_READ,  3u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_MEM,  false, 0u},
+    {0xDAu, SIM_WRITE, 3u, 1u, 1u, 1u, SIM_DATA_TX,    SIM_LAT_NONE, true,  0u},
+    {0x0Bu, SIM_READ,  3u, 1u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_MEM,  false, 0u},
+    {0x42u, SIM_SSWR,  3u, 0u, 1u, 1u, SIM_DATA_TX,    SIM_LAT_NONE, true,  0u},
+    {0x4Bu, SIM_SSRD,  3u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_MEM,  false, 0u},
+    {0xC2u, SIM_WRSN,  0u, 0u, 1u, 1u, SIM_DATA_PARAM, SIM_LAT_NONE, true,  0u},
+    {0xC3u, SIM_RDSN,  0u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_REG,  false, 0u},
+    {0x9Fu, SIM_RDID,  0u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_REG,  false, 0u},
+    {0x4Cu, SIM_RUID,  0u, 0u, 1u, 1u, SIM_DATA_RX,    SIM_LAT_REG,  false, 0u},
+    {0xA1u, SIM_WRITE, 3u, 1u, 2u, 2u, SIM_DATA_TX,    SIM_LAT_NONE, true,  0u},
+    {0xD2u, SIM_WRITE, 3u, 1u, 4u, 4u, SIM_DATA_TX,    SIM_LAT_NONE, true,  0u},
+    {0xA2u, SIM_WRITE, 3u, 1u, 1u, 2u, SIM_DATA_TX,    SIM_LAT_NONE, true,  0u},
+    {0x32u, SIM_WRITE, 3u, 1u, 1u, 4u, SIM_DATA_TX,    SIM_LAT_NONE, true,  0u},
+    {0xBBu, SIM_READ,  3u, 1u, 2u, 2u, SIM_DATA_RX,    SIM_LAT_MEM,  false, 0u},
+    {0xEBu, SIM_READ,  3u, 1u, 4u, 4u, SIM_DATA_RX,    SIM_LAT_MEM,  false, 0u},
+    {0x3Bu, SIM_READ,  3u, 1u, 1u, 2u, SIM_DATA_RX,    SIM_LAT_MEM,  false, 0u},
+    {0x6Bu, SIM_READ,  3u, 1u, 1u, 4u, SIM_DATA_RX,    SIM_LAT_MEM,  false, 0u},
+    {0xB9u, SIM_SLEEP, 0u, 0u, 1u, 1u, SIM_DATA_NONE,  SIM_LAT_NONE, false, 0u},
+    {0xBAu, SIM_SLEEP, 0u, 0u, 1u, 1u, SIM_DATA_NONE,  SIM_LAT_NONE, false, 0u}
+};
+
+static const uint8_t defaultId[SIM_ID_SIZE] = {0x50u, 0x51u, 0x82u, 0x06u, 0x00u, 0x00u, 0x00u, 0x00u};
+static const uint8_t uniqueId[SIM_ID_SIZE] = {0x1Au, 0x2Bu, 0x3Cu, 0x4Du, 0x5Eu, 0x6Fu, 0x70u, 0x81u};
+
+/*******************************************************************************
+*            Model state
+*******************************************************************************/
+static uint8_t array[SIM_MEM_SIZE];
+static uint8_t specialSector[SIM_SS_SIZE];
+static uint8_t serialNumber[SIM_SN_SIZE];
+static uint8_t deviceId[SIM_ID_SIZE];
+static uint8_t regs[SIM_REG_COUNT];         /* By WRAR address, SR1 holds WEL */
+
+static sim_power_t power;
+static uint64_t wakeEnd;
+
+static uint64_t now;
+static uint64_t busFree;                    /* End of the transaction on the bus */
+static uint32_t spiClock;
+static uint32_t memAccessNs;
+static uint32_t regAccessNs;
+static sim_stats_t stats;
+
+/* Driver state */
+static bool smifEnabled;
+static uint32_t busySpins;
+
+/* Raw transaction opened by Cy_SMIF_TransmitCommand() */
+static bool rawOpen;
+static uint8_t rawCmd;
+static uint32_t rawCmdLines;
+static uint8_t rawParams[SIM_PARAM_MAX];
+static uint32_t rawParamSize;
+static uint32_t rawParamLines;
+static uint32_t rawDummy;
+
+static sim_fifo_t fifoState;
+static uint8_t fifo[CY_SMIF_MAX_TX_TR];
+static uint32_t fifoSize;
+static uint32_t fifoCount;
+static sim_txn_t fifoTxn;
+
+/* DataWire and interrupts */
+static sim_dma_channel_t dmaChannels[CY_DMA_CH_COUNT];
+static bool dmaEnabled;
+static uint32_t dmaFailures;
+
+static cy_israddress isrTable[SIM_IRQ_COUNT];
+static bool irqEnabled[SIM_IRQ_COUNT];
+static bool irqPending[SIM_IRQ_COUNT];
+static bool irqHold;
+static uint32_t ipsr;
+static uint32_t primask;
+
+/* Symbols of the generated sources */
+uint32_t SystemCoreClock = 100000000u;
+CoreDebug_Type simCoreDebug;
+SMIF_Type simSmif;
+DW_Type simDw0;
+static DWT_Type dwt;
+
+/*******************************************************************************
+* Function Name: Lines
+********************************************************************************
+*
+* Returns the number of data lines of a transfer width.
+*
+*******************************************************************************/
+static uint32_t Lines(cy_en_smif_txfr_width_t width)
+{
+    return 1uL << (uint32_t)width;
+}
+
+/*******************************************************************************
+* Function Name: ModeLines
+********************************************************************************
+*
+* Returns the width of all phases in the access mode set in CR2: 1 in SPI, 
+* where the command table gives the address and data widths, 2 in DPI and 4 
+* in QPI.
+*
+*******************************************************************************/
+static uint32_t ModeLines(void)
+{
+    if((regs[SIM_REG_CR2] & SIM_CR2_QPI) != 0u)
+    {
+        return 4u;
+    }
+    if((regs[SIM_REG_CR2] & SIM_CR2_DPI) != 0u)
+    {
+        return 2u;
+    }
+    return 1u;
+}
+
+/*******************************************************************************
+* Function Name: FindOpcode
+********************************************************************************
+*
+* Returns the command of an opcode, NULL if the part does not know it.
+*
+*******************************************************************************/
+static const sim_opcode_t *FindOpcode(uint8_t opcode)
+{
+    uint32_t i;
+    
+    for(i = 0u; i < (sizeof(opcodes) / sizeof(opcodes[0])); i++)
+    {
+        if(opcodes[i].opcode == opcode)
+        {
+            return &opcodes[i];
+        }
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+* Function Name: Advance
+********************************************************************************
+*
+* Moves the simulated clock.
+*
+*******************************************************************************/
+static void Advance(uint64_t ns)
+{
+    now += ns;
+}
+
+/*******************************************************************************
+* Function Name: Transfer
+********************************************************************************
+*
+* Accounts a transaction of the given SPI clocks. The CPU spends the driver 
+* call queuing it, the SMIF clocks it out once the bus is free, while the CPU
+* goes on: Cy_SMIF_BusyCheck() waits for the end of the bus time.
+*
+* \return
+* The time the transaction starts on the bus.
+*
+*******************************************************************************/
+static uint64_t Transfer(uint64_t clocks)
+{
+    uint64_t ns = ((clocks * 1000000000uLL) + spiClock - 1u) / spiClock;
+    uint64_t start;
+    
+    stats.commands++;
+    stats.busClocks += clocks;
+    stats.busNs += ns;
+    Advance(SIM_CALL_NS);
+    
+    start = (now > busFree) ? now : busFree;
+    busFree = start + ns;
+    return start;
+}
+
+/*******************************************************************************
+* Function Name: Clocks
+********************************************************************************
+*
+* Returns the SPI clocks of a transaction.
+*
+*******************************************************************************/
+static uint64_t Clocks(const sim_txn_t *txn)
+{
+    uint64_t clocks = (8u / txn->cmdLines) + ((txn->paramSize * 8u) / txn->paramLines) + txn->dummy;
+    
+    if(txn->hasData)
+    {
+        clocks += ((uint64_t)txn->size * 8u) / txn->dataLines;
+    }
+    return clocks;
+}
+
+/*******************************************************************************
+* Function Name: LatencyNeeded
+********************************************************************************
+*
+* Returns the latency cycles the part needs for an access time at the SPI 
+* clock.
+*
+*******************************************************************************/
+static uint32_t LatencyNeeded(uint32_t accessNs)
+{
+    return (uint32_t)((((uint64_t)spiClock * accessNs) + 999999999u) / 1000000000u);
+}
+
+/*******************************************************************************
+* Function Name: ReadShift
+********************************************************************************
+*
+* Returns the shift in bits of the read data as sampled by the host. The part 
+* drives the data after the cycles of its latency code; a host sending other 
+* dummy cycles samples it shifted. A latency code too small for the SPI clock 
+* makes the part drive the data late, as does a clock above the rating.
+*
+*******************************************************************************/
+static int32_t ReadShift(const sim_opcode_t *opcode, uint32_t latency, uint32_t dataLines)
+{
+    uint32_t code;
+    uint32_t needed;
+    int32_t shift;
+    
+    if(opcode->latency == SIM_LAT_MEM)
+    {
+        code = (uint32_t)regs[SIM_REG_CR1] >> SIM_CR1_MLC_POS;
+        needed = LatencyNeeded(memAccessNs);
+    }
+    else
+    {
+        code = (uint32_t)regs[SIM_REG_CR5] >> SIM_CR5_RLC_POS;
+        needed = LatencyNeeded(regAccessNs);
+    }
+    
+    shift = ((int32_t)latency - (int32_t)code) * (int32_t)dataLines;
+    if(code < needed)
+    {
+        shift -= (int32_t)(needed - code) * (int32_t)dataLines;
+    }
+    if(spiClock > SIM_MAX_SPI_CLOCK)
+    {
+        shift--;
+    }
+    
+    if(shift != 0)
+    {
+        stats.badReads++;
+    }
+    return shift;
+}
+
+/*******************************************************************************
+* Function Name: ShiftOut
+********************************************************************************
+*
+* Copies bytes of a data stream as sampled by the host. A positive shift is
+* the number of bits the host missed because it waited too long, a negative
+* one the number of bits sampled before the part drove the lines, which read
+* as 1. The stream wraps at its end.
+*
+*******************************************************************************/
+static void ShiftOut(const uint8_t stream[], uint32_t streamSize, uint32_t start,
+                     int32_t shift, uint8_t data[], uint32_t size)
+{
+    uint32_t i;
+    uint32_t bit;
+    int64_t src;
+    uint8_t value;
+    
+    for(i = 0u; i < size; i++)
+    {
+        value = 0u;
+        for(bit = 0u; bit < 8u; bit++)
+        {
+            src = ((int64_t)i * 8) + bit + shift;
+            value <<= 1u;
+            if(src < 0)
+            {
+                value |= 1u;
+            }
+            else
+            {
+                value |= (uint8_t)((stream[(start + (uint32_t)(src / 8)) % streamSize] >> (7u - (uint32_t)(src % 8))) & 1u);
+            }
+        }
+        data[i] = value;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ValidWidths
+********************************************************************************
+*
+* Checks the phases of a transaction against the command: the address and 
+* data widths of the access mode, the address and mode bytes, the direction 
+* of the data phase and, for the quad commands in SPI mode, the QUAD bit 
+* which turns WP# and HOLD# into IO2 and IO3.
+*
+*******************************************************************************/
+static bool ValidWidths(const sim_opcode_t *opcode, const sim_txn_t *txn, uint32_t modeLines)
+{
+    uint32_t addrLines = (modeLines == 1u) ? opcode->addrLines : modeLines;
+    uint32_t dataLines = (modeLines == 1u) ? opcode->dataLines : modeLines;
+    
+    if((modeLines == 1u) && ((addrLines == 4u) || (dataLines == 4u)) && 
+       ((regs[SIM_REG_CR1] & SIM_CR1_QUAD) == 0u))
+    {
+        return false;
+    }
+    
+    switch(opcode->data)
+    {
+        case SIM_DATA_PARAM:
+            return (!txn->hasData) && (txn->paramSize != 0u) && (txn->paramLines == modeLines);
+        
+        case SIM_DATA_NONE:
+            return (!txn->hasData) && (txn->paramSize == 0u);
+        
+        default:
+            break;
+    }
+    
+    if((!txn->hasData) || (txn->rx != (opcode->data == SIM_DATA_RX)) || (txn->dataLines != dataLines))
+    {
+        return false;
+    }
+    if(txn->paramSize < ((uint32_t)opcode->addrBytes + opcode->modeByte))
+    {
+        return false;
+    }
+    return (txn->paramSize == 0u) || (txn->paramLines == addrLines);
+}
+
+/*******************************************************************************
+* Function Name: WriteRegister
+********************************************************************************
+*
+* Writes a register by its WRAR address. SR2 and the unused addresses are 
+* read-only.
+*
+* \return
+* false if the register cannot be written.
+*
+*******************************************************************************/
+static bool WriteRegister(uint32_t reg, uint8_t value)
+{
+    switch(reg)
+    {
+        case SIM_REG_SR1:
+            regs[SIM_REG_SR1] = (uint8_t)((regs[SIM_REG_SR1] & SIM_SR1_WEL) | (value & SIM_SR1_WRITE_MASK));
+            return true;
+        
+        case SIM_REG_CR1:
+        case SIM_REG_CR2:
+        case SIM_REG_CR4:
+        case SIM_REG_CR5:
+            regs[reg] = value;
+            return true;
+        
+        default:
+            return false;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Execute
+********************************************************************************
+*
+* Runs a transaction. A chip select while the part is in DPD or hibernate 
+* starts the wake-up and the command is dropped, as are the commands sent 
+* before the exit time. A command sent on a width other than the access mode 
+* reaches the part as another opcode, which it ignores. Unselected read data 
+* reads as 1s.
+*
+*******************************************************************************/
+static void Execute(const sim_txn_t *txn)
+{
+    const sim_opcode_t *opcode;
+    const uint8_t *params = txn->params;
+    uint32_t modeLines = ModeLines();
+    uint64_t start;
+    uint32_t address = 0u;
+    uint32_t latency;
+    uint32_t i;
+    int32_t shift = 0;
+    
+    start = Transfer(Clocks(txn));
+    if(txn->hasData && txn->rx)
+    {
+        (void)memset(txn->data, 0xFF, txn->size);
+    }
+    
+    if((power == SIM_WAKING) && (start >= wakeEnd))
+    {
+        power = SIM_AWAKE;
+    }
+    if(power == SIM_ASLEEP)
+    {
+        power = SIM_WAKING;
+        wakeEnd = start + SIM_EXIT_LP_NS;
+        stats.wakeups++;
+        return;
+    }
+    if(power == SIM_WAKING)
+    {
+        stats.ignored++;
+        return;
+    }
+    
+    if(txn->cmdLines != modeLines)
+    {
+        stats.wrongMode++;
+        return;
+    }
+    
+    opcode = FindOpcode(txn->cmd);
+    if((opcode == NULL) || (!ValidWidths(opcode, txn, modeLines)))
+    {
+        stats.badCommands++;
+        return;
+    }
+    
+    if(opcode->wel)
+    {
+        if((regs[SIM_REG_SR1] & SIM_SR1_WEL) == 0u)
+        {
+            stats.ignored++;
+            return;
+        }
+        regs[SIM_REG_SR1] &= (uint8_t)~SIM_SR1_WEL;
+    }
+    
+    for(i = 0u; i < opcode->addrBytes; i++)
+    {
+        address = (address << 8u) | params[i];
+    }
+    
+    /* Parameters after the address and mode byte are clocks of the latency */
+    latency = txn->dummy;
+    if(opcode->data != SIM_DATA_PARAM)
+    {
+        latency += ((txn->paramSize - opcode->addrBytes - opcode->modeByte) * 8u) / txn->paramLines;
+    }
+    if(opcode->latency != SIM_LAT_NONE)
+    {
+        shift = ReadShift(opcode, latency, txn->dataLines);
+    }
+    
+    switch(opcode->cls)
+    {
+        case SIM_WREN:
+            regs[SIM_REG_SR1] |= SIM_SR1_WEL;
+            break;
+        
+        case SIM_WRDI:
+            regs[SIM_REG_SR1] &= (uint8_t)~SIM_SR1_WEL;
+            break;
+        
+        case SIM_WRSR:
+        {
+            static const uint8_t order[] = {SIM_REG_SR1, SIM_REG_CR1, SIM_REG_CR2, SIM_REG_CR4, SIM_REG_CR5};
+            
+            if(txn->paramSize > sizeof(order))
+            {
+                stats.badCommands++;
+                break;
+            }
+            for(i = 0u; i < txn->paramSize; i++)
+            {
+                (void)WriteRegister(order[i], params[i]);
+            }
+            stats.regWrites++;
+            break;
+        }
+        
+        case SIM_RDREG:
+            ShiftOut(&regs[opcode->reg], 1u, 0u, shift, txn->data, txn->size);
+            stats.regReads++;
+            break;
+        
+        case SIM_WRAR:
+            if((txn->size != 0u) && (!WriteRegister(address, txn->data[0])))
+            {
+                stats.badCommands++;
+                break;
+            }
+            stats.regWrites++;
+            break;
+        
+        case SIM_RDAR:
+            if((address >= SIM_REG_COUNT) || (address == 4u) || (address == 7u))
+            {
+                stats.badCommands++;
+                break;
+            }
+            ShiftOut(&regs[address], 1u, 0u, shift, txn->data, txn->size);
+            stats.regReads++;
+            break;
+        
+        case SIM_WRITE:
+            for(i = 0u; i < txn->size; i++)
+            {
+                array[(address + i) & SIM_ADDR_MASK] = txn->data[i];
+            }
+            stats.writes++;
+            stats.bytesWritten += txn->size;
+            break;
+        
+        case SIM_READ:
+            ShiftOut(array, SIM_MEM_SIZE, address & SIM_ADDR_MASK, shift, txn->data, txn->size);
+            stats.reads++;
+            stats.bytesRead += txn->size;
+            break;
+        
+        case SIM_SSWR:
+            for(i = 0u; i < txn->size; i++)
+            {
+                specialSector[(address + i) % SIM_SS_SIZE] = txn->data[i];
+            }
+            stats.writes++;
+            stats.bytesWritten += txn->size;
+            break;
+        
+        case SIM_SSRD:
+            ShiftOut(specialSector, SIM_SS_SIZE, address % SIM_SS_SIZE, shift, txn->data, txn->size);
+            stats.reads++;
+            stats.bytesRead += txn->size;
+            break;
+        
+        case SIM_WRSN:
+            if(txn->paramSize > SIM_SN_SIZE)
+            {
+                stats.badCommands++;
+                break;
+            }
+            (void)memcpy(serialNumber, params, txn->paramSize);
+            stats.regWrites++;
+            break;
+        
+        case SIM_RDSN:
+            ShiftOut(serialNumber, SIM_SN_SIZE, 0u, shift, txn->data, txn->size);
+            stats.regReads++;
+            break;
+        
+        case SIM_RDID:
+            ShiftOut(deviceId, SIM_ID_SIZE, 0u, shift, txn->data, txn->size);
+            stats.regReads++;
+            break;
+        
+        case SIM_RUID:
+            ShiftOut(uniqueId, SIM_ID_SIZE, 0u, shift, txn->data, txn->size);
+            stats.regReads++;
+            break;
+        
+        case SIM_SLEEP:
+            power = SIM_ASLEEP;
+            stats.sleeps++;
+            break;
+        
+        default:
+            break;
+    }
+}
+
+/*******************************************************************************
+* Function Name: DriverReady
+********************************************************************************
+*
+* Checks the driver can start a command: the block is enabled and no data 
+* phase is left to the DMA.
+*
+*******************************************************************************/
+static bool DriverReady(void)
+{
+    if((!smifEnabled) || (fifoState != SIM_FIFO_IDLE))
+    {
+        stats.driverErrors++;
+        return false;
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: DataPhase
+********************************************************************************
+*
+* Completes the raw transaction with its data phase. Without a buffer the 
+* data goes through the FIFO registers: the read data is ready for the DMA, 
+* the write is executed once the DMA has written all bytes.
+*
+*******************************************************************************/
+static cy_en_smif_status_t DataPhase(uint8_t *buffer, uint32_t size, cy_en_smif_txfr_width_t width, bool rx)
+{
+    sim_txn_t txn;
+    
+    if((!DriverReady()) || (!rawOpen) || (size == 0u) || (size > CY_SMIF_MAX_TX_TR))
+    {
+        stats.driverErrors++;
+        return CY_SMIF_BAD_PARAM;
+    }
+    
+    txn = (sim_txn_t){rawCmd, rawCmdLines, rawParams, rawParamSize, rawParamLines, rawDummy, 
+                      true, rx, buffer, size, Lines(width)};
+    rawOpen = false;
+    
+    if(buffer == NULL)
+    {
+        txn.data = fifo;
+        fifoSize = size;
+        fifoCount = 0u;
+        fifoState = rx ? SIM_FIFO_RX : SIM_FIFO_TX;
+        if(rx)
+        {
+            Execute(&txn);
+        }
+        else
+        {
+            fifoTxn = txn;
+        }
+    }
+    else
+    {
+        Execute(&txn);
+    }
+    return CY_SMIF_SUCCESS;
+}
+
+/*******************************************************************************
+* Function Name: FifoRead
+********************************************************************************
+*
+* DMA read of the RX FIFO. Without wait states the DMA is always ahead of the 
+* part and fails on the first byte.
+*
+*******************************************************************************/
+static bool FifoRead(uint8_t *value)
+{
+    if((fifoState != SIM_FIFO_RX) || (_FLD2VAL(SMIF_CTL_BLOCK, simSmif.CTL) != CY_SMIF_WAIT_STATES))
+    {
+        return false;
+    }
+    
+    *value = fifo[fifoCount];
+    fifoCount++;
+    if(fifoCount == fifoSize)
+    {
+        fifoState = SIM_FIFO_IDLE;
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: FifoWrite
+********************************************************************************
+*
+* DMA write of the TX FIFO, the write runs when the last byte is in.
+*
+*******************************************************************************/
+static bool FifoWrite(uint8_t value)
+{
+    if((fifoState != SIM_FIFO_TX) || (_FLD2VAL(SMIF_CTL_BLOCK, simSmif.CTL) != CY_SMIF_WAIT_STATES))
+    {
+        return false;
+    }
+    
+    fifo[fifoCount] = value;
+    fifoCount++;
+    if(fifoCount == fifoSize)
+    {
+        fifoState = SIM_FIFO_IDLE;
+        Execute(&fifoTxn);
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: RunDescriptor
+********************************************************************************
+*
+* Moves the elements of a 1D or 2D descriptor. The increments are in 
+* elements; only byte elements are modeled.
+*
+*******************************************************************************/
+static cy_en_dma_intr_cause_t RunDescriptor(const cy_stc_dma_descriptor_config_t *config)
+{
+    uint32_t xCount = (config->descriptorType == CY_DMA_SINGLE_TRANSFER) ? 1u : config->xCount;
+    uint32_t yCount = (config->descriptorType == CY_DMA_2D_TRANSFER) ? config->yCount : 1u;
+    uint8_t *src;
+    uint8_t *dst;
+    uint8_t value = 0u;
+    uint32_t x;
+    uint32_t y;
+    
+    if((config->dataSize != CY_DMA_BYTE) || (config->descriptorType == CY_DMA_CRC_TRANSFER))
+    {
+        return CY_DMA_INTR_CAUSE_SRC_MISAL;
+    }
+    
+    for(y = 0u; y < yCount; y++)
+    {
+        for(x = 0u; x < xCount; x++)
+        {
+            src = (uint8_t *)config->srcAddress + ((int64_t)y * config->srcYincrement) + ((int64_t)x * config->srcXincrement);
+            dst = (uint8_t *)config->dstAddress + ((int64_t)y * config->dstYincrement) + ((int64_t)x * config->dstXincrement);
+            
+            if(src == (uint8_t *)&simSmif.RX_DATA_FIFO_RD1)
+            {
+                if(!FifoRead(&value))
+                {
+                    return CY_DMA_INTR_CAUSE_SRC_BUS_ERROR;
+                }
+            }
+            else
+            {
+                value = *src;
+            }
+            
+            if(dst == (uint8_t *)&simSmif.TX_DATA_FIFO_WR1)
+            {
+                if(!FifoWrite(value))
+                {
+                    return CY_DMA_INTR_CAUSE_DST_BUS_ERROR;
+                }
+            }
+            else
+            {
+                *dst = value;
+            }
+        }
+    }
+    return CY_DMA_INTR_CAUSE_COMPLETION;
+}
+
+/*******************************************************************************
+* Function Name: DispatchInterrupts
+********************************************************************************
+*
+* Runs the handlers of the pending interrupts, in thread mode with the 
+* interrupts enabled. The handlers run with IPSR set and can raise further 
+* interrupts, which run after them.
+*
+*******************************************************************************/
+static void DispatchInterrupts(bool force)
+{
+    uint32_t irq = 0u;
+    
+    if(((irqHold) && (!force)) || (ipsr != 0u) || (primask != 0u))
+    {
+        return;
+    }
+    
+    while(irq < SIM_IRQ_COUNT)
+    {
+        if(irqPending[irq] && irqEnabled[irq] && (isrTable[irq] != NULL))
+        {
+            irqPending[irq] = false;
+            stats.interrupts++;
+            ipsr = 16u + irq;
+            isrTable[irq]();
+            ipsr = 0u;
+            irq = 0u;
+        }
+        else
+        {
+            irq++;
+        }
+    }
+}
+
+/*******************************************************************************
+*            Test functions
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: SimReset
+********************************************************************************
+*
+* Puts the model in the factory state: the array, special sector and serial 
+* number cleared, SPI mode with the power-up latency codes, the clock and 
+* counters at 0. The driver, DMA and interrupts are uninitialized.
+*
+*******************************************************************************/
+void SimReset(void)
+{
+    (void)memset(array, 0, sizeof(array));
+    (void)memset(specialSector, 0, sizeof(specialSector));
+    (void)memset(serialNumber, 0, sizeof(serialNumber));
+    (void)memcpy(deviceId, defaultId, sizeof(deviceId));
+    (void)memset(regs, 0, sizeof(regs));
+    regs[SIM_REG_CR1] = SIM_DEFAULT_CR1;
+    regs[SIM_REG_CR4] = SIM_DEFAULT_CR4;
+    regs[SIM_REG_CR5] = SIM_DEFAULT_CR5;
+    
+    now = 0u;
+    busFree = 0u;
+    spiClock = SIM_DEFAULT_SPI_CLOCK;
+    memAccessNs = SIM_MEM_ACCESS_NS;
+    regAccessNs = SIM_REG_ACCESS_NS;
+    
+    (void)memset(dmaChannels, 0, sizeof(dmaChannels));
+    dmaEnabled = false;
+    dmaFailures = 0u;
+    (void)memset(isrTable, 0, sizeof(isrTable));
+    (void)memset(irqEnabled, 0, sizeof(irqEnabled));
+    (void)memset(irqPending, 0, sizeof(irqPending));
+    irqHold = false;
+    ipsr = 0u;
+    primask = 0u;
+    simSmif.CTL = 0u;
+    
+    SimPowerCycle();
+    SimClearStats();
+}
+
+/*******************************************************************************
+* Function Name: SimPowerCycle
+********************************************************************************
+*
+* Removes the power. The array, special sector, serial number and the 
+* status and configuration registers are nonvolatile and kept, so is the 
+* access mode; WEL is cleared and the driver must be enabled again.
+*
+*******************************************************************************/
+void SimPowerCycle(void)
+{
+    regs[SIM_REG_SR1] &= (uint8_t)~SIM_SR1_WEL;
+    power = SIM_AWAKE;
+    smifEnabled = false;
+    rawOpen = false;
+    fifoState = SIM_FIFO_IDLE;
+    busySpins = 0u;
+}
+
+/*******************************************************************************
+* Function Name: SimSetSpiClock
+********************************************************************************
+*
+* Sets the SPI clock of the timing and of the latency the part needs.
+*
+*******************************************************************************/
+void SimSetSpiClock(uint32_t hz)
+{
+    spiClock = hz;
+}
+
+/*******************************************************************************
+* Function Name: SimSetAccessTimes
+********************************************************************************
+*
+* Sets the access times behind the memory and register latency codes.
+*
+*******************************************************************************/
+void SimSetAccessTimes(uint32_t memNs, uint32_t regNs)
+{
+    memAccessNs = memNs;
+    regAccessNs = regNs;
+}
+
+/*******************************************************************************
+* Function Name: SimSetDeviceId
+********************************************************************************
+*
+* Sets the device ID, for example of a part the driver does not know.
+*
+*******************************************************************************/
+void SimSetDeviceId(const uint8_t id[])
+{
+    (void)memcpy(deviceId, id, SIM_ID_SIZE);
+}
+
+/*******************************************************************************
+* Function Name: SimGetRegister
+********************************************************************************
+*
+* Returns a register by its WRAR address.
+*
+*******************************************************************************/
+uint8_t SimGetRegister(uint8_t reg)
+{
+    return regs[reg % SIM_REG_COUNT];
+}
+
+/*******************************************************************************
+* Function Name: SimSetRegister
+********************************************************************************
+*
+* Sets a register by its WRAR address, as a previous application left it.
+*
+*******************************************************************************/
+void SimSetRegister(uint8_t reg, uint8_t value)
+{
+    regs[reg % SIM_REG_COUNT] = value;
+}
+
+/*******************************************************************************
+* Function Name: SimArray
+********************************************************************************
+*
+* Returns the memory array.
+*
+*******************************************************************************/
+uint8_t *SimArray(void)
+{
+    return array;
+}
+
+/*******************************************************************************
+* Function Name: SimSpecialSector
+********************************************************************************
+*
+* Returns the special sector.
+*
+*******************************************************************************/
+uint8_t *SimSpecialSector(void)
+{
+    return specialSector;
+}
+
+/*******************************************************************************
+* Function Name: SimSerialNumber
+********************************************************************************
+*
+* Returns the serial number register.
+*
+*******************************************************************************/
+uint8_t *SimSerialNumber(void)
+{
+    return serialNumber;
+}
+
+/*******************************************************************************
+* Function Name: SimUniqueId
+********************************************************************************
+*
+* Returns the unique ID read by RUID.
+*
+*******************************************************************************/
+const uint8_t *SimUniqueId(void)
+{
+    return uniqueId;
+}
+
+/*******************************************************************************
+* Function Name: SimIsAsleep
+********************************************************************************
+*
+* Returns true in DPD or hibernate and until the exit time has passed.
+*
+*******************************************************************************/
+bool SimIsAsleep(void)
+{
+    return (power == SIM_ASLEEP) || ((power == SIM_WAKING) && (now < wakeEnd));
+}
+
+/*******************************************************************************
+* Function Name: SimFailDma
+********************************************************************************
+*
+* Makes the next descriptor chains fail at their first element, without 
+* moving data.
+*
+*******************************************************************************/
+void SimFailDma(uint32_t count)
+{
+    dmaFailures = count;
+}
+
+/*******************************************************************************
+* Function Name: SimHoldInterrupts
+********************************************************************************
+*
+* Keeps the interrupts pending until SimRunInterrupts(), as if the CPU was 
+* busy at a higher priority.
+*
+*******************************************************************************/
+void SimHoldInterrupts(bool hold)
+{
+    irqHold = hold;
+}
+
+/*******************************************************************************
+* Function Name: SimRunInterrupts
+********************************************************************************
+*
+* Runs the pending interrupts, also if they are held.
+*
+*******************************************************************************/
+void SimRunInterrupts(void)
+{
+    DispatchInterrupts(true);
+}
+
+/*******************************************************************************
+* Function Name: SimSetIsrContext
+********************************************************************************
+*
+* Runs the test code as an interrupt handler: IPSR is non-zero and the other 
+* interrupts wait until it returns.
+*
+*******************************************************************************/
+void SimSetIsrContext(bool active)
+{
+    ipsr = active ? SIM_TEST_EXCEPTION : 0u;
+    DispatchInterrupts(false);
+}
+
+/*******************************************************************************
+* Function Name: SimTimeNs
+********************************************************************************
+*
+* Returns the simulated time.
+*
+*******************************************************************************/
+uint64_t SimTimeNs(void)
+{
+    return now;
+}
+
+/*******************************************************************************
+* Function Name: SimAdvance
+********************************************************************************
+*
+* Lets time pass without bus traffic.
+*
+*******************************************************************************/
+void SimAdvance(uint64_t ns)
+{
+    Advance(ns);
+}
+
+/*******************************************************************************
+* Function Name: SimGetStats
+********************************************************************************
+*
+* Copies the counters.
+*
+*******************************************************************************/
+void SimGetStats(sim_stats_t *result)
+{
+    *result = stats;
+    result->timeNs = now;
+}
+
+/*******************************************************************************
+* Function Name: SimClearStats
+********************************************************************************
+*
+* Clears the counters.
+*
+*******************************************************************************/
+void SimClearStats(void)
+{
+    (void)memset(&stats, 0, sizeof(stats));
+}
+
+/*******************************************************************************
+* Function Name: SimPrintStats
+********************************************************************************
+*
+* Prints the timing report of the counters.
+*
+*******************************************************************************/
+void SimPrintStats(const char *name)
+{
+    printf("%s: %.3f ms, bus %.3f ms in %u commands (%llu clocks at %u MHz)\n",
+           name, (double)now / 1e6, (double)stats.busNs / 1e6, (unsigned)stats.commands,
+           (unsigned long long)stats.busClocks, (unsigned)(spiClock / 1000000u));
+    printf("%s: %u reads (%llu B), %u writes (%llu B), %u register reads, %u sleeps, %u wake-ups\n",
+           name, (unsigned)stats.reads, (unsigned long long)stats.bytesRead,
+           (unsigned)stats.writes, (unsigned long long)stats.bytesWritten,
+           (unsigned)stats.regReads, (unsigned)stats.sleeps, (unsigned)stats.wakeups);
+}
+
+/*******************************************************************************
+*            Core and system functions
+*******************************************************************************/
+DWT_Type *SimDwt(void)
+{
+    Advance(SIM_CPU_STEP_NS);
+    dwt.CYCCNT = (uint32_t)((now * (SystemCoreClock / 1000000u)) / 1000u);
+    return &dwt;
+}
+
+uint32_t __get_IPSR(void)
+{
+    return ipsr;
+}
+
+uint32_t __get_PRIMASK(void)
+{
+    return primask;
+}
+
+void SimAssertFailed(const char *file, int line)
+{
+    fprintf(stderr, "cy15x104qsn_sim: assertion failed at %s:%d\n", file, line);
+    abort();
+}
+
+void NVIC_EnableIRQ(IRQn_Type irq)
+{
+    if((irq >= 0) && (irq < (IRQn_Type)SIM_IRQ_COUNT))
+    {
+        irqEnabled[irq] = true;
+    }
+}
+
+void Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr)
+{
+    if((config->intrSrc >= 0) && (config->intrSrc < (IRQn_Type)SIM_IRQ_COUNT))
+    {
+        isrTable[config->intrSrc] = userIsr;
+    }
+}
+
+uint32_t Cy_SysLib_EnterCriticalSection(void)
+{
+    uint32_t saved = primask;
+    
+    primask = 1u;
+    return saved;
+}
+
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus)
+{
+    primask = savedIntrStatus;
+    DispatchInterrupts(false);
+}
+
+void Cy_SysLib_DelayUs(uint16_t microseconds)
+{
+    Advance((uint64_t)microseconds * 1000u);
+}
+
+/*******************************************************************************
+*            SMIF driver
+*******************************************************************************/
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Init
+********************************************************************************
+*
+* Takes the FIFO access behavior of the configuration into CTL.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Init(SMIF_Type *base, cy_stc_smif_config_t const *config, uint32_t timeout,
+                                 cy_stc_smif_context_t *context)
+{
+    (void)timeout; (void)context;
+    
+    base->CTL = (base->CTL & ~SMIF_CTL_BLOCK_Msk) | ((config->blockEvent << SMIF_CTL_BLOCK_Pos) & SMIF_CTL_BLOCK_Msk);
+    return CY_SMIF_SUCCESS;
+}
+
+void Cy_SMIF_Enable(SMIF_Type *base, cy_stc_smif_context_t *context)
+{
+    (void)base; (void)context;
+    smifEnabled = true;
+}
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_Disable
+********************************************************************************
+*
+* Stops the block, which empties the FIFOs and deselects the part: the bytes 
+* a write received until then are written.
+*
+*******************************************************************************/
+void Cy_SMIF_Disable(SMIF_Type *base)
+{
+    (void)base;
+    
+    if(fifoState == SIM_FIFO_TX)
+    {
+        fifoTxn.size = fifoCount;
+        fifoState = SIM_FIFO_IDLE;
+        Execute(&fifoTxn);
+    }
+    fifoState = SIM_FIFO_IDLE;
+    rawOpen = false;
+    smifEnabled = false;
+}
+
+void Cy_SMIF_SetDataSelect(SMIF_Type *base, cy_en_smif_slave_select_t slaveSelect,
+                           cy_en_smif_data_select_t dataSelect)
+{
+    (void)base; (void)slaveSelect; (void)dataSelect;
+}
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_BusyCheck
+********************************************************************************
+*
+* Busy while a data phase waits for the DMA. The target would poll forever 
+* if the DMA never moves the data, the model aborts the test instead.
+*
+*******************************************************************************/
+bool Cy_SMIF_BusyCheck(SMIF_Type const *base)
+{
+    (void)base;
+    
+    /* Spin until the last transaction is clocked out */
+    if(now < busFree)
+    {
+        Advance(busFree - now);
+    }
+    
+    if(fifoState == SIM_FIFO_IDLE)
+    {
+        busySpins = 0u;
+        return false;
+    }
+    
+    Advance(SIM_CPU_STEP_NS);
+    busySpins++;
+    if(busySpins > SIM_BUSY_SPIN_MAX)
+    {
+        fprintf(stderr, "cy15x104qsn_sim: the SMIF never gets idle, the data phase waits for the DMA\n");
+        abort();
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: Cy_SMIF_TransmitCommand
+********************************************************************************
+*
+* Opens a raw transaction. It is executed when the last byte is sent or with 
+* its data phase.
+*
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_TransmitCommand(SMIF_Type *base, uint8_t cmd, cy_en_smif_txfr_width_t cmdTxfrWidth,
+                                            uint8_t const cmdParam[], uint32_t paramSize,
+                                            cy_en_smif_txfr_width_t paramTxfrWidth,
+                                            cy_en_smif_slave_select_t slaveSelect, uint32_t completeTxfr,
+                                            cy_stc_smif_context_t const *context)
+{
+    sim_txn_t txn;
+    
+    (void)base; (void)slaveSelect; (void)context;
+    
+    if((!DriverReady()) || rawOpen || (paramSize > sizeof(rawParams)) || ((paramSize != 0u) && (cmdParam == NULL)))
+    {
+        stats.driverErrors++;
+        rawOpen = false;
+        return CY_SMIF_BAD_PARAM;
+    }
+    
+    rawOpen = true;
+    rawCmd = cmd;
+    rawCmdLines = Lines(cmdTxfrWidth);
+    rawParamSize = paramSize;
+    rawParamLines = Lines(paramTxfrWidth);
+    rawDummy = 0u;
+    if(paramSize != 0u)
+    {
+        (void)memcpy(rawParams, cmdParam, paramSize);
+    }
+    
+    if(completeTxfr == CY_SMIF_TX_LAST_BYTE)
+    {
+        txn = (sim_txn_t){rawCmd, rawCmdLines, rawParams, rawParamSize, rawParamLines, 0u, false, false, NULL, 0u, 1u};
+        rawOpen = false;
+        Execute(&txn);
+    }
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_SendDummyCycles(SMIF_Type *base, uint32_t cycles)
+{
+    (void)base;
+    
+    if((!DriverReady()) || (!rawOpen))
+    {
+        stats.driverErrors++;
+        return CY_SMIF_BAD_PARAM;
+    }
+    rawDummy += cycles;
+    return CY_SMIF_SUCCESS;
+}
+
+cy_en_smif_status_t Cy_SMIF_TransmitData(SMIF_Type *base, uint8_t const *txBuffer, uint32_t size,
+                                         cy_en_smif_txfr_width_t transferWidth,
+                                         cy_smif_event_cb_t TxCmpltCb, cy_stc_smif_context_t *context)
+{
+    cy_en_smif_status_t status;
+    
+    (void)base; (void)context;
+    
+    status = DataPhase((uint8_t *)txBuffer, size, transferWidth, false);
+    if((status == CY_SMIF_SUCCESS) && (txBuffer != NULL) && (TxCmpltCb != NULL))
+    {
+        TxCmpltCb(CY_SMIF_SEND_CMPLT);
+    }
+    return status;
+}
+
+cy_en_smif_status_t Cy_SMIF_ReceiveData(SMIF_Type *base, uint8_t *rxBuffer, uint32_t size,
+                                        cy_en_smif_txfr_width_t transferWidth,
+                                        cy_smif_event_cb_t RxCmpltCb, cy_stc_smif_context_t *context)
+{
+    cy_en_smif_status_t status;
+    
+    (void)base; (void)context;
+    
+    status = DataPhase(rxBuffer, size, transferWidth, true);
+    if((status == CY_SMIF_SUCCESS) && (rxBuffer != NULL) && (RxCmpltCb != NULL))
+    {
+        RxCmpltCb(CY_SMIF_REC_CMPLT);
+    }
+    return status;
+}
+
+/*******************************************************************************
+*            DMA driver and trigger multiplexer
+*******************************************************************************/
+cy_en_dma_status_t Cy_DMA_Descriptor_Init(cy_stc_dma_descriptor_t *descriptor,
+                                          cy_stc_dma_descriptor_config_t const *config)
+{
+    if((descriptor == NULL) || (config == NULL))
+    {
+        return CY_DMA_BAD_PARAM;
+    }
+    descriptor->config = *config;
+    return CY_DMA_SUCCESS;
+}
+
+cy_en_dma_status_t Cy_DMA_Channel_Init(DW_Type *base, uint32_t channel,
+                                       cy_stc_dma_channel_config_t const *channelConfig)
+{
+    (void)base;
+    
+    if((channel >= CY_DMA_CH_COUNT) || (channelConfig == NULL))
+    {
+        return CY_DMA_BAD_PARAM;
+    }
+    dmaChannels[channel].descriptor = channelConfig->descriptor;
+    dmaChannels[channel].enabled = channelConfig->enable;
+    dmaChannels[channel].status = CY_DMA_INTR_CAUSE_NO_INTR;
+    return CY_DMA_SUCCESS;
+}
+
+void Cy_DMA_Channel_SetDescriptor(DW_Type *base, uint32_t channel, cy_stc_dma_descriptor_t const *descriptor)
+{
+    (void)base;
+    dmaChannels[channel].descriptor = descriptor;
+}
+
+void Cy_DMA_Channel_Enable(DW_Type *base, uint32_t channel)
+{
+    (void)base;
+    dmaChannels[channel].enabled = true;
+}
+
+void Cy_DMA_Channel_Disable(DW_Type *base, uint32_t channel)
+{
+    (void)base;
+    dmaChannels[channel].enabled = false;
+}
+
+void Cy_DMA_Channel_SetInterruptMask(DW_Type *base, uint32_t channel, uint32_t interrupt)
+{
+    (void)base;
+    dmaChannels[channel].intrMask = ((interrupt & CY_DMA_INTR_MASK) != 0u);
+}
+
+void Cy_DMA_Channel_ClearInterrupt(DW_Type *base, uint32_t channel)
+{
+    (void)base;
+    irqPending[(uint32_t)cpuss_interrupts_dw0_0_IRQn + channel] = false;
+}
+
+cy_en_dma_intr_cause_t Cy_DMA_Channel_GetStatus(DW_Type const *base, uint32_t channel)
+{
+    (void)base;
+    return dmaChannels[channel].status;
+}
+
+void Cy_DMA_Enable(DW_Type *base)
+{
+    (void)base;
+    dmaEnabled = true;
+}
+
+/*******************************************************************************
+* Function Name: Cy_TrigMux_SwTrigger
+********************************************************************************
+*
+* Runs the descriptor chain of the triggered DataWire channel at once and 
+* raises its interrupt. The chain stops at an error or when a descriptor 
+* leaves the channel disabled.
+*
+*******************************************************************************/
+cy_en_trigmux_status_t Cy_TrigMux_SwTrigger(uint32_t trigLine, uint32_t cycles)
+{
+    uint32_t channel = trigLine - TRIG0_OUT_CPUSS_DW0_TR_IN0;
+    const cy_stc_dma_descriptor_t *descriptor;
+    cy_en_dma_intr_cause_t cause = CY_DMA_INTR_CAUSE_COMPLETION;
+    sim_dma_channel_t *ch;
+    
+    (void)cycles;
+    
+    if(channel >= CY_DMA_CH_COUNT)
+    {
+        return CY_TRIGMUX_BAD_PARAM;
+    }
+    
+    ch = &dmaChannels[channel];
+    if((!dmaEnabled) || (!ch->enabled) || (ch->descriptor == NULL))
+    {
+        /* The trigger is lost */
+        stats.driverErrors++;
+        return CY_TRIGMUX_SUCCESS;
+    }
+    
+    if(dmaFailures != 0u)
+    {
+        dmaFailures--;
+        cause = CY_DMA_INTR_CAUSE_SRC_BUS_ERROR;
+    }
+    else
+    {
+        descriptor = ch->descriptor;
+        while((descriptor != NULL) && (cause == CY_DMA_INTR_CAUSE_COMPLETION))
+        {
+            cause = RunDescriptor(&descriptor->config);
+            if(descriptor->config.channelState == CY_DMA_CHANNEL_DISABLED)
+            {
+                ch->enabled = false;
+                break;
+            }
+            descriptor = descriptor->config.nextDescriptor;
+        }
+    }
+    
+    ch->status = cause;
+    if(cause == CY_DMA_INTR_CAUSE_COMPLETION)
+    {
+        stats.dmaTransfers++;
+    }
+    else
+    {
+        stats.dmaErrors++;
+    }
+    
+    if(ch->intrMask)
+    {
+        irqPending[(uint32_t)cpuss_interrupts_dw0_0_IRQn + channel] = true;
+        DispatchInterrupts(false);
+    }
+    return CY_TRIGMUX_SUCCESS;
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,158 @@
+/******************************************************************************
+* File Name: cy15x104qsn_sim.h
+*
+* Version: 1.0
+*
+* Description: Behavioral model of the CY15x104QSN QSPI F-RAM behind the
+*              host SMIF and DMA drivers. The test functions below reset
+*              and inspect the model and report the simulated bus time.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef __CY15X104QSN_SIM_H
+#define __CY15X104QSN_SIM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*            Constants
+*******************************************************************************/
+#define SIM_MEM_SIZE            (0x00080000u)   /* 4 Mbit, the address wraps */
+#define SIM_SS_SIZE             (256u)          /* Special sector */
+#define SIM_SN_SIZE             (8u)            /* Serial number */
+#define SIM_ID_SIZE             (8u)            /* Device ID and unique ID */
+
+#define SIM_MAX_SPI_CLOCK       (108000000u)    /* Highest SCK of the part */
+#define SIM_DEFAULT_SPI_CLOCK   (50000000u)     /* Half of HFCLK2 at 100 MHz */
+#define SIM_MEM_ACCESS_NS       (80u)           /* Array access behind MLC */
+#define SIM_REG_ACCESS_NS       (30u)           /* Register access behind RLC */
+#define SIM_EXIT_LP_NS          (450000u)       /* tEXIT of DPD and hibernate */
+
+/* Register addresses of WRAR and RDAR */
+#define SIM_REG_SR1             (0x00u)
+#define SIM_REG_SR2             (0x01u)
+#define SIM_REG_CR1             (0x02u)
+#define SIM_REG_CR2             (0x03u)
+#define SIM_REG_CR4             (0x05u)
+#define SIM_REG_CR5             (0x06u)
+
+/* Register bits */
+#define SIM_SR1_WEL             (0x02u)
+#define SIM_CR1_QUAD            (0x02u)
+#define SIM_CR1_MLC_POS         (4u)
+#define SIM_CR2_DPI             (0x10u)
+#define SIM_CR2_QPI             (0x40u)
+#define SIM_CR5_RLC_POS         (6u)
+
+/*******************************************************************************
+*            Data Types
+*******************************************************************************/
+/* Counters of the model, times in simulated nanoseconds */
+typedef struct
+{
+    uint64_t timeNs;            /* Simulated time                               */
+    uint64_t busClocks;         /* SPI clocks of all transactions               */
+    uint64_t busNs;             /* Time the bus was driven                      */
+    uint32_t commands;          /* Transactions on the bus                      */
+    uint32_t reads;             /* Array and special sector reads               */
+    uint64_t bytesRead;
+    uint32_t writes;            /* Array and special sector writes              */
+    uint64_t bytesWritten;
+    uint32_t regReads;          /* Register, ID and serial number reads         */
+    uint32_t regWrites;         /* WRSR, WRAR and WRSN                          */
+    uint32_t sleeps;            /* DPD and hibernate entries                    */
+    uint32_t wakeups;           /* Chip selects which woke the part, the command is dropped */
+    uint32_t ignored;           /* Commands dropped: waking up, no WEL          */
+    uint32_t wrongMode;         /* Opcodes sent on a width other than the mode's */
+    uint32_t badCommands;       /* Unknown opcode, wrong widths, size or QUAD bit */
+    uint32_t badReads;          /* Reads with the wrong latency or above the rated clock */
+    uint32_t driverErrors;      /* Driver calls while disabled or out of order  */
+    uint32_t dmaTransfers;      /* Completed descriptor chains                  */
+    uint32_t dmaErrors;         /* Descriptor chains which failed               */
+    uint32_t interrupts;        /* Interrupt handlers run                       */
+} sim_stats_t;
+
+/*******************************************************************************
+*            Function Prototypes
+*******************************************************************************/
+void SimReset(void);                        /* Factory state, time 0 */
+
+void SimPowerCycle(void);                   /* Keep the nonvolatile content, drop WEL and the driver */
+
+void SimSetSpiClock(uint32_t hz);           /* SCK used for the timing and the latency */
+
+void SimSetAccessTimes(
+                    uint32_t memNs,
+                    uint32_t regNs);        /* A slower or faster part */
+
+void SimSetDeviceId(const uint8_t id[]);    /* 8-byte device ID returned by RDID */
+
+uint8_t SimGetRegister(uint8_t reg);        /* Register by its WRAR address */
+
+void SimSetRegister(
+                    uint8_t reg,
+                    uint8_t value);         /* Set a register without a command */
+
+uint8_t *SimArray(void);                    /* The memory array, for direct checks */
+
+uint8_t *SimSpecialSector(void);
+
+uint8_t *SimSerialNumber(void);
+
+const uint8_t *SimUniqueId(void);
+
+bool SimIsAsleep(void);                     /* In DPD or hibernate, or waking up */
+
+void SimFailDma(uint32_t count);            /* The next descriptor chains fail with a bus error */
+
+void SimHoldInterrupts(bool hold);          /* Keep the interrupts pending */
+
+void SimRunInterrupts(void);                /* Run the pending interrupts */
+
+void SimSetIsrContext(bool active);         /* The test code runs as an interrupt handler */
+
+uint64_t SimTimeNs(void);                   /* Simulated time */
+
+void SimAdvance(uint64_t ns);               /* Let time pass */
+
+void SimGetStats(sim_stats_t *stats);       /* Copy the counters */
+
+void SimClearStats(void);                   /* Clear the counters, keep the time */
+
+void SimPrintStats(const char *name);       /* Print a timing report */
+
+#endif /*__CY15X104QSN_SIM_H*/
+
+/* [] END OF FILE */
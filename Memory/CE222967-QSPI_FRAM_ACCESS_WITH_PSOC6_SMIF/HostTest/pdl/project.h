@@ -0,0 +1,257 @@
+/******************************************************************************
+* File Name: project.h
+*
+* Version: 1.0
+*
+* Description: Host replacement of the generated project.h, for building
+*              the F-RAM sources of CE222967 on a PC. The functions are
+*              implemented by cy15x104qsn_sim.c.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef PROJECT_H
+#define PROJECT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "smif/cy_smif.h"
+
+/*******************************************************************************
+*            Core and system functions
+*******************************************************************************/
+/* CPU clock of the simulated CM4 */
+extern uint32_t SystemCoreClock;
+
+/* The cycle counter follows the simulated time, every access takes a CPU step */
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+DWT_Type *SimDwt(void);
+extern CoreDebug_Type simCoreDebug;
+
+#define DWT                             (SimDwt())
+#define CoreDebug                       (&simCoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk          (1uL)
+#define CoreDebug_DEMCR_TRCENA_Msk      (1uL << 24u)
+
+/* Exception number and interrupt mask, driven by the simulated interrupts */
+uint32_t __get_IPSR(void);
+uint32_t __get_PRIMASK(void);
+
+#define _FLD2VAL(field, value)          (((uint32_t)(value) & field ## _Msk) >> field ## _Pos)
+
+/* Aborts the test, the target would halt in Cy_SysLib_AssertFailed() */
+void SimAssertFailed(const char *file, int line);
+#define CY_ASSERT(x)                    do { if(!(x)) { SimAssertFailed(__FILE__, __LINE__); } } while(0)
+
+typedef int IRQn_Type;
+void NVIC_EnableIRQ(IRQn_Type irq);
+
+typedef struct
+{
+    IRQn_Type intrSrc;
+    uint32_t intrPriority;
+} cy_stc_sysint_t;
+
+typedef void (*cy_israddress)(void);
+void Cy_SysInt_Init(const cy_stc_sysint_t *config, cy_israddress userIsr);
+
+uint32_t Cy_SysLib_EnterCriticalSection(void);
+void Cy_SysLib_ExitCriticalSection(uint32_t savedIntrStatus);
+void Cy_SysLib_DelayUs(uint16_t microseconds);
+
+/*******************************************************************************
+*            Device: SMIF, DataWire and trigger lines
+*******************************************************************************/
+extern SMIF_Type simSmif;
+#define SMIF0                           (&simSmif)
+
+#define cpuss_interrupts_dw0_0_IRQn     (28)
+#define TRIG0_OUT_CPUSS_DW0_TR_IN0      (0x40000000u)
+#define CY_DMA_CH_COUNT                 (16u)
+
+/* The host has no DataWire block, the model keeps the channel state */
+typedef struct
+{
+    uint32_t reserved;
+} DW_Type;
+
+extern DW_Type simDw0;
+#define DW0                             (&simDw0)
+
+/*******************************************************************************
+*            DMA driver
+*******************************************************************************/
+typedef enum
+{
+    CY_DMA_SUCCESS = 0u,
+    CY_DMA_BAD_PARAM
+} cy_en_dma_status_t;
+
+typedef enum
+{
+    CY_DMA_RETRIG_IM = 0u,
+    CY_DMA_RETRIG_4CYC,
+    CY_DMA_RETRIG_16CYC,
+    CY_DMA_WAIT_FOR_REACT
+} cy_en_dma_retrigger_t;
+
+/* Used for the interrupt, trigger out and trigger in types */
+typedef enum
+{
+    CY_DMA_1ELEMENT = 0u,
+    CY_DMA_X_LOOP,
+    CY_DMA_DESCR,
+    CY_DMA_DESCR_CHAIN
+} cy_en_dma_trigger_type_t;
+
+typedef enum
+{
+    CY_DMA_CHANNEL_ENABLED = 0u,
+    CY_DMA_CHANNEL_DISABLED
+} cy_en_dma_channel_state_t;
+
+typedef enum
+{
+    CY_DMA_BYTE = 0u,
+    CY_DMA_HALFWORD,
+    CY_DMA_WORD
+} cy_en_dma_data_size_t;
+
+typedef enum
+{
+    CY_DMA_TRANSFER_SIZE_DATA = 0u,
+    CY_DMA_TRANSFER_SIZE_WORD
+} cy_en_dma_transfer_size_t;
+
+typedef enum
+{
+    CY_DMA_SINGLE_TRANSFER = 0u,
+    CY_DMA_1D_TRANSFER,
+    CY_DMA_2D_TRANSFER,
+    CY_DMA_CRC_TRANSFER
+} cy_en_dma_descriptor_type_t;
+
+/* Last interrupt cause of a channel */
+typedef enum
+{
+    CY_DMA_INTR_CAUSE_NO_INTR = 0u,
+    CY_DMA_INTR_CAUSE_COMPLETION,
+    CY_DMA_INTR_CAUSE_SRC_BUS_ERROR,
+    CY_DMA_INTR_CAUSE_DST_BUS_ERROR,
+    CY_DMA_INTR_CAUSE_SRC_MISAL,
+    CY_DMA_INTR_CAUSE_DST_MISAL,
+    CY_DMA_INTR_CAUSE_CURR_PTR_NULL,
+    CY_DMA_INTR_CAUSE_ACTIVE_CH_DISABLED,
+    CY_DMA_INTR_CAUSE_DESCR_BUS_ERROR
+} cy_en_dma_intr_cause_t;
+
+#define CY_DMA_INTR_MASK                (1uL)
+
+struct cy_stc_dma_descriptor;
+
+typedef struct
+{
+    cy_en_dma_retrigger_t retrigger;
+    cy_en_dma_trigger_type_t interruptType;
+    cy_en_dma_trigger_type_t triggerOutType;
+    cy_en_dma_channel_state_t channelState;
+    cy_en_dma_trigger_type_t triggerInType;
+    cy_en_dma_data_size_t dataSize;
+    cy_en_dma_transfer_size_t srcTransferSize;
+    cy_en_dma_transfer_size_t dstTransferSize;
+    cy_en_dma_descriptor_type_t descriptorType;
+    void *srcAddress;
+    void *dstAddress;
+    int32_t srcXincrement;
+    int32_t dstXincrement;
+    uint32_t xCount;
+    int32_t srcYincrement;
+    int32_t dstYincrement;
+    uint32_t yCount;
+    struct cy_stc_dma_descriptor *nextDescriptor;
+} cy_stc_dma_descriptor_config_t;
+
+/* The host descriptor keeps its configuration instead of the register words */
+typedef struct cy_stc_dma_descriptor
+{
+    cy_stc_dma_descriptor_config_t config;
+} cy_stc_dma_descriptor_t;
+
+typedef struct
+{
+    cy_stc_dma_descriptor_t *descriptor;
+    bool preemptable;
+    uint32_t priority;
+    bool enable;
+} cy_stc_dma_channel_config_t;
+
+cy_en_dma_status_t Cy_DMA_Descriptor_Init(cy_stc_dma_descriptor_t *descriptor,
+                                          cy_stc_dma_descriptor_config_t const *config);
+cy_en_dma_status_t Cy_DMA_Channel_Init(DW_Type *base, uint32_t channel,
+                                       cy_stc_dma_channel_config_t const *channelConfig);
+void Cy_DMA_Channel_SetDescriptor(DW_Type *base, uint32_t channel, cy_stc_dma_descriptor_t const *descriptor);
+void Cy_DMA_Channel_Enable(DW_Type *base, uint32_t channel);
+void Cy_DMA_Channel_Disable(DW_Type *base, uint32_t channel);
+void Cy_DMA_Channel_SetInterruptMask(DW_Type *base, uint32_t channel, uint32_t interrupt);
+void Cy_DMA_Channel_ClearInterrupt(DW_Type *base, uint32_t channel);
+cy_en_dma_intr_cause_t Cy_DMA_Channel_GetStatus(DW_Type const *base, uint32_t channel);
+void Cy_DMA_Enable(DW_Type *base);
+
+/*******************************************************************************
+*            Trigger multiplexer
+*******************************************************************************/
+typedef enum
+{
+    CY_TRIGMUX_SUCCESS = 0u,
+    CY_TRIGMUX_BAD_PARAM
+} cy_en_trigmux_status_t;
+
+#define CY_TRIGGER_TWO_CYCLES           (2u)
+
+cy_en_trigmux_status_t Cy_TrigMux_SwTrigger(uint32_t trigLine, uint32_t cycles);
+
+#endif /* PROJECT_H */
+
+
+/* [] END OF FILE */
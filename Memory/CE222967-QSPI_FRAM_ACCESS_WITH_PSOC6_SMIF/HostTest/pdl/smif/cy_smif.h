@@ -0,0 +1,166 @@
+/******************************************************************************
+* File Name: cy_smif.h
+*
+* Version: 1.0
+*
+* Description: Host declarations of the PDL SMIF types and the driver
+*              functions used by the F-RAM sources of CE222967. Only what
+*              the sources use is declared; the names match the PDL.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#ifndef CY_SMIF_H
+#define CY_SMIF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*******************************************************************************
+*            PDL types used by the F-RAM sources
+*******************************************************************************/
+
+/* Driver status */
+typedef enum
+{
+    CY_SMIF_SUCCESS = 0u,
+    CY_SMIF_CMD_FIFO_FULL,
+    CY_SMIF_EXCEED_TIMEOUT,
+    CY_SMIF_NO_QE_BIT,
+    CY_SMIF_BAD_PARAM,
+    CY_SMIF_NO_SFDP_SUPPORT
+} cy_en_smif_status_t;
+
+/* Number of data lines of a command phase */
+typedef enum
+{
+    CY_SMIF_WIDTH_SINGLE = 0u,
+    CY_SMIF_WIDTH_DUAL,
+    CY_SMIF_WIDTH_QUAD,
+    CY_SMIF_WIDTH_OCTAL
+} cy_en_smif_txfr_width_t;
+
+typedef enum
+{
+    CY_SMIF_SLAVE_SELECT_0 = 1u,
+    CY_SMIF_SLAVE_SELECT_1 = 2u,
+    CY_SMIF_SLAVE_SELECT_2 = 4u,
+    CY_SMIF_SLAVE_SELECT_3 = 8u
+} cy_en_smif_slave_select_t;
+
+typedef enum
+{
+    CY_SMIF_DATA_SEL0 = 0u,
+    CY_SMIF_DATA_SEL1,
+    CY_SMIF_DATA_SEL2,
+    CY_SMIF_DATA_SEL3
+} cy_en_smif_data_select_t;
+
+typedef enum
+{
+    CY_SMIF_NORMAL = 0u,
+    CY_SMIF_MEMORY
+} cy_en_smif_mode_t;
+
+/* Access to an empty RX FIFO or a full TX FIFO, CTL.BLOCK */
+typedef enum
+{
+    CY_SMIF_BUS_ERROR = 0u,
+    CY_SMIF_WAIT_STATES = 1u
+} cy_en_smif_error_event_t;
+
+/* The registers the sources access, the FIFOs are served by the model */
+typedef struct
+{
+    volatile uint32_t CTL;
+    volatile uint32_t TX_DATA_FIFO_WR1;
+    volatile uint32_t RX_DATA_FIFO_RD1;
+} SMIF_Type;
+
+#define SMIF_CTL_BLOCK_Pos              (12u)
+#define SMIF_CTL_BLOCK_Msk              (0x00001000uL)
+
+typedef struct
+{
+    volatile uint32_t transferStatus;
+} cy_stc_smif_context_t;
+
+typedef void (*cy_smif_event_cb_t)(uint32_t event);
+
+typedef struct
+{
+    uint32_t mode;
+    uint32_t deselectDelay;
+    uint32_t rxClockSel;
+    uint32_t blockEvent;
+} cy_stc_smif_config_t;
+
+/* Events passed to the completion callbacks */
+#define CY_SMIF_SEND_CMPLT              (1u)
+#define CY_SMIF_REC_CMPLT               (3u)
+
+#define CY_SMIF_TX_NOT_LAST_BYTE        (0u)
+#define CY_SMIF_TX_LAST_BYTE            (1u)
+
+/* Largest data phase of one command */
+#define CY_SMIF_MAX_TX_TR               (0x10000u)
+
+/*******************************************************************************
+*            PDL functions used by the F-RAM sources
+*******************************************************************************/
+cy_en_smif_status_t Cy_SMIF_Init(SMIF_Type *base, cy_stc_smif_config_t const *config, uint32_t timeout,
+                                 cy_stc_smif_context_t *context);
+void Cy_SMIF_Enable(SMIF_Type *base, cy_stc_smif_context_t *context);
+void Cy_SMIF_Disable(SMIF_Type *base);
+void Cy_SMIF_SetDataSelect(SMIF_Type *base, cy_en_smif_slave_select_t slaveSelect,
+                           cy_en_smif_data_select_t dataSelect);
+bool Cy_SMIF_BusyCheck(SMIF_Type const *base);
+
+cy_en_smif_status_t Cy_SMIF_TransmitCommand(SMIF_Type *base, uint8_t cmd, cy_en_smif_txfr_width_t cmdTxfrWidth,
+                                            uint8_t const cmdParam[], uint32_t paramSize,
+                                            cy_en_smif_txfr_width_t paramTxfrWidth,
+                                            cy_en_smif_slave_select_t slaveSelect, uint32_t completeTxfr,
+                                            cy_stc_smif_context_t const *context);
+cy_en_smif_status_t Cy_SMIF_TransmitData(SMIF_Type *base, uint8_t const *txBuffer, uint32_t size,
+                                         cy_en_smif_txfr_width_t transferWidth,
+                                         cy_smif_event_cb_t TxCmpltCb, cy_stc_smif_context_t *context);
+cy_en_smif_status_t Cy_SMIF_ReceiveData(SMIF_Type *base, uint8_t *rxBuffer, uint32_t size,
+                                        cy_en_smif_txfr_width_t transferWidth,
+                                        cy_smif_event_cb_t RxCmpltCb, cy_stc_smif_context_t *context);
+cy_en_smif_status_t Cy_SMIF_SendDummyCycles(SMIF_Type *base, uint32_t cycles);
+
+#endif /* CY_SMIF_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,619 @@
+/******************************************************************************
+* File Name: test_access.c
+*
+* Version: 1.0
+*
+* Description: Host tests of the F-RAM command functions of CE222967 on the
+*              CY15x104QSN model: registers, IDs, serial number, the
+*              memory in SPI, DPI and QPI with all read and write
+*              commands, the special sector, the latency codes, the bus
+*              clocks of a transfer, the low power modes and the time of
+*              a small write with the WREN folded in.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "FRAM_ACCESS.h"
+#include "cy15x104qsn_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Checks a condition and counts the failures */
+#define CHECK(cond)     Check((cond), #cond, __LINE__)
+
+/* Latency codes the model starts with, right at the default 50 MHz SCK */
+#define TEST_MLC                (8u)
+#define TEST_RLC                (3u)
+#define TEST_SMALL_WRITE        (8u)
+#define TEST_RANDOM_WRITES      (64u)
+
+static uint32_t failures = 0u;
+
+static cy_stc_smif_context_t smifContext;
+
+/*******************************************************************************
+* Function Name: Check
+********************************************************************************
+*
+* Reports a failed check.
+*
+*******************************************************************************/
+static void Check(bool cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("test_access.c:%d: check failed: %s\n", line, text);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: StartFram
+********************************************************************************
+*
+* Resets the model and enables the SMIF, the F-RAM is in SPI mode with the 
+* QUAD bit set.
+*
+*******************************************************************************/
+static void StartFram(void)
+{
+    static const cy_stc_smif_config_t config = {CY_SMIF_NORMAL, 7u, 1u, CY_SMIF_WAIT_STATES};
+    
+    SimReset();
+    (void)Cy_SMIF_Init(SMIF0, &config, TIMEOUT_1_MS, &smifContext);
+    Cy_SMIF_Enable(SMIF0, &smifContext);
+    SimSetRegister(SIM_REG_CR1, (uint8_t)((TEST_MLC << SIM_CR1_MLC_POS) | SIM_CR1_QUAD));
+}
+
+/*******************************************************************************
+* Function Name: SetMode
+********************************************************************************
+*
+* Switches the F-RAM from SPI to another access mode with WRSR, keeping the 
+* latency codes.
+*
+*******************************************************************************/
+static void SetMode(uint8_t spimode)
+{
+    static const uint8_t cr2[] = {0x00u, SIM_CR2_DPI, SIM_CR2_QPI};
+    uint8_t regs[5u] = {0x00u, SimGetRegister(SIM_REG_CR1), cr2[spimode], 
+                        SimGetRegister(SIM_REG_CR4), SimGetRegister(SIM_REG_CR5)};
+    
+    WriteCmdWRSR(SMIF0, &smifContext, regs, sizeof(regs), SPI_MODE);
+}
+
+/*******************************************************************************
+* Function Name: Fill
+********************************************************************************
+*
+* Fills a buffer with a pattern of a seed.
+*
+*******************************************************************************/
+static void Fill(uint8_t buffer[], uint32_t size, uint8_t seed)
+{
+    uint32_t i;
+    
+    for(i = 0u; i < size; i++)
+    {
+        buffer[i] = (uint8_t)((i * 7u) + seed);
+    }
+}
+
+/*******************************************************************************
+* Function Name: CheckClean
+********************************************************************************
+*
+* Checks no command was dropped or decoded wrong since the last clear.
+*
+*******************************************************************************/
+static void CheckClean(void)
+{
+    sim_stats_t stats;
+    
+    SimGetStats(&stats);
+    CHECK(stats.ignored == 0u);
+    CHECK(stats.wrongMode == 0u);
+    CHECK(stats.badCommands == 0u);
+    CHECK(stats.badReads == 0u);
+    CHECK(stats.driverErrors == 0u);
+}
+
+/*******************************************************************************
+* Function Name: TestRegisters
+********************************************************************************
+*
+* WRSR writes SR1 and CR1 to CR5 in order, WRAR one register; both need the 
+* WEL bit, which the command functions set. The read-back is with the RLC.
+*
+*******************************************************************************/
+static void TestRegisters(void)
+{
+    uint8_t regs[5u] = {0x00u, (uint8_t)((TEST_MLC << 4u) | SIM_CR1_QUAD), 0x00u, 0x08u, (uint8_t)(TEST_RLC << 6u)};
+    uint8_t address[ADDRESS_SIZE] = {0x00u, 0x00u, SIM_REG_CR4};
+    uint8_t value = 0x0Cu;
+    uint8_t data[SR_SIZE];
+    
+    StartFram();
+    
+    WriteCmdWRSR(SMIF0, &smifContext, regs, sizeof(regs), SPI_MODE);
+    CHECK(SimGetRegister(SIM_REG_CR1) == regs[1u]);
+    CHECK(SimGetRegister(SIM_REG_CR5) == regs[4u]);
+    CHECK((SimGetRegister(SIM_REG_SR1) & SIM_SR1_WEL) == 0u);
+    
+    WriteCmdSPIWriteAnyReg(SMIF0, &smifContext, &value, 1u, address, SPI_MODE);
+    CHECK(SimGetRegister(SIM_REG_CR4) == 0x0Cu);
+    
+    data[0u] = 0u;
+    WriteCmdSPIReadAnyReg(SMIF0, &smifContext, data, SR_SIZE, address, SPI_MODE, TEST_RLC);
+    CHECK(data[0u] == 0x0Cu);
+    
+    WriteCmdReadCRx(SMIF0, &smifContext, data, SR_SIZE, SPI_MODE, MEM_CMD_RDCR1, TEST_RLC);
+    CHECK(data[0u] == regs[1u]);
+    
+    WriteCmdWREN(SMIF0, &smifContext, SPI_MODE);
+    WriteCmdReadSRx(SMIF0, &smifContext, data, SR_SIZE, SPI_MODE, MEM_CMD_RDSR1, TEST_RLC);
+    CHECK(data[0u] == SIM_SR1_WEL);
+    WriteCmdWRDI(SMIF0, &smifContext, SPI_MODE);
+    WriteCmdReadSRx(SMIF0, &smifContext, data, SR_SIZE, SPI_MODE, MEM_CMD_RDSR1, TEST_RLC);
+    CHECK(data[0u] == 0x00u);
+    
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestIds
+********************************************************************************
+*
+* RDID, RUID and the serial number written by WRSN and read by RDSN.
+*
+*******************************************************************************/
+static void TestIds(void)
+{
+    static const uint8_t expected[DID_REG_SIZE] = {0x50u, 0x51u, 0x82u, 0x06u, 0x00u, 0x00u, 0x00u, 0x00u};
+    uint8_t sn[SN_BUF_SIZE] = {0x11u, 0x22u, 0x33u, 0x44u, 0x55u, 0x66u, 0x77u, 0x88u};
+    uint8_t data[DID_REG_SIZE];
+    
+    StartFram();
+    
+    WriteCmdRDID(SMIF0, &smifContext, data, SPI_MODE, TEST_RLC);
+    CHECK(memcmp(data, expected, sizeof(data)) == 0);
+    
+    WriteCmdRDUID(SMIF0, &smifContext, data, SPI_MODE, TEST_RLC);
+    CHECK(memcmp(data, SimUniqueId(), sizeof(data)) == 0);
+    
+    WriteCmdWRSN(SMIF0, &smifContext, sn, sizeof(sn), SPI_MODE);
+    CHECK(memcmp(SimSerialNumber(), sn, sizeof(sn)) == 0);
+    (void)memset(data, 0, sizeof(data));
+    WriteCmdRDSN(SMIF0, &smifContext, data, sizeof(data), SPI_MODE, TEST_RLC);
+    CHECK(memcmp(data, sn, sizeof(sn)) == 0);
+    
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestWriteEnable
+********************************************************************************
+*
+* A write sent without WREN is ignored by the part; the command functions 
+* send WREN and the WEL bit is cleared after the write.
+*
+*******************************************************************************/
+static void TestWriteEnable(void)
+{
+    uint8_t address[ADDRESS_SIZE] = {0x00u, 0x10u, 0x00u};
+    uint8_t data[4u] = {1u, 2u, 3u, 4u};
+    sim_stats_t stats;
+    
+    StartFram();
+    
+    (void)Cy_SMIF_TransmitCommand(SMIF0, MEM_CMD_WRITE, CY_SMIF_WIDTH_SINGLE, address, ADDRESS_SIZE, 
+                                  CY_SMIF_WIDTH_SINGLE, CY_SMIF_SLAVE_SELECT_2, TX_NOT_LAST_BYTE, &smifContext);
+    (void)Cy_SMIF_TransmitData(SMIF0, data, sizeof(data), CY_SMIF_WIDTH_SINGLE, NULL, &smifContext);
+    SimGetStats(&stats);
+    CHECK(stats.ignored == 1u);
+    CHECK(SimArray()[0x1000u] == 0x00u);
+    
+    SimClearStats();
+    WriteCmdSPIWrite(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE);
+    CHECK(memcmp(&SimArray()[0x1000u], data, sizeof(data)) == 0);
+    CHECK((SimGetRegister(SIM_REG_SR1) & SIM_SR1_WEL) == 0u);
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: CheckMemory
+********************************************************************************
+*
+* Writes and reads back a packet with the commands of an access mode.
+*
+*******************************************************************************/
+static void CheckMemory(uint8_t spimode, uint32_t addr, uint8_t seed)
+{
+    uint8_t address[ADDRESS_PLUS_MODE_SIZE] = {(uint8_t)(addr >> 16u), (uint8_t)(addr >> 8u), (uint8_t)addr, 0x00u};
+    uint8_t pattern[PACKET_SIZE];
+    uint8_t data[PACKET_SIZE];
+    
+    Fill(pattern, sizeof(pattern), seed);
+    WriteCmdSPIWrite(SMIF0, &smifContext, pattern, sizeof(pattern), address, spimode);
+    CHECK(memcmp(&SimArray()[addr], pattern, sizeof(pattern)) == 0);
+    (void)memset(data, 0, sizeof(data));
+    WriteCmdSPIRead(SMIF0, &smifContext, data, sizeof(data), address, spimode, TEST_MLC);
+    CHECK(memcmp(data, pattern, sizeof(data)) == 0);
+    
+    Fill(pattern, sizeof(pattern), (uint8_t)(seed + 1u));
+    WriteCmdSPIFastWrite(SMIF0, &smifContext, pattern, sizeof(pattern), address, spimode);
+    (void)memset(data, 0, sizeof(data));
+    WriteCmdSPIFastRead(SMIF0, &smifContext, data, sizeof(data), address, spimode, TEST_MLC);
+    CHECK(memcmp(data, pattern, sizeof(data)) == 0);
+    
+    /* DPI mode has no quad read */
+    (void)memset(data, 0, sizeof(data));
+    WriteCmdSPIRead_DIOR_QIOR(SMIF0, &smifContext, data, sizeof(data), address, spimode, TEST_MLC, 
+                              (spimode == DPI_MODE) ? MEM_CMD_DIOR : MEM_CMD_QIOR);
+    CHECK(memcmp(data, pattern, sizeof(data)) == 0);
+}
+
+/*******************************************************************************
+* Function Name: TestModes
+********************************************************************************
+*
+* The memory commands in SPI, DPI and QPI mode, and the dual and quad 
+* commands of the SPI mode.
+*
+*******************************************************************************/
+static void TestModes(void)
+{
+    static const uint8_t writes[] = {MEM_CMD_DIOW, MEM_CMD_QIOW, MEM_CMD_DIW, MEM_CMD_QIW};
+    uint8_t address[ADDRESS_PLUS_MODE_SIZE] = {0x02u, 0x00u, 0x00u, 0x00u};
+    uint8_t pattern[PACKET_SIZE];
+    uint8_t data[PACKET_SIZE];
+    uint32_t i;
+    
+    StartFram();
+    
+    CheckMemory(SPI_MODE, 0x01000u, 0x10u);
+    
+    for(i = 0u; i < sizeof(writes); i++)
+    {
+        Fill(pattern, sizeof(pattern), (uint8_t)(0x40u + i));
+        if(i < 2u)
+        {
+            WriteCmdSPIWrite_DIOW_QIOW(SMIF0, &smifContext, pattern, sizeof(pattern), address, writes[i]);
+        }
+        else
+        {
+            WriteCmdSPIWrite_DIW_QIW(SMIF0, &smifContext, pattern, sizeof(pattern), address, writes[i]);
+        }
+        CHECK(memcmp(&SimArray()[0x20000u], pattern, sizeof(pattern)) == 0);
+        
+        (void)memset(data, 0, sizeof(data));
+        WriteCmdSPIRead_DIOR_QIOR(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE, TEST_MLC, MEM_CMD_DIOR);
+        CHECK(memcmp(data, pattern, sizeof(data)) == 0);
+        (void)memset(data, 0, sizeof(data));
+        WriteCmdSPIRead_DOR_QOR(SMIF0, &smifContext, data, sizeof(data), address, MEM_CMD_DOR, TEST_MLC);
+        CHECK(memcmp(data, pattern, sizeof(data)) == 0);
+        (void)memset(data, 0, sizeof(data));
+        WriteCmdSPIRead_DOR_QOR(SMIF0, &smifContext, data, sizeof(data), address, MEM_CMD_QOR, TEST_MLC);
+        CHECK(memcmp(data, pattern, sizeof(data)) == 0);
+    }
+    
+    SetMode(DPI_MODE);
+    CHECK(SimGetRegister(SIM_REG_CR2) == SIM_CR2_DPI);
+    CheckMemory(DPI_MODE, 0x03000u, 0x20u);
+    
+    SetMode(QPI_MODE);
+    CHECK(SimGetRegister(SIM_REG_CR2) == SIM_CR2_DPI);   /* The WRSR in SPI mode is not decoded */
+    {
+        uint8_t regs[5u] = {0x00u, SimGetRegister(SIM_REG_CR1), SIM_CR2_QPI, 0x08u, (uint8_t)(TEST_RLC << 6u)};
+        
+        WriteCmdWRSR(SMIF0, &smifContext, regs, sizeof(regs), DPI_MODE);
+    }
+    CHECK(SimGetRegister(SIM_REG_CR2) == SIM_CR2_QPI);
+    SimClearStats();
+    CheckMemory(QPI_MODE, 0x7FF00u, 0x30u);
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestWrongSetup
+********************************************************************************
+*
+* The part rejects the quad commands of the SPI mode without the QUAD bit, 
+* a read with other dummy cycles than the latency code returns shifted data, 
+* and so does a latency code too small for the SCK.
+*
+*******************************************************************************/
+static void TestWrongSetup(void)
+{
+    uint8_t address[ADDRESS_PLUS_MODE_SIZE] = {0x00u, 0x40u, 0x00u, 0x00u};
+    uint8_t pattern[PACKET_SIZE];
+    uint8_t data[PACKET_SIZE];
+    sim_stats_t stats;
+    
+    StartFram();
+    Fill(pattern, sizeof(pattern), 0x55u);
+    WriteCmdSPIWrite(SMIF0, &smifContext, pattern, sizeof(pattern), address, SPI_MODE);
+    
+    SimSetRegister(SIM_REG_CR1, (uint8_t)(TEST_MLC << SIM_CR1_MLC_POS));
+    SimClearStats();
+    WriteCmdSPIRead_DOR_QOR(SMIF0, &smifContext, data, sizeof(data), address, MEM_CMD_QOR, TEST_MLC);
+    SimGetStats(&stats);
+    CHECK(stats.badCommands == 1u);
+    CHECK(data[0u] == 0xFFu);
+    SimSetRegister(SIM_REG_CR1, (uint8_t)((TEST_MLC << SIM_CR1_MLC_POS) | SIM_CR1_QUAD));
+    
+    SimClearStats();
+    WriteCmdSPIRead(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE, TEST_MLC - 1u);
+    SimGetStats(&stats);
+    CHECK(stats.badReads == 1u);
+    CHECK(data[0u] == (uint8_t)(0x80u | (pattern[0u] >> 1u)));   /* Sampled one cycle early */
+    
+    /* MLC 2 is right at 25 MHz only */
+    SimSetRegister(SIM_REG_CR1, (uint8_t)((2u << SIM_CR1_MLC_POS) | SIM_CR1_QUAD));
+    SimClearStats();
+    WriteCmdSPIRead(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE, 2u);
+    SimGetStats(&stats);
+    CHECK(stats.badReads == 1u);
+    CHECK(memcmp(data, pattern, sizeof(data)) != 0);
+    
+    SimSetSpiClock(25000000u);
+    SimClearStats();
+    WriteCmdSPIRead(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE, 2u);
+    CHECK(memcmp(data, pattern, sizeof(data)) == 0);
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestSpecialSector
+********************************************************************************
+*
+* SSWR and SSRD access the 256-byte special sector, not the array; the 
+* address wraps in the sector.
+*
+*******************************************************************************/
+static void TestSpecialSector(void)
+{
+    uint8_t address[ADDRESS_SIZE] = {0x00u, 0x00u, 0x00u};
+    uint8_t pattern[PACKET_SIZE];
+    uint8_t data[PACKET_SIZE];
+    
+    StartFram();
+    Fill(pattern, sizeof(pattern), 0x99u);
+    
+    WriteCmdSSWR(SMIF0, &smifContext, pattern, sizeof(pattern), address, SPI_MODE);
+    CHECK(memcmp(SimSpecialSector(), pattern, sizeof(pattern)) == 0);
+    CHECK(SimArray()[0u] == 0x00u);
+    
+    address[2u] = 0x80u;
+    WriteCmdSSRD(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE, TEST_MLC);
+    CHECK(memcmp(data, &pattern[0x80u], 0x80u) == 0);
+    CHECK(memcmp(&data[0x80u], pattern, 0x80u) == 0);
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestAddressWrap
+********************************************************************************
+*
+* A transfer past the end continues at address 0, and the address bits above 
+* the array size are ignored.
+*
+*******************************************************************************/
+static void TestAddressWrap(void)
+{
+    uint8_t address[ADDRESS_SIZE] = {0x07u, 0xFFu, 0xF8u};
+    uint8_t pattern[16u];
+    uint8_t data[16u];
+    
+    StartFram();
+    Fill(pattern, sizeof(pattern), 0xA0u);
+    
+    WriteCmdSPIWrite(SMIF0, &smifContext, pattern, sizeof(pattern), address, SPI_MODE);
+    CHECK(memcmp(&SimArray()[0x7FFF8u], pattern, 8u) == 0);
+    CHECK(memcmp(SimArray(), &pattern[8u], 8u) == 0);
+    
+    /* 0x123456 is 0x23456 in the 4-Mbit array */
+    address[0u] = 0x12u;
+    address[1u] = 0x34u;
+    address[2u] = 0x56u;
+    WriteCmdSPIWrite(SMIF0, &smifContext, pattern, sizeof(pattern), address, SPI_MODE);
+    CHECK(memcmp(&SimArray()[0x23456u], pattern, sizeof(pattern)) == 0);
+    address[0u] = 0x02u;
+    WriteCmdSPIRead(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE, TEST_MLC);
+    CHECK(memcmp(data, pattern, sizeof(data)) == 0);
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestBusClocks
+********************************************************************************
+*
+* The SPI clocks of a packet transfer: WREN and WRITE in SPI mode, READ in 
+* QPI mode and QIOR in SPI mode, with the memory latency.
+*
+*******************************************************************************/
+static void TestBusClocks(void)
+{
+    uint8_t address[ADDRESS_PLUS_MODE_SIZE] = {0x00u, 0x00u, 0x00u, 0x00u};
+    uint8_t data[PACKET_SIZE];
+    sim_stats_t stats;
+    
+    StartFram();
+    
+    /* WREN 8, WRITE 8 + 24 + 256 x 8 */
+    SimClearStats();
+    WriteCmdSPIWrite(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE);
+    SimGetStats(&stats);
+    CHECK(stats.commands == 2u);
+    CHECK(stats.busClocks == (8u + 2080u));
+    
+    /* 8 + 24 + 8 dummy + 256 x 8, each on 4 lines except the dummy */
+    SimClearStats();
+    WriteCmdSPIRead_DIOR_QIOR(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE, TEST_MLC, MEM_CMD_QIOR);
+    SimGetStats(&stats);
+    CHECK(stats.busClocks == (8u + 8u + 8u + 512u));
+    
+    SetMode(QPI_MODE);
+    SimClearStats();
+    WriteCmdSPIRead(SMIF0, &smifContext, data, sizeof(data), address, QPI_MODE, TEST_MLC);
+    SimGetStats(&stats);
+    CHECK(stats.busClocks == (2u + 6u + 8u + 512u));
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestLowPower
+********************************************************************************
+*
+* In hibernate the first chip select wakes the part and its command is lost, 
+* the part takes commands again after the exit time. A command in another 
+* access mode is not decoded.
+*
+*******************************************************************************/
+static void TestLowPower(void)
+{
+    uint8_t data[DID_REG_SIZE];
+    sim_stats_t stats;
+    
+    StartFram();
+    
+    WriteCmdEnterLPMode(SMIF0, &smifContext, MEM_CMD_ENTHBN, SPI_MODE);
+    CHECK(SimIsAsleep());
+    
+    SimClearStats();
+    WriteCmdRDID(SMIF0, &smifContext, data, SPI_MODE, TEST_RLC);
+    CHECK(data[0u] == 0xFFu);
+    SimGetStats(&stats);
+    CHECK(stats.wakeups == 1u);
+    CHECK(SimIsAsleep());
+    
+    WriteCmdRDID(SMIF0, &smifContext, data, SPI_MODE, TEST_RLC);
+    SimGetStats(&stats);
+    CHECK(stats.ignored == 1u);
+    
+    Cy_SysLib_DelayUs((uint16_t)(SIM_EXIT_LP_NS / 1000u));
+    CHECK(!SimIsAsleep());
+    WriteCmdRDID(SMIF0, &smifContext, data, SPI_MODE, TEST_RLC);
+    CHECK(data[0u] == 0x50u);
+    
+    SimClearStats();
+    WriteCmdRDID(SMIF0, &smifContext, data, QPI_MODE, TEST_RLC);
+    SimGetStats(&stats);
+    CHECK(stats.wrongMode == 1u);
+    CHECK(data[0u] == 0xFFu);
+}
+
+/*******************************************************************************
+* Function Name: TestFoldedWren
+********************************************************************************
+*
+* Small writes to pseudo-random addresses, timed in model time: WREN folded 
+* into the WRITE command by WriteCmdSPIWrite(), against a blocking WREN 
+* followed by the WRITE. The folded WREN runs on the bus while the CPU queues 
+* the WRITE, so it must be faster.
+*
+*******************************************************************************/
+static void TestFoldedWren(void)
+{
+    uint8_t address[ADDRESS_SIZE];
+    uint8_t data[TEST_SMALL_WRITE];
+    uint64_t foldedNs = 0u;
+    uint64_t unfoldedNs = 0u;
+    uint64_t start;
+    uint32_t seed = 1u;
+    uint32_t offset;
+    uint32_t i;
+    bool same = true;
+    
+    StartFram();
+    
+    for(i = 0u; i < TEST_RANDOM_WRITES; i++)
+    {
+        seed = (seed * 1103515245u) + 12345u;
+        offset = (seed >> 8u) % (SIM_MEM_SIZE - sizeof(data));
+        address[0u] = (uint8_t)(offset >> 16u);
+        address[1u] = (uint8_t)(offset >> 8u);
+        address[2u] = (uint8_t)offset;
+        (void)memset(data, (int)(i & 0xFFu), sizeof(data));
+        
+        start = SimTimeNs();
+        (void)WriteCmdSPIWrite(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE);
+        foldedNs += SimTimeNs() - start;
+        same = same && (memcmp(&SimArray()[offset], data, sizeof(data)) == 0);
+        
+        data[0u] ^= 0xFFu;
+        start = SimTimeNs();
+        (void)WriteCmdWREN(SMIF0, &smifContext, SPI_MODE);
+        Cy_SMIF_TransmitCommand(SMIF0, MEM_CMD_WRITE, CY_SMIF_WIDTH_SINGLE, address, ADDRESS_SIZE,
+                                CY_SMIF_WIDTH_SINGLE, CY_SMIF_SLAVE_SELECT_2, TX_NOT_LAST_BYTE, &smifContext);
+        Cy_SMIF_TransmitData(SMIF0, data, sizeof(data), CY_SMIF_WIDTH_SINGLE, NULL, &smifContext);
+        while(Cy_SMIF_BusyCheck(SMIF0))
+        {
+        }
+        unfoldedNs += SimTimeNs() - start;
+        same = same && (memcmp(&SimArray()[offset], data, sizeof(data)) == 0);
+    }
+    
+    printf("test_access: %u-byte random write: %u ns with folded WREN, %u ns with a separate WREN\n",
+           (unsigned)sizeof(data), (unsigned)(foldedNs / TEST_RANDOM_WRITES),
+           (unsigned)(unfoldedNs / TEST_RANDOM_WRITES));
+    CHECK(same);
+    CHECK(foldedNs < unfoldedNs);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests, returns non-zero if a check failed.
+*
+*******************************************************************************/
+int main(void)
+{
+    TestRegisters();
+    TestIds();
+    TestWriteEnable();
+    TestModes();
+    TestWrongSetup();
+    TestSpecialSector();
+    TestAddressWrap();
+    TestBusClocks();
+    TestLowPower();
+    TestFoldedWren();
+
+    printf("test_access: %s (%u failed)\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,343 @@
+/******************************************************************************
+* File Name: test_async.c
+*
+* Version: 1.0
+*
+* Description: Host tests of the asynchronous F-RAM access of CE222967
+*              on the CY15x104QSN model: DMA transfers of the SMIF data
+*              phases in SPI and QPI mode, the queue limits, commands
+*              without data, DMA errors and requests chained from the
+*              completion callback.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "FRAM_ASYNC.h"
+#include "cy15x104qsn_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Checks a condition and counts the failures */
+#define CHECK(cond)     Check((cond), #cond, __LINE__)
+
+#define TEST_MLC                (8u)
+#define TEST_SIZE               (1000u)     /* 3 DMA rows and a rest */
+
+static uint32_t failures = 0u;
+
+static cy_stc_smif_context_t smifContext;
+
+static uint32_t completed;
+static uint32_t failed;
+
+static uint8_t pattern[TEST_SIZE];
+static uint8_t data[FRAM_ASYNC_MAX_SIZE];
+
+/*******************************************************************************
+* Function Name: Check
+********************************************************************************
+*
+* Reports a failed check.
+*
+*******************************************************************************/
+static void Check(bool cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("test_async.c:%d: check failed: %s\n", line, text);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: Done
+********************************************************************************
+*
+* Counts the completed and failed requests.
+*
+*******************************************************************************/
+static void Done(uint8_t buffer[], uint32_t size, bool success, void *arg)
+{
+    if(success)
+    {
+        completed++;
+    }
+    else
+    {
+        failed++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: StartFram
+********************************************************************************
+*
+* Resets the model and starts the SMIF and the asynchronous access.
+*
+*******************************************************************************/
+static void StartFram(void)
+{
+    static const cy_stc_smif_config_t config = {CY_SMIF_NORMAL, 7u, 1u, CY_SMIF_WAIT_STATES};
+    uint32_t i;
+    
+    SimReset();
+    (void)Cy_SMIF_Init(SMIF0, &config, TIMEOUT_1_MS, &smifContext);
+    Cy_SMIF_Enable(SMIF0, &smifContext);
+    SimSetRegister(SIM_REG_CR1, (uint8_t)((TEST_MLC << SIM_CR1_MLC_POS) | SIM_CR1_QUAD));
+    FRAM_AsyncInit(SMIF0, &smifContext);
+    
+    for(i = 0u; i < TEST_SIZE; i++)
+    {
+        pattern[i] = (uint8_t)((i * 11u) + 3u);
+    }
+    completed = 0u;
+    failed = 0u;
+}
+
+/*******************************************************************************
+* Function Name: CheckClean
+********************************************************************************
+*
+* Checks no command was dropped or decoded wrong and no DMA failed.
+*
+*******************************************************************************/
+static void CheckClean(void)
+{
+    sim_stats_t stats;
+    
+    SimGetStats(&stats);
+    CHECK(stats.ignored == 0u);
+    CHECK(stats.wrongMode == 0u);
+    CHECK(stats.badCommands == 0u);
+    CHECK(stats.badReads == 0u);
+    CHECK(stats.driverErrors == 0u);
+    CHECK(stats.dmaErrors == 0u);
+}
+
+/*******************************************************************************
+* Function Name: CheckTransfer
+********************************************************************************
+*
+* Writes the pattern and reads it back with DMA in an access mode.
+*
+*******************************************************************************/
+static void CheckTransfer(uint8_t spimode, uint32_t address)
+{
+    sim_stats_t stats;
+    
+    SimClearStats();
+    CHECK(FRAM_AsyncWrite(spimode, address, pattern, TEST_SIZE, Done, NULL));
+    FRAM_AsyncWait();
+    CHECK(memcmp(&SimArray()[address], pattern, TEST_SIZE) == 0);
+    
+    (void)memset(data, 0, TEST_SIZE);
+    CHECK(FRAM_AsyncRead(spimode, address, data, TEST_SIZE, TEST_MLC, Done, NULL));
+    FRAM_AsyncWait();
+    CHECK(memcmp(data, pattern, TEST_SIZE) == 0);
+    CHECK(completed == 2u);
+    
+    SimGetStats(&stats);
+    CHECK(stats.dmaTransfers == 2u);
+    CHECK(stats.interrupts == 2u);
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestTransfers
+********************************************************************************
+*
+* QIOW and QIOR in SPI mode, WRITE and READ in QPI mode.
+*
+*******************************************************************************/
+static void TestTransfers(void)
+{
+    StartFram();
+    CheckTransfer(SPI_MODE, 0x10000u);
+    
+    completed = 0u;
+    SimSetRegister(SIM_REG_CR2, SIM_CR2_QPI);
+    CheckTransfer(QPI_MODE, 0x20010u);
+}
+
+/*******************************************************************************
+* Function Name: TestLimits
+********************************************************************************
+*
+* The queue takes FRAM_ASYNC_QUEUE_SIZE requests, one request moves up to 
+* FRAM_ASYNC_MAX_SIZE bytes and a data command needs data.
+*
+*******************************************************************************/
+static void TestLimits(void)
+{
+    uint32_t i;
+    
+    StartFram();
+    
+    SimHoldInterrupts(true);
+    for(i = 0u; i < FRAM_ASYNC_QUEUE_SIZE; i++)
+    {
+        CHECK(FRAM_AsyncRead(SPI_MODE, i * 0x100u, &data[i * 0x100u], 0x100u, TEST_MLC, Done, NULL));
+    }
+    CHECK(!FRAM_AsyncRead(SPI_MODE, 0u, data, 0x100u, TEST_MLC, Done, NULL));
+    CHECK(FRAM_AsyncPending() == FRAM_ASYNC_QUEUE_SIZE);
+    SimRunInterrupts();
+    SimHoldInterrupts(false);
+    CHECK(FRAM_AsyncPending() == 0u);
+    CHECK(completed == FRAM_ASYNC_QUEUE_SIZE);
+    
+    CHECK(!FRAM_AsyncRead(SPI_MODE, 0u, data, FRAM_ASYNC_MAX_SIZE + 1u, TEST_MLC, Done, NULL));
+    CHECK(!FRAM_AsyncRead(SPI_MODE, 0u, data, 0u, TEST_MLC, Done, NULL));
+    CHECK(!FRAM_AsyncRead(SPI_MODE, 0u, NULL, 16u, TEST_MLC, Done, NULL));
+    
+    SimArray()[0x3FFFFu] = 0x5Au;
+    SimArray()[0x30000u] = 0xA5u;
+    CHECK(FRAM_AsyncRead(SPI_MODE, 0x30000u, data, FRAM_ASYNC_MAX_SIZE, TEST_MLC, Done, NULL));
+    FRAM_AsyncWait();
+    CHECK(data[0u] == 0xA5u);
+    CHECK(data[FRAM_ASYNC_MAX_SIZE - 1u] == 0x5Au);
+    CHECK(completed == (FRAM_ASYNC_QUEUE_SIZE + 1u));
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestCommands
+********************************************************************************
+*
+* Commands without a data phase run at once, in the queue order.
+*
+*******************************************************************************/
+static void TestCommands(void)
+{
+    uint8_t sn[SN_BUF_SIZE] = {1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u};
+    
+    StartFram();
+    
+    CHECK(FRAM_AsyncSubmit(FRAM_CMD_WREN, SPI_MODE, 0u, NULL, 0u, 0u, Done, NULL));
+    CHECK((SimGetRegister(SIM_REG_SR1) & SIM_SR1_WEL) != 0u);
+    CHECK(FRAM_AsyncSubmit(FRAM_CMD_WRDI, SPI_MODE, 0u, NULL, 0u, 0u, Done, NULL));
+    CHECK((SimGetRegister(SIM_REG_SR1) & SIM_SR1_WEL) == 0u);
+    CHECK(FRAM_AsyncSubmit(FRAM_CMD_WRSN, SPI_MODE, 0u, sn, sizeof(sn), 0u, Done, NULL));
+    CHECK(memcmp(SimSerialNumber(), sn, sizeof(sn)) == 0);
+    CHECK(!FRAM_AsyncSubmit(FRAM_CMD_COUNT, SPI_MODE, 0u, NULL, 0u, 0u, Done, NULL));
+    CHECK(completed == 3u);
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestDmaError
+********************************************************************************
+*
+* A DMA error completes the request as failed without leaving the SMIF busy, 
+* the next request works.
+*
+*******************************************************************************/
+static void TestDmaError(void)
+{
+    sim_stats_t stats;
+    
+    StartFram();
+    
+    SimFailDma(1u);
+    CHECK(FRAM_AsyncRead(SPI_MODE, 0u, data, TEST_SIZE, TEST_MLC, Done, NULL));
+    FRAM_AsyncWait();
+    CHECK(failed == 1u);
+    CHECK(!Cy_SMIF_BusyCheck(SMIF0));
+    
+    SimFailDma(1u);
+    CHECK(FRAM_AsyncWrite(SPI_MODE, 0x1000u, pattern, TEST_SIZE, Done, NULL));
+    FRAM_AsyncWait();
+    CHECK(failed == 2u);
+    CHECK(SimArray()[0x1000u] == 0x00u);
+    
+    SimGetStats(&stats);
+    CHECK(stats.dmaErrors == 2u);
+    
+    SimClearStats();
+    CheckTransfer(SPI_MODE, 0x1000u);
+}
+
+/*******************************************************************************
+* Function Name: Chain
+********************************************************************************
+*
+* Completion callback which submits the read back of its write.
+*
+*******************************************************************************/
+static void Chain(uint8_t buffer[], uint32_t size, bool success, void *arg)
+{
+    CHECK(success);
+    CHECK(FRAM_AsyncRead(SPI_MODE, *(uint32_t *)arg, data, size, TEST_MLC, Done, NULL));
+}
+
+/*******************************************************************************
+* Function Name: TestChain
+********************************************************************************
+*
+* A request submitted from the completion callback runs after it.
+*
+*******************************************************************************/
+static void TestChain(void)
+{
+    static uint32_t address = 0x44000u;
+    
+    StartFram();
+    
+    (void)memset(data, 0, TEST_SIZE);
+    CHECK(FRAM_AsyncWrite(SPI_MODE, address, pattern, TEST_SIZE, Chain, &address));
+    FRAM_AsyncWait();
+    CHECK(completed == 1u);
+    CHECK(memcmp(data, pattern, TEST_SIZE) == 0);
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests, returns non-zero if a check failed.
+*
+*******************************************************************************/
+int main(void)
+{
+    TestTransfers();
+    TestLimits();
+    TestCommands();
+    TestDmaError();
+    TestChain();
+
+    printf("test_async: %s (%u failed)\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,300 @@
+/******************************************************************************
+* File Name: test_link.c
+*
+* Version: 1.0
+*
+* Description: Host tests of the access mode and latency negotiation of
+*              CE222967 on the CY15x104QSN model, at several SPI clocks,
+*              from any start mode and with an unknown part.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "FRAM_LINK.h"
+#include "cy15x104qsn_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Checks a condition and counts the failures */
+#define CHECK(cond)     Check((cond), #cond, __LINE__)
+
+static uint32_t failures = 0u;
+
+static cy_stc_smif_context_t smifContext;
+
+/*******************************************************************************
+* Function Name: Check
+********************************************************************************
+*
+* Reports a failed check.
+*
+*******************************************************************************/
+static void Check(bool cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("test_link.c:%d: check failed: %s\n", line, text);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: StartFram
+********************************************************************************
+*
+* Resets the model at an SCK, enables the SMIF and fills the test area of 
+* the negotiation with application data.
+*
+*******************************************************************************/
+static void StartFram(uint32_t sckHz)
+{
+    static const cy_stc_smif_config_t config = {CY_SMIF_NORMAL, 7u, 1u, CY_SMIF_WAIT_STATES};
+    uint32_t i;
+    
+    SimReset();
+    SimSetSpiClock(sckHz);
+    (void)Cy_SMIF_Init(SMIF0, &config, TIMEOUT_1_MS, &smifContext);
+    Cy_SMIF_Enable(SMIF0, &smifContext);
+    
+    for(i = 0u; i < FRAM_LINK_TEST_SIZE; i++)
+    {
+        SimArray()[FRAM_LINK_TEST_ADDR + i] = (uint8_t)((i * 13u) + 5u);
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestAreaKept
+********************************************************************************
+*
+* Returns true if the test area holds the data of StartFram().
+*
+*******************************************************************************/
+static bool TestAreaKept(void)
+{
+    uint32_t i;
+    
+    for(i = 0u; i < FRAM_LINK_TEST_SIZE; i++)
+    {
+        if(SimArray()[FRAM_LINK_TEST_ADDR + i] != (uint8_t)((i * 13u) + 5u))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: CheckLink
+********************************************************************************
+*
+* Checks the negotiated settings are in the F-RAM registers and a memory and 
+* a register read with them get the right data.
+*
+*******************************************************************************/
+static void CheckLink(const fram_link_t *link)
+{
+    uint8_t address[ADDRESS_SIZE] = {(uint8_t)(FRAM_LINK_TEST_ADDR >> 16u), (uint8_t)(FRAM_LINK_TEST_ADDR >> 8u), 0x00u};
+    uint8_t data[FRAM_LINK_TEST_SIZE];
+    uint8_t id[DID_REG_SIZE];
+    sim_stats_t stats;
+    
+    CHECK((SimGetRegister(SIM_REG_CR1) >> SIM_CR1_MLC_POS) == link->memLatency);
+    CHECK((SimGetRegister(SIM_REG_CR5) >> SIM_CR5_RLC_POS) == link->regLatency);
+    
+    SimClearStats();
+    WriteCmdSPIRead(SMIF0, &smifContext, data, sizeof(data), address, link->spimode, link->memLatency);
+    CHECK(memcmp(data, &SimArray()[FRAM_LINK_TEST_ADDR], sizeof(data)) == 0);
+    WriteCmdRDID(SMIF0, &smifContext, id, link->spimode, link->regLatency);
+    CHECK(id[0u] == 0x50u);
+    
+    SimGetStats(&stats);
+    CHECK(stats.badReads == 0u);
+    CHECK(stats.wrongMode == 0u);
+    CHECK(stats.badCommands == 0u);
+}
+
+/*******************************************************************************
+* Function Name: TestClocks
+********************************************************************************
+*
+* The CY15x104QSN gets QPI mode and the smallest latency codes of each SCK, 
+* the test area is restored.
+*
+*******************************************************************************/
+static void TestClocks(void)
+{
+    static const uint32_t clocks[] = {25000000u, 50000000u, 100000000u};
+    static const uint8_t mlc[] = {2u, 4u, 8u};
+    static const uint8_t rlc[] = {1u, 2u, 3u};
+    fram_link_t link;
+    uint32_t i;
+    
+    for(i = 0u; i < (sizeof(clocks) / sizeof(clocks[0])); i++)
+    {
+        StartFram(clocks[i]);
+        
+        CHECK(FRAM_Negotiate(SMIF0, &smifContext, clocks[i], &link));
+        CHECK(link.spimode == QPI_MODE);
+        CHECK(link.memLatency == mlc[i]);
+        CHECK(link.regLatency == rlc[i]);
+        CHECK(SimGetRegister(SIM_REG_CR2) == SIM_CR2_QPI);
+        CHECK(TestAreaKept());
+        CheckLink(&link);
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestSlowPart
+********************************************************************************
+*
+* A part with a longer access time than the datasheet value fails the 
+* verification at the computed MLC and gets the next one.
+*
+*******************************************************************************/
+static void TestSlowPart(void)
+{
+    fram_link_t link;
+    
+    StartFram(50000000u);
+    SimSetAccessTimes(100u, SIM_REG_ACCESS_NS);
+    
+    CHECK(FRAM_Negotiate(SMIF0, &smifContext, 50000000u, &link));
+    CHECK(link.spimode == QPI_MODE);
+    CHECK(link.memLatency == 5u);
+    CHECK(TestAreaKept());
+    CheckLink(&link);
+}
+
+/*******************************************************************************
+* Function Name: TestStartModes
+********************************************************************************
+*
+* The F-RAM left in QPI or DPI mode by a previous application is found.
+*
+*******************************************************************************/
+static void TestStartModes(void)
+{
+    static const uint8_t cr2[] = {SIM_CR2_QPI, SIM_CR2_DPI};
+    fram_link_t link;
+    uint32_t i;
+    
+    for(i = 0u; i < sizeof(cr2); i++)
+    {
+        StartFram(100000000u);
+        SimSetRegister(SIM_REG_CR2, cr2[i]);
+        
+        CHECK(FRAM_Negotiate(SMIF0, &smifContext, 100000000u, &link));
+        CHECK(link.spimode == QPI_MODE);
+        CHECK(link.memLatency == 8u);
+        CHECK(TestAreaKept());
+        CheckLink(&link);
+    }
+}
+
+/*******************************************************************************
+* Function Name: TestUnknownPart
+********************************************************************************
+*
+* An unknown device ID fails the negotiation and leaves SPI mode with the 
+* largest latency codes; the test area is not written.
+*
+*******************************************************************************/
+static void TestUnknownPart(void)
+{
+    static const uint8_t otherId[SIM_ID_SIZE] = {0x7Fu, 0x7Fu, 0xC2u, 0x20u, 0x00u, 0x00u, 0x00u, 0x00u};
+    fram_link_t link;
+    sim_stats_t stats;
+    
+    StartFram(50000000u);
+    SimSetDeviceId(otherId);
+    
+    CHECK(!FRAM_Negotiate(SMIF0, &smifContext, 50000000u, &link));
+    CHECK(link.spimode == SPI_MODE);
+    CHECK(link.memLatency == FRAM_MLC_MAX);
+    CHECK(link.regLatency == FRAM_RLC_MAX);
+    CHECK(SimGetRegister(SIM_REG_CR2) == 0x00u);
+    CHECK((SimGetRegister(SIM_REG_CR1) >> SIM_CR1_MLC_POS) == FRAM_MLC_MAX);
+    CHECK((SimGetRegister(SIM_REG_CR5) >> SIM_CR5_RLC_POS) == FRAM_RLC_MAX);
+    CHECK(TestAreaKept());
+    
+    SimGetStats(&stats);
+    CHECK(stats.writes == 0u);
+}
+
+/*******************************************************************************
+* Function Name: TestApply
+********************************************************************************
+*
+* FRAM_LinkApply() switches the F-RAM from the mode given to the negotiated 
+* settings, as at a boot which keeps them.
+*
+*******************************************************************************/
+static void TestApply(void)
+{
+    fram_link_t link = {QPI_MODE, 8u, 3u};
+    
+    StartFram(100000000u);
+    
+    FRAM_LinkApply(SMIF0, &smifContext, SPI_MODE, &link);
+    CHECK(SimGetRegister(SIM_REG_CR2) == SIM_CR2_QPI);
+    CHECK((SimGetRegister(SIM_REG_CR1) & SIM_CR1_QUAD) != 0u);
+    CheckLink(&link);
+    
+    link.spimode = DPI_MODE;
+    link.memLatency = 9u;
+    FRAM_LinkApply(SMIF0, &smifContext, QPI_MODE, &link);
+    CHECK(SimGetRegister(SIM_REG_CR2) == SIM_CR2_DPI);
+    CheckLink(&link);
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests, returns non-zero if a check failed.
+*
+*******************************************************************************/
+int main(void)
+{
+    TestClocks();
+    TestSlowPart();
+    TestStartModes();
+    TestUnknownPart();
+    TestApply();
+
+    printf("test_link: %s (%u failed)\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
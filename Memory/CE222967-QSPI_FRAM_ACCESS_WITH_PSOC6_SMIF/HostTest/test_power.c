@@ -0,0 +1,328 @@
+/******************************************************************************
+* File Name: test_power.c
+*
+* Version: 1.0
+*
+* Description: Host tests of the F-RAM power manager of CE222967 on the
+*              CY15x104QSN model, built with FRAM_POWER_MANAGER set: the
+*              idle entry, the wake-up on access, the refused wake-up in
+*              interrupts and critical sections and the idle threshold.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "FRAM_POWER.h"
+#include "FRAM_ASYNC.h"
+#include "cy15x104qsn_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <string.h>
+
+#if (FRAM_POWER_MANAGER == 0u)
+#error "Build with -DFRAM_POWER_MANAGER=1u"
+#endif /* (FRAM_POWER_MANAGER == 0u) */
+
+/* Checks a condition and counts the failures */
+#define CHECK(cond)     Check((cond), #cond, __LINE__)
+
+#define TEST_IDLE_US            (1000u)
+#define TEST_TARGET_US          (100u)
+#define TEST_MLC                (8u)
+#define TEST_RLC                (3u)
+
+static uint32_t failures = 0u;
+
+static cy_stc_smif_context_t smifContext;
+
+static uint32_t completed;
+
+/*******************************************************************************
+* Function Name: Check
+********************************************************************************
+*
+* Reports a failed check.
+*
+*******************************************************************************/
+static void Check(bool cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("test_power.c:%d: check failed: %s\n", line, text);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ReadDone
+********************************************************************************
+*
+* Counts the successful asynchronous reads.
+*
+*******************************************************************************/
+static void ReadDone(uint8_t buffer[], uint32_t size, bool success, void *arg)
+{
+    if(success)
+    {
+        completed++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: StartFram
+********************************************************************************
+*
+* Resets the model, starts the SMIF, the asynchronous access and the power 
+* manager with hibernate.
+*
+*******************************************************************************/
+static void StartFram(void)
+{
+    static const cy_stc_smif_config_t config = {CY_SMIF_NORMAL, 7u, 1u, CY_SMIF_WAIT_STATES};
+    
+    SimReset();
+    (void)Cy_SMIF_Init(SMIF0, &config, TIMEOUT_1_MS, &smifContext);
+    Cy_SMIF_Enable(SMIF0, &smifContext);
+    SimSetRegister(SIM_REG_CR1, (uint8_t)((TEST_MLC << SIM_CR1_MLC_POS) | SIM_CR1_QUAD));
+    
+    FRAM_AsyncInit(SMIF0, &smifContext);
+    FRAM_PowerInit(SMIF0, &smifContext, SPI_MODE, MEM_CMD_ENTHBN, TEST_IDLE_US, TEST_TARGET_US);
+    completed = 0u;
+}
+
+/*******************************************************************************
+* Function Name: Sleep
+********************************************************************************
+*
+* Lets the F-RAM get idle and polls the power manager.
+*
+*******************************************************************************/
+static void Sleep(void)
+{
+    SimAdvance((TEST_IDLE_US + 100u) * 1000uLL);
+    FRAM_PowerPoll();
+}
+
+/*******************************************************************************
+* Function Name: TestIdle
+********************************************************************************
+*
+* The F-RAM enters hibernate once idle for the threshold, not before.
+*
+*******************************************************************************/
+static void TestIdle(void)
+{
+    fram_power_stats_t stats;
+    
+    StartFram();
+    
+    FRAM_PowerPoll();
+    CHECK(!SimIsAsleep());
+    
+    Sleep();
+    CHECK(SimIsAsleep());
+    FRAM_PowerGetStats(&stats);
+    CHECK(stats.sleeps == 1u);
+    CHECK(stats.accesses == 0u);
+}
+
+/*******************************************************************************
+* Function Name: TestWakeOnAccess
+********************************************************************************
+*
+* A command in thread mode wakes the F-RAM and waits the exit time, so the 
+* part takes the command.
+*
+*******************************************************************************/
+static void TestWakeOnAccess(void)
+{
+    uint8_t address[ADDRESS_SIZE] = {0x00u, 0x01u, 0x00u};
+    uint8_t data[16u];
+    fram_power_stats_t power;
+    sim_stats_t stats;
+    
+    StartFram();
+    (void)memset(&SimArray()[0x100u], 0x3C, sizeof(data));
+    Sleep();
+    
+    SimClearStats();
+    CHECK(WriteCmdSPIRead(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE, TEST_MLC));
+    CHECK(data[0u] == 0x3Cu);
+    CHECK(data[15u] == 0x3Cu);
+    CHECK(!SimIsAsleep());
+    
+    SimGetStats(&stats);
+    CHECK(stats.wakeups == 1u);
+    CHECK(stats.ignored == 0u);
+    CHECK(stats.badReads == 0u);
+    
+    FRAM_PowerGetStats(&power);
+    CHECK(power.wakes == 1u);
+    CHECK(power.wakeUs >= FRAM_EXIT_HBN_US);
+    CHECK(power.accesses == 1u);
+}
+
+/*******************************************************************************
+* Function Name: TestNoBlocking
+********************************************************************************
+*
+* In an interrupt handler and in a critical section the wake-up is refused 
+* without waiting the exit time, FRAM_PowerPoll() does it later. Synchronous
+* commands to the sleeping F-RAM are refused and not sent.
+*
+*******************************************************************************/
+static void TestNoBlocking(void)
+{
+    uint8_t address[ADDRESS_SIZE] = {0x00u, 0x01u, 0x00u};
+    uint8_t data[16u];
+    uint32_t interruptState;
+    uint64_t start;
+    sim_stats_t stats;
+    
+    StartFram();
+    Sleep();
+    
+    SimSetIsrContext(true);
+    SimClearStats();
+    start = SimTimeNs();
+    CHECK(!FRAM_PowerWake());
+    CHECK(!FRAM_AsyncRead(SPI_MODE, 0x100u, data, sizeof(data), TEST_MLC, ReadDone, NULL));
+    CHECK(!WriteCmdSPIRead(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE, TEST_MLC));
+    CHECK(!WriteCmdSPIWrite(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE));
+    CHECK((SimTimeNs() - start) < (FRAM_EXIT_HBN_US * 1000uLL));
+    CHECK(FRAM_AsyncPending() == 0u);
+    SimSetIsrContext(false);
+    CHECK(SimIsAsleep());
+    SimGetStats(&stats);
+    CHECK(stats.commands == 0u);
+    CHECK(stats.ignored == 0u);
+    
+    FRAM_PowerPoll();
+    CHECK(!SimIsAsleep());
+    
+    Sleep();
+    CHECK(SimIsAsleep());
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    start = SimTimeNs();
+    CHECK(!FRAM_PowerWake());
+    CHECK(!WriteCmdSPIRead(SMIF0, &smifContext, data, sizeof(data), address, SPI_MODE, TEST_MLC));
+    CHECK((SimTimeNs() - start) < (FRAM_EXIT_HBN_US * 1000uLL));
+    Cy_SysLib_ExitCriticalSection(interruptState);
+    
+    FRAM_PowerPoll();
+    CHECK(!SimIsAsleep());
+    CHECK(FRAM_AsyncRead(SPI_MODE, 0x100u, data, sizeof(data), TEST_MLC, ReadDone, NULL));
+    FRAM_AsyncWait();
+    CHECK(completed == 1u);
+}
+
+/*******************************************************************************
+* Function Name: TestAsyncPending
+********************************************************************************
+*
+* The F-RAM is not put to sleep while an asynchronous request is queued.
+*
+*******************************************************************************/
+static void TestAsyncPending(void)
+{
+    uint8_t data[64u];
+    
+    StartFram();
+    
+    SimHoldInterrupts(true);
+    CHECK(FRAM_AsyncRead(SPI_MODE, 0x200u, data, sizeof(data), TEST_MLC, ReadDone, NULL));
+    CHECK(FRAM_AsyncPending() == 1u);
+    
+    Sleep();
+    CHECK(!SimIsAsleep());
+    
+    SimRunInterrupts();
+    SimHoldInterrupts(false);
+    CHECK(FRAM_AsyncPending() == 0u);
+    CHECK(completed == 1u);
+    
+    Sleep();
+    CHECK(SimIsAsleep());
+}
+
+/*******************************************************************************
+* Function Name: TestThreshold
+********************************************************************************
+*
+* When every access pays a wake-up above the target, the idle threshold is 
+* doubled after a window of accesses.
+*
+*******************************************************************************/
+static void TestThreshold(void)
+{
+    uint8_t id[DID_REG_SIZE];
+    fram_power_stats_t power;
+    uint32_t i;
+    
+    StartFram();
+    
+    for(i = 0u; i < FRAM_POWER_WINDOW; i++)
+    {
+        Sleep();
+        WriteCmdRDID(SMIF0, &smifContext, id, SPI_MODE, TEST_RLC);
+    }
+    CHECK(id[0u] == 0x50u);
+    
+    FRAM_PowerGetStats(&power);
+    CHECK(power.wakes == FRAM_POWER_WINDOW);
+    CHECK(power.idleUs == (2u * TEST_IDLE_US));
+    
+    /* Not idle for the new threshold */
+    Sleep();
+    CHECK(!SimIsAsleep());
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests, returns non-zero if a check failed.
+*
+*******************************************************************************/
+int main(void)
+{
+    TestIdle();
+    TestWakeOnAccess();
+    TestNoBlocking();
+    TestAsyncPending();
+    TestThreshold();
+
+    printf("test_power: %s (%u failed)\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
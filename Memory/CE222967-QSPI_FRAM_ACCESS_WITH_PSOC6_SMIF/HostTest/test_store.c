@@ -0,0 +1,297 @@
+/******************************************************************************
+* File Name: test_store.c
+*
+* Version: 1.0
+*
+* Description: Host tests of the F-RAM stores of CE222967 on the
+*              CY15x104QSN model: the metadata records in the special
+*              sector, the ring log and the block device.
+*
+* Hardware Dependency: None, built and run on the host
+*
+******************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+******************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*****************************************************************************/
+
+#include "FRAM_META.h"
+#include "FRAM_LOG.h"
+#include "FRAM_BLOCKDEV.h"
+#include "cy15x104qsn_sim.h"
+#include "project.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Checks a condition and counts the failures */
+#define CHECK(cond)     Check((cond), #cond, __LINE__)
+
+#define TEST_MLC                (8u)
+#define TEST_RLC                (3u)
+#define TEST_RECORDS            (20u)
+#define TEST_BD_ADDRESS         (0x10000u)
+#define TEST_BD_SIZE            (0x18000u)  /* More than one SMIF data phase */
+
+static uint32_t failures = 0u;
+
+static cy_stc_smif_context_t smifContext;
+
+static uint8_t pattern[TEST_BD_SIZE];
+static uint8_t data[TEST_BD_SIZE];
+
+/*******************************************************************************
+* Function Name: Check
+********************************************************************************
+*
+* Reports a failed check.
+*
+*******************************************************************************/
+static void Check(bool cond, const char *text, int line)
+{
+    if(!cond)
+    {
+        printf("test_store.c:%d: check failed: %s\n", line, text);
+        failures++;
+    }
+}
+
+/*******************************************************************************
+* Function Name: StartFram
+********************************************************************************
+*
+* Resets the model and enables the SMIF, the F-RAM is in SPI mode with the 
+* QUAD bit set.
+*
+*******************************************************************************/
+static void StartFram(void)
+{
+    static const cy_stc_smif_config_t config = {CY_SMIF_NORMAL, 7u, 1u, CY_SMIF_WAIT_STATES};
+    
+    SimReset();
+    (void)Cy_SMIF_Init(SMIF0, &config, TIMEOUT_1_MS, &smifContext);
+    Cy_SMIF_Enable(SMIF0, &smifContext);
+    SimSetRegister(SIM_REG_CR1, (uint8_t)((TEST_MLC << SIM_CR1_MLC_POS) | SIM_CR1_QUAD));
+}
+
+/*******************************************************************************
+* Function Name: CheckClean
+********************************************************************************
+*
+* Checks no command was dropped or decoded wrong.
+*
+*******************************************************************************/
+static void CheckClean(void)
+{
+    sim_stats_t stats;
+    
+    SimGetStats(&stats);
+    CHECK(stats.ignored == 0u);
+    CHECK(stats.wrongMode == 0u);
+    CHECK(stats.badCommands == 0u);
+    CHECK(stats.badReads == 0u);
+    CHECK(stats.driverErrors == 0u);
+}
+
+/*******************************************************************************
+* Function Name: TestMeta
+********************************************************************************
+*
+* A blank special sector has no record, a committed word survives a power 
+* cycle, and a corrupted newest copy falls back to the older one. The QPI 
+* mode reads the same records.
+*
+*******************************************************************************/
+static void TestMeta(void)
+{
+    fram_link_t link = {SPI_MODE, TEST_MLC, TEST_RLC};
+    
+    StartFram();
+    
+    CHECK(!FRAM_MetaInit(SMIF0, &smifContext, &link));
+    CHECK(FRAM_MetaGet(FRAM_META_BOOT_COUNT) == 0u);
+    
+    FRAM_MetaUpdate(FRAM_META_BOOT_COUNT, 5u);
+    SimPowerCycle();
+    Cy_SMIF_Enable(SMIF0, &smifContext);
+    CHECK(FRAM_MetaInit(SMIF0, &smifContext, &link));
+    CHECK(FRAM_MetaGet(FRAM_META_BOOT_COUNT) == 5u);
+    
+    FRAM_MetaUpdate(FRAM_META_BOOT_COUNT, 6u);
+    CHECK(FRAM_MetaInit(SMIF0, &smifContext, &link));
+    CHECK(FRAM_MetaGet(FRAM_META_BOOT_COUNT) == 6u);
+    
+    /* The second commit went to copy 1 */
+    SimSpecialSector()[FRAM_META_RECORD_SIZE + 8u] ^= 0x01u;
+    CHECK(FRAM_MetaInit(SMIF0, &smifContext, &link));
+    CHECK(FRAM_MetaGet(FRAM_META_BOOT_COUNT) == 5u);
+    
+    SimSetRegister(SIM_REG_CR2, SIM_CR2_QPI);
+    link.spimode = QPI_MODE;
+    SimClearStats();
+    CHECK(FRAM_MetaInit(SMIF0, &smifContext, &link));
+    CHECK(FRAM_MetaGet(FRAM_META_BOOT_COUNT) == 5u);
+    FRAM_MetaUpdate(FRAM_META_LAST_GOOD, 0x1234u);
+    CHECK(FRAM_MetaInit(SMIF0, &smifContext, &link));
+    CHECK(FRAM_MetaGet(FRAM_META_LAST_GOOD) == 0x1234u);
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: TestLog
+********************************************************************************
+*
+* Records are written in batches with the quad commands of the SPI mode, 
+* read back in order and found again after a power cycle.
+*
+*******************************************************************************/
+static void TestLog(void)
+{
+    uint8_t record[FRAM_LOG_RECORD_SIZE];
+    uint8_t records[TEST_RECORDS * FRAM_LOG_RECORD_SIZE];
+    uint32_t i;
+    
+    StartFram();
+    
+    CHECK(!FRAM_LogInit(SMIF0, &smifContext, TEST_MLC));
+    CHECK(FRAM_LogCount() == 0u);
+    
+    for(i = 0u; i < TEST_RECORDS; i++)
+    {
+        (void)memset(record, (int)i, sizeof(record));
+        FRAM_LogAppend(record);
+    }
+    CHECK(FRAM_LogCount() == ((TEST_RECORDS / FRAM_LOG_BATCH_RECORDS) * FRAM_LOG_BATCH_RECORDS));
+    FRAM_LogFlush();
+    CHECK(FRAM_LogCount() == TEST_RECORDS);
+    
+    CHECK(FRAM_LogRead(0u, records, TEST_RECORDS) == TEST_RECORDS);
+    for(i = 0u; i < TEST_RECORDS; i++)
+    {
+        CHECK(records[i * FRAM_LOG_RECORD_SIZE] == (uint8_t)i);
+        CHECK(records[((i + 1u) * FRAM_LOG_RECORD_SIZE) - 1u] == (uint8_t)i);
+    }
+    
+    SimPowerCycle();
+    Cy_SMIF_Enable(SMIF0, &smifContext);
+    CHECK(FRAM_LogInit(SMIF0, &smifContext, TEST_MLC));
+    CHECK(FRAM_LogCount() == TEST_RECORDS);
+    CHECK(FRAM_LogReadLatest(records, 5u) == 5u);
+    CHECK(records[0u] == (uint8_t)(TEST_RECORDS - 5u));
+    CHECK(records[4u * FRAM_LOG_RECORD_SIZE] == (uint8_t)(TEST_RECORDS - 1u));
+    
+    FRAM_LogClear();
+    CHECK(FRAM_LogCount() == 0u);
+    CHECK(FRAM_LogInit(SMIF0, &smifContext, TEST_MLC));
+    CHECK(FRAM_LogCount() == 0u);
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: CheckBlockDev
+********************************************************************************
+*
+* Programs and reads more than one data phase, erases a range to 0xFF and 
+* rejects an access past the end.
+*
+*******************************************************************************/
+static void CheckBlockDev(const blockdev_t *bd)
+{
+    uint32_t i;
+    
+    CHECK(bd != NULL);
+    if(bd == NULL)
+    {
+        return;
+    }
+    CHECK(bd->caps.size == SIM_MEM_SIZE);
+    
+    for(i = 0u; i < TEST_BD_SIZE; i++)
+    {
+        pattern[i] = (uint8_t)((i >> 8u) ^ (i * 3u));
+    }
+    
+    CHECK(bd->program(TEST_BD_ADDRESS, pattern, TEST_BD_SIZE) == BLOCKDEV_SUCCESS);
+    CHECK(memcmp(&SimArray()[TEST_BD_ADDRESS], pattern, TEST_BD_SIZE) == 0);
+    (void)memset(data, 0, TEST_BD_SIZE);
+    CHECK(bd->read(TEST_BD_ADDRESS, data, TEST_BD_SIZE) == BLOCKDEV_SUCCESS);
+    CHECK(memcmp(data, pattern, TEST_BD_SIZE) == 0);
+    
+    CHECK(bd->erase(TEST_BD_ADDRESS + 0x10u, 0x300u) == BLOCKDEV_SUCCESS);
+    CHECK(bd->read(TEST_BD_ADDRESS, data, 0x320u) == BLOCKDEV_SUCCESS);
+    CHECK(memcmp(data, pattern, 0x10u) == 0);
+    for(i = 0x10u; i < 0x310u; i++)
+    {
+        CHECK(data[i] == 0xFFu);
+    }
+    CHECK(memcmp(&data[0x310u], &pattern[0x310u], 0x10u) == 0);
+    
+    CHECK(bd->program(SIM_MEM_SIZE - 1u, pattern, 2u) == BLOCKDEV_BAD_PARAM);
+    CHECK(bd->read(SIM_MEM_SIZE, data, 1u) == BLOCKDEV_BAD_PARAM);
+    CHECK(SimArray()[0u] == 0x00u);
+}
+
+/*******************************************************************************
+* Function Name: TestBlockDev
+********************************************************************************
+*
+* The block device with the quad commands of the SPI mode and in QPI mode; 
+* DPI mode is not supported.
+*
+*******************************************************************************/
+static void TestBlockDev(void)
+{
+    StartFram();
+    
+    CHECK(FRAM_BlockDevInit(SMIF0, &smifContext, DPI_MODE, TEST_MLC) == NULL);
+    CheckBlockDev(FRAM_BlockDevInit(SMIF0, &smifContext, SPI_MODE, TEST_MLC));
+    CheckClean();
+    
+    StartFram();
+    SimSetRegister(SIM_REG_CR2, SIM_CR2_QPI);
+    CheckBlockDev(FRAM_BlockDevInit(SMIF0, &smifContext, QPI_MODE, TEST_MLC));
+    CheckClean();
+}
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Runs the tests, returns non-zero if a check failed.
+*
+*******************************************************************************/
+int main(void)
+{
+    TestMeta();
+    TestLog();
+    TestBlockDev();
+
+    printf("test_store: %s (%u failed)\n", (failures == 0u) ? "PASS" : "FAIL", (unsigned)failures);
+    return (failures == 0u) ? 0 : 1;
+}
+
+/* [] END OF FILE */
@@ -43,18 +43,118 @@
 *******************************************************************************/
 
 #include "FRAM_ACCESS.h"
+#include "FRAM_POWER.h"
 #include "stdio.h"
 #include "project.h"
 
 cy_smif_event_cb_t RxCmpltCallback;
 cy_en_smif_slave_select_t ONBOARD_MEM_SSFRAM = CY_SMIF_SLAVE_SELECT_2;
 
+/* SMIF width for each access mode (SPI_MODE, DPI_MODE, QPI_MODE) */
+static const cy_en_smif_txfr_width_t framModeWidth[] =
+{
+    CY_SMIF_WIDTH_SINGLE,
+    CY_SMIF_WIDTH_DUAL,
+    CY_SMIF_WIDTH_QUAD
+};
+
+/* 
+* F-RAM command descriptors, indexed by fram_cmd_id_t. The address and data 
+* widths are the minimal widths used in SPI mode; in DPI and QPI modes every 
+* phase is transferred on the access mode width.
+*/
+static const fram_cmd_t framCmdTable[FRAM_CMD_COUNT] =
+{
+    /* opcode            addrSize      modeByte  addrWidth             dataWidth             dataPhase        latency         flags */
+    {MEM_CMD_WREN,       0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_NONE,  FRAM_LAT_NONE,  0u},
+    {MEM_CMD_WRDI,       0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_NONE,  FRAM_LAT_NONE,  0u},
+    {MEM_CMD_WRSR,       0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_PARAM, FRAM_LAT_NONE,  FRAM_FLAG_WREN},
+    {MEM_CMD_RDSR1,      0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_REG,   0u},
+    {MEM_CMD_RDSR2,      0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_REG,   0u},
+    {MEM_CMD_RDCR1,      0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_REG,   0u},
+    {MEM_CMD_RDCR2,      0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_REG,   0u},
+    {MEM_CMD_RDCR4,      0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_REG,   0u},
+    {MEM_CMD_RDCR5,      0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_REG,   0u},
+    {MEM_CMD_WRAR,       ADDRESS_SIZE, 0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_TX,    FRAM_LAT_NONE,  FRAM_FLAG_WREN},
+    {MEM_CMD_RDAR,       ADDRESS_SIZE, 0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_REG,   0u},
+    {MEM_CMD_WRITE,      ADDRESS_SIZE, 0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_TX,    FRAM_LAT_NONE,  FRAM_FLAG_WREN},
+    {MEM_CMD_READ,       ADDRESS_SIZE, 0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_MEM,   0u},
+    {MEM_CMD_FASTWRITE,  ADDRESS_SIZE, 1u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_TX,    FRAM_LAT_NONE,  FRAM_FLAG_WREN},
+    {MEM_CMD_FAST_READ,  ADDRESS_SIZE, 1u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_MEM,   0u},
+    {MEM_CMD_SSWR,       ADDRESS_SIZE, 0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_TX,    FRAM_LAT_NONE,  FRAM_FLAG_WREN},
+    {MEM_CMD_SSRD,       ADDRESS_SIZE, 0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_MEM,   0u},
+    {MEM_CMD_WRSN,       0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_PARAM, FRAM_LAT_NONE,  FRAM_FLAG_WREN},
+    {MEM_CMD_RDSN,       0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_REG,   0u},
+    {MEM_CMD_RDID,       0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_REG,   0u},
+    {MEM_CMD_RUID,       0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_RX,    FRAM_LAT_REG,   0u},
+    {MEM_CMD_DIOW,       ADDRESS_SIZE, 1u,       CY_SMIF_WIDTH_DUAL,   CY_SMIF_WIDTH_DUAL,   FRAM_DATA_TX,    FRAM_LAT_NONE,  FRAM_FLAG_WREN},
+    {MEM_CMD_QIOW,       ADDRESS_SIZE, 1u,       CY_SMIF_WIDTH_QUAD,   CY_SMIF_WIDTH_QUAD,   FRAM_DATA_TX,    FRAM_LAT_NONE,  FRAM_FLAG_WREN},
+    {MEM_CMD_DIW,        ADDRESS_SIZE, 1u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_DUAL,   FRAM_DATA_TX,    FRAM_LAT_NONE,  FRAM_FLAG_WREN},
+    {MEM_CMD_QIW,        ADDRESS_SIZE, 1u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_QUAD,   FRAM_DATA_TX,    FRAM_LAT_NONE,  FRAM_FLAG_WREN},
+    {MEM_CMD_DIOR,       ADDRESS_SIZE, 1u,       CY_SMIF_WIDTH_DUAL,   CY_SMIF_WIDTH_DUAL,   FRAM_DATA_RX,    FRAM_LAT_MEM,   0u},
+    {MEM_CMD_QIOR,       ADDRESS_SIZE, 1u,       CY_SMIF_WIDTH_QUAD,   CY_SMIF_WIDTH_QUAD,   FRAM_DATA_RX,    FRAM_LAT_MEM,   0u},
+    {MEM_CMD_DOR,        ADDRESS_SIZE, 1u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_DUAL,   FRAM_DATA_RX,    FRAM_LAT_MEM,   0u},
+    {MEM_CMD_QOR,        ADDRESS_SIZE, 1u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_QUAD,   FRAM_DATA_RX,    FRAM_LAT_MEM,   0u},
+    {MEM_CMD_ENTDPD,     0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_NONE,  FRAM_LAT_NONE,  0u},
+    {MEM_CMD_ENTHBN,     0u,           0u,       CY_SMIF_WIDTH_SINGLE, CY_SMIF_WIDTH_SINGLE, FRAM_DATA_NONE,  FRAM_LAT_NONE,  0u}
+};
+
 /*******************************************************************************
-* Function Name: WriteCmdWREN
+* Function Name: FRAM_GetCommand
 ****************************************************************************//**
 *
-* This function enables the Write bit in the status register. 
-* The function sends the WREN 0x06 command to the external memory.
+* This function returns the descriptor of an F-RAM command.
+*
+* \param cmdId
+* The command to look up.
+*
+* \return
+* The command descriptor.
+*
+*******************************************************************************/
+const fram_cmd_t *FRAM_GetCommand(fram_cmd_id_t cmdId)
+{
+    return (&framCmdTable[cmdId]);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_FindCommand
+****************************************************************************//**
+*
+* This function finds the command descriptor for an opcode.
+*
+* \param opcode
+* The command opcode (MEM_CMD_xxx).
+*
+* \return
+* The command index or FRAM_CMD_COUNT if the opcode is not in the table.
+*
+*******************************************************************************/
+fram_cmd_id_t FRAM_FindCommand(uint8_t opcode)
+{
+    uint32_t idx;
+    
+    for (idx = 0u; idx < (uint32_t)FRAM_CMD_COUNT; idx++)
+    {
+        if (framCmdTable[idx].opcode == opcode)
+        {
+            break;
+        }
+    }
+    
+    return ((fram_cmd_id_t)idx);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_StartCommand
+****************************************************************************//**
+*
+* This function starts any F-RAM command described in the command table and 
+* returns once the command, address and latency cycles are queued. The data 
+* phase completes in the SMIF interrupt, which calls the callback. For the 
+* commands which need it, the WREN command is queued in the same command FIFO 
+* right before the command. WREN ends with the slave deselect, which latches 
+* WEL, so the CPU does not wait for it.
 *
 * \param baseaddr
 * Holds the base address of the SMIF block registers.
@@ -62,43 +162,209 @@ cy_en_smif_slave_select_t ONBOARD_MEM_SSFRAM = CY_SMIF_SLAVE_SELECT_2;
 * \param smifContext
 * The internal SMIF context data.
 *
+* \param cmdId
+* The command to send.
+*
 * \param spimode
 * Determines SMIF width single,dual,or quad.
 *
+* \param address 
+* The address bytes (with the mode byte if used). NULL for commands without 
+* an address.
+*
+* \param buffer
+* The data to write or the buffer for the read data.
+*
+* \param size
+* The size of data.
+*
+* \param latency
+* Memory or register latency cycles for the read commands.
+*
+* \param callback
+* Called by the SMIF interrupt when the data phase is completed. Can be NULL.
+*
+* \return
+* true if the command was started. false if the F-RAM is in the low power mode
+* and can not be woken up here (interrupt or critical section): nothing is sent
+* and the callback is not called.
+*
 *******************************************************************************/
-void WriteCmdWREN(SMIF_Type *baseaddr,
-                            cy_stc_smif_context_t *smifContext,
-                            uint8_t spimode)
-{    
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
+bool FRAM_StartCommand(SMIF_Type *baseaddr,
+                       cy_stc_smif_context_t *smifContext,
+                       fram_cmd_id_t cmdId,
+                       uint8_t spimode,
+                       uint8_t *address,
+                       uint8_t buffer[],
+                       uint32_t size,
+                       uint8_t latency,
+                       cy_smif_event_cb_t callback)
+{
+    const fram_cmd_t *cmd = &framCmdTable[cmdId];
+    cy_en_smif_txfr_width_t width = CY_SMIF_WIDTH_SINGLE;
+    cy_en_smif_txfr_width_t addrWidth;
+    cy_en_smif_txfr_width_t dataWidth;
+    uint8_t *param = address;
+    uint32_t paramSize = (uint32_t)cmd->addrSize + cmd->modeByte;
+    uint32_t lastByte = TX_NOT_LAST_BYTE;
+    
+    if (spimode <= QPI_MODE)
+    {
+        width = framModeWidth[spimode];
+    }
+    addrWidth = (cmd->addrWidth > width) ? cmd->addrWidth : width;
+    dataWidth = (cmd->dataWidth > width) ? cmd->dataWidth : width;
     
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;     
+#if (FRAM_POWER_MANAGER != 0u)
+    /* Wake the F-RAM from the low power mode, a sleeping F-RAM ignores commands */
+    if (!FRAM_PowerAccess())
+    {
+        return false;
+    }
+#endif /* (FRAM_POWER_MANAGER != 0u) */
     
-    /* Transmit command */
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_WREN,				  
-                            CY_SMIF_WIDTH,
-                            CMD_WITHOUT_PARAM, 
-                            CMD_WITHOUT_PARAM, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_LAST_BYTE, 
-                            smifContext);     
+    /* Set the write enable (WEL) bit in SR1, back-to-back with the command */
+    if ((cmd->flags & FRAM_FLAG_WREN) != 0u)
+    {
+        Cy_SMIF_TransmitCommand(baseaddr,
+                                MEM_CMD_WREN,
+                                width,
+                                NULL,
+                                0u,
+                                width,
+                                ONBOARD_MEM_SSFRAM,
+                                TX_LAST_BYTE,
+                                smifContext);
+    }
+    
+    /* Register data is sent as the command parameters */
+    if (cmd->dataPhase == FRAM_DATA_PARAM)
+    {
+        param = buffer;
+        paramSize = size;
+    }
+    if ((cmd->dataPhase == FRAM_DATA_NONE) || (cmd->dataPhase == FRAM_DATA_PARAM))
+    {
+        lastByte = TX_LAST_BYTE;
+    }
+    
+    /* Transmit command and address */
+    Cy_SMIF_TransmitCommand(baseaddr,
+                            cmd->opcode,
+                            width,
+                            param,
+                            paramSize,
+                            addrWidth,
+                            ONBOARD_MEM_SSFRAM,
+                            lastByte,
+                            smifContext);
+    
+    if (cmd->dataPhase == FRAM_DATA_RX)
+    {
+        /* Sends extra dummy clocks to add clock cycle latency */
+        if (cmd->latency != FRAM_LAT_NONE)
+        {
+            Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
+        }
         
+        Cy_SMIF_ReceiveData(baseaddr, buffer, size, dataWidth, callback, smifContext);
+    }
+    else if (cmd->dataPhase == FRAM_DATA_TX)
+    {
+        Cy_SMIF_TransmitData(baseaddr, buffer, size, dataWidth, callback, smifContext);
+    }
+    else
+    {
+        /* No data phase */
+    }
+    
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_Command
+****************************************************************************//**
+*
+* This function sends any F-RAM command described in the command table and 
+* waits until it is completed.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param cmdId
+* The command to send.
+*
+* \param spimode
+* Determines SMIF width single,dual,or quad.
+*
+* \param address 
+* The address bytes (with the mode byte if used). NULL for commands without 
+* an address.
+*
+* \param buffer
+* The data to write or the buffer for the read data.
+*
+* \param size
+* The size of data.
+*
+* \param latency
+* Memory or register latency cycles for the read commands.
+*
+* \return
+* true if the command was sent, false if it was refused, see FRAM_StartCommand().
+*
+*******************************************************************************/
+bool FRAM_Command(SMIF_Type *baseaddr,
+                  cy_stc_smif_context_t *smifContext,
+                  fram_cmd_id_t cmdId,
+                  uint8_t spimode,
+                  uint8_t *address,
+                  uint8_t buffer[],
+                  uint32_t size,
+                  uint8_t latency)
+{
+    if (!FRAM_StartCommand(baseaddr, smifContext, cmdId, spimode, address, buffer, size, latency, RxCmpltCallback))
+    {
+        return false;
+    }
+    
     /* Check if the SMIF IP is busy */
     while(Cy_SMIF_BusyCheck(baseaddr))
     {
         /* Wait until the SMIF IP operation is completed. */
     }
+    
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: WriteCmdWREN
+****************************************************************************//**
+*
+* This function enables the Write bit in the status register. 
+* The function sends the WREN 0x06 command to the external memory.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param spimode
+* Determines SMIF width single,dual,or quad.
+*
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
+*******************************************************************************/
+bool WriteCmdWREN(SMIF_Type *baseaddr,
+                            cy_stc_smif_context_t *smifContext,
+                            uint8_t spimode)
+{
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_WREN, spimode, NULL, NULL, 0u, 0u);
 }
 
 /*******************************************************************************
@@ -117,40 +383,15 @@ void WriteCmdWREN(SMIF_Type *baseaddr,
 * \param spimode
 * Determines SMIF width single,dual,or quad.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdWRDI(SMIF_Type *baseaddr,
+bool WriteCmdWRDI(SMIF_Type *baseaddr,
                             cy_stc_smif_context_t *smifContext,
                             uint8_t spimode)
-{    
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE; 
-    
-     /* Transmit command */
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_WRDI,				  
-                            CY_SMIF_WIDTH,
-                            CMD_WITHOUT_PARAM, 
-                            CMD_WITHOUT_PARAM, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_LAST_BYTE, 
-                            smifContext); 
-    
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed. */
-    }
+{
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_WRDI, spimode, NULL, NULL, 0u, 0u);
 }
 /*******************************************************************************
 * Function Name: WriteCmdWRSR
@@ -174,46 +415,17 @@ void WriteCmdWRDI(SMIF_Type *baseaddr,
 * \param spimode
 * Determines SMIF width single,dual,or quads
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdWRSR(  SMIF_Type *baseaddr,
+bool WriteCmdWRSR(  SMIF_Type *baseaddr,
                     cy_stc_smif_context_t *smifContext, 
                     uint8_t cmdParam[], 
                     uint32_t cmdSize,
                     uint8_t spimode)
 {
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-    else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;   
-    
-    /* Write Enable */
-    WriteCmdWREN(baseaddr, smifContext,spimode);
-    
-     /* Transmit command and data byte(s) */
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_WRSR,				  
-                            CY_SMIF_WIDTH,
-                            cmdParam, 
-                            cmdSize, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_LAST_BYTE, 
-                            smifContext);
-    
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed. */
-    }
-    
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_WRSR, spimode, NULL, cmdParam, cmdSize, 0u);
 }
 
 /*******************************************************************************
@@ -242,8 +454,11 @@ void WriteCmdWRSR(  SMIF_Type *baseaddr,
 * \param latency
 * Memory latency cycle during read.
 * 
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdReadSRx(SMIF_Type *baseaddr,
+bool WriteCmdReadSRx(SMIF_Type *baseaddr,
                     cy_stc_smif_context_t *smifContext,
                     uint8_t tst_rxBuffer[], 
                     uint32_t rxSize,
@@ -251,53 +466,9 @@ void WriteCmdReadSRx(SMIF_Type *baseaddr,
                     uint8_t cmdtype,
                     uint8_t latency)
 {
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    uint8_t CMD_TYPE =0x00;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;  
-    
-    if (cmdtype==MEM_CMD_RDSR1)
-    CMD_TYPE = MEM_CMD_RDSR1;
-   
-    else if (cmdtype==MEM_CMD_RDSR2)
-    CMD_TYPE = MEM_CMD_RDSR2;
-    
-     /* Transmit command */
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            CMD_TYPE,				
-                            CY_SMIF_WIDTH,
-                            CMD_WITHOUT_PARAM, 
-                            CMD_WITHOUT_PARAM, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
+    fram_cmd_id_t cmdId = (cmdtype == MEM_CMD_RDSR2) ? FRAM_CMD_RDSR2 : FRAM_CMD_RDSR1;
     
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
-      
-    /* Receive data */
-    Cy_SMIF_ReceiveData( baseaddr,
-                        tst_rxBuffer, 					
-                        rxSize, 
-                        CY_SMIF_WIDTH, 
-                        RxCmpltCallback,
-                        smifContext);
-    
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed */
-    }
+    return FRAM_Command(baseaddr, smifContext, cmdId, spimode, NULL, tst_rxBuffer, rxSize, latency);
 }
 
 /*******************************************************************************
@@ -325,54 +496,19 @@ void WriteCmdReadSRx(SMIF_Type *baseaddr,
 * \param spimode
 * Determines SMIF width single,dual,or quad.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSPIWriteAnyReg(SMIF_Type *baseaddr, 
+bool WriteCmdSPIWriteAnyReg(SMIF_Type *baseaddr, 
                     cy_stc_smif_context_t *smifContext, 
                     uint8_t tst_txBuffer[], 
                     uint32_t txSize, 
                     uint8_t *address,
                     uint8_t spimode)
 
-{         
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-      (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;  
-    else
-     CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    /* Set the write enable (WEL) bit in SR1 */
-    WriteCmdWREN(baseaddr, smifContext, spimode);
-    
-    /* Transmit command */
-	Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_WRAR,		
-                            CY_SMIF_WIDTH,
-                            address, 
-                            ADDRESS_SIZE, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    /* Transmit data */
-    Cy_SMIF_TransmitData(baseaddr, 
-                            tst_txBuffer,
-                            txSize, 
-                            CY_SMIF_WIDTH, 
-                            RxCmpltCallback, 
-                            smifContext);
-    
-    /* Check if the SMIF IP is busy */
-   while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed */
-    }
+{
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_WRAR, spimode, address, tst_txBuffer, txSize, 0u);
 }
 
 /*******************************************************************************
@@ -403,55 +539,19 @@ void WriteCmdSPIWriteAnyReg(SMIF_Type *baseaddr,
 * \param latency
 * Register latency cycle during read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSPIReadAnyReg(SMIF_Type *baseaddr,
+bool WriteCmdSPIReadAnyReg(SMIF_Type *baseaddr,
                         cy_stc_smif_context_t *smifContext, 
                         uint8_t tst_rxBuffer[], 
                         uint32_t rxSize, 
                         uint8_t *address,
                         uint8_t spimode,
                         uint8_t latency)
-{   
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;    
-    
-    /* Transmit command */
-	Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_RDAR,				
-                            CY_SMIF_WIDTH,
-                            address, 
-                            ADDRESS_SIZE, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
-    
-    /* Receive command */
-    Cy_SMIF_ReceiveData(  baseaddr,
-                            tst_rxBuffer, 
-                            rxSize, 
-                            CY_SMIF_WIDTH, 
-                            RxCmpltCallback,
-                            smifContext);
-    
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed. */
-    }
+{
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_RDAR, spimode, address, tst_rxBuffer, rxSize, latency);
 }
 
 /*******************************************************************************
@@ -482,8 +582,11 @@ void WriteCmdSPIReadAnyReg(SMIF_Type *baseaddr,
 * \param latency
 * Memory latency cycle during read.
 * 
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdReadCRx(SMIF_Type *baseaddr,
+bool WriteCmdReadCRx(SMIF_Type *baseaddr,
                     cy_stc_smif_context_t *smifContext,
                     uint8_t tst_rxBuffer[], 
                     uint32_t rxSize,
@@ -491,62 +594,14 @@ void WriteCmdReadCRx(SMIF_Type *baseaddr,
                     uint8_t crtype,
                     uint8_t latency)
 {
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    uint8_t CMD_TYPE = 1U;
+    fram_cmd_id_t cmdId = FRAM_FindCommand(crtype);
     
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;  
-    
-    if (crtype==MEM_CMD_RDCR1)
-        CMD_TYPE = MEM_CMD_RDCR1;
-   
-     else if (crtype==MEM_CMD_RDCR2)
-              CMD_TYPE = MEM_CMD_RDCR2;
-  
-     else if (crtype==MEM_CMD_RDCR4)
-              CMD_TYPE = MEM_CMD_RDCR4;
-  
-    else if (crtype==MEM_CMD_RDCR5)
-             CMD_TYPE = MEM_CMD_RDCR5;
-
-   else
-    CMD_TYPE = MEM_CMD_RDCR1; 
-    
-    /* Transmit command */
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            CMD_TYPE,				
-                            CY_SMIF_WIDTH,
-                            CMD_WITHOUT_PARAM, 
-                            CMD_WITHOUT_PARAM, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
-    
-    /* Receive data */
-    Cy_SMIF_ReceiveData( baseaddr,
-                        tst_rxBuffer, 					
-                        rxSize, 
-                        CY_SMIF_WIDTH, 
-                        RxCmpltCallback,
-                        smifContext);
-    
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
+    if ((cmdId < FRAM_CMD_RDCR1) || (cmdId > FRAM_CMD_RDCR5))
     {
-        /* Wait until the SMIF IP operation is completed */
-    }   
+        cmdId = FRAM_CMD_RDCR1;
+    }
+    
+    return FRAM_Command(baseaddr, smifContext, cmdId, spimode, NULL, tst_rxBuffer, rxSize, latency);
 }
 
 /*******************************************************************************
@@ -574,54 +629,18 @@ void WriteCmdReadCRx(SMIF_Type *baseaddr,
 * \param spimode
 * Determines SMIF width single,dual,or quad.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSPIWrite(SMIF_Type *baseaddr, 
+bool WriteCmdSPIWrite(SMIF_Type *baseaddr, 
                     cy_stc_smif_context_t *smifContext, 
                     uint8_t tst_txBuffer[], 
                     uint32_t txSize, 
                     uint8_t *address,
                     uint8_t spimode)
-{       
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-      (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;  
-    else
-     CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    /* Set the write enable (WEL) bit in SR1 */
-    WriteCmdWREN(baseaddr, smifContext, spimode);
-	
-    /* Transmit command and address */
-	Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_WRITE,		
-                            CY_SMIF_WIDTH,
-                            address, 
-                            ADDRESS_SIZE, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    
-     /* Transmit data */
-    Cy_SMIF_TransmitData(baseaddr, 
-                            tst_txBuffer,
-                            txSize, 
-                            CY_SMIF_WIDTH, 
-                            RxCmpltCallback, 
-                            smifContext);
-    
-    /* Check if the SMIF IP is busy */
-   while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed */
-    }
+{
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_WRITE, spimode, address, tst_txBuffer, txSize, 0u);
 }
 
 /*******************************************************************************
@@ -652,55 +671,19 @@ void WriteCmdSPIWrite(SMIF_Type *baseaddr,
 * \param latency
 * Memory latency cycle during read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSPIRead(SMIF_Type *baseaddr,
+bool WriteCmdSPIRead(SMIF_Type *baseaddr,
                         cy_stc_smif_context_t *smifContext, 
                         uint8_t tst_rxBuffer[], 
                         uint32_t rxSize, 
                         uint8_t *address,
                         uint8_t spimode,
                         uint8_t latency)
-{   
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;    
-    
-    /* Transmit command and address */
-	Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_READ,				
-                            CY_SMIF_WIDTH,
-                            address, 
-                            ADDRESS_SIZE, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext); 
-    
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
-    
-    /* Receive data */
-    Cy_SMIF_ReceiveData(  baseaddr,
-                            tst_rxBuffer, 
-                            rxSize, 
-                            CY_SMIF_WIDTH, 
-                            RxCmpltCallback,
-                            smifContext);
-
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed. */
-    }
+{
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_READ, spimode, address, tst_rxBuffer, rxSize, latency);
 }
 
 /*******************************************************************************
@@ -728,53 +711,18 @@ void WriteCmdSPIRead(SMIF_Type *baseaddr,
 * \param spimode
 * Determines SMIF width single,dual,or quad.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSPIFastWrite(SMIF_Type *baseaddr, 
+bool WriteCmdSPIFastWrite(SMIF_Type *baseaddr, 
                     cy_stc_smif_context_t *smifContext, 
                     uint8_t tst_txBuffer[], 
                     uint32_t txSize, 
                     uint8_t *address,
                     uint8_t spimode)
-{       
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-      (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;  
-    else
-     CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    /* Set the write enable (WEL) bit in SR1 */
-    WriteCmdWREN(baseaddr, smifContext, spimode);	
-    
-    /* Transmit command and address */
-	Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_FASTWRITE,		
-                            CY_SMIF_WIDTH,
-                            address, 
-                            (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/  
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    /* Transmit data */
-    Cy_SMIF_TransmitData(baseaddr, 
-                            tst_txBuffer,
-                            txSize, 
-                            CY_SMIF_WIDTH, 
-                            RxCmpltCallback, 
-                            smifContext);
-    
-    /* Check if the SMIF IP is busy */
-   while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed */
-    }
+{
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_FASTWRITE, spimode, address, tst_txBuffer, txSize, 0u);
 }
 
 /*******************************************************************************
@@ -805,55 +753,19 @@ void WriteCmdSPIFastWrite(SMIF_Type *baseaddr,
 * \param latency
 * Memory latency cycle during read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSPIFastRead(SMIF_Type *baseaddr,
+bool WriteCmdSPIFastRead(SMIF_Type *baseaddr,
                         cy_stc_smif_context_t *smifContext, 
                         uint8_t tst_rxBuffer[], 
                         uint32_t rxSize, 
                         uint8_t *address,
                         uint8_t spimode,
                         uint8_t latency)
-{   
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;    
-    
-    /* Transmit command and address */
-	Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_FAST_READ,				
-                            CY_SMIF_WIDTH,
-                            address, 
-                           (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/ 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext); 
-    
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
-    
-    /* Receive data */ 
-    Cy_SMIF_ReceiveData(  baseaddr,
-                            tst_rxBuffer, 
-                            rxSize, 
-                            CY_SMIF_WIDTH, 
-                            RxCmpltCallback,
-                            smifContext);
-   
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed. */
-    }
+{
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_FAST_READ, spimode, address, tst_rxBuffer, rxSize, latency);
 }
 
 /*******************************************************************************
@@ -881,54 +793,18 @@ void WriteCmdSPIFastRead(SMIF_Type *baseaddr,
 * \param spimode
 * Determines SMIF width single,dual,or quad.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSSWR(SMIF_Type *baseaddr, 
+bool WriteCmdSSWR(SMIF_Type *baseaddr, 
                     cy_stc_smif_context_t *smifContext, 
                     uint8_t tst_txBuffer[], 
                     uint32_t txSize, 
                     uint8_t *address,
                     uint8_t spimode)
-{  
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-      (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;  
-    else
-     CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;  
-    
-    /* Set the write enable (WEL) bit in SR1 */
-    WriteCmdWREN(baseaddr, smifContext,spimode);
-	
-    /* Transmit command and address */
-	Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_SSWR,		
-                            CY_SMIF_WIDTH,
-                            address, 
-                            ADDRESS_SIZE, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    
-     /* Transmit data */
-    Cy_SMIF_TransmitData(baseaddr, 
-                            tst_txBuffer,
-                            txSize, 
-                            CY_SMIF_WIDTH, 
-                            RxCmpltCallback, 
-                            smifContext);
-    
-    /* Check if the SMIF IP is busy */
-   while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed */
-    }
+{
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_SSWR, spimode, address, tst_txBuffer, txSize, 0u);
 }
 
 /*******************************************************************************
@@ -953,47 +829,17 @@ void WriteCmdSSWR(SMIF_Type *baseaddr,
 * \param address 
 * The address to write data to.  
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdWRSN(  SMIF_Type *baseaddr,
+bool WriteCmdWRSN(  SMIF_Type *baseaddr,
                     cy_stc_smif_context_t *smifContext, 
                     uint8_t tst_txBuffer[], 
                     uint32_t txSize, 
                     uint8_t spimode)
 {
-    
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-      (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;  
-    else
-     CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE; 
-    
-    /* Set the write enable (WEL) bit in SR1 */
-    WriteCmdWREN(baseaddr, smifContext, spimode);
-    
-    /* Transmit command */    
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_WRSN,				  
-                            CY_SMIF_WIDTH,
-                            tst_txBuffer, 
-                            txSize, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_LAST_BYTE, 
-                            smifContext);
-    
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed. */
-    }
-   
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_WRSN, spimode, NULL, tst_txBuffer, txSize, 0u);
 }
 
 /*******************************************************************************
@@ -1024,8 +870,11 @@ void WriteCmdWRSN(  SMIF_Type *baseaddr,
 * \param latency
 * Memory latency cycle during read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSPIWrite_DIOW_QIOW(SMIF_Type *baseaddr,
+bool WriteCmdSPIWrite_DIOW_QIOW(SMIF_Type *baseaddr,
                         cy_stc_smif_context_t *smifContext, 
                         uint8_t tst_txBuffer[], 
                         uint32_t txSize, 
@@ -1033,54 +882,10 @@ void WriteCmdSPIWrite_DIOW_QIOW(SMIF_Type *baseaddr,
                         uint8_t CMDtype)
 
 {
-    /* Set the write enable (WEL) bit in SR1 */
-    WriteCmdWREN(baseaddr, smifContext, SPI_MODE);
-    
-    /* Transmit command and address in DIO or QIO */
-      if( CMDtype==MEM_CMD_DIOW)
-       Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_DIOW ,				
-                            CY_SMIF_WIDTH_SINGLE,
-                            address, 
-                           (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/ 
-                            CY_SMIF_WIDTH_DUAL, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);         
-    
-      if( CMDtype==MEM_CMD_QIOW)
-       Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_QIOW,				
-                            CY_SMIF_WIDTH_SINGLE,
-                            address, 
-                           (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/ 
-                            CY_SMIF_WIDTH_QUAD, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);     
-    
-    /* Transmit data byte(s) in DIO or QIO */ 
-    if( CMDtype==MEM_CMD_DIOW)    
-    Cy_SMIF_TransmitData(baseaddr, 
-                            tst_txBuffer,
-                            txSize, 
-                            CY_SMIF_WIDTH_DUAL, 
-                            RxCmpltCallback, 
-                            smifContext);
-       
-    if( CMDtype==MEM_CMD_QIOW)
-    Cy_SMIF_TransmitData(baseaddr,
-                            tst_txBuffer, 
-                            txSize, 
-                            CY_SMIF_WIDTH_QUAD, 
-                            RxCmpltCallback,
-                            smifContext);
+    fram_cmd_id_t cmdId = (CMDtype == MEM_CMD_DIOW) ? FRAM_CMD_DIOW : FRAM_CMD_QIOW;
     
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed. */
-    }
+    /* Extended SPI command: the opcode is always sent on a single line */
+    return FRAM_Command(baseaddr, smifContext, cmdId, SPI_MODE, address, tst_txBuffer, txSize, 0u);
 }
 
 /*******************************************************************************
@@ -1111,8 +916,11 @@ void WriteCmdSPIWrite_DIOW_QIOW(SMIF_Type *baseaddr,
 * \param latency
 * Memory latency cycle during read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSPIRead_DIOR_QIOR(SMIF_Type *baseaddr,
+bool WriteCmdSPIRead_DIOR_QIOR(SMIF_Type *baseaddr,
                         cy_stc_smif_context_t *smifContext, 
                         uint8_t tst_rxBuffer[], 
                         uint32_t rxSize, 
@@ -1120,72 +928,16 @@ void WriteCmdSPIRead_DIOR_QIOR(SMIF_Type *baseaddr,
                         uint8_t spimode,
                         uint8_t latency,
                         uint8_t CMDtype)
-{       
-   /* Transmit command and address in DIO or QIO */
-    if (spimode==SPI_MODE)      
-     { 
-      if( CMDtype==MEM_CMD_DIOR)
-       Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_DIOR,				
-                            CY_SMIF_WIDTH_SINGLE,
-                            address, 
-                           (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/ 
-                            CY_SMIF_WIDTH_DUAL, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);         
-    
-      if( CMDtype==MEM_CMD_QIOR)
-       Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_QIOR,				
-                            CY_SMIF_WIDTH_SINGLE,
-                            address, 
-                           (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/ 
-                            CY_SMIF_WIDTH_QUAD, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);  
-    
-      }
-    
-    if (spimode==QPI_MODE)                                      
-     { 	
-       Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_QIOR,				
-                            CY_SMIF_WIDTH_QUAD,
-                            address, 
-                           (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/ 
-                            CY_SMIF_WIDTH_QUAD, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-      } 
- 
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
-   
-    /* Transmit data in DIO or QIO */
-    if( CMDtype==MEM_CMD_DIOR)
-    Cy_SMIF_ReceiveData(  baseaddr,
-                            tst_rxBuffer, 
-                            rxSize, 
-                            CY_SMIF_WIDTH_DUAL, 
-                            RxCmpltCallback,
-                            smifContext);
-    
-    if( CMDtype==MEM_CMD_QIOR)    
-    Cy_SMIF_ReceiveData(  baseaddr,
-                            tst_rxBuffer, 
-                            rxSize, 
-                            CY_SMIF_WIDTH_QUAD, 
-                            RxCmpltCallback,
-                            smifContext);
+{
+    fram_cmd_id_t cmdId = FRAM_CMD_QIOR;
     
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
+    /* Only QIOR is available in QPI mode */
+    if ((spimode != QPI_MODE) && (CMDtype == MEM_CMD_DIOR))
     {
-        /* Wait until the SMIF IP operation is completed. */
+        cmdId = FRAM_CMD_DIOR;
     }
+    
+    return FRAM_Command(baseaddr, smifContext, cmdId, spimode, address, tst_rxBuffer, rxSize, latency);
 }
 
 /*******************************************************************************
@@ -1216,8 +968,11 @@ void WriteCmdSPIRead_DIOR_QIOR(SMIF_Type *baseaddr,
 * \param latency
 * Memory latency cycle during read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSPIWrite_DIW_QIW(SMIF_Type *baseaddr,
+bool WriteCmdSPIWrite_DIW_QIW(SMIF_Type *baseaddr,
                         cy_stc_smif_context_t *smifContext, 
                         uint8_t tst_txBuffer[], 
                         uint32_t txSize, 
@@ -1225,54 +980,10 @@ void WriteCmdSPIWrite_DIW_QIW(SMIF_Type *baseaddr,
                         uint8_t CMDtype)
 
 {
-    /* Set the write enable (WEL) bit in SR1 */
-    WriteCmdWREN(baseaddr, smifContext, SPI_MODE);
+    fram_cmd_id_t cmdId = (CMDtype == MEM_CMD_DIW) ? FRAM_CMD_DIW : FRAM_CMD_QIW;
     
-    /* Transmit command and address in DIW or QIW */
-    if( CMDtype==MEM_CMD_DIW)
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_DIW ,				
-                            CY_SMIF_WIDTH_SINGLE,
-                            address, 
-                           (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/ 
-                            CY_SMIF_WIDTH_SINGLE, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);         
-    
-    if( CMDtype==MEM_CMD_QIW)
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_QIW,				
-                            CY_SMIF_WIDTH_SINGLE,
-                            address, 
-                           (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/ 
-                            CY_SMIF_WIDTH_SINGLE, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);     
-    
-   /* Transmit data byte(s) in DIW or QIW */ 
-   if( CMDtype==MEM_CMD_DIW)    
-   Cy_SMIF_TransmitData(baseaddr, 
-                            tst_txBuffer,
-                            txSize, 
-                            CY_SMIF_WIDTH_DUAL, 
-                            RxCmpltCallback, 
-                            smifContext);
-       
-   if( CMDtype==MEM_CMD_QIW)    
-   Cy_SMIF_TransmitData(  baseaddr,
-                            tst_txBuffer, 
-                            txSize, 
-                            CY_SMIF_WIDTH_QUAD, 
-                            RxCmpltCallback,
-                            smifContext);
-    
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed. */
-    }
+    /* Extended SPI command: the opcode and address are always sent on a single line */
+    return FRAM_Command(baseaddr, smifContext, cmdId, SPI_MODE, address, tst_txBuffer, txSize, 0u);
 }
 
 /* Function Name: WriteCmdSPIRead_DOR_QOR
@@ -1302,79 +1013,22 @@ void WriteCmdSPIWrite_DIW_QIW(SMIF_Type *baseaddr,
 * \param latency
 * Memory latency cycle during read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSPIRead_DOR_QOR(SMIF_Type *baseaddr,
+bool WriteCmdSPIRead_DOR_QOR(SMIF_Type *baseaddr,
                         cy_stc_smif_context_t *smifContext, 
                         uint8_t tst_rxBuffer[], 
                         uint32_t rxSize, 
                         uint8_t *address,
                         uint8_t CMDtype,
                         uint8_t latency)
-{   
-    
-    /* Transmit command and data in DO */  
-    if (CMDtype==MEM_CMD_DOR)      
-     { 	
-       Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_DOR,				
-                            CY_SMIF_WIDTH_SINGLE,
-                            address, 
-                           (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/ 
-                            CY_SMIF_WIDTH_SINGLE, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    
-       /* Sends extra dummy clocks to adde clock cycle latency */
-       Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);    
-    
-       Cy_SMIF_ReceiveData(  baseaddr,
-                            tst_rxBuffer, 
-                            rxSize, 
-                            CY_SMIF_WIDTH_DUAL, 
-                            RxCmpltCallback,
-                            smifContext);
-      }
-    
-    if (CMDtype==MEM_CMD_QOR)      
-     { 	
-       Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_QOR,				
-                            CY_SMIF_WIDTH_SINGLE,
-                            address, 
-                           (ADDRESS_SIZE+1),                      /*ADDRESS_PLUS_MODE_SIZE*/ 
-                            CY_SMIF_WIDTH_SINGLE, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);    
-    
-    /* Transmit data in DO */
-    if( CMDtype==MEM_CMD_DOR)
-    Cy_SMIF_ReceiveData(  baseaddr,
-                            tst_rxBuffer, 
-                            rxSize, 
-                            CY_SMIF_WIDTH_DUAL, 
-                            RxCmpltCallback,
-                            smifContext);
-    
-    if( CMDtype==MEM_CMD_QOR)    
-    Cy_SMIF_ReceiveData(  baseaddr,
-                            tst_rxBuffer, 
-                            rxSize, 
-                            CY_SMIF_WIDTH_QUAD, 
-                            RxCmpltCallback,
-                            smifContext);
-      } 
- 
+{
+    fram_cmd_id_t cmdId = (CMDtype == MEM_CMD_DOR) ? FRAM_CMD_DOR : FRAM_CMD_QOR;
     
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed. */
-    }
+    /* Extended SPI command: the opcode and address are always sent on a single line */
+    return FRAM_Command(baseaddr, smifContext, cmdId, SPI_MODE, address, tst_rxBuffer, rxSize, latency);
 }
 
 /*******************************************************************************
@@ -1399,53 +1053,17 @@ void WriteCmdSPIRead_DOR_QOR(SMIF_Type *baseaddr,
 * \param latency
 * Register latency cycle during register read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdRDID(SMIF_Type *baseaddr,
+bool WriteCmdRDID(SMIF_Type *baseaddr,
                     cy_stc_smif_context_t *smifContext,
                      uint8_t tst_rxBuffer[],
                     uint8_t spimode,
                     uint8_t latency)
 {
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE; 
-    
-    /* Transmit command */
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_RDID,				
-                            CY_SMIF_WIDTH,
-                            CMD_WITHOUT_PARAM, 
-                            CMD_WITHOUT_PARAM, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
-    
-    /* Receive data */
-    Cy_SMIF_ReceiveData( baseaddr,
-                        tst_rxBuffer, 					
-                        DID_REG_SIZE, 
-                        CY_SMIF_WIDTH, 
-                        RxCmpltCallback,
-                        smifContext);       
-  
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed */
-    }
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_RDID, spimode, NULL, tst_rxBuffer, DID_REG_SIZE, latency);
 }
 
 /*******************************************************************************
@@ -1470,53 +1088,17 @@ void WriteCmdRDID(SMIF_Type *baseaddr,
 * \param latency
 * Register latency cycle during register read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdRDUID(SMIF_Type *baseaddr,
+bool WriteCmdRDUID(SMIF_Type *baseaddr,
                     cy_stc_smif_context_t *smifContext,
                     uint8_t tst_rxBuffer[],
                     uint8_t spimode,
                     uint8_t latency)
 {
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;    
-    
-    /* Transmit command */
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_RUID,				
-                            CY_SMIF_WIDTH,
-                            CMD_WITHOUT_PARAM, 
-                            CMD_WITHOUT_PARAM, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
-    
-    /* Receive data */
-    Cy_SMIF_ReceiveData( baseaddr,
-                        tst_rxBuffer, 					
-                        UID_BUF_SIZE, 
-                        CY_SMIF_WIDTH, 
-                        RxCmpltCallback,
-                        smifContext);
-    
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed */
-    }
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_RUID, spimode, NULL, tst_rxBuffer, UID_BUF_SIZE, latency);
 }
 
 /*******************************************************************************
@@ -1541,54 +1123,18 @@ void WriteCmdRDUID(SMIF_Type *baseaddr,
 * \param latency
 * Register latency cycle during read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdRDSN(SMIF_Type *baseaddr,
+bool WriteCmdRDSN(SMIF_Type *baseaddr,
                     cy_stc_smif_context_t *smifContext,
                     uint8_t tst_rxBuffer[],
                     uint32_t txSize, 
                     uint8_t spimode,
                     uint8_t latency)
 {
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;    
-     
-    /* Transmit command */
-    Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_RDSN,				
-                            CY_SMIF_WIDTH,
-                            CMD_WITHOUT_PARAM, 
-                            CMD_WITHOUT_PARAM, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
-    
-    /* Receive data */
-    Cy_SMIF_ReceiveData( baseaddr,
-                        tst_rxBuffer, 					
-                        txSize, 
-                        CY_SMIF_WIDTH, 
-                        RxCmpltCallback,
-                        smifContext);
-    
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed */
-    }
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_RDSN, spimode, NULL, tst_rxBuffer, txSize, latency);
 }
 /*******************************************************************************
 * Function Name: WriteCmdSSRD
@@ -1618,55 +1164,19 @@ void WriteCmdRDSN(SMIF_Type *baseaddr,
 * \param latency
 * Memory latency cycle during read.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdSSRD(SMIF_Type *baseaddr,
+bool WriteCmdSSRD(SMIF_Type *baseaddr,
                         cy_stc_smif_context_t *smifContext, 
                         uint8_t tst_rxBuffer[], 
                         uint32_t rxSize, 
                         uint8_t *address,
                         uint8_t spimode,
                         uint8_t latency)
-{   
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;   
-    
-    /* Transmit command */
-	Cy_SMIF_TransmitCommand( baseaddr,
-                            MEM_CMD_SSRD,				
-                            CY_SMIF_WIDTH,
-                            address, 
-                            ADDRESS_SIZE, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_NOT_LAST_BYTE, 
-                            smifContext);
-    
-    /* Sends extra dummy clocks to adde clock cycle latency */
-    Cy_SMIF_SendDummyCycles(baseaddr, (uint32_t)latency);
-     
-    /* Receive data */
-    Cy_SMIF_ReceiveData(  baseaddr,
-                            tst_rxBuffer, 
-                            rxSize, 
-                            CY_SMIF_WIDTH, 
-                            RxCmpltCallback,
-                            smifContext);
- 
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
-    {
-        /* Wait until the SMIF IP operation is completed. */
-    }        
+{
+    return FRAM_Command(baseaddr, smifContext, FRAM_CMD_SSRD, spimode, address, tst_rxBuffer, rxSize, latency);
 }
 
 /*******************************************************************************
@@ -1688,50 +1198,31 @@ void WriteCmdSSRD(SMIF_Type *baseaddr,
 * \param spimode
 * Determines SMIF width single,dual,or quad.
 *
+* \return
+* true if the command was sent, false if it was refused, see FRAM_Command().
+*
 *******************************************************************************/
-void WriteCmdEnterLPMode(SMIF_Type *baseaddr,	
+bool WriteCmdEnterLPMode(SMIF_Type *baseaddr,	
                     cy_stc_smif_context_t *smifContext,
                     uint8_t cmdtype, 
                     uint8_t spimode)
-{    
-    cy_en_smif_txfr_width_t CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-    uint8_t CMD_TYPE=0x00;
-    
-    if (spimode==SPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;
-     else if
-       (spimode==DPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_DUAL;    
-     else if
-       (spimode==QPI_MODE)
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_QUAD;   
-    else
-       CY_SMIF_WIDTH = CY_SMIF_WIDTH_SINGLE;      
+{
+    bool sent = false;
     
-    if (cmdtype==MEM_CMD_ENTDPD)
-      CMD_TYPE = MEM_CMD_ENTDPD;
-   
-     else if (cmdtype==MEM_CMD_ENTHBN)
-           CMD_TYPE = MEM_CMD_ENTHBN;  
+    if (cmdtype == MEM_CMD_ENTDPD)
+    {
+        sent = FRAM_Command(baseaddr, smifContext, FRAM_CMD_ENTDPD, spimode, NULL, NULL, 0u, 0u);
+    }
+    else if (cmdtype == MEM_CMD_ENTHBN)
+    {
+        sent = FRAM_Command(baseaddr, smifContext, FRAM_CMD_ENTHBN, spimode, NULL, NULL, 0u, 0u);
+    }
     else
-    CMD_TYPE = MEM_CMD_RDSR1; 
-    
-    /* Transmit command */
-    Cy_SMIF_TransmitCommand(baseaddr,
-                            CMD_TYPE,				  
-                            CY_SMIF_WIDTH,
-                            CMD_WITHOUT_PARAM, 
-                            CMD_WITHOUT_PARAM, 
-                            CY_SMIF_WIDTH, 
-                            ONBOARD_MEM_SSFRAM, 
-                            TX_LAST_BYTE, 
-                            smifContext); 
-    
-    /* Check if the SMIF IP is busy */
-    while(Cy_SMIF_BusyCheck(baseaddr))
     {
-        /* Wait until the SMIF IP operation is completed. */
+        /* Unknown power mode: nothing to send */
     }
-}  
+    
+    return sent;
+}
 
 /* [] END OF FILE */
@@ -42,6 +42,9 @@
 * Cypress software license agreement.
 *******************************************************************************/
 
+#ifndef FRAM_ACCESS_H
+#define FRAM_ACCESS_H
+
 #include <stdint.h>
 #include <stdbool.h>
 #include "smif/cy_smif.h"
@@ -139,17 +142,111 @@
 #define MEM_CMD_ENTDPD      (0xB9) 	/* Enter DPD*/
 #define MEM_CMD_ENTHBN      (0xBA) 	/* Enter Hibernate*/
 
+/***************************************
+*     F-RAM command descriptors
+***************************************/
+/* Data phase of a command */
+#define FRAM_DATA_NONE            (0u)      /* Opcode and address only */
+#define FRAM_DATA_PARAM           (1u)      /* Data sent as the command parameters (registers) */
+#define FRAM_DATA_TX              (2u)      /* Data written after the address */
+#define FRAM_DATA_RX              (3u)      /* Data read after the latency cycles */
+
+/* Latency cycles used by a read command */
+#define FRAM_LAT_NONE             (0u)      /* No latency cycles */
+#define FRAM_LAT_MEM              (1u)      /* Memory latency (MLC) */
+#define FRAM_LAT_REG              (2u)      /* Register latency (RLC) */
+
+/* Command flags */
+#define FRAM_FLAG_WREN            (0x01u)   /* The WEL bit must be set before the command */
+
+/* F-RAM commands, indexes in the command table */
+typedef enum
+{
+    FRAM_CMD_WREN = 0u,
+    FRAM_CMD_WRDI,
+    FRAM_CMD_WRSR,
+    FRAM_CMD_RDSR1,
+    FRAM_CMD_RDSR2,
+    FRAM_CMD_RDCR1,
+    FRAM_CMD_RDCR2,
+    FRAM_CMD_RDCR4,
+    FRAM_CMD_RDCR5,
+    FRAM_CMD_WRAR,
+    FRAM_CMD_RDAR,
+    FRAM_CMD_WRITE,
+    FRAM_CMD_READ,
+    FRAM_CMD_FASTWRITE,
+    FRAM_CMD_FAST_READ,
+    FRAM_CMD_SSWR,
+    FRAM_CMD_SSRD,
+    FRAM_CMD_WRSN,
+    FRAM_CMD_RDSN,
+    FRAM_CMD_RDID,
+    FRAM_CMD_RUID,
+    FRAM_CMD_DIOW,
+    FRAM_CMD_QIOW,
+    FRAM_CMD_DIW,
+    FRAM_CMD_QIW,
+    FRAM_CMD_DIOR,
+    FRAM_CMD_QIOR,
+    FRAM_CMD_DOR,
+    FRAM_CMD_QOR,
+    FRAM_CMD_ENTDPD,
+    FRAM_CMD_ENTHBN,
+    FRAM_CMD_COUNT
+} fram_cmd_id_t;
+
+/* F-RAM command descriptor */
+typedef struct
+{
+    uint8_t opcode;                         /* Command opcode (MEM_CMD_xxx) */
+    uint8_t addrSize;                       /* Address bytes, 0 if no address */
+    uint8_t modeByte;                       /* 1 if a mode byte follows the address */
+    cy_en_smif_txfr_width_t addrWidth;      /* Address width in SPI mode */
+    cy_en_smif_txfr_width_t dataWidth;      /* Data width in SPI mode */
+    uint8_t dataPhase;                      /* FRAM_DATA_xxx */
+    uint8_t latency;                        /* FRAM_LAT_xxx */
+    uint8_t flags;                          /* FRAM_FLAG_xxx */
+} fram_cmd_t;
+
+/***************************************/
+/*QSPI F-RAM command engine            */
+/***************************************/
+
+const fram_cmd_t *FRAM_GetCommand(fram_cmd_id_t cmdId); /* Command descriptor */
+
+fram_cmd_id_t FRAM_FindCommand(uint8_t opcode);         /* Command index of an opcode */
+
+bool FRAM_StartCommand(SMIF_Type *baseaddr,             /* Start any command, the data phase completes in the interrupt */
+                       cy_stc_smif_context_t *smifContext,
+                       fram_cmd_id_t cmdId,
+                       uint8_t spimode,
+                       uint8_t *address,
+                       uint8_t buffer[],
+                       uint32_t size,
+                       uint8_t latency,
+                       cy_smif_event_cb_t callback);
+
+bool FRAM_Command(SMIF_Type *baseaddr,                  /* Send any command and wait until it is completed */
+                  cy_stc_smif_context_t *smifContext,
+                  fram_cmd_id_t cmdId,
+                  uint8_t spimode,
+                  uint8_t *address,
+                  uint8_t buffer[],
+                  uint32_t size,
+                  uint8_t latency);
+
 /***************************************/
 /*QSPI F-RAM Fiunction Protype         */
 /***************************************/
 
-void WriteCmdWRSR(SMIF_Type *baseaddr,                   /* Change the Status and Config Register */
+bool WriteCmdWRSR(SMIF_Type *baseaddr,                   /* Change the Status and Config Register */
                   cy_stc_smif_context_t *smifContext, 
                   uint8_t cmdParam[], 	
                   uint32_t cmdSize,
                   uint8_t spimode);		    		
 
-void WriteCmdReadSRx(SMIF_Type *baseaddr,                 /* Read from Status Register (SR1 and SR2) */
+bool WriteCmdReadSRx(SMIF_Type *baseaddr,                 /* Read from Status Register (SR1 and SR2) */
                   cy_stc_smif_context_t *smifContext,
                   uint8_t tst_rxBuffer[], 
                   uint32_t rxSize,
@@ -157,7 +254,7 @@ void WriteCmdReadSRx(SMIF_Type *baseaddr,                 /* Read from Status Re
                   uint8_t cmdtype,
                   uint8_t latency);	
 
-void WriteCmdSPIReadAnyReg(SMIF_Type *baseaddr,         /* Read Any Register (Status and Config) from register address, one byte */
+bool WriteCmdSPIReadAnyReg(SMIF_Type *baseaddr,         /* Read Any Register (Status and Config) from register address, one byte */
                            cy_stc_smif_context_t *smifContext, 
                            uint8_t tst_rxBuffer[], 
                            uint32_t rxSize, 
@@ -165,14 +262,14 @@ void WriteCmdSPIReadAnyReg(SMIF_Type *baseaddr,         /* Read Any Register (St
                            uint8_t spimode,
                            uint8_t latency);
 
-void WriteCmdSPIWriteAnyReg(SMIF_Type *baseaddr,        /* Write Any Register (Status and Config) at register address, one byte */ 
+bool WriteCmdSPIWriteAnyReg(SMIF_Type *baseaddr,        /* Write Any Register (Status and Config) at register address, one byte */ 
                             cy_stc_smif_context_t *smifContext, 
                             uint8_t tst_txBuffer[], 
                             uint32_t txSize, 
                             uint8_t *address,
                             uint8_t spimode);
 
-void WriteCmdReadCRx(SMIF_Type *baseaddr,               /* Read Config Register (CR1, CR2, CR4, CR5)*/
+bool WriteCmdReadCRx(SMIF_Type *baseaddr,               /* Read Config Register (CR1, CR2, CR4, CR5)*/
                    cy_stc_smif_context_t *smifContext,
                    uint8_t tst_rxBuffer[], 
                    uint32_t rxSize,
@@ -180,14 +277,14 @@ void WriteCmdReadCRx(SMIF_Type *baseaddr,               /* Read Config Register
                    uint8_t crtype,
                    uint8_t latency);
 
-void WriteCmdSPIWrite(SMIF_Type *baseaddr, 	            /* Write to memory */
+bool WriteCmdSPIWrite(SMIF_Type *baseaddr, 	            /* Write to memory */
                       cy_stc_smif_context_t *smifContext, 	
                       uint8_t tst_txBuffer[], 	
                       uint32_t txSize, 	
                       uint8_t *address,
                       uint8_t spimode);	    			
 
-void WriteCmdSPIRead(SMIF_Type *baseaddr,	            /* Read from memory using Read command */
+bool WriteCmdSPIRead(SMIF_Type *baseaddr,	            /* Read from memory using Read command */
                      cy_stc_smif_context_t *smifContext, 	
                      uint8_t tst_rxBuffer[], 	
                      uint32_t rxSize, 	
@@ -195,14 +292,14 @@ void WriteCmdSPIRead(SMIF_Type *baseaddr,	            /* Read from memory using
                      uint8_t spimode,
                      uint8_t latency);   
 
-void WriteCmdSPIFastWrite(SMIF_Type *baseaddr,         /* Fast Write to memory */
+bool WriteCmdSPIFastWrite(SMIF_Type *baseaddr,         /* Fast Write to memory */
                     cy_stc_smif_context_t *smifContext, 
                     uint8_t tst_txBuffer[], 
                     uint32_t txSize, 
                     uint8_t *address,
                     uint8_t spimode);
 
-void WriteCmdSPIFastRead(SMIF_Type *baseaddr,	        /* Read from memory using FastRead command */
+bool WriteCmdSPIFastRead(SMIF_Type *baseaddr,	        /* Read from memory using FastRead command */
                          cy_stc_smif_context_t *smifContext, 	
                          uint8_t tst_rxBuffer[], 	
                          uint32_t rxSize, 	
@@ -210,14 +307,14 @@ void WriteCmdSPIFastRead(SMIF_Type *baseaddr,	        /* Read from memory using
                          uint8_t spimode,
                          uint8_t latency);
 
-void WriteCmdSPIWrite_DIOW_QIOW(SMIF_Type *baseaddr,    /* Write to memory using DIOW, QIOW in extended SPI dual IO, quad IO mode */ 
+bool WriteCmdSPIWrite_DIOW_QIOW(SMIF_Type *baseaddr,    /* Write to memory using DIOW, QIOW in extended SPI dual IO, quad IO mode */ 
                         cy_stc_smif_context_t *smifContext, 
                         uint8_t tst_txBuffer[], 
                         uint32_t txSize, 
                         uint8_t *address,
                         uint8_t CMDtype);
 
-void WriteCmdSPIRead_DIOR_QIOR(SMIF_Type *baseaddr,     /* Read from memory using DIOR, QIOR in extended SPI dual IO, quad IO mode */ 
+bool WriteCmdSPIRead_DIOR_QIOR(SMIF_Type *baseaddr,     /* Read from memory using DIOR, QIOR in extended SPI dual IO, quad IO mode */ 
                                cy_stc_smif_context_t *smifContext, 
                                uint8_t tst_rxBuffer[], 
                                uint32_t rxSize, 
@@ -226,14 +323,14 @@ void WriteCmdSPIRead_DIOR_QIOR(SMIF_Type *baseaddr,     /* Read from memory usin
                                uint8_t latency,
                                uint8_t CMDtype);
 
-void WriteCmdSPIWrite_DIW_QIW(SMIF_Type *baseaddr,      /* Write to memory using DIW, QIW in extended SPI dual line data input, quad line input */ 
+bool WriteCmdSPIWrite_DIW_QIW(SMIF_Type *baseaddr,      /* Write to memory using DIW, QIW in extended SPI dual line data input, quad line input */ 
                         cy_stc_smif_context_t *smifContext, 
                         uint8_t tst_txBuffer[], 
                         uint32_t txSize, 
                         uint8_t *address,
                         uint8_t CMDtype);
 
-void WriteCmdSPIRead_DOR_QOR(SMIF_Type *baseaddr,       /* Read from memory using DOR, QOR in extended SPI dual line output, quad line output  */ 
+bool WriteCmdSPIRead_DOR_QOR(SMIF_Type *baseaddr,       /* Read from memory using DOR, QOR in extended SPI dual line output, quad line output  */ 
                              cy_stc_smif_context_t *smifContext, 
                              uint8_t tst_rxBuffer[], 
                              uint32_t rxSize, 
@@ -241,22 +338,22 @@ void WriteCmdSPIRead_DOR_QOR(SMIF_Type *baseaddr,       /* Read from memory usin
                              uint8_t CMDtype,
                              uint8_t latency);
 
-void WriteCmdWREN(SMIF_Type *baseaddr,	                /* Memory Write Enable */
+bool WriteCmdWREN(SMIF_Type *baseaddr,	                /* Memory Write Enable */
                   cy_stc_smif_context_t *smifContext,
                   uint8_t spimode);	
 
-void WriteCmdWRDI(SMIF_Type *baseaddr,	                /* Memory Write Disable */
+bool WriteCmdWRDI(SMIF_Type *baseaddr,	                /* Memory Write Disable */
                   cy_stc_smif_context_t *smifContext,
                   uint8_t spimode);	   
 
-void WriteCmdSSWR(SMIF_Type *baseaddr,                  /* Wtite 256-byte Special Sector */ 
+bool WriteCmdSSWR(SMIF_Type *baseaddr,                  /* Wtite 256-byte Special Sector */ 
                   cy_stc_smif_context_t *smifContext, 
                   uint8_t tst_txBuffer[], 
                   uint32_t txSize, 
                   uint8_t *address,
                   uint8_t spimode);
 
-void WriteCmdSSRD(SMIF_Type *baseaddr,                  /* Read 256-byte Special Sector */
+bool WriteCmdSSRD(SMIF_Type *baseaddr,                  /* Read 256-byte Special Sector */
                    cy_stc_smif_context_t *smifContext, 
                    uint8_t tst_rxBuffer[], 
                    uint32_t rxSize, 
@@ -264,34 +361,36 @@ void WriteCmdSSRD(SMIF_Type *baseaddr,                  /* Read 256-byte Special
                    uint8_t spimode,
                    uint8_t latency);
 
-void WriteCmdWRSN(SMIF_Type *baseaddr,                  /* Wrire 8-byte Serial Number */   
+bool WriteCmdWRSN(SMIF_Type *baseaddr,                  /* Wrire 8-byte Serial Number */   
                   cy_stc_smif_context_t *smifContext, 
                   uint8_t cmdParam[], 	
                   uint32_t cmdSize,
                   uint8_t spimode);
 
-void WriteCmdRDSN(SMIF_Type *baseaddr,                  /* Read 8-byte Serial Number */  
+bool WriteCmdRDSN(SMIF_Type *baseaddr,                  /* Read 8-byte Serial Number */  
                   cy_stc_smif_context_t *smifContext,
                   uint8_t tst_rxBuffer[],
                   uint32_t txSize,
                   uint8_t spimode,
                   uint8_t latency);    
 
-void WriteCmdRDID(SMIF_Type *baseaddr,                  /* Read 8-byte Device ID */
+bool WriteCmdRDID(SMIF_Type *baseaddr,                  /* Read 8-byte Device ID */
                   cy_stc_smif_context_t *smifContext,
                   uint8_t tst_rxBuffer[], 
                   uint8_t spimode,
                   uint8_t latency);
 
-void WriteCmdRDUID(SMIF_Type *baseaddr,                 /* Read 8-byte Unique Device ID */
+bool WriteCmdRDUID(SMIF_Type *baseaddr,                 /* Read 8-byte Unique Device ID */
                    cy_stc_smif_context_t *smifContext,
                    uint8_t tst_rxBuffer[], 
                    uint8_t spimode,
                    uint8_t latency);
 
-void WriteCmdEnterLPMode(SMIF_Type *baseaddr,	        /* Enter low power modes (DPD and HIBNET) */ 
+bool WriteCmdEnterLPMode(SMIF_Type *baseaddr,	        /* Enter low power modes (DPD and HIBNET) */ 
                   cy_stc_smif_context_t *smifContext,
                   uint8_t powermode, 
-                  uint8_t spimode);	
-    
+                  uint8_t spimode);
+
+#endif /* FRAM_ACCESS_H */
+
 /* [] END OF FILE */
@@ -0,0 +1,537 @@
+/****************************************************************************
+*File Name: FRAM_ASYNC.c
+*
+* Version: 1.0
+*
+* Description: 
+* This file contains the queued, non-blocking F-RAM access. Requests are sent 
+* with the command engine of FRAM_ACCESS.c and their data is moved between 
+* the SMIF FIFO and SRAM by a DataWire channel.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#include "FRAM_ASYNC.h"
+#include "FRAM_POWER.h"
+#include "project.h"
+
+/* Elements of one X loop of a DataWire descriptor */
+#define DMA_X_COUNT_MAX           (256u)
+
+/* Queued F-RAM request */
+typedef struct
+{
+    fram_cmd_id_t cmdId;                            /* Command to send */
+    uint8_t spimode;                                /* Access mode */
+    uint8_t latency;                                /* Latency cycles of a read */
+    uint8_t address[ADDRESS_PLUS_MODE_SIZE];        /* Address, MSB first, and mode byte */
+    uint8_t *buffer;                                /* Data to write or buffer for the read data */
+    uint32_t size;                                  /* Size of data */
+    fram_async_cb_t callback;                       /* Completion callback */
+    void *arg;                                      /* Argument of the callback */
+} fram_async_req_t;
+
+/* Requests in the order of submission, the one at queueHead is in progress */
+static fram_async_req_t queue[FRAM_ASYNC_QUEUE_SIZE];
+static volatile uint32_t queueHead = 0u;
+static volatile uint32_t queueCount = 0u;
+static volatile bool queueBusy = false;
+
+static SMIF_Type *smifBase;
+static cy_stc_smif_context_t *smifCtx;
+
+/* 2D descriptor for whole 256-byte rows and 1D descriptor for the rest */
+static cy_stc_dma_descriptor_t dmaDescriptors[2u];
+
+static cy_stc_dma_descriptor_config_t dmaDescriptorConfig =
+{
+    .retrigger       = CY_DMA_RETRIG_IM,
+    .interruptType   = CY_DMA_DESCR_CHAIN,
+    .triggerOutType  = CY_DMA_DESCR_CHAIN,
+    .channelState    = CY_DMA_CHANNEL_DISABLED,
+    .triggerInType   = CY_DMA_DESCR_CHAIN,
+    .dataSize        = CY_DMA_BYTE,
+    .srcTransferSize = CY_DMA_TRANSFER_SIZE_WORD,
+    .dstTransferSize = CY_DMA_TRANSFER_SIZE_DATA,
+    .descriptorType  = CY_DMA_1D_TRANSFER,
+    .srcAddress      = NULL,
+    .dstAddress      = NULL,
+    .srcXincrement   = 0,
+    .dstXincrement   = 1,
+    .xCount          = 1u,
+    .srcYincrement   = 0,
+    .dstYincrement   = 0,
+    .yCount          = 1u,
+    .nextDescriptor  = NULL
+};
+
+/* Local functions */
+static void SetupDma(const fram_async_req_t *req, bool rx);
+static void StartNext(void);
+static void Complete(bool success);
+static void FramDmaInterrupt(void);
+
+/*******************************************************************************
+* Function Name: SetupDma
+****************************************************************************//**
+*
+* This function prepares the DMA channel to move the data phase of a request 
+* between the SMIF data FIFO and the request buffer. The channel is enabled but 
+* starts only on the software trigger.
+*
+* \param req
+* The request in progress.
+*
+* \param rx
+* true to read from the RX FIFO, false to write to the TX FIFO.
+*
+*******************************************************************************/
+static void SetupDma(const fram_async_req_t *req, bool rx)
+{
+    void *fifo = rx ? (void *)&smifBase->RX_DATA_FIFO_RD1 : (void *)&smifBase->TX_DATA_FIFO_WR1;
+    uint32_t rows = req->size / DMA_X_COUNT_MAX;
+    uint32_t rest = req->size % DMA_X_COUNT_MAX;
+    uint32_t idx = 0u;
+    
+    /* The FIFO side is a register and does not increment */
+    dmaDescriptorConfig.srcTransferSize = rx ? CY_DMA_TRANSFER_SIZE_WORD : CY_DMA_TRANSFER_SIZE_DATA;
+    dmaDescriptorConfig.dstTransferSize = rx ? CY_DMA_TRANSFER_SIZE_DATA : CY_DMA_TRANSFER_SIZE_WORD;
+    dmaDescriptorConfig.srcXincrement = rx ? 0 : 1;
+    dmaDescriptorConfig.dstXincrement = rx ? 1 : 0;
+    dmaDescriptorConfig.srcYincrement = rx ? 0 : (int32_t)DMA_X_COUNT_MAX;
+    dmaDescriptorConfig.dstYincrement = rx ? (int32_t)DMA_X_COUNT_MAX : 0;
+    
+    if (rows != 0u)
+    {
+        dmaDescriptorConfig.descriptorType = CY_DMA_2D_TRANSFER;
+        dmaDescriptorConfig.srcAddress = rx ? fifo : (void *)req->buffer;
+        dmaDescriptorConfig.dstAddress = rx ? (void *)req->buffer : fifo;
+        dmaDescriptorConfig.xCount = DMA_X_COUNT_MAX;
+        dmaDescriptorConfig.yCount = rows;
+        dmaDescriptorConfig.channelState = (rest != 0u) ? CY_DMA_CHANNEL_ENABLED : CY_DMA_CHANNEL_DISABLED;
+        dmaDescriptorConfig.nextDescriptor = (rest != 0u) ? &dmaDescriptors[1u] : NULL;
+        (void)Cy_DMA_Descriptor_Init(&dmaDescriptors[0u], &dmaDescriptorConfig);
+        idx = 1u;
+    }
+    
+    if (rest != 0u)
+    {
+        dmaDescriptorConfig.descriptorType = CY_DMA_1D_TRANSFER;
+        dmaDescriptorConfig.srcAddress = rx ? fifo : (void *)&req->buffer[rows * DMA_X_COUNT_MAX];
+        dmaDescriptorConfig.dstAddress = rx ? (void *)&req->buffer[rows * DMA_X_COUNT_MAX] : fifo;
+        dmaDescriptorConfig.xCount = rest;
+        dmaDescriptorConfig.yCount = 1u;
+        dmaDescriptorConfig.channelState = CY_DMA_CHANNEL_DISABLED;
+        dmaDescriptorConfig.nextDescriptor = NULL;
+        (void)Cy_DMA_Descriptor_Init(&dmaDescriptors[idx], &dmaDescriptorConfig);
+    }
+    
+    Cy_DMA_Channel_SetDescriptor(FRAM_DMA_HW, FRAM_DMA_CHANNEL, &dmaDescriptors[0u]);
+    Cy_DMA_Channel_Enable(FRAM_DMA_HW, FRAM_DMA_CHANNEL);
+}
+
+/*******************************************************************************
+* Function Name: StartNext
+****************************************************************************//**
+*
+* This function starts the request at the head of the queue if the F-RAM is 
+* idle. The SMIF is given the command, address and the size of the data phase 
+* without a buffer, so the driver leaves the FIFO to the DMA. Commands without 
+* a data phase are completed at once and the next request is started.
+* Must be called with the interrupts disabled or from the DMA interrupt.
+*
+*******************************************************************************/
+static void StartNext(void)
+{
+    fram_async_req_t *req;
+    const fram_cmd_t *cmd;
+    uint8_t *address;
+    
+    while ((queueCount != 0u) && (!queueBusy))
+    {
+        req = &queue[queueHead];
+        cmd = FRAM_GetCommand(req->cmdId);
+        address = (cmd->addrSize != 0u) ? req->address : NULL;
+        
+        if ((cmd->dataPhase == FRAM_DATA_RX) || (cmd->dataPhase == FRAM_DATA_TX))
+        {
+            queueBusy = true;
+            SetupDma(req, (cmd->dataPhase == FRAM_DATA_RX));
+            if (FRAM_StartCommand(smifBase, smifCtx, req->cmdId, req->spimode, address, 
+                                  NULL, req->size, req->latency, NULL))
+            {
+                /* 
+                * Trigger the DMA only after the command is queued: the DMA access 
+                * to the FIFO stalls the SMIF slave port until the data is there. 
+                */
+                (void)Cy_TrigMux_SwTrigger((uint32_t)TRIG0_OUT_CPUSS_DW0_TR_IN0 + FRAM_DMA_CHANNEL, CY_TRIGGER_TWO_CYCLES);
+            }
+            else
+            {
+                /* Refused by the power manager, nothing was sent */
+                Cy_DMA_Channel_Disable(FRAM_DMA_HW, FRAM_DMA_CHANNEL);
+                Complete(false);
+            }
+        }
+        else
+        {
+            Complete(FRAM_Command(smifBase, smifCtx, req->cmdId, req->spimode, address, 
+                                  req->buffer, req->size, req->latency));
+        }
+    }
+}
+
+/*******************************************************************************
+* Function Name: Complete
+****************************************************************************//**
+*
+* This function removes the request in progress from the queue and calls its 
+* callback.
+*
+* \param success
+* false if the data phase failed.
+*
+*******************************************************************************/
+static void Complete(bool success)
+{
+    fram_async_req_t req = queue[queueHead];
+    
+    /* Free the slot first, so the callback can submit the next request */
+    queueHead = (queueHead + 1u) % FRAM_ASYNC_QUEUE_SIZE;
+    queueCount--;
+    queueBusy = false;
+    
+    if (req.callback != NULL)
+    {
+        req.callback(req.buffer, req.size, success, req.arg);
+    }
+}
+
+/*******************************************************************************
+* Function Name: FramDmaInterrupt
+****************************************************************************//**
+*
+* The DMA completion interrupt. Completes the request in progress and starts 
+* the next one. A DMA error fails the request and aborts its SMIF transfer.
+*
+*******************************************************************************/
+static void FramDmaInterrupt(void)
+{
+    Cy_DMA_Channel_ClearInterrupt(FRAM_DMA_HW, FRAM_DMA_CHANNEL);
+    
+    if (Cy_DMA_Channel_GetStatus(FRAM_DMA_HW, FRAM_DMA_CHANNEL) != CY_DMA_INTR_CAUSE_COMPLETION)
+    {
+        /* 
+        * The SMIF waits for data the DMA will not move, so it never gets idle. 
+        * Abort the transfer by a restart of the block, which empties the FIFOs.
+        */
+        Cy_DMA_Channel_Disable(FRAM_DMA_HW, FRAM_DMA_CHANNEL);
+        Cy_SMIF_Disable(smifBase);
+        Cy_SMIF_Enable(smifBase, smifCtx);
+        Complete(false);
+    }
+    else
+    {
+        /* The last bytes of a write can still be in the TX FIFO, a few SCK cycles */
+        while(Cy_SMIF_BusyCheck(smifBase))
+        {
+            /* Wait until the SMIF IP operation is completed. */
+        }
+        Complete(true);
+    }
+    
+    StartNext();
+}
+
+/*******************************************************************************
+* Function Name: FRAM_AsyncInit
+****************************************************************************//**
+*
+* This function sets up the DMA channel and its completion interrupt and 
+* empties the queue. The SMIF must be initialized and enabled. It must insert 
+* wait states on a read from an empty RX FIFO or a write to a full TX FIFO 
+* (blockEvent = CY_SMIF_WAIT_STATES), so the DMA follows the F-RAM clock.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+*******************************************************************************/
+void FRAM_AsyncInit(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext)
+{
+    cy_stc_dma_channel_config_t channelConfig;
+    cy_stc_sysint_t dmaIntConfig =
+    {
+        .intrSrc = (IRQn_Type)((uint32_t)cpuss_interrupts_dw0_0_IRQn + FRAM_DMA_CHANNEL),
+        .intrPriority = FRAM_DMA_INT_PRIORITY
+    };
+    
+    /* A bus error instead of wait states fails the DMA on every FIFO access it is early for */
+    CY_ASSERT(_FLD2VAL(SMIF_CTL_BLOCK, baseaddr->CTL) == (uint32_t)CY_SMIF_WAIT_STATES);
+    
+    smifBase = baseaddr;
+    smifCtx = smifContext;
+    queueHead = 0u;
+    queueCount = 0u;
+    queueBusy = false;
+    
+    channelConfig.descriptor  = &dmaDescriptors[0u];
+    channelConfig.preemptable = true;
+    channelConfig.priority    = FRAM_DMA_PRIORITY;
+    channelConfig.enable      = false;
+    (void)Cy_DMA_Descriptor_Init(&dmaDescriptors[0u], &dmaDescriptorConfig);
+    (void)Cy_DMA_Channel_Init(FRAM_DMA_HW, FRAM_DMA_CHANNEL, &channelConfig);
+    Cy_DMA_Channel_SetInterruptMask(FRAM_DMA_HW, FRAM_DMA_CHANNEL, CY_DMA_INTR_MASK);
+    Cy_DMA_Enable(FRAM_DMA_HW);
+    
+    Cy_SysInt_Init(&dmaIntConfig, FramDmaInterrupt);
+    NVIC_EnableIRQ(dmaIntConfig.intrSrc);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_AsyncSubmit
+****************************************************************************//**
+*
+* This function queues any command of the command table and returns at once. 
+* The buffer must stay valid until the callback is called. The WriteCmd* 
+* functions must not be used while requests are pending.
+*
+* \param cmdId
+* The command to send.
+*
+* \param spimode
+* Determines SMIF width single,dual,or quad.
+*
+* \param address 
+* The F-RAM address. Ignored by the commands without an address.
+*
+* \param buffer
+* The data to write or the buffer for the read data.
+*
+* \param size
+* The size of data, 1 to FRAM_ASYNC_MAX_SIZE for the commands with a data phase.
+*
+* \param latency
+* Memory or register latency cycles for the read commands.
+*
+* \param callback
+* Called from the DMA interrupt when the request is completed. Can be NULL.
+*
+* \param arg
+* Passed to the callback.
+*
+* \return
+* false if the queue is full or the request is not valid. With the power 
+* manager, also false if the F-RAM is in the low power mode and this is called 
+* from an interrupt or a critical section: submit again after FRAM_PowerPoll().
+*
+*******************************************************************************/
+bool FRAM_AsyncSubmit(fram_cmd_id_t cmdId,
+                      uint8_t spimode,
+                      uint32_t address,
+                      uint8_t buffer[],
+                      uint32_t size,
+                      uint8_t latency,
+                      fram_async_cb_t callback,
+                      void *arg)
+{
+    fram_async_req_t *req;
+    uint8_t dataPhase;
+    uint32_t interruptState;
+    bool result = false;
+    
+    if (cmdId >= FRAM_CMD_COUNT)
+    {
+        return false;
+    }
+    
+    dataPhase = FRAM_GetCommand(cmdId)->dataPhase;
+    if (((dataPhase == FRAM_DATA_RX) || (dataPhase == FRAM_DATA_TX)) && 
+        ((size == 0u) || (size > FRAM_ASYNC_MAX_SIZE) || (buffer == NULL)))
+    {
+        return false;
+    }
+    
+#if (FRAM_POWER_MANAGER != 0u)
+    /* The wake-up waits the exit time, which StartNext() must not */
+    if (!FRAM_PowerWake())
+    {
+        return false;
+    }
+#endif /* (FRAM_POWER_MANAGER != 0u) */
+    
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    
+    if (queueCount < FRAM_ASYNC_QUEUE_SIZE)
+    {
+        req = &queue[(queueHead + queueCount) % FRAM_ASYNC_QUEUE_SIZE];
+        req->cmdId = cmdId;
+        req->spimode = spimode;
+        req->latency = latency;
+        req->address[0u] = (uint8_t)(address >> 16u);
+        req->address[1u] = (uint8_t)(address >> 8u);
+        req->address[2u] = (uint8_t)address;
+        req->address[3u] = 0x00u;               /* Mode byte, non XIP */
+        req->buffer = buffer;
+        req->size = size;
+        req->callback = callback;
+        req->arg = arg;
+        queueCount++;
+        
+        StartNext();
+        result = true;
+    }
+    
+    Cy_SysLib_ExitCriticalSection(interruptState);
+    
+    return result;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_AsyncRead
+****************************************************************************//**
+*
+* This function queues a memory read. QIOR is used in SPI mode, READ in DPI 
+* and QPI modes.
+*
+* \param spimode
+* Determines SMIF width single,dual,or quad.
+*
+* \param address 
+* The address to read data from.
+*
+* \param buffer
+* The buffer for read data.
+*
+* \param size
+* The size of data to read.
+*
+* \param latency
+* Memory latency cycle during read.
+*
+* \param callback
+* Called from the DMA interrupt when the read is completed. Can be NULL.
+*
+* \param arg
+* Passed to the callback.
+*
+* \return
+* false if the queue is full or the request is not valid.
+*
+*******************************************************************************/
+bool FRAM_AsyncRead(uint8_t spimode,
+                    uint32_t address,
+                    uint8_t buffer[],
+                    uint32_t size,
+                    uint8_t latency,
+                    fram_async_cb_t callback,
+                    void *arg)
+{
+    fram_cmd_id_t cmdId = (spimode == SPI_MODE) ? FRAM_CMD_QIOR : FRAM_CMD_READ;
+    
+    return (FRAM_AsyncSubmit(cmdId, spimode, address, buffer, size, latency, callback, arg));
+}
+
+/*******************************************************************************
+* Function Name: FRAM_AsyncWrite
+****************************************************************************//**
+*
+* This function queues a memory write. QIOW is used in SPI mode, WRITE in DPI 
+* and QPI modes.
+*
+* \param spimode
+* Determines SMIF width single,dual,or quad.
+*
+* \param address 
+* The address to write data to.
+*
+* \param buffer
+* Data to write in the external memory.
+*
+* \param size
+* The size of data.
+*
+* \param callback
+* Called from the DMA interrupt when the write is completed. Can be NULL.
+*
+* \param arg
+* Passed to the callback.
+*
+* \return
+* false if the queue is full or the request is not valid.
+*
+*******************************************************************************/
+bool FRAM_AsyncWrite(uint8_t spimode,
+                     uint32_t address,
+                     uint8_t buffer[],
+                     uint32_t size,
+                     fram_async_cb_t callback,
+                     void *arg)
+{
+    fram_cmd_id_t cmdId = (spimode == SPI_MODE) ? FRAM_CMD_QIOW : FRAM_CMD_WRITE;
+    
+    return (FRAM_AsyncSubmit(cmdId, spimode, address, buffer, size, 0u, callback, arg));
+}
+
+/*******************************************************************************
+* Function Name: FRAM_AsyncPending
+****************************************************************************//**
+*
+* This function returns the number of requests which are not completed.
+*
+*******************************************************************************/
+uint32_t FRAM_AsyncPending(void)
+{
+    return (queueCount);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_AsyncWait
+****************************************************************************//**
+*
+* This function waits until all queued requests are completed.
+*
+*******************************************************************************/
+void FRAM_AsyncWait(void)
+{
+    while (queueCount != 0u)
+    {
+        /* Wait until the DMA interrupt completes the queue */
+    }
+}
+
+/* [] END OF FILE */
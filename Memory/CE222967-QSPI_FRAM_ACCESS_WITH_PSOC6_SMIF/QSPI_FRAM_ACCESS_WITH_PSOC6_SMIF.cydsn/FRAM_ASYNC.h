@@ -0,0 +1,107 @@
+/****************************************************************************
+*File Name: FRAM_ASYNC.h
+*
+* Version: 1.0
+*
+* Description: 
+* This file contains the queued, non-blocking F-RAM access API. The data 
+* phase of each request is moved by a DataWire channel.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#ifndef FRAM_ASYNC_H
+#define FRAM_ASYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FRAM_ACCESS.h"
+
+/***************************************
+*       Asynchronous access constants
+***************************************/
+#define FRAM_ASYNC_QUEUE_SIZE     (8u)      /* Number of requests which can be queued */
+#define FRAM_ASYNC_MAX_SIZE       (0x10000u)/* Largest transfer of one request (256 x 256 DMA elements) */
+
+/* DataWire channel moving the data between the SMIF FIFO and SRAM */
+#define FRAM_DMA_HW               (DW0)     /* DataWire block */
+#define FRAM_DMA_CHANNEL          (14u)     /* Channel of the block, must not be used elsewhere */
+#define FRAM_DMA_PRIORITY         (3u)      /* Lowest channel priority */
+#define FRAM_DMA_INT_PRIORITY     (2u)      /* DMA completion interrupt priority, below the SMIF */
+
+/* 
+* Called from the DMA interrupt when a request is completed. 
+* success is false if the DMA reported an error.
+*/
+typedef void (*fram_async_cb_t)(uint8_t buffer[], uint32_t size, bool success, void *arg);
+
+/***************************************/
+/*QSPI F-RAM asynchronous access       */
+/***************************************/
+
+void FRAM_AsyncInit(SMIF_Type *baseaddr,                /* Set up the DMA channel and its interrupt */
+                    cy_stc_smif_context_t *smifContext);
+
+bool FRAM_AsyncSubmit(fram_cmd_id_t cmdId,              /* Queue any command of the command table */
+                      uint8_t spimode,
+                      uint32_t address,
+                      uint8_t buffer[],
+                      uint32_t size,
+                      uint8_t latency,
+                      fram_async_cb_t callback,
+                      void *arg);
+
+bool FRAM_AsyncRead(uint8_t spimode,                    /* Queue a memory read, QIOR in SPI mode */
+                    uint32_t address,
+                    uint8_t buffer[],
+                    uint32_t size,
+                    uint8_t latency,
+                    fram_async_cb_t callback,
+                    void *arg);
+
+bool FRAM_AsyncWrite(uint8_t spimode,                   /* Queue a memory write, QIOW in SPI mode */
+                     uint32_t address,
+                     uint8_t buffer[],
+                     uint32_t size,
+                     fram_async_cb_t callback,
+                     void *arg);
+
+uint32_t FRAM_AsyncPending(void);                       /* Number of requests not yet completed */
+
+void FRAM_AsyncWait(void);                              /* Wait until all requests are completed */
+
+#endif /* FRAM_ASYNC_H */
+
+/* [] END OF FILE */
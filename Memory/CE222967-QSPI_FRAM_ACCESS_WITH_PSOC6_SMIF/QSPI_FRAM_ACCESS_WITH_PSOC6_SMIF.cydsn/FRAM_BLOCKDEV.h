@@ -0,0 +1,68 @@
+/****************************************************************************
+*File Name: FRAM_BLOCKDEV.h
+*
+* Version: 1.0
+*
+* Description: 
+* This file contains the API of the QSPI F-RAM block device driver.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#ifndef FRAM_BLOCKDEV_H
+#define FRAM_BLOCKDEV_H
+
+#include <stdint.h>
+#include "FRAM_ACCESS.h"
+#include "blockdev.h"
+
+/***************************************
+*       Block device constants
+***************************************/
+#define FRAM_BLOCKDEV_SIZE          (0x80000u)  /* CY15x104QSN, 4 Mbit */
+#define FRAM_BLOCKDEV_MAX_TRANSFER  (0x10000u)  /* Largest data phase of one SMIF command */
+
+/***************************************/
+/*QSPI F-RAM block device              */
+/***************************************/
+
+const blockdev_t *FRAM_BlockDevInit(SMIF_Type *baseaddr,    /* Block device of the QSPI F-RAM */
+                                    cy_stc_smif_context_t *smifContext,
+                                    uint8_t spimode,
+                                    uint8_t latency);
+
+#endif /* FRAM_BLOCKDEV_H */
+
+/* [] END OF FILE */
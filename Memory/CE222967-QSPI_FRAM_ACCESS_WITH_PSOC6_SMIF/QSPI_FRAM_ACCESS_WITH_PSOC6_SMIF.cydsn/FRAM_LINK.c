@@ -0,0 +1,327 @@
+/****************************************************************************
+*File Name: FRAM_LINK.c
+*
+* Version: 1.0
+*
+* Description: 
+* This file selects the widest access mode and the lowest memory and register 
+* latencies the QSPI F-RAM supports at the actual SMIF clock.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#include "FRAM_LINK.h"
+#include "project.h"
+
+/* Known QSPI F-RAM parts */
+typedef struct
+{
+    uint8_t id[4u];                         /* First bytes of the 8-byte device ID */
+    uint8_t maxMode;                        /* Widest access mode */
+} fram_part_t;
+
+static const fram_part_t framParts[] =
+{
+    {{0x50u, 0x51u, 0x82u, 0x06u}, QPI_MODE}    /* CY15x104QSN */
+};
+
+/* CR2 value for each access mode (SPI_MODE, DPI_MODE, QPI_MODE) */
+static const uint8_t framModeCr2[] = {0x00u, FRAM_CR2_DPI, FRAM_CR2_QPI};
+
+static SMIF_Type *linkBase;
+static cy_stc_smif_context_t *linkContext;
+
+/* Test area and its content before the negotiation */
+static uint8_t testAddress[ADDRESS_SIZE] = 
+{
+    (uint8_t)(FRAM_LINK_TEST_ADDR >> 16u), (uint8_t)(FRAM_LINK_TEST_ADDR >> 8u), (uint8_t)FRAM_LINK_TEST_ADDR
+};
+static uint8_t testSaved[FRAM_LINK_TEST_SIZE];
+
+/* Local functions */
+static uint8_t LatencyCycles(uint32_t sckHz, uint32_t accessNs, uint8_t maxCycles);
+static void WriteConfig(uint8_t spimode, uint8_t newMode, uint8_t mlc, uint8_t rlc);
+static const fram_part_t *ReadPart(uint8_t spimode, uint8_t rlc);
+static bool VerifyMemory(uint8_t spimode, uint8_t mlc);
+
+/*******************************************************************************
+* Function Name: LatencyCycles
+****************************************************************************//**
+*
+* This function returns the SCK cycles covering an access time.
+*
+*******************************************************************************/
+static uint8_t LatencyCycles(uint32_t sckHz, uint32_t accessNs, uint8_t maxCycles)
+{
+    uint32_t cycles = (uint32_t)((((uint64_t)sckHz * accessNs) + 999999999u) / 1000000000u);
+    
+    return ((cycles < maxCycles) ? (uint8_t)cycles : maxCycles);
+}
+
+/*******************************************************************************
+* Function Name: WriteConfig
+****************************************************************************//**
+*
+* This function writes SR1, CR1, CR2, CR4 and CR5 with one WRSR command.
+*
+* \param spimode
+* The access mode the F-RAM is in.
+*
+* \param newMode
+* The access mode to set in CR2.
+*
+* \param mlc
+* The memory latency code for CR1.
+*
+* \param rlc
+* The register latency code for CR5.
+*
+*******************************************************************************/
+static void WriteConfig(uint8_t spimode, uint8_t newMode, uint8_t mlc, uint8_t rlc)
+{
+    uint8_t regs[5u] = {0x00u, (uint8_t)((mlc << 4u) | 0x02u), framModeCr2[newMode], 0x08u, (uint8_t)(rlc << 6u)}; /*{ SR1, CR1, CR2, CR4, CR5 }*/
+    
+    WriteCmdWRSR(linkBase, linkContext, regs, sizeof(regs), spimode);
+}
+
+/*******************************************************************************
+* Function Name: ReadPart
+****************************************************************************//**
+*
+* This function reads the device ID and looks it up in the known parts.
+*
+* \return
+* The part or NULL if the ID is not known or not read correctly.
+*
+*******************************************************************************/
+static const fram_part_t *ReadPart(uint8_t spimode, uint8_t rlc)
+{
+    uint8_t id[DID_REG_SIZE];
+    uint32_t idx;
+    
+    WriteCmdRDID(linkBase, linkContext, id, spimode, rlc);
+    
+    for (idx = 0u; idx < (sizeof(framParts) / sizeof(framParts[0u])); idx++)
+    {
+        if ((id[0u] == framParts[idx].id[0u]) && (id[1u] == framParts[idx].id[1u]) &&
+            (id[2u] == framParts[idx].id[2u]) && (id[3u] == framParts[idx].id[3u]))
+        {
+            return (&framParts[idx]);
+        }
+    }
+    
+    return (NULL);
+}
+
+/*******************************************************************************
+* Function Name: VerifyMemory
+****************************************************************************//**
+*
+* This function writes a pattern and its complement to the scratch area and 
+* reads them back.
+*
+* \return
+* true if both patterns are read back.
+*
+*******************************************************************************/
+static bool VerifyMemory(uint8_t spimode, uint8_t mlc)
+{
+    uint8_t pattern[FRAM_LINK_TEST_SIZE];
+    uint8_t readback[FRAM_LINK_TEST_SIZE];
+    uint32_t pass;
+    uint32_t idx;
+    
+    for (pass = 0u; pass < 2u; pass++)
+    {
+        for (idx = 0u; idx < FRAM_LINK_TEST_SIZE; idx++)
+        {
+            pattern[idx] = (pass == 0u) ? (uint8_t)idx : (uint8_t)~idx;
+            readback[idx] = (uint8_t)~pattern[idx];
+        }
+        
+        WriteCmdSPIWrite(linkBase, linkContext, pattern, FRAM_LINK_TEST_SIZE, testAddress, spimode);
+        WriteCmdSPIRead(linkBase, linkContext, readback, FRAM_LINK_TEST_SIZE, testAddress, spimode, mlc);
+        
+        for (idx = 0u; idx < FRAM_LINK_TEST_SIZE; idx++)
+        {
+            if (readback[idx] != pattern[idx])
+            {
+                return false;
+            }
+        }
+    }
+    
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_Negotiate
+****************************************************************************//**
+*
+* This function brings the F-RAM from any state into the fastest safe setting 
+* for the SCK frequency:
+* - SPI mode, the minimal register latency for sckHz and the largest memory 
+*   latency are written in every mode. The content of the test area is saved.
+* - The device ID is read, the register latency is raised until it matches 
+*   a known part. The part gives the widest access mode.
+* - The widest mode is selected and a test pattern is written and read back 
+*   at FRAM_LINK_TEST_ADDR. The memory latency is raised until it passes, 
+*   then the next narrower mode is tried.
+* - The saved content of the test area is written back.
+* The F-RAM is left in the negotiated mode.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param sckHz
+* The SPI clock frequency.
+*
+* \param link
+* The negotiated mode and latencies, to use with all following commands.
+*
+* \return
+* false if the part is not known or not even SPI mode passed the test; the 
+* F-RAM is then left in SPI mode with the largest latencies.
+*
+*******************************************************************************/
+bool FRAM_Negotiate(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, uint32_t sckHz, fram_link_t *link)
+{
+    const fram_part_t *part = NULL;
+    uint8_t startMlc = LatencyCycles(sckHz, FRAM_MEM_ACCESS_NS, FRAM_MLC_MAX);
+    uint8_t rlc = LatencyCycles(sckHz, FRAM_REG_ACCESS_NS, FRAM_RLC_MAX);
+    uint8_t mlc = startMlc;
+    uint8_t mode;
+    uint8_t current = SPI_MODE;
+    
+    linkBase = baseaddr;
+    linkContext = smifContext;
+    
+    /* The mode after reset is not known: the command is only accepted in the right one */
+    for (mode = SPI_MODE; mode <= QPI_MODE; mode++)
+    {
+        WriteConfig(mode, SPI_MODE, FRAM_MLC_MAX, rlc);
+    }
+    
+    /* Read with the largest latency, which is right at any SCK */
+    WriteCmdSPIRead(linkBase, linkContext, testSaved, FRAM_LINK_TEST_SIZE, testAddress, SPI_MODE, FRAM_MLC_MAX);
+    
+    part = ReadPart(SPI_MODE, rlc);
+    while ((part == NULL) && (rlc < FRAM_RLC_MAX))
+    {
+        rlc++;
+        WriteConfig(SPI_MODE, SPI_MODE, mlc, rlc);
+        part = ReadPart(SPI_MODE, rlc);
+    }
+    
+    if (part != NULL)
+    {
+        mode = part->maxMode;
+        for (;;)
+        {
+            WriteConfig(current, mode, mlc, rlc);
+            current = mode;
+            
+            while (mlc <= FRAM_MLC_MAX)
+            {
+                if (VerifyMemory(mode, mlc) && (ReadPart(mode, rlc) == part))
+                {
+                    WriteCmdSPIWrite(linkBase, linkContext, testSaved, FRAM_LINK_TEST_SIZE, testAddress, mode);
+                    link->spimode = mode;
+                    link->memLatency = mlc;
+                    link->regLatency = rlc;
+                    return true;
+                }
+                
+                mlc++;
+                if (mlc <= FRAM_MLC_MAX)
+                {
+                    WriteConfig(mode, mode, mlc, rlc);
+                }
+            }
+            
+            if (mode == SPI_MODE)
+            {
+                break;
+            }
+            mode--;
+            mlc = startMlc;
+        }
+    }
+    
+    /* Fall back to the slowest setting */
+    WriteConfig(current, SPI_MODE, FRAM_MLC_MAX, FRAM_RLC_MAX);
+    if (part != NULL)
+    {
+        WriteCmdSPIWrite(linkBase, linkContext, testSaved, FRAM_LINK_TEST_SIZE, testAddress, SPI_MODE);
+    }
+    link->spimode = SPI_MODE;
+    link->memLatency = FRAM_MLC_MAX;
+    link->regLatency = FRAM_RLC_MAX;
+    
+    return false;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_LinkApply
+****************************************************************************//**
+*
+* This function writes the negotiated access mode and latencies to the F-RAM, 
+* for example after the registers were reset by the application.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param spimode
+* The access mode the F-RAM is in.
+*
+* \param link
+* The result of FRAM_Negotiate().
+*
+*******************************************************************************/
+void FRAM_LinkApply(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, uint8_t spimode, const fram_link_t *link)
+{
+    linkBase = baseaddr;
+    linkContext = smifContext;
+    
+    WriteConfig(spimode, link->spimode, link->memLatency, link->regLatency);
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,100 @@
+/****************************************************************************
+*File Name: FRAM_LINK.h
+*
+* Version: 1.0
+*
+* Description: 
+* This file contains the API of the QSPI F-RAM access mode and latency 
+* negotiation.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#ifndef FRAM_LINK_H
+#define FRAM_LINK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FRAM_ACCESS.h"
+
+/***************************************
+* Conditional Compilation Parameters
+***************************************/
+#define FRAM_LINK_NEGOTIATE       (0u)      /* Set to 1 to negotiate the mode, MLC and RLC at start-up */
+
+/***************************************
+*       Link negotiation constants
+***************************************/
+#define FRAM_SMIF_CLK_HF          (2u)      /* The SMIF is clocked from HFClk2, SCK is half of it */
+
+/* Access times behind the latency codes, MLC = 8 and RLC = 3 at 100 MHz */
+#define FRAM_MEM_ACCESS_NS        (80u)     /* Memory read latency */
+#define FRAM_REG_ACCESS_NS        (30u)     /* Register read latency */
+#define FRAM_MLC_MAX              (15u)     /* Largest memory latency code (CR1[7:4]) */
+#define FRAM_RLC_MAX              (3u)      /* Largest register latency code (CR5[7:6]) */
+
+/* CR2 access mode bits */
+#define FRAM_CR2_DPI              (0x10u)   /* DPI mode enable */
+#define FRAM_CR2_QPI              (0x40u)   /* QPI mode enable */
+
+/* Area the test pattern is written to, its content is restored after the negotiation */
+#define FRAM_LINK_TEST_ADDR       (0x3FF00u)
+#define FRAM_LINK_TEST_SIZE       (PACKET_SIZE)
+
+/* Negotiated access settings */
+typedef struct
+{
+    uint8_t spimode;                        /* SPI_MODE, DPI_MODE or QPI_MODE */
+    uint8_t memLatency;                     /* Memory latency cycles (MLC) */
+    uint8_t regLatency;                     /* Register latency cycles (RLC) */
+} fram_link_t;
+
+/***************************************/
+/*QSPI F-RAM link negotiation          */
+/***************************************/
+
+bool FRAM_Negotiate(SMIF_Type *baseaddr,                /* Select the widest mode and lowest latencies */
+                    cy_stc_smif_context_t *smifContext,
+                    uint32_t sckHz,
+                    fram_link_t *link);
+
+void FRAM_LinkApply(SMIF_Type *baseaddr,                /* Switch to the negotiated mode and latencies */
+                    cy_stc_smif_context_t *smifContext,
+                    uint8_t spimode,
+                    const fram_link_t *link);
+
+#endif /* FRAM_LINK_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,454 @@
+/****************************************************************************
+*File Name: FRAM_LOG.c
+*
+* Version: 1.0
+*
+* Description: 
+* This file contains a persistent ring log of fixed-size records on the 
+* QSPI F-RAM. Records are batched into quad bursts and committed by writing 
+* one of two header copies, so a power failure never leaves a torn log.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#include "FRAM_LOG.h"
+#include "project.h"
+#include <string.h>
+
+/* Log header, two copies are written alternately */
+typedef struct
+{
+    uint32_t sequence;                      /* Incremented on every commit */
+    uint32_t head;                          /* Index of the next record to write */
+    uint32_t count;                         /* Number of committed records */
+    uint32_t check;                         /* sequence ^ head ^ count ^ FRAM_LOG_MAGIC */
+} fram_log_hdr_t;
+
+/* F-RAM address of the header copy for a sequence number */
+#define HDR_ADDRESS(seq)          (FRAM_LOG_BASE + (((seq) & 1u) * sizeof(fram_log_hdr_t)))
+
+/* F-RAM address of a record */
+#define RECORD_ADDRESS(index)     (FRAM_LOG_BASE + FRAM_LOG_HDR_SIZE + ((index) * FRAM_LOG_RECORD_SIZE))
+
+static SMIF_Type *logBase;
+static cy_stc_smif_context_t *logContext;
+static uint8_t logLatency;
+
+/* Last committed header */
+static fram_log_hdr_t logHdr;
+
+/* Records waiting for the next burst */
+static uint8_t batch[FRAM_LOG_BATCH_RECORDS * FRAM_LOG_RECORD_SIZE];
+static uint32_t batchCount = 0u;
+
+/* Local functions */
+static void SetAddress(uint8_t address[], uint32_t addr);
+static void WriteRecords(uint32_t index, uint8_t data[], uint32_t count);
+static void ReadRecords(uint32_t index, uint8_t data[], uint32_t count);
+static void Commit(uint32_t head, uint32_t count);
+static bool HeaderValid(const fram_log_hdr_t *hdr);
+
+/*******************************************************************************
+* Function Name: SetAddress
+****************************************************************************//**
+*
+* This function converts an F-RAM address into the address bytes of a quad 
+* command, MSB first, followed by the mode byte.
+*
+*******************************************************************************/
+static void SetAddress(uint8_t address[], uint32_t addr)
+{
+    address[0u] = (uint8_t)(addr >> 16u);
+    address[1u] = (uint8_t)(addr >> 8u);
+    address[2u] = (uint8_t)addr;
+    address[3u] = 0x00u;                    /* Mode byte, non XIP */
+}
+
+/*******************************************************************************
+* Function Name: WriteRecords
+****************************************************************************//**
+*
+* This function writes consecutive records in quad input bursts. The write is 
+* split in two bursts when it wraps at the end of the log.
+*
+* \param index
+* The index of the first record.
+*
+* \param data
+* The records to write.
+*
+* \param count
+* The number of records.
+*
+*******************************************************************************/
+static void WriteRecords(uint32_t index, uint8_t data[], uint32_t count)
+{
+    uint8_t address[ADDRESS_PLUS_MODE_SIZE];
+    uint32_t part;
+    
+    while (count != 0u)
+    {
+        part = FRAM_LOG_CAPACITY - index;
+        part = (part < count) ? part : count;
+        
+        SetAddress(address, RECORD_ADDRESS(index));
+        WriteCmdSPIWrite_DIW_QIW(logBase, logContext, data, part * FRAM_LOG_RECORD_SIZE, address, MEM_CMD_QIW);
+        
+        data = &data[part * FRAM_LOG_RECORD_SIZE];
+        count -= part;
+        index = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: ReadRecords
+****************************************************************************//**
+*
+* This function reads consecutive records in quad output bursts. The read is 
+* split in two bursts when it wraps at the end of the log.
+*
+* \param index
+* The index of the first record.
+*
+* \param data
+* The buffer for the records.
+*
+* \param count
+* The number of records.
+*
+*******************************************************************************/
+static void ReadRecords(uint32_t index, uint8_t data[], uint32_t count)
+{
+    uint8_t address[ADDRESS_PLUS_MODE_SIZE];
+    uint32_t part;
+    
+    while (count != 0u)
+    {
+        part = FRAM_LOG_CAPACITY - index;
+        part = (part < count) ? part : count;
+        
+        SetAddress(address, RECORD_ADDRESS(index));
+        WriteCmdSPIRead_DOR_QOR(logBase, logContext, data, part * FRAM_LOG_RECORD_SIZE, address, MEM_CMD_QOR, logLatency);
+        
+        data = &data[part * FRAM_LOG_RECORD_SIZE];
+        count -= part;
+        index = 0u;
+    }
+}
+
+/*******************************************************************************
+* Function Name: HeaderValid
+****************************************************************************//**
+*
+* This function checks a header read from the F-RAM.
+*
+*******************************************************************************/
+static bool HeaderValid(const fram_log_hdr_t *hdr)
+{
+    return ((hdr->check == (hdr->sequence ^ hdr->head ^ hdr->count ^ FRAM_LOG_MAGIC)) &&
+            (hdr->head < FRAM_LOG_CAPACITY) && (hdr->count <= FRAM_LOG_CAPACITY));
+}
+
+/*******************************************************************************
+* Function Name: Commit
+****************************************************************************//**
+*
+* This function writes a new header into the copy not holding the last 
+* committed one. A power loss during the write leaves the previous copy valid.
+*
+* \param head
+* The index of the next record to write.
+*
+* \param count
+* The number of committed records.
+*
+*******************************************************************************/
+static void Commit(uint32_t head, uint32_t count)
+{
+    uint8_t address[ADDRESS_PLUS_MODE_SIZE];
+    fram_log_hdr_t hdr;
+    
+    hdr.sequence = logHdr.sequence + 1u;
+    hdr.head = head;
+    hdr.count = count;
+    hdr.check = hdr.sequence ^ hdr.head ^ hdr.count ^ FRAM_LOG_MAGIC;
+    
+    SetAddress(address, HDR_ADDRESS(hdr.sequence));
+    WriteCmdSPIWrite_DIW_QIW(logBase, logContext, (uint8_t *)&hdr, sizeof(hdr), address, MEM_CMD_QIW);
+    
+    logHdr = hdr;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_LogInit
+****************************************************************************//**
+*
+* This function mounts the log from the newest valid header copy. The F-RAM 
+* must be in SPI mode, the log uses the QIW and QOR extended SPI commands.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param latency
+* Memory latency cycle during read.
+*
+* \return
+* true if a log was found, false if a new empty log was created.
+*
+*******************************************************************************/
+bool FRAM_LogInit(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, uint8_t latency)
+{
+    uint8_t address[ADDRESS_PLUS_MODE_SIZE];
+    fram_log_hdr_t hdr[2u];
+    bool valid0;
+    bool valid1;
+    
+    logBase = baseaddr;
+    logContext = smifContext;
+    logLatency = latency;
+    batchCount = 0u;
+    
+    SetAddress(address, FRAM_LOG_BASE);
+    WriteCmdSPIRead_DOR_QOR(logBase, logContext, (uint8_t *)hdr, sizeof(hdr), address, MEM_CMD_QOR, logLatency);
+    
+    valid0 = HeaderValid(&hdr[0u]);
+    valid1 = HeaderValid(&hdr[1u]);
+    
+    if (valid0 && ((!valid1) || ((int32_t)(hdr[0u].sequence - hdr[1u].sequence) > 0)))
+    {
+        logHdr = hdr[0u];
+    }
+    else if (valid1)
+    {
+        logHdr = hdr[1u];
+    }
+    else
+    {
+        logHdr.sequence = 0u;
+        Commit(0u, 0u);
+        return false;
+    }
+    
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_LogClear
+****************************************************************************//**
+*
+* This function drops all committed and batched records.
+*
+*******************************************************************************/
+void FRAM_LogClear(void)
+{
+    batchCount = 0u;
+    Commit(0u, 0u);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_LogAppend
+****************************************************************************//**
+*
+* This function adds one record to the batch. The batch is written in one 
+* burst and committed when it holds FRAM_LOG_BATCH_RECORDS records.
+* Records in the batch are lost on a power failure until FRAM_LogFlush().
+*
+* \param record
+* FRAM_LOG_RECORD_SIZE bytes to append.
+*
+*******************************************************************************/
+void FRAM_LogAppend(const uint8_t record[])
+{
+    (void)memcpy(&batch[batchCount * FRAM_LOG_RECORD_SIZE], record, FRAM_LOG_RECORD_SIZE);
+    batchCount++;
+    
+    if (batchCount == FRAM_LOG_BATCH_RECORDS)
+    {
+        FRAM_LogFlush();
+    }
+}
+
+/*******************************************************************************
+* Function Name: FRAM_LogFlush
+****************************************************************************//**
+*
+* This function writes the batched records after the newest one and commits 
+* them. If the log is full, the oldest records are dropped in a commit before 
+* they are overwritten, so a power loss never exposes partly written records.
+*
+*******************************************************************************/
+void FRAM_LogFlush(void)
+{
+    uint32_t count = logHdr.count;
+    
+    if (batchCount == 0u)
+    {
+        return;
+    }
+    
+    if ((count + batchCount) > FRAM_LOG_CAPACITY)
+    {
+        count = FRAM_LOG_CAPACITY - batchCount;
+        Commit(logHdr.head, count);
+    }
+    
+    WriteRecords(logHdr.head, batch, batchCount);
+    Commit((logHdr.head + batchCount) % FRAM_LOG_CAPACITY, count + batchCount);
+    
+    batchCount = 0u;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_LogCount
+****************************************************************************//**
+*
+* This function returns the number of committed records.
+*
+*******************************************************************************/
+uint32_t FRAM_LogCount(void)
+{
+    return (logHdr.count);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_LogRead
+****************************************************************************//**
+*
+* This function reads committed records in at most two bursts.
+*
+* \param first
+* The record to start from, 0 is the oldest record.
+*
+* \param buffer
+* The buffer for count * FRAM_LOG_RECORD_SIZE bytes.
+*
+* \param count
+* The number of records to read.
+*
+* \return
+* The number of records read.
+*
+*******************************************************************************/
+uint32_t FRAM_LogRead(uint32_t first, uint8_t buffer[], uint32_t count)
+{
+    uint32_t oldest = (logHdr.head + FRAM_LOG_CAPACITY - logHdr.count) % FRAM_LOG_CAPACITY;
+    
+    if (first >= logHdr.count)
+    {
+        return 0u;
+    }
+    if (count > (logHdr.count - first))
+    {
+        count = logHdr.count - first;
+    }
+    
+    ReadRecords((oldest + first) % FRAM_LOG_CAPACITY, buffer, count);
+    
+    return (count);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_LogReadLatest
+****************************************************************************//**
+*
+* This function reads the newest committed records, oldest first.
+*
+* \param buffer
+* The buffer for count * FRAM_LOG_RECORD_SIZE bytes.
+*
+* \param count
+* The number of records to read.
+*
+* \return
+* The number of records read.
+*
+*******************************************************************************/
+uint32_t FRAM_LogReadLatest(uint8_t buffer[], uint32_t count)
+{
+    if (count > logHdr.count)
+    {
+        count = logHdr.count;
+    }
+    
+    return (FRAM_LogRead(logHdr.count - count, buffer, count));
+}
+
+#if (FRAM_LOG_BENCHMARK != 0u)
+/*******************************************************************************
+* Function Name: FRAM_LogBenchmark
+****************************************************************************//**
+*
+* This function appends records back to back and measures the sustained rate, 
+* commits included, with the CPU cycle counter.
+*
+* \param records
+* The number of records to append.
+*
+* \return
+* The append rate in records/s.
+*
+*******************************************************************************/
+uint32_t FRAM_LogBenchmark(uint32_t records)
+{
+    uint8_t record[FRAM_LOG_RECORD_SIZE];
+    uint32_t startCycles;
+    uint32_t cycles;
+    uint32_t idx;
+    
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    for (idx = 0u; idx < FRAM_LOG_RECORD_SIZE; idx++)
+    {
+        record[idx] = (uint8_t)idx;
+    }
+    
+    startCycles = DWT->CYCCNT;
+    for (idx = 0u; idx < records; idx++)
+    {
+        (void)memcpy(record, &idx, sizeof(idx));
+        FRAM_LogAppend(record);
+    }
+    FRAM_LogFlush();
+    cycles = DWT->CYCCNT - startCycles;
+    
+    return ((cycles == 0u) ? 0u : (uint32_t)(((uint64_t)records * SystemCoreClock) / cycles));
+}
+#endif /* (FRAM_LOG_BENCHMARK != 0u) */
+
+/* [] END OF FILE */
@@ -0,0 +1,97 @@
+/****************************************************************************
+*File Name: FRAM_LOG.h
+*
+* Version: 1.0
+*
+* Description: 
+* This file contains the API of the persistent ring log on the QSPI F-RAM.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#ifndef FRAM_LOG_H
+#define FRAM_LOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FRAM_ACCESS.h"
+
+/***************************************
+*   Conditional Compilation Parameters
+***************************************/
+/* Set to non-zero to build FRAM_LogBenchmark() */
+#define FRAM_LOG_BENCHMARK        (0u)
+
+/***************************************
+*       Ring log constants
+***************************************/
+#define FRAM_LOG_BASE             (0x40000u) /* F-RAM address of the log, upper half of the 4-Mbit part */
+#define FRAM_LOG_SIZE             (0x40000u) /* Bytes used by the log, headers included */
+#define FRAM_LOG_HDR_SIZE         (0x100u)   /* Bytes reserved for the two header copies */
+#define FRAM_LOG_RECORD_SIZE      (32u)      /* Size of one log record */
+#define FRAM_LOG_BATCH_RECORDS    (PACKET_SIZE / FRAM_LOG_RECORD_SIZE) /* Records written in one burst */
+#define FRAM_LOG_CAPACITY         ((FRAM_LOG_SIZE - FRAM_LOG_HDR_SIZE) / FRAM_LOG_RECORD_SIZE)
+#define FRAM_LOG_MAGIC            (0x464C4F47u) /* "FLOG", mixed into the header check word */
+
+/***************************************/
+/*QSPI F-RAM ring log                  */
+/***************************************/
+
+bool FRAM_LogInit(SMIF_Type *baseaddr,                  /* Mount the log, false if it was empty or corrupted */
+                  cy_stc_smif_context_t *smifContext,
+                  uint8_t latency);
+
+void FRAM_LogClear(void);                               /* Drop all records */
+
+void FRAM_LogAppend(const uint8_t record[]);            /* Add one record, written when the batch is full */
+
+void FRAM_LogFlush(void);                               /* Write and commit the batched records */
+
+uint32_t FRAM_LogCount(void);                           /* Number of committed records */
+
+uint32_t FRAM_LogRead(uint32_t first,                   /* Read records, first = 0 is the oldest one */
+                      uint8_t buffer[],
+                      uint32_t count);
+
+uint32_t FRAM_LogReadLatest(uint8_t buffer[],           /* Read the newest records, oldest first */
+                            uint32_t count);
+
+#if (FRAM_LOG_BENCHMARK != 0u)
+uint32_t FRAM_LogBenchmark(uint32_t records);           /* Sustained append rate in records/s */
+#endif /* (FRAM_LOG_BENCHMARK != 0u) */
+
+#endif /* FRAM_LOG_H */
+
+/* [] END OF FILE */
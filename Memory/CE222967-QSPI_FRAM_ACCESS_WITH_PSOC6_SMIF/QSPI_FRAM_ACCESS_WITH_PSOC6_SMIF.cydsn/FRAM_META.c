@@ -0,0 +1,268 @@
+/****************************************************************************
+*File Name: FRAM_META.c
+*
+* Version: 1.0
+*
+* Description: 
+* This file keeps small metadata (boot flags, counters, image pointers) in 
+* the 256-byte special sector of the QSPI F-RAM as two CRC-protected record 
+* copies, updated alternately.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#include "FRAM_META.h"
+#include "project.h"
+#include <string.h>
+
+#define FRAM_META_CRC_POLY        (0xEDB88320u)     /* CRC-32, reflected */
+
+static SMIF_Type *metaBase;
+static cy_stc_smif_context_t *metaContext;
+static fram_link_t metaLink;
+
+static fram_meta_record_t metaRecord;       /* Loaded record, changed by FRAM_MetaSet() */
+static uint32_t metaSlot;                   /* Copy holding the loaded record */
+
+/* Local functions */
+static uint32_t RecordCrc(const fram_meta_record_t *record);
+static void SetAddress(uint8_t addrBytes[], uint32_t address);
+
+/*******************************************************************************
+* Function Name: RecordCrc
+****************************************************************************//**
+*
+* This function returns the CRC-32 of the sequence and the metadata words.
+*
+*******************************************************************************/
+static uint32_t RecordCrc(const fram_meta_record_t *record)
+{
+    const uint8_t *data = (const uint8_t *)record;
+    uint32_t crc = 0xFFFFFFFFu;
+    uint32_t idx;
+    uint32_t bit;
+    
+    for (idx = 0u; idx < (FRAM_META_RECORD_SIZE - sizeof(record->crc)); idx++)
+    {
+        crc ^= data[idx];
+        for (bit = 0u; bit < 8u; bit++)
+        {
+            crc = ((crc & 1u) != 0u) ? ((crc >> 1u) ^ FRAM_META_CRC_POLY) : (crc >> 1u);
+        }
+    }
+    
+    return (~crc);
+}
+
+/*******************************************************************************
+* Function Name: SetAddress
+****************************************************************************//**
+*
+* This function converts a special sector address to the bytes sent, MSB first.
+*
+*******************************************************************************/
+static void SetAddress(uint8_t addrBytes[], uint32_t address)
+{
+    addrBytes[0u] = (uint8_t)(address >> 16u);
+    addrBytes[1u] = (uint8_t)(address >> 8u);
+    addrBytes[2u] = (uint8_t)address;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_MetaInit
+****************************************************************************//**
+*
+* This function reads both record copies from the special sector and loads 
+* the valid one with the higher sequence. A copy torn by a reset during the 
+* commit fails its CRC, so the other copy is used.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param link
+* The access mode and latencies the F-RAM is set to.
+*
+* \return
+* false if no copy is valid; the store is then empty (all words 0).
+*
+*******************************************************************************/
+bool FRAM_MetaInit(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, const fram_link_t *link)
+{
+    fram_meta_record_t copy[2u];
+    uint8_t addrBytes[ADDRESS_SIZE];
+    bool valid[2u];
+    uint32_t slot;
+    
+    metaBase = baseaddr;
+    metaContext = smifContext;
+    metaLink = *link;
+    
+    SetAddress(addrBytes, 0u);
+    WriteCmdSSRD(metaBase, metaContext, (uint8_t *)copy, FRAM_META_SECTOR_SIZE, addrBytes, 
+                 metaLink.spimode, metaLink.memLatency);
+    
+    for (slot = 0u; slot < 2u; slot++)
+    {
+        valid[slot] = (copy[slot].crc == RecordCrc(&copy[slot]));
+    }
+    
+    if (valid[0u] && valid[1u])
+    {
+        /* Sequence order, also after the wrap-around */
+        slot = ((int32_t)(copy[1u].sequence - copy[0u].sequence) > 0) ? 1u : 0u;
+    }
+    else if (valid[0u] || valid[1u])
+    {
+        slot = valid[1u] ? 1u : 0u;
+    }
+    else
+    {
+        /* Empty store: the first commit goes to copy 0 */
+        memset(&metaRecord, 0, sizeof(metaRecord));
+        metaSlot = 1u;
+        return false;
+    }
+    
+    metaRecord = copy[slot];
+    metaSlot = slot;
+    
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_MetaGet
+****************************************************************************//**
+*
+* This function returns a word of the loaded record, 0 for an invalid index.
+*
+*******************************************************************************/
+uint32_t FRAM_MetaGet(uint32_t index)
+{
+    return ((index < FRAM_META_WORDS) ? metaRecord.word[index] : 0u);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_MetaSet
+****************************************************************************//**
+*
+* This function changes a word of the loaded record. Several words can be 
+* changed and then written together by FRAM_MetaCommit().
+*
+*******************************************************************************/
+void FRAM_MetaSet(uint32_t index, uint32_t value)
+{
+    if (index < FRAM_META_WORDS)
+    {
+        metaRecord.word[index] = value;
+    }
+}
+
+/*******************************************************************************
+* Function Name: FRAM_MetaCommit
+****************************************************************************//**
+*
+* This function writes the record with the next sequence over the older copy, 
+* with a single SSWR command. The newer copy stays untouched until the next 
+* commit, so a reset leaves either the old or the new record.
+*
+*******************************************************************************/
+void FRAM_MetaCommit(void)
+{
+    uint8_t addrBytes[ADDRESS_SIZE];
+    
+    metaSlot ^= 1u;
+    metaRecord.sequence++;
+    metaRecord.crc = RecordCrc(&metaRecord);
+    
+    SetAddress(addrBytes, metaSlot * FRAM_META_RECORD_SIZE);
+    WriteCmdSSWR(metaBase, metaContext, (uint8_t *)&metaRecord, FRAM_META_RECORD_SIZE, addrBytes, metaLink.spimode);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_MetaUpdate
+****************************************************************************//**
+*
+* This function changes a word and commits the record, for example to count 
+* the boots.
+*
+*******************************************************************************/
+void FRAM_MetaUpdate(uint32_t index, uint32_t value)
+{
+    FRAM_MetaSet(index, value);
+    FRAM_MetaCommit();
+}
+
+#if (FRAM_META_SN_COUNTER != 0u)
+/*******************************************************************************
+* Function Name: FRAM_MetaCounterRead
+****************************************************************************//**
+*
+* This function reads the counter kept in the 8-byte serial number register 
+* as the value and its complement. The serial number of the part is lost.
+*
+* \return
+* false if the complement does not match.
+*
+*******************************************************************************/
+bool FRAM_MetaCounterRead(uint32_t *value)
+{
+    uint32_t sn[2u];
+    
+    WriteCmdRDSN(metaBase, metaContext, (uint8_t *)sn, sizeof(sn), metaLink.spimode, metaLink.regLatency);
+    *value = sn[0u];
+    
+    return (sn[1u] == ~sn[0u]);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_MetaCounterWrite
+****************************************************************************//**
+*
+* This function writes the counter to the serial number register with a 
+* single WRSN command.
+*
+*******************************************************************************/
+void FRAM_MetaCounterWrite(uint32_t value)
+{
+    uint32_t sn[2u] = {value, ~value};
+    
+    WriteCmdWRSN(metaBase, metaContext, (uint8_t *)sn, sizeof(sn), metaLink.spimode);
+}
+#endif /* (FRAM_META_SN_COUNTER != 0u) */
+
+/* [] END OF FILE */
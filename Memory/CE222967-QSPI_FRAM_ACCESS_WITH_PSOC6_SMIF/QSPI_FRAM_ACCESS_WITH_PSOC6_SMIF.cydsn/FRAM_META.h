@@ -0,0 +1,103 @@
+/****************************************************************************
+*File Name: FRAM_META.h
+*
+* Version: 1.0
+*
+* Description: 
+* This file contains the API of the QSPI F-RAM metadata store.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#ifndef FRAM_META_H
+#define FRAM_META_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FRAM_ACCESS.h"
+#include "FRAM_LINK.h"
+
+/***************************************
+* Conditional Compilation Parameters
+***************************************/
+#define FRAM_META_DEMO            (0u)      /* Set to 1 to count the boots in main, instead of */
+                                            /* the special sector example */
+#define FRAM_META_SN_COUNTER      (0u)      /* Set to 1 to keep a counter in the serial number */
+
+/***************************************
+*       Metadata store constants
+***************************************/
+#define FRAM_META_SECTOR_SIZE     (256u)    /* Special sector size */
+#define FRAM_META_RECORD_SIZE     (128u)    /* Two record copies in the special sector */
+#define FRAM_META_WORDS           ((FRAM_META_RECORD_SIZE / 4u) - 2u)   /* Without sequence and CRC */
+
+/* Suggested word assignment, the others are free for the application */
+#define FRAM_META_BOOT_FLAGS      (0u)      /* Boot flags */
+#define FRAM_META_BOOT_COUNT      (1u)      /* Boot counter */
+#define FRAM_META_LAST_GOOD       (2u)      /* Address of the last known good image */
+
+/* Record copy in the special sector */
+typedef struct
+{
+    uint32_t sequence;                      /* Incremented by each commit */
+    uint32_t word[FRAM_META_WORDS];         /* Metadata */
+    uint32_t crc;                           /* CRC-32 of sequence and word[] */
+} fram_meta_record_t;
+
+/***************************************/
+/*QSPI F-RAM metadata store            */
+/***************************************/
+
+bool FRAM_MetaInit(SMIF_Type *baseaddr,                 /* Load the newest valid record */
+                   cy_stc_smif_context_t *smifContext,
+                   const fram_link_t *link);
+
+uint32_t FRAM_MetaGet(uint32_t index);                  /* Read a word of the loaded record */
+
+void FRAM_MetaSet(uint32_t index, uint32_t value);      /* Change a word, kept until the commit */
+
+void FRAM_MetaCommit(void);                             /* Write the record to the older copy */
+
+void FRAM_MetaUpdate(uint32_t index, uint32_t value);   /* Change a word and commit */
+
+#if (FRAM_META_SN_COUNTER != 0u)
+bool FRAM_MetaCounterRead(uint32_t *value);             /* Counter in the serial number register */
+
+void FRAM_MetaCounterWrite(uint32_t value);
+#endif /* (FRAM_META_SN_COUNTER != 0u) */
+
+#endif /* FRAM_META_H */
+
+/* [] END OF FILE */
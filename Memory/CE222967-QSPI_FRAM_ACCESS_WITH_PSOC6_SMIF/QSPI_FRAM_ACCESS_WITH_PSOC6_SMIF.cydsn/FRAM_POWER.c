@@ -0,0 +1,377 @@
+/****************************************************************************
+*File Name: FRAM_POWER.c
+*
+* Version: 1.0
+*
+* Description: 
+* This file puts the QSPI F-RAM into DPD or hibernate mode after an idle time 
+* and wakes it up on the next command. The idle time is adapted to keep the 
+* average wake time per access within a target.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#include "FRAM_POWER.h"
+#include "FRAM_ASYNC.h"
+#include "project.h"
+
+static SMIF_Type *powerBase;
+static cy_stc_smif_context_t *powerContext;
+static uint8_t powerMode;                   /* Access mode for the low power commands */
+static uint8_t powerCmd;                    /* MEM_CMD_ENTDPD or MEM_CMD_ENTHBN */
+static uint32_t exitUs;                     /* Wake-up time of the low power mode */
+static uint32_t targetPenaltyUs;            /* Allowed average wake time per access */
+static uint32_t idleCycles;                 /* Idle threshold in CPU cycles */
+static uint32_t lastAccess;                 /* Cycle counter at the last command */
+static volatile bool asleep;
+static volatile bool wakeRequest;           /* A wake-up was refused, FRAM_PowerPoll() does it */
+static bool started = false;
+
+static fram_power_stats_t powerStats;
+static uint32_t windowAccesses;
+static uint32_t windowWakeUs;
+
+/* Local functions */
+static void SetIdleThreshold(uint32_t idleUs);
+static void AdaptThreshold(void);
+static bool CanBlock(void);
+static uint32_t Wake(void);
+
+/*******************************************************************************
+* Function Name: SetIdleThreshold
+****************************************************************************//**
+*
+* This function clamps the idle threshold and converts it to CPU cycles.
+*
+*******************************************************************************/
+static void SetIdleThreshold(uint32_t idleUs)
+{
+    if (idleUs < FRAM_IDLE_MIN_US)
+    {
+        idleUs = FRAM_IDLE_MIN_US;
+    }
+    if (idleUs > FRAM_IDLE_MAX_US)
+    {
+        idleUs = FRAM_IDLE_MAX_US;
+    }
+    
+    powerStats.idleUs = idleUs;
+    idleCycles = (uint32_t)(((uint64_t)idleUs * SystemCoreClock) / 1000000u);
+}
+
+/*******************************************************************************
+* Function Name: AdaptThreshold
+****************************************************************************//**
+*
+* This function updates the idle threshold after each FRAM_POWER_WINDOW 
+* accesses. The threshold is doubled if the wake time per access is above 
+* the target and halved if it is below half of the target.
+*
+*******************************************************************************/
+static void AdaptThreshold(void)
+{
+    uint32_t penaltyUs = windowWakeUs / windowAccesses;
+    
+    if (penaltyUs > targetPenaltyUs)
+    {
+        SetIdleThreshold(powerStats.idleUs * 2u);
+    }
+    else if (penaltyUs < (targetPenaltyUs / 2u))
+    {
+        SetIdleThreshold(powerStats.idleUs / 2u);
+    }
+    else
+    {
+        /* Within the target */
+    }
+    
+    windowAccesses = 0u;
+    windowWakeUs = 0u;
+}
+
+/*******************************************************************************
+* Function Name: CanBlock
+****************************************************************************//**
+*
+* This function returns true in thread mode with the interrupts enabled, where 
+* the wake-up time can be waited.
+*
+*******************************************************************************/
+static bool CanBlock(void)
+{
+    return ((__get_IPSR() == 0u) && (__get_PRIMASK() == 0u));
+}
+
+/*******************************************************************************
+* Function Name: Wake
+****************************************************************************//**
+*
+* This function wakes the F-RAM from the low power mode. The chip select of a 
+* WRDI command wakes the F-RAM, the command itself is ignored, then the exit 
+* time is waited.
+*
+* \return
+* The time the wake-up took, in us.
+*
+*******************************************************************************/
+static uint32_t Wake(void)
+{
+    uint32_t startCycles = DWT->CYCCNT;
+    uint32_t wakeUs;
+    
+    asleep = false;
+    wakeRequest = false;
+    
+    started = false;    /* The wake-up command is not counted as an access */
+    WriteCmdWRDI(powerBase, powerContext, powerMode);
+    started = true;
+    Cy_SysLib_DelayUs((uint16_t)exitUs);
+    
+    wakeUs = (uint32_t)(((uint64_t)(DWT->CYCCNT - startCycles) * 1000000u) / SystemCoreClock);
+    powerStats.wakes++;
+    powerStats.wakeUs += wakeUs;
+    lastAccess = DWT->CYCCNT;
+    
+    return (wakeUs);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_PowerInit
+****************************************************************************//**
+*
+* This function starts the power manager. The F-RAM is put into the low power 
+* mode by FRAM_PowerPoll() once no command was sent for the idle threshold and 
+* is woken up by FRAM_StartCommand() before the next command. The wake-up 
+* blocks for the exit time, so it is only done in thread mode with the 
+* interrupts enabled: code running in an interrupt or a critical section calls 
+* FRAM_PowerWake() first and retries later if it returns false.
+*
+* Memory-mapped (XIP) reads do not pass FRAM_StartCommand(): do not call 
+* FRAM_PowerPoll() while the SMIF is in the memory mode.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param spimode
+* The access mode of the F-RAM.
+*
+* \param lpCmd
+* MEM_CMD_ENTDPD or MEM_CMD_ENTHBN.
+*
+* \param idleUs
+* The initial idle threshold.
+*
+* \param targetUs
+* The average wake time per access the threshold is adapted to.
+*
+*******************************************************************************/
+void FRAM_PowerInit(SMIF_Type *baseaddr,
+                    cy_stc_smif_context_t *smifContext,
+                    uint8_t spimode,
+                    uint8_t lpCmd,
+                    uint32_t idleUs,
+                    uint32_t targetUs)
+{
+    powerBase = baseaddr;
+    powerContext = smifContext;
+    powerMode = spimode;
+    powerCmd = lpCmd;
+    exitUs = (lpCmd == MEM_CMD_ENTHBN) ? FRAM_EXIT_HBN_US : FRAM_EXIT_DPD_US;
+    targetPenaltyUs = targetUs;
+    
+    powerStats.accesses = 0u;
+    powerStats.sleeps = 0u;
+    powerStats.wakes = 0u;
+    powerStats.wakeUs = 0u;
+    windowAccesses = 0u;
+    windowWakeUs = 0u;
+    SetIdleThreshold(idleUs);
+    
+    /* The idle time is measured with the CPU cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    lastAccess = DWT->CYCCNT;
+    asleep = false;
+    wakeRequest = false;
+    started = true;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_PowerPoll
+****************************************************************************//**
+*
+* This function wakes the F-RAM if a wake-up was refused in an interrupt or a 
+* critical section. Otherwise it enters the low power mode if the F-RAM has 
+* been idle for the threshold and no queued request is pending. Call it from 
+* the main loop at least once in 2^32 CPU cycles.
+*
+*******************************************************************************/
+void FRAM_PowerPoll(void)
+{
+    uint32_t interruptState;
+    
+    if (!started)
+    {
+        return;
+    }
+    
+    if (wakeRequest && asleep)
+    {
+        (void)Wake();
+        return;
+    }
+    
+    /* A request queued in between would be sent to the sleeping F-RAM */
+    interruptState = Cy_SysLib_EnterCriticalSection();
+    
+    if ((!asleep) && (FRAM_AsyncPending() == 0u) && (!Cy_SMIF_BusyCheck(powerBase)) &&
+        ((DWT->CYCCNT - lastAccess) >= idleCycles))
+    {
+        started = false;    /* The low power command is not counted as an access */
+        WriteCmdEnterLPMode(powerBase, powerContext, powerCmd, powerMode);
+        started = true;
+        asleep = true;
+        powerStats.sleeps++;
+    }
+    
+    Cy_SysLib_ExitCriticalSection(interruptState);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_PowerWake
+****************************************************************************//**
+*
+* This function wakes the F-RAM if it is in the low power mode. In an interrupt 
+* or a critical section it does not wait for the exit time: it returns false and 
+* the next FRAM_PowerPoll() wakes the F-RAM.
+*
+* \return
+* true if the F-RAM is awake.
+*
+*******************************************************************************/
+bool FRAM_PowerWake(void)
+{
+    if ((!started) || (!asleep))
+    {
+        return true;
+    }
+    
+    if (!CanBlock())
+    {
+        wakeRequest = true;
+        return false;
+    }
+    
+    (void)Wake();
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_PowerAccess
+****************************************************************************//**
+*
+* This function restarts the idle time and wakes the F-RAM if it is in the low 
+* power mode. It is called by FRAM_StartCommand(), also from the DMA interrupt 
+* of the queued access, which does not wait: FRAM_AsyncSubmit() wakes the F-RAM 
+* first and FRAM_PowerPoll() does not enter the low power mode while requests 
+* are pending. In an interrupt or a critical section a sleeping F-RAM is not 
+* woken up: the F-RAM would ignore the command, so it is refused and a wake-up
+* is requested from FRAM_PowerPoll().
+*
+* \return
+* true if the command can be sent, false if it must be refused.
+*
+*******************************************************************************/
+bool FRAM_PowerAccess(void)
+{
+    uint32_t wakeUs = 0u;
+    
+    if (!started)
+    {
+        return true;
+    }
+    
+    if (asleep)
+    {
+        if (!CanBlock())
+        {
+            wakeRequest = true;
+            return false;
+        }
+        wakeUs = Wake();
+    }
+    
+    powerStats.accesses++;
+    windowAccesses++;
+    windowWakeUs += wakeUs;
+    if (windowAccesses >= FRAM_POWER_WINDOW)
+    {
+        AdaptThreshold();
+    }
+    
+    lastAccess = DWT->CYCCNT;
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_PowerSetMode
+****************************************************************************//**
+*
+* This function sets the access mode used for the low power command, after 
+* the mode is changed in CR2.
+*
+*******************************************************************************/
+void FRAM_PowerSetMode(uint8_t spimode)
+{
+    powerMode = spimode;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_PowerGetStats
+****************************************************************************//**
+*
+* This function returns the power manager statistics.
+*
+*******************************************************************************/
+void FRAM_PowerGetStats(fram_power_stats_t *stats)
+{
+    *stats = powerStats;
+}
+
+/* [] END OF FILE */
@@ -0,0 +1,102 @@
+/****************************************************************************
+*File Name: FRAM_POWER.h
+*
+* Version: 1.0
+*
+* Description: 
+* This file contains the API of the QSPI F-RAM power manager.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#ifndef FRAM_POWER_H
+#define FRAM_POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FRAM_ACCESS.h"
+
+/***************************************
+* Conditional Compilation Parameters
+***************************************/
+#ifndef FRAM_POWER_MANAGER
+#define FRAM_POWER_MANAGER        (0u)      /* Set to 1 to wake the F-RAM on every command */
+#endif /* FRAM_POWER_MANAGER */
+
+/***************************************
+*       Power manager constants
+***************************************/
+/* Wake-up time after the chip select, see tEXIT_DPD and tEXIT_HBN in the datasheet */
+#define FRAM_EXIT_DPD_US          (450u)
+#define FRAM_EXIT_HBN_US          (450u)
+
+#define FRAM_IDLE_MIN_US          (1000u)       /* Idle threshold range, the cycle counter */
+#define FRAM_IDLE_MAX_US          (1000000u)    /* limits it to a few seconds */
+#define FRAM_POWER_WINDOW         (64u)         /* Accesses between threshold updates */
+
+/* Power manager statistics */
+typedef struct
+{
+    uint32_t accesses;                      /* Commands sent */
+    uint32_t sleeps;                        /* Low power mode entries */
+    uint32_t wakes;                         /* Wake-ups on access */
+    uint32_t wakeUs;                        /* Total time spent in wake-ups */
+    uint32_t idleUs;                        /* Current idle threshold */
+} fram_power_stats_t;
+
+/***************************************/
+/*QSPI F-RAM power manager             */
+/***************************************/
+
+void FRAM_PowerInit(SMIF_Type *baseaddr,                /* Start the power manager */
+                    cy_stc_smif_context_t *smifContext,
+                    uint8_t spimode,
+                    uint8_t lpCmd,
+                    uint32_t idleUs,
+                    uint32_t targetUs);
+
+void FRAM_PowerPoll(void);                              /* Enter the low power mode once idle */
+
+bool FRAM_PowerWake(void);                              /* Wake up, false in an interrupt or critical section */
+
+bool FRAM_PowerAccess(void);                            /* Wake up before a command, false if it must be refused */
+
+void FRAM_PowerSetMode(uint8_t spimode);                /* Track access mode changes */
+
+void FRAM_PowerGetStats(fram_power_stats_t *stats);
+
+#endif /* FRAM_POWER_H */
+
+/* [] END OF FILE */
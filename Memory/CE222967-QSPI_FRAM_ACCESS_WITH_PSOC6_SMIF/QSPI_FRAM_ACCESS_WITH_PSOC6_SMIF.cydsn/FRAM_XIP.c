@@ -0,0 +1,389 @@
+/****************************************************************************
+*File Name: FRAM_XIP.c
+*
+* Version: 1.0
+*
+* Description: 
+* This file contains the SMIF memory slot configuration of the CY15x104QSN 
+* and the functions to read the QSPI F-RAM through the PSoC memory map.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#include "FRAM_XIP.h"
+#include "project.h"
+
+cy_stc_smif_mem_cmd_t CY15x104QSN_readCmd =
+{
+    /**< 8 bit command. Quad I/O read (QIOR) */
+    .command = MEM_CMD_QIOR,
+    /**< Width of command transfer, quad in QPI mode */
+    .cmdWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< Width of address transfer */
+    .addrWidth = CY_SMIF_WIDTH_QUAD,
+    /**< 8 bit mode byte. This value is 0xFFFFFFFF when there is no mode present */
+    .mode = FRAM_XIP_MODE_BYTE,
+    /**< Width of mode command transfer */
+    .modeWidth = CY_SMIF_WIDTH_QUAD,
+    /**< Number of dummy cycles, the memory latency (MLC) set in FRAM_XipInit() */
+    .dummyCycles = 0U,
+    /**< Width of data transfer */
+    .dataWidth = CY_SMIF_WIDTH_QUAD
+};
+
+cy_stc_smif_mem_cmd_t CY15x104QSN_writeEnCmd =
+{
+    /**< 8 bit command. Write enable (WREN) */
+    .command = MEM_CMD_WREN,
+    /**< Width of command transfer, quad in QPI mode */
+    .cmdWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< Width of address transfer */
+    .addrWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< 8 bit mode byte. This value is 0xFFFFFFFF when there is no mode present */
+    .mode = 0xFFFFFFFFU,
+    /**< Width of mode command transfer */
+    .modeWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< Number of dummy cycles. A value of zero suggest no dummy cycles */
+    .dummyCycles = 0U,
+    /**< Width of data transfer */
+    .dataWidth = CY_SMIF_WIDTH_SINGLE
+};
+
+cy_stc_smif_mem_cmd_t CY15x104QSN_writeDisCmd =
+{
+    /**< 8 bit command. Write disable (WRDI) */
+    .command = MEM_CMD_WRDI,
+    /**< Width of command transfer, quad in QPI mode */
+    .cmdWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< Width of address transfer */
+    .addrWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< 8 bit mode byte. This value is 0xFFFFFFFF when there is no mode present */
+    .mode = 0xFFFFFFFFU,
+    /**< Width of mode command transfer */
+    .modeWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< Number of dummy cycles. A value of zero suggest no dummy cycles */
+    .dummyCycles = 0U,
+    /**< Width of data transfer */
+    .dataWidth = CY_SMIF_WIDTH_SINGLE
+};
+
+cy_stc_smif_mem_cmd_t CY15x104QSN_programCmd =
+{
+    /**< 8 bit command. Quad I/O write (QIOW) */
+    .command = MEM_CMD_QIOW,
+    /**< Width of command transfer, quad in QPI mode */
+    .cmdWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< Width of address transfer */
+    .addrWidth = CY_SMIF_WIDTH_QUAD,
+    /**< 8 bit mode byte. This value is 0xFFFFFFFF when there is no mode present */
+    .mode = FRAM_XIP_MODE_BYTE,
+    /**< Width of mode command transfer */
+    .modeWidth = CY_SMIF_WIDTH_QUAD,
+    /**< Number of dummy cycles. A value of zero suggest no dummy cycles */
+    .dummyCycles = 0U,
+    /**< Width of data transfer */
+    .dataWidth = CY_SMIF_WIDTH_QUAD
+};
+
+cy_stc_smif_mem_cmd_t CY15x104QSN_readStsRegWipCmd =
+{
+    /**< 8 bit command. Read status register 1 (RDSR1) */
+    .command = MEM_CMD_RDSR1,
+    /**< Width of command transfer, quad in QPI mode */
+    .cmdWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< Width of address transfer */
+    .addrWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< 8 bit mode byte. This value is 0xFFFFFFFF when there is no mode present */
+    .mode = 0xFFFFFFFFU,
+    /**< Width of mode command transfer */
+    .modeWidth = CY_SMIF_WIDTH_SINGLE,
+    /**< Number of dummy cycles. A value of zero suggest no dummy cycles */
+    .dummyCycles = 0U,
+    /**< Width of data transfer */
+    .dataWidth = CY_SMIF_WIDTH_SINGLE
+};
+
+cy_stc_smif_mem_device_cfg_t deviceCfg_CY15x104QSN =
+{
+    /**< This specifies the number of address bytes used by the memory slave device */
+    .numOfAddrBytes = ADDRESS_SIZE,
+    /**< Size of the memory */
+    .memSize = FRAM_XIP_SIZE,
+    /**< This specifies the read command */
+    .readCmd = &CY15x104QSN_readCmd,
+    /**< This specifies the write enable command */
+    .writeEnCmd = &CY15x104QSN_writeEnCmd,
+    /**< This specifies the write disable command */
+    .writeDisCmd = &CY15x104QSN_writeDisCmd,
+    /**< F-RAM has no erase */
+    .eraseCmd = NULL,
+    /**< This specifies the sector size of each erase */
+    .eraseSize = 0U,
+    /**< F-RAM has no erase */
+    .chipEraseCmd = NULL,
+    /**< This specifies the program command */
+    .programCmd = &CY15x104QSN_programCmd,
+    /**< F-RAM has no pages, the packet size is used */
+    .programSize = PACKET_SIZE,
+    /**< The quad mode is always enabled */
+    .readStsRegQeCmd = NULL,
+    /**< This specifies the command to read the WIP-containing status register */
+    .readStsRegWipCmd = &CY15x104QSN_readStsRegWipCmd,
+    /**< The quad mode is always enabled */
+    .writeStsRegQeCmd = NULL,
+    /**< Mask for the status register, F-RAM is never busy */
+    .stsRegBusyMask = 0x00U,
+    /**< Mask for the status register */
+    .stsRegQuadEnableMask = 0x00U,
+    /**< Max time for erase type 1 cycle time in ms */
+    .eraseTime = 0U,
+    /**< Max time for chip erase cycle time in ms */
+    .chipEraseTime = 0U,
+    /**< Writes complete at the bus speed */
+    .programTime = 0U
+};
+
+cy_stc_smif_mem_config_t CY15x104QSN_SlaveSlot_2 =
+{
+    /**< Determines the slot number where the memory device is placed */
+    .slaveSelect = CY_SMIF_SLAVE_SELECT_2,
+    /**< Flags */
+    .flags = CY_SMIF_FLAG_MEMORY_MAPPED,
+    /**< Data line selection options for a slave device */
+    .dataSelect = CY_SMIF_DATA_SEL0,
+    /**< The base address the memory slave is mapped to in the PSoC memory map.
+    Valid when memory mapped mode is enabled */
+    .baseAddress = FRAM_XIP_BASE,
+    /**< The size allocated in the PSoC memory map, for the memory slave device.
+    The size is allocated from the base address Valid when memory mapped mode is enabled */
+    .memMappedSize = FRAM_XIP_SIZE,
+    /**< Is this memory device one of the devices in a dual quad SPI configuration.
+    Valid when memory mapped mode is enabled */
+    .dualQuadSlots = 0,
+    /**< Configuration of the device */
+    .deviceCfg = &deviceCfg_CY15x104QSN
+};
+
+cy_stc_smif_mem_config_t* framMemConfigs[] = {
+   &CY15x104QSN_SlaveSlot_2
+};
+
+cy_stc_smif_block_config_t framBlockConfig =
+{
+    /* Number of SMIF memories defined  */
+    .memCount = 1U,
+    /* The pointer to the array of memory config structures of size memCount */
+    .memConfig = (cy_stc_smif_mem_config_t**)framMemConfigs,
+    /* Version of the SMIF driver */
+    .majorVersion = CY_SMIF_DRV_VERSION_MAJOR,
+    /* Version of the SMIF driver */
+    .minorVersion = CY_SMIF_DRV_VERSION_MINOR
+};
+
+static SMIF_Type *xipBase;
+static cy_stc_smif_context_t *xipContext;
+static uint8_t xipSpimode;
+static uint8_t xipLatency;
+
+/*******************************************************************************
+* Function Name: FRAM_XipInit
+****************************************************************************//**
+*
+* This function maps the F-RAM at FRAM_XIP_BASE and switches the SMIF to the 
+* memory mode. The F-RAM is then read through plain pointers (FRAM_XIP_PTR) 
+* with QIOR commands generated by the SMIF. The commands of FRAM_ACCESS.c 
+* need the normal mode: use FRAM_XipExit() first.
+*
+* Writes through the mapping are not enabled: the SMIF does not send WREN 
+* before a memory-mapped write, and the F-RAM clears WEL after every write. 
+* Use FRAM_XipWrite() instead.
+*
+* \param baseaddr
+* Holds the base address of the SMIF block registers.
+*
+* \param smifContext
+* The internal SMIF context data.
+*
+* \param spimode
+* SPI_MODE or QPI_MODE. The SMIF memory mode cannot send DPI commands.
+*
+* \param latency
+* Memory latency cycle during read (MLC), as programmed in CR1.
+*
+* \return
+* false if the mode is not supported or the memory slot is not initialized.
+*
+*******************************************************************************/
+bool FRAM_XipInit(SMIF_Type *baseaddr, cy_stc_smif_context_t *smifContext, uint8_t spimode, uint8_t latency)
+{
+    cy_en_smif_txfr_width_t cmdWidth = (spimode == QPI_MODE) ? CY_SMIF_WIDTH_QUAD : CY_SMIF_WIDTH_SINGLE;
+    
+    if (spimode == DPI_MODE)
+    {
+        return false;
+    }
+    
+    xipBase = baseaddr;
+    xipContext = smifContext;
+    xipSpimode = spimode;
+    xipLatency = latency;
+    
+    /* In QPI mode every phase is on four lines */
+    CY15x104QSN_readCmd.cmdWidth = cmdWidth;
+    CY15x104QSN_readCmd.dummyCycles = latency;
+    CY15x104QSN_programCmd.cmdWidth = cmdWidth;
+    CY15x104QSN_writeEnCmd.cmdWidth = cmdWidth;
+    CY15x104QSN_writeDisCmd.cmdWidth = cmdWidth;
+    CY15x104QSN_readStsRegWipCmd.cmdWidth = cmdWidth;
+    CY15x104QSN_readStsRegWipCmd.dataWidth = cmdWidth;
+    
+    if (Cy_SMIF_Memslot_Init(xipBase, &framBlockConfig, xipContext) != CY_SMIF_SUCCESS)
+    {
+        return false;
+    }
+    
+    Cy_SMIF_SetMode(xipBase, CY_SMIF_MEMORY);
+    
+    return true;
+}
+
+/*******************************************************************************
+* Function Name: FRAM_XipExit
+****************************************************************************//**
+*
+* This function returns the SMIF to the normal mode, so the commands of 
+* FRAM_ACCESS.c can be used again.
+*
+*******************************************************************************/
+void FRAM_XipExit(void)
+{
+    Cy_SMIF_SetMode(xipBase, CY_SMIF_NORMAL);
+}
+
+/*******************************************************************************
+* Function Name: FRAM_XipWrite
+****************************************************************************//**
+*
+* This function writes data with WREN and QIOW (or WRITE in QPI mode) in the 
+* normal mode and returns to the memory mode. The SMIF cache is not enabled 
+* for the F-RAM, so the mapped contents are up to date at once.
+*
+* \param address 
+* The F-RAM address to write data to.
+*
+* \param buffer
+* Data to write in the external memory.
+*
+* \param size
+* The size of data.
+*
+*******************************************************************************/
+void FRAM_XipWrite(uint32_t address, uint8_t buffer[], uint32_t size)
+{
+    uint8_t addrBytes[ADDRESS_PLUS_MODE_SIZE] = 
+    {
+        (uint8_t)(address >> 16u), (uint8_t)(address >> 8u), (uint8_t)address, FRAM_XIP_MODE_BYTE
+    };
+    
+    Cy_SMIF_SetMode(xipBase, CY_SMIF_NORMAL);
+    
+    if (xipSpimode == SPI_MODE)
+    {
+        WriteCmdSPIWrite_DIOW_QIOW(xipBase, xipContext, buffer, size, addrBytes, MEM_CMD_QIOW);
+    }
+    else
+    {
+        WriteCmdSPIWrite(xipBase, xipContext, buffer, size, addrBytes, xipSpimode);
+    }
+    
+    Cy_SMIF_SetMode(xipBase, CY_SMIF_MEMORY);
+}
+
+#if (FRAM_XIP_BENCHMARK != 0u)
+/*******************************************************************************
+* Function Name: FRAM_XipBenchmark
+****************************************************************************//**
+*
+* This function times FRAM_XIP_BENCH_READS random 4-byte reads through the 
+* mapping and the same reads with QIOR commands in the normal mode. 
+* FRAM_XipInit() must have been called.
+*
+* \param result
+* The average CPU cycles of one read for each path.
+*
+*******************************************************************************/
+void FRAM_XipBenchmark(fram_xip_bench_t *result)
+{
+    uint8_t addrBytes[ADDRESS_PLUS_MODE_SIZE];
+    uint8_t data[4u];
+    uint32_t seed = 1u;
+    uint32_t address;
+    uint32_t startCycles;
+    uint32_t idx;
+    
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    
+    /* Memory-mapped reads */
+    startCycles = DWT->CYCCNT;
+    for (idx = 0u; idx < FRAM_XIP_BENCH_READS; idx++)
+    {
+        seed = (seed * 1664525u) + 1013904223u;
+        address = (seed >> 8u) & (FRAM_XIP_SIZE - 4u);
+        (void)*(volatile uint32_t *)FRAM_XIP_PTR(address);
+    }
+    result->xipCycles = (DWT->CYCCNT - startCycles) / FRAM_XIP_BENCH_READS;
+    
+    /* The same addresses with commands */
+    seed = 1u;
+    Cy_SMIF_SetMode(xipBase, CY_SMIF_NORMAL);
+    startCycles = DWT->CYCCNT;
+    for (idx = 0u; idx < FRAM_XIP_BENCH_READS; idx++)
+    {
+        seed = (seed * 1664525u) + 1013904223u;
+        address = (seed >> 8u) & (FRAM_XIP_SIZE - 4u);
+        addrBytes[0u] = (uint8_t)(address >> 16u);
+        addrBytes[1u] = (uint8_t)(address >> 8u);
+        addrBytes[2u] = (uint8_t)address;
+        addrBytes[3u] = FRAM_XIP_MODE_BYTE;
+        WriteCmdSPIRead_DIOR_QIOR(xipBase, xipContext, data, sizeof(data), addrBytes, 
+                                  xipSpimode, xipLatency, MEM_CMD_QIOR);
+    }
+    result->cmdCycles = (DWT->CYCCNT - startCycles) / FRAM_XIP_BENCH_READS;
+    Cy_SMIF_SetMode(xipBase, CY_SMIF_MEMORY);
+}
+#endif /* (FRAM_XIP_BENCHMARK != 0u) */
+
+/* [] END OF FILE */
@@ -0,0 +1,99 @@
+/****************************************************************************
+*File Name: FRAM_XIP.h
+*
+* Version: 1.0
+*
+* Description: 
+* This file contains the API of the memory-mapped (XIP) QSPI F-RAM access.
+*
+* Related Document: CE222967.pdf
+*
+* Hardware Dependency PSoC 6 Pioneer Kit (CY8CKIT-062-BLE) WITH SERIAL F-RAM 
+*
+*****************************************************************************
+* Copyright (2018), Cypress Semiconductor Corporation.
+*****************************************************************************
+* This software, including source code, documentation and related materials
+* ("Software") is owned by Cypress Semiconductor Corporation (Cypress) and is
+* protected by and subject to worldwide patent protection (United States and 
+* foreign), United States copyright laws and international treaty provisions. 
+* Cypress hereby grants to licensee a personal, non-exclusive, non-transferable
+* license to copy, use, modify, create derivative works of, and compile the 
+* Cypress source code and derivative works for the sole purpose of creating 
+* custom software in support of licensee product, such licensee product to be
+* used only in conjunction with Cypress's integrated circuit as specified in the
+* applicable agreement. Any reproduction, modification, translation, compilation,
+* or representation of this Software except as specified above is prohibited 
+* without the express written permission of Cypress.
+* 
+* Disclaimer: THIS SOFTWARE IS PROVIDED AS-IS, WITH NO WARRANTY OF ANY KIND, 
+* EXPRESS OR IMPLIED, INCLUDING, BUT NOT LIMITED TO, NONINFRINGEMENT, IMPLIED 
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+* Cypress reserves the right to make changes to the Software without notice. 
+* Cypress does not assume any liability arising out of the application or use
+* of Software or any product or circuit described in the Software. Cypress does
+* not authorize its products for use as critical components in any products 
+* where a malfunction or failure may reasonably be expected to result in 
+* significant injury or death ("ACTIVE Risk Product"). By including Cypress's 
+* product in a ACTIVE Risk Product, the manufacturer of such system or application
+* assumes all risk of such use and in doing so indemnifies Cypress against all
+* liability. Use of this Software may be limited by and subject to the applicable
+* Cypress software license agreement.
+*******************************************************************************/
+
+#ifndef FRAM_XIP_H
+#define FRAM_XIP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FRAM_ACCESS.h"
+
+/***************************************
+*   Conditional Compilation Parameters
+***************************************/
+/* Set to non-zero to build FRAM_XipBenchmark() */
+#define FRAM_XIP_BENCHMARK        (0u)
+
+/***************************************
+*       Memory-mapped access constants
+***************************************/
+#define FRAM_XIP_BASE             (0x18000000u) /* F-RAM address 0 in the PSoC memory map */
+#define FRAM_XIP_SIZE             (0x80000u)    /* CY15x104QSN density, 4 Mbit */
+#define FRAM_XIP_MODE_BYTE        (0x00u)       /* Mode byte of QIOR/QIOW, non XIP continuous mode */
+
+/* Pointer to an F-RAM address in the memory-mapped mode */
+#define FRAM_XIP_PTR(address)     ((volatile uint8_t *)(FRAM_XIP_BASE + (uint32_t)(address)))
+
+#if (FRAM_XIP_BENCHMARK != 0u)
+#define FRAM_XIP_BENCH_READS      (1024u)       /* Random reads timed for each access path */
+
+/* Average CPU cycles of one random 4-byte read */
+typedef struct
+{
+    uint32_t xipCycles;                     /* Pointer read in the memory-mapped mode */
+    uint32_t cmdCycles;                     /* QIOR command in the normal mode */
+} fram_xip_bench_t;
+#endif /* (FRAM_XIP_BENCHMARK != 0u) */
+
+/***************************************/
+/*QSPI F-RAM memory-mapped access      */
+/***************************************/
+
+bool FRAM_XipInit(SMIF_Type *baseaddr,                  /* Map the F-RAM and switch the SMIF to the memory mode */
+                  cy_stc_smif_context_t *smifContext,
+                  uint8_t spimode,
+                  uint8_t latency);
+
+void FRAM_XipExit(void);                                /* Return the SMIF to the normal (command) mode */
+
+void FRAM_XipWrite(uint32_t address,                    /* Write data, the mapping stays valid */
+                   uint8_t buffer[],
+                   uint32_t size);
+
+#if (FRAM_XIP_BENCHMARK != 0u)
+void FRAM_XipBenchmark(fram_xip_bench_t *result);       /* Random-access latency of both access paths */
+#endif /* (FRAM_XIP_BENCHMARK != 0u) */
+
+#endif /* FRAM_XIP_H */
+
+/* [] END OF FILE */
@@ -44,6 +44,11 @@
 #include <stdio.h>
 #include <project.h>
 #include "FRAM_ACCESS.h"
+#include "FRAM_LOG.h"
+#include "FRAM_XIP.h"
+#include "FRAM_LINK.h"
+#include "FRAM_POWER.h"
+#include "FRAM_META.h"
 #include "SMIF_FRAM.h"
 
 /*******************************************************************************
@@ -82,6 +87,9 @@ uint32_t ACCESS_MODE = SPI_MODE;         /* Sets the device access mode */
                                                                                    /* with mode bye */
 cy_stc_smif_context_t smifContext;
 cy_en_smif_slave_select_t ONBOARD_SSFRAM = CY_SMIF_SLAVE_SELECT_2;
+#if (FRAM_LINK_NEGOTIATE != 0u)
+fram_link_t framLink;                    /* Negotiated access mode and latencies */
+#endif /* (FRAM_LINK_NEGOTIATE != 0u) */
 
 void ExtMemInterrupt(void);
 void PrintData(uint8_t *tst_rxBuffer,uint32_t size); /* Send the buffer data to the console */
@@ -150,7 +158,7 @@ int main()
         .mode           = CY_SMIF_NORMAL,   /* The mode of operation; non XIP */
         .deselectDelay  = DESELECT_DELAY,   /* The minimum duration of SPI deselection */
         .rxClockSel     = RX_CLOCK_SELECT,  /* The clock source for the receiver clock */
-        .blockEvent     = AHB_BUS_ERROR,    /* What happens when there is a Read to an empty RX FIFO or Write to a full TX FIFO*/
+        .blockEvent     = CY_SMIF_WAIT_STATES, /* Wait states on a Read to an empty RX FIFO or Write to a full TX FIFO, needed by FRAM_ASYNC */
     };
 	
   
@@ -170,6 +178,17 @@ int main()
     
     printf("\r\n********QSPI F-RAM Access with PSoC 6 SMIF - Code Example (CE222967)*********"); 
     
+#if (FRAM_LINK_NEGOTIATE != 0u)
+    /* Selects the latencies for the actual SCK; the examples below start in SPI mode, the mode is applied after them */
+    if (!FRAM_Negotiate(SMIF0, &smifContext, Cy_SysClk_ClkHfGetFrequency(FRAM_SMIF_CLK_HF) / 2u, &framLink))
+    {
+        printf("\r\n F-RAM negotiation failed, SPI mode with max latency");
+    }
+    MLC = framLink.memLatency;
+    RLC = framLink.regLatency;
+    printf("\r\n F-RAM link - mode %d, MLC %d, RLC %d\r\n", framLink.spimode, MLC, RLC);
+#endif /* (FRAM_LINK_NEGOTIATE != 0u) */
+    
     /* Sets the device access mode to default SPI */     
     PowerUpMemoryDefaultSPI (); 
         
@@ -499,6 +518,8 @@ int main()
 /***256-Byte Special Sector Write and Read in QPI********/
 /********************************************************/   
   
+#if (FRAM_META_DEMO == 0u)
+    /* The metadata store demo keeps its records in the special sector */
     STATUS_LED_CNTRL_Write (STATUS_LED_OFF); /* Turn off the Status LED before the next text */ 
     CyDelay(LED_ON_TIME);
   
@@ -556,13 +577,66 @@ int main()
           STATUS_LED_CNTRL_Write (STATUS_LED_GREEN); /* Turns GREEN LED ON */ 
           CyDelay(LED_ON_TIME);
         }   
+#endif /* (FRAM_META_DEMO == 0u) */
        
    printf("\r\n========================================================================= ");   
 
+#if (FRAM_LOG_BENCHMARK != 0u)
+    /* The ring log uses the extended SPI quad commands: return to SPI mode */
+    PowerUpMemoryDefaultSPI();
+    (void)FRAM_LogInit(SMIF0, &smifContext, MLC);
+    printf("\r\nRing log append rate: %lu records/s ", (unsigned long)FRAM_LogBenchmark(FRAM_LOG_CAPACITY));
+    printf("\r\n========================================================================= ");
+#endif /* (FRAM_LOG_BENCHMARK != 0u) */
+
+#if (FRAM_XIP_BENCHMARK != 0u)
+    fram_xip_bench_t xipBench;
+    
+    /* Random 4-byte reads through the memory map and with QIOR commands */
+    PowerUpMemoryDefaultSPI();
+    if (FRAM_XipInit(SMIF0, &smifContext, SPI_MODE, MLC))
+    {
+        FRAM_XipBenchmark(&xipBench);
+        FRAM_XipExit();
+        printf("\r\nRandom read latency: XIP %lu cycles, command %lu cycles ", 
+               (unsigned long)xipBench.xipCycles, (unsigned long)xipBench.cmdCycles);
+    }
+    printf("\r\n========================================================================= ");
+#endif /* (FRAM_XIP_BENCHMARK != 0u) */
+
+#if (FRAM_META_DEMO != 0u)
+    fram_link_t metaLink = {SPI_MODE, 0u, 0u};
+    
+    /* Boot counter in the special sector, one SSWR per update */
+    PowerUpMemoryDefaultSPI();
+    metaLink.memLatency = MLC;
+    metaLink.regLatency = RLC;
+    (void)FRAM_MetaInit(SMIF0, &smifContext, &metaLink);
+    FRAM_MetaUpdate(FRAM_META_BOOT_COUNT, FRAM_MetaGet(FRAM_META_BOOT_COUNT) + 1u);
+    printf("\r\nBoot count: %lu ", (unsigned long)FRAM_MetaGet(FRAM_META_BOOT_COUNT));
+    printf("\r\n========================================================================= ");
+#endif /* (FRAM_META_DEMO != 0u) */
+
+    /* Leave the F-RAM in SPI mode, or in the negotiated mode */
+    PowerUpMemoryDefaultSPI();
+    ACCESS_MODE = SPI_MODE;
+#if (FRAM_LINK_NEGOTIATE != 0u)
+    FRAM_LinkApply(SMIF0, &smifContext, SPI_MODE, &framLink);
+    ACCESS_MODE = framLink.spimode;
+#endif /* (FRAM_LINK_NEGOTIATE != 0u) */
+
+#if (FRAM_POWER_MANAGER != 0u)
+    /* Hibernate after 10 ms idle, at most 50 us average wake time per access */
+    FRAM_PowerInit(SMIF0, &smifContext, (uint8_t)ACCESS_MODE, MEM_CMD_ENTHBN, 10000u, 50u);
+#endif /* (FRAM_POWER_MANAGER != 0u) */
+
     for(;;)
       {  
         /*Loops forever*/
         /* CM4 does nothing after SMIF operation is complete. */
+    #if (FRAM_POWER_MANAGER != 0u)
+        FRAM_PowerPoll();
+    #endif /* (FRAM_POWER_MANAGER != 0u) */
       }    
 }     
 